@@ -224,6 +224,9 @@ def _init_paths():
 _paths = _init_paths()
 
 
+# The gates themselves are native engine components (see init_components.h).
+# These definitions mirror them only to compute the hashes the schematics are keyed by,
+# so every field that goes into the hash must match the native definition.
 digital_gates: list[ComponentDefinition] = []
 schematic_diagrams: dict[int, SchematicDiagram] = {}
 
@@ -3,7 +3,6 @@ from bessplug import Plugin
 from bessplug.api.sim_engine import ComponentDefinition
 from components.latches import latches
 from components.digital_gates import (
-    digital_gates,
     schematic_diagrams as digital_gates_schematics,
 )
 from components.flip_flops import flip_flops
@@ -26,9 +25,9 @@ class BessPlugin(Plugin):
 
     @override
     def on_components_reg_load(self) -> list[ComponentDefinition]:
+        # digital gates are built into the engine, only their schematics live here
         return [
             *latches,
-            *digital_gates,
             *flip_flops,
             *combinational_circuits,
             tristate_buffer_def,
@@ -145,6 +145,9 @@ namespace Bess::Pages {
     void MainPage::update(TimeMs ts, std::vector<ApplicationEvent> &events) {
         m_state.update();
 
+        // slot changes the sim thread logged since the last frame, probes record them here
+        SimEngine::SimulationEngine::instance().dispatchStateChanges();
+
         int clickEvtIdx = -1;
 
         int idx = -1;
@@ -123,9 +123,13 @@ namespace Bess::Canvas {
 
         auto &simEngine = SimEngine::SimulationEngine::instance();
 
-        simEngine.setOutputSlotState(slotParentComp->getSimEngineId(),
+        // the engine's own state, the frame snapshot can lag behind a fast second click
+        const auto simId = slotParentComp->getSimEngineId();
+        const auto current = simEngine.getDigitalSlotState(simId, SimEngine::SlotType::digitalOutput,
+                                                           slotComp->getIndex());
+        simEngine.setOutputSlotState(simId,
                                      slotComp->getIndex(),
-                                     slotComp->getSlotState(*e.sceneState).state == SimEngine::LogicState::high
+                                     current.state == SimEngine::LogicState::high
                                          ? SimEngine::LogicState::low
                                          : SimEngine::LogicState::high);
     }
@@ -104,6 +104,8 @@ namespace Bess::Canvas {
         }
 
         outputDigitalComp->removeOnStateChangeCB(m_uuid);
+        // stays a synchronous callback on the sim thread instead of a state change listener,
+        // it drives the module's outputs and must not wait for the next UI frame
         outputDigitalComp->addOnStateChangeCB(m_uuid, [this](const SimEngine::ComponentState &oldState,
                                                              const SimEngine::ComponentState &newState) {
             auto &simEngine = SimEngine::SimulationEngine::instance();
@@ -10,14 +10,16 @@
 #include "settings/viewport_theme.h"
 #include "simulation_engine.h"
 #include "types.h"
+#include <algorithm>
 
 namespace Bess::Canvas {
     std::vector<std::shared_ptr<SceneComponent>> SlotProbeSceneComponent::clone(const SceneState &sceneState) const {
         (void)sceneState;
         auto clonedComponent = std::make_shared<SlotProbeSceneComponent>(*this);
         prepareClone(*clonedComponent);
-        clonedComponent->setProbeData({});
+        clonedComponent->m_probeHistory.clear();
         clonedComponent->m_probedSlotUuid = UUID::null;
+        clonedComponent->m_subscribedComponent = UUID::null;
         return {clonedComponent};
     }
 
@@ -78,8 +80,7 @@ namespace Bess::Canvas {
                                              glm::vec2(endPos.x, endPos.y),
                                              0.75f);
 
-            const auto &color = !m_probeData.empty() &&
-                                        m_probeData.back().second == SimEngine::LogicState::high
+            const auto &color = m_probeHistory.getLastState() == SimEngine::LogicState::high
                                     ? ViewportTheme::colors.stateHigh
                                     : ViewportTheme::colors.stateLow;
 
@@ -101,14 +102,14 @@ namespace Bess::Canvas {
     }
 
     void SlotProbeSceneComponent::update(TimeMs frameTime, SceneState &state) {
-        if (m_probedSlotUuid == UUID::null)
-            return;
-
         if (m_unsubscribeFlag) {
             m_unsubscribeFlag = false;
             unsubscribeFromSlot(state);
         }
 
+        if (m_probedSlotUuid == UUID::null)
+            return;
+
         if (m_subscribeFlag) {
             m_subscribeFlag = false;
             subscribeToSlot(state, m_probedSlotUuid);
@@ -132,7 +133,7 @@ namespace Bess::Canvas {
     }
 
     void SlotProbeSceneComponent::onProbedSlotChanged() {
-        m_probeData.clear();
+        m_probeHistory.clear();
         m_subscribeFlag = true;
     }
 
@@ -144,6 +145,7 @@ namespace Bess::Canvas {
     std::vector<UUID> SlotProbeSceneComponent::cleanup(SceneState &state, UUID caller) {
         auto &mainPageState = Pages::MainPage::getInstance()->getState();
         mainPageState.getProbes().erase(getUuid());
+        unsubscribeFromSlot(state);
         return NonSimSceneComponent::cleanup(state, caller);
     }
 
@@ -164,19 +166,30 @@ namespace Bess::Canvas {
                     m_probedSlotUuid != UUID::null
                         ? m_probedSlotUuid.toString().c_str()
                         : "None");
+        if (ImGui::Checkbox("Record Every Transition", &m_recordEveryTransition) &&
+            m_subscribedComponent != UUID::null) {
+            m_unsubscribeFlag = true;
+            m_subscribeFlag = true;
+        }
+        int limitMiB = static_cast<int>(getHistoryLimitMiB());
+        if (ImGui::InputInt("History Limit (MiB)", &limitMiB) && limitMiB > 0) {
+            setHistoryLimitMiB(static_cast<uint32_t>(limitMiB));
+        }
+        ImGui::Text("Recorded: %llu, dropped: %llu",
+                    static_cast<unsigned long long>(m_probeHistory.getTransitionCount()),
+                    static_cast<unsigned long long>(m_probeHistory.getDroppedCount()));
+
         if (ImGui::BeginTable("ProbeDataTable", 2, ImGuiTableFlags_Borders)) {
             ImGui::TableSetupColumn("Time");
             ImGui::TableSetupColumn("State");
             ImGui::TableHeadersRow();
-            for (auto it = m_probeData.rbegin();
-                 it != m_probeData.rend() &&
-                 std::distance(m_probeData.rbegin(), it) < 20;
-                 ++it) {
+            const auto recent = m_probeHistory.getRecent(20);
+            for (auto it = recent.rbegin(); it != recent.rend(); ++it) {
                 ImGui::TableNextRow();
                 ImGui::TableSetColumnIndex(0);
-                ImGui::Text("%.3f s", std::chrono::duration<float>(it->first).count());
+                ImGui::Text("%.3f s", std::chrono::duration<float>(it->time).count());
                 ImGui::TableSetColumnIndex(1);
-                ImGui::Text("%s", it->second == SimEngine::LogicState::high ? "High" : "Low");
+                ImGui::Text("%s", it->state == SimEngine::LogicState::high ? "High" : "Low");
             }
             ImGui::EndTable();
         }
@@ -190,47 +203,39 @@ namespace Bess::Canvas {
         const auto &simId = sceneState.getComponentByUuid<SimulationSceneComponent>(
                                           comp->getParentComponent())
                                 ->getSimEngineId();
-        const auto &digComp = SimEngine::SimulationEngine::instance().getDigitalComponent(simId);
-        digComp->addOnStateChangeCB(m_uuid, [this, slotComp = comp](const SimEngine::ComponentState &oldState,
-                                                                    const SimEngine::ComponentState &newState) {
-            SimEngine::SlotState slotState;
-
-            if (slotComp->isInputSlot()) {
-                slotState = newState.inputStates[slotComp->getIndex()];
-            } else {
-                slotState = newState.outputStates[slotComp->getIndex()];
-            }
-
-            if (m_probeData.empty()) {
-                m_probeData.emplace_back(slotState.lastChangeTime,
-                                         slotState.state);
-            } else {
-                auto &lastEntry = m_probeData.back();
-                if (slotState.state != lastEntry.second) {
-                    m_probeData.emplace_back(slotState.lastChangeTime,
-                                             slotState.state);
-                }
-            }
-        });
+        const auto slotType = comp->isInputSlot() ? SimEngine::SlotType::digitalInput
+                                                  : SimEngine::SlotType::digitalOutput;
+        const auto slotIdx = static_cast<uint32_t>(comp->getIndex());
+
+        // delivered on the UI thread by MainPage::update
+        SimEngine::SimulationEngine::instance().addStateChangeListener(
+            m_uuid, simId, [this, slotType, slotIdx](const SimEngine::SlotChange &change) {
+                if (change.type != slotType || change.slot != slotIdx)
+                    return;
+
+                m_probeHistory.append(change.time, change.state);
+            },
+            m_recordEveryTransition);
+        m_subscribedComponent = simId;
     }
 
     void SlotProbeSceneComponent::unsubscribeFromSlot(const SceneState &sceneState) {
-        if (m_unsubscribeSlotUuid == UUID::null)
+        if (m_subscribedComponent == UUID::null)
             return;
 
-        const auto &comp = sceneState.getComponentByUuid<SlotSceneComponent>(m_unsubscribeSlotUuid);
-        if (!comp)
-            return;
+        SimEngine::SimulationEngine::instance().removeStateChangeListener(m_uuid, m_subscribedComponent);
+        m_subscribedComponent = UUID::null;
+    }
 
-        const auto &simId = sceneState.getComponentByUuid<SimulationSceneComponent>(
-                                          comp->getParentComponent())
-                                ->getSimEngineId();
-        const auto &digComp = SimEngine::SimulationEngine::instance().getDigitalComponent(simId);
-        digComp->removeOnStateChangeCB(m_uuid);
+    uint32_t SlotProbeSceneComponent::getHistoryLimitMiB() const {
+        return static_cast<uint32_t>(m_probeHistory.getMemoryLimit() >> 20);
+    }
+
+    void SlotProbeSceneComponent::setHistoryLimitMiB(uint32_t limit) {
+        m_probeHistory.setMemoryLimit(uint64_t{std::max(limit, 1u)} << 20);
     }
 
     void SlotProbeSceneComponent::onBeforeProbedSlotChanged() {
         m_unsubscribeFlag = true;
-        m_unsubscribeSlotUuid = m_probedSlotUuid;
     }
 } // namespace Bess::Canvas
@@ -1,11 +1,14 @@
 #pragma once
 #include "common/bess_uuid.h"
+#include "probe/probe_history.h"
 #include "pages/main_page/scene_components/non_sim_scene_component.h"
 #include "pages/main_page/scene_components/scene_comp_types.h"
 #include "scene_state/components/scene_component.h"
 #include "types.h"
 
-#define SLOT_PROBE_SER_PROPS ("probedSlot", getProbedSlotUuid, setProbedSlotUuid)
+#define SLOT_PROBE_SER_PROPS ("probedSlot", getProbedSlotUuid, setProbedSlotUuid), \
+                             ("recordEveryTransition", getRecordEveryTransition, setRecordEveryTransition), \
+                             ("historyLimitMiB", getHistoryLimitMiB, setHistoryLimitMiB)
 
 namespace Bess::Canvas {
     class SceneState;
@@ -24,8 +27,14 @@ namespace Bess::Canvas {
                                  onBeforeProbedSlotChanged,
                                  onProbedSlotChanged);
 
-        typedef std::pair<TimeNs, SimEngine::LogicState> ProbeDataEntry;
-        MAKE_GETTER_SETTER(std::vector<ProbeDataEntry>, ProbeData, m_probeData)
+        MAKE_GETTER_SETTER(SimEngine::ProbeHistory, ProbeHistory, m_probeHistory)
+
+        // memory the recorded history may use before its oldest transitions are dropped
+        uint32_t getHistoryLimitMiB() const;
+        void setHistoryLimitMiB(uint32_t limit);
+
+        // off: only the latest state of the slot per frame is recorded
+        MAKE_GETTER_SETTER(bool, RecordEveryTransition, m_recordEveryTransition)
 
         SCENE_COMP_SER(SlotProbeSceneComponent, NonSimSceneComponent, SLOT_PROBE_SER_PROPS)
 
@@ -56,10 +65,12 @@ namespace Bess::Canvas {
 
       private:
         UUID m_probedSlotUuid = UUID::null;
-        UUID m_unsubscribeSlotUuid = UUID::null;
+        // sim engine component the listener is registered on
+        UUID m_subscribedComponent = UUID::null;
         bool m_subscribeFlag = false,
              m_unsubscribeFlag = false;
-        std::vector<std::pair<TimeNs, SimEngine::LogicState>> m_probeData;
+        bool m_recordEveryTransition = false;
+        SimEngine::ProbeHistory m_probeHistory;
         bool m_scaleDirty = false;
     };
 } // namespace Bess::Canvas
@@ -166,71 +166,47 @@ namespace Bess::Canvas {
         }
     }
 
-    SimEngine::SlotState SlotSceneComponent::getSlotState(
-        const SceneState &state) const {
-        BESS_ASSERT(m_parentComponent != UUID::null,
-                    std::format("Parent component UUID is null, {}", (uint64_t)m_uuid));
-        BESS_ASSERT(m_index >= 0, "Slot index is negative");
+    uint32_t SlotSceneComponent::getSnapshotSlot(const SceneState &state,
+                                                 const SimEngine::SlotStateSnapshot &snapshot) const {
+        if (m_snapshotLayoutId == snapshot.getLayoutId() && m_snapshotSlotIndex == m_index &&
+            m_snapshotParent == m_parentComponent) {
+            return m_snapshotSlot;
+        }
+
+        m_snapshotLayoutId = snapshot.getLayoutId();
+        m_snapshotSlotIndex = m_index;
+        m_snapshotParent = m_parentComponent;
+        m_snapshotSlot = SimEngine::invalidSnapshotSlot;
 
         const auto parentComp = state.getComponentByUuid<SimulationSceneComponent>(m_parentComponent);
-        if (!parentComp || m_index < 0) {
-            return {SimEngine::LogicState::unknown, SimEngine::SimTime(0)};
+        if (!parentComp || m_index < 0 || !snapshot.getLayout()) {
+            return m_snapshotSlot;
         }
 
-        auto &simEngine = SimEngine::SimulationEngine::instance();
-        const auto digitalComp = simEngine.getDigitalComponent(parentComp->getSimEngineId());
-        if (!digitalComp) {
-            return {SimEngine::LogicState::unknown, SimEngine::SimTime(0)};
-        }
+        const auto type = isInputSlot() ? SimEngine::SlotType::digitalInput : SimEngine::SlotType::digitalOutput;
+        m_snapshotSlot = snapshot.getLayout()->slotIndexOf(parentComp->getSimEngineId(), type, m_index);
+        return m_snapshotSlot;
+    }
 
-        if (isInputSlot()) {
-            const auto &compState = digitalComp->state;
-            BESS_ASSERT(static_cast<size_t>(m_index) < compState.inputStates.size(),
-                        "Slot index greater than input states size");
-            if (static_cast<size_t>(m_index) >= compState.inputStates.size()) {
-                return {SimEngine::LogicState::unknown, SimEngine::SimTime(0)};
-            }
-            return compState.inputStates[m_index];
-        }
+    SimEngine::SlotState SlotSceneComponent::getSlotState(
+        const SceneState &state) const {
+        BESS_ASSERT(m_parentComponent != UUID::null,
+                    std::format("Parent component UUID is null, {}", (uint64_t)m_uuid));
+        BESS_ASSERT(m_index >= 0, "Slot index is negative");
 
-        const auto &compState = digitalComp->state;
-        BESS_ASSERT(static_cast<size_t>(m_index) < compState.outputStates.size(),
-                    "Slot index greater than output states size");
-        if (static_cast<size_t>(m_index) >= compState.outputStates.size()) {
+        const auto &snapshot = SimEngine::SimulationEngine::instance().getSlotSnapshot();
+        const auto slot = getSnapshotSlot(state, snapshot);
+        if (slot == SimEngine::invalidSnapshotSlot) {
             return {SimEngine::LogicState::unknown, SimEngine::SimTime(0)};
         }
 
-        return compState.outputStates[m_index];
+        return {snapshot.getState(slot), SimEngine::SimTime(0)};
     }
 
     bool SlotSceneComponent::isSlotConnected(const SceneState &state) const {
-        const auto parentComp = state.getComponentByUuid<SimulationSceneComponent>(m_parentComponent);
-        if (!parentComp || m_index < 0) {
-            return false;
-        }
-
-        auto &simEngine = SimEngine::SimulationEngine::instance();
-        const auto digitalComp = simEngine.getDigitalComponent(parentComp->getSimEngineId());
-        if (!digitalComp) {
-            return false;
-        }
-        const auto &compState = digitalComp->state;
-
-        if (isInputSlot()) {
-            BESS_ASSERT(static_cast<size_t>(m_index) < compState.inputStates.size(),
-                        "Slot index greater than inputs in sim engine");
-            if (static_cast<size_t>(m_index) >= compState.inputConnected.size()) {
-                return false;
-            }
-            return compState.inputConnected[m_index];
-        } else {
-            BESS_ASSERT(static_cast<size_t>(m_index) < compState.outputStates.size(),
-                        "Slot index greater than outputs in sim engine");
-            if (static_cast<size_t>(m_index) >= compState.outputConnected.size()) {
-                return false;
-            }
-            return compState.outputConnected[m_index];
-        }
+        const auto &snapshot = SimEngine::SimulationEngine::instance().getSlotSnapshot();
+        const auto slot = getSnapshotSlot(state, snapshot);
+        return slot != SimEngine::invalidSnapshotSlot && snapshot.isConnected(slot);
     }
 
     void SlotSceneComponent::addConnection(const UUID &connectionId) {
@@ -6,6 +6,7 @@
 #include "scene/scene_state/components/scene_component.h"
 #include "scene_comp_types.h"
 #include "scene_draw_context.h"
+#include "snapshot/slot_state_snapshot.h"
 #include "types.h"
 
 namespace Bess::Canvas {
@@ -57,6 +58,7 @@ namespace Bess::Canvas {
 
         glm::vec3 getConnectionPos(const SceneState &state) const;
 
+        // read from the slot snapshot of the current frame, lastChangeTime is not part of it
         SimEngine::SlotState getSlotState(const SceneState &state) const;
         bool isSlotConnected(const SceneState &state) const;
 
@@ -73,6 +75,9 @@ namespace Bess::Canvas {
 
         void onMouseLeftClick(const Events::MouseButtonEvent &e);
 
+        // index of this slot in the snapshot, looked up again only when the layout changed
+        uint32_t getSnapshotSlot(const SceneState &state, const SimEngine::SlotStateSnapshot &snapshot) const;
+
       private:
         glm::vec3 m_schematicPos = glm::vec3(0.f);
         SlotType m_slotType = SlotType::none;
@@ -80,6 +85,11 @@ namespace Bess::Canvas {
 
         bool m_invalidateCache = false;
         int m_index = -1;
+
+        mutable uint64_t m_snapshotLayoutId = 0;
+        mutable uint32_t m_snapshotSlot = SimEngine::invalidSnapshotSlot;
+        mutable int m_snapshotSlotIndex = -1;       // m_index the slot was looked up for
+        mutable UUID m_snapshotParent = UUID::null; // parent it was looked up for
     };
 
 } // namespace Bess::Canvas
@@ -18,7 +18,6 @@
 #include <functional>
 #include <limits>
 #include <optional>
-#include <thread>
 #include <unordered_set>
 
 namespace Bess::Pages {
@@ -953,9 +952,10 @@ namespace Bess::Pages {
             simEngine.setSimulationState(previousSimulationState);
         };
 
-        // Ensure the simulation loop has quiesced before mutating graph topology.
-        for (int attempt = 0; attempt < 200 && !simEngine.isSimStable(); ++attempt) {
-            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        // Settle the imported design while paused, so the simulation loop has quiesced
+        // before mutating graph topology.
+        if (!simEngine.runUntilStable(std::chrono::milliseconds(200))) {
+            BESS_WARN("[VerilogImport] Imported design did not settle, it may oscillate");
         }
 
         try {
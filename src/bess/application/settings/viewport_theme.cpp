@@ -85,6 +85,8 @@ namespace Bess {
 
         s_compHeaderColorMap["Digital Gates"] = logicColor;
 
+        s_compHeaderColorMap["Buses"] = routingColor;
+
         s_compHeaderColorMap["Latches"] = encoderDecoderColor;
 
         s_compHeaderColorMap["Combinational Circuits"] = combinationalColor;
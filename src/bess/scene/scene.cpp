@@ -9,6 +9,7 @@
 #include "scene/scene_events.h"
 #include "scene/scene_state/components/behaviours/drag_behaviour.h"
 #include "scene/scene_state/components/scene_component.h"
+#include "simulation_engine.h"
 #include <GLFW/glfw3.h>
 #include <cstdint>
 #include <memory>
@@ -108,6 +109,9 @@ namespace Bess::Canvas {
 
         m_camera->update(ts);
 
+        // every slot drawn this frame reads the same snapshot
+        SimEngine::SimulationEngine::instance().acquireSlotSnapshot();
+
         const auto &rootComps = m_state.getRootComponents();
 
         for (const auto &compId : rootComps) {
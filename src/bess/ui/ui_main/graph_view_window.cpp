@@ -8,6 +8,7 @@
 #include "types.h"
 #include "ui/icons/CodIcons.h"
 #include "ui/widgets/m_widgets.h"
+#include <algorithm>
 
 namespace Bess::UI {
 
@@ -25,13 +26,45 @@ namespace Bess::UI {
             return {"Missing Probe", {}};
         }
 
-        std::vector<std::pair<float, int>> parsedData;
-        for (const auto &d : probeComp->getProbeData()) {
-            auto timeSec = std::chrono::duration<float>(d.first).count();
-            parsedData.emplace_back(timeSec,
-                                    d.second == SimEngine::LogicState::high ? 1 : 0);
+        return {probeComp->getName(), &probeComp->getProbeHistory()};
+    }
+
+    // step line of the visible part of a history, at most a few points per pixel column
+    void buildSignalSteps(const SimEngine::ProbeHistory &history, double fromSec, double toSec, int columns,
+                          std::vector<double> &plotX, std::vector<double> &plotY) {
+        const auto level = [](SimEngine::LogicState state) {
+            return state == SimEngine::LogicState::high ? 1.0 : 0.0;
+        };
+        constexpr uint8_t highBit = 1u << static_cast<uint8_t>(SimEngine::LogicState::high);
+
+        fromSec = std::max(fromSec, 0.0);
+        if (toSec <= fromSec || columns <= 0)
+            return;
+
+        std::vector<SimEngine::ProbeBucket> buckets(columns);
+        history.query(SimEngine::SimTime(static_cast<int64_t>(fromSec * 1e9)),
+                      SimEngine::SimTime(static_cast<int64_t>(toSec * 1e9)),
+                      buckets);
+
+        const double width = (toSec - fromSec) / columns;
+        for (int i = 0; i < columns; i++) {
+            const auto &bucket = buckets[i];
+            const double x = fromSec + (width * i);
+            plotX.push_back(x);
+            plotY.push_back(level(bucket.first));
+            if (bucket.transitions == 0)
+                continue;
+
+            // several transitions in one column are drawn as a bar over the levels they reached
+            if ((bucket.stateMask & highBit) && (bucket.stateMask & ~highBit)) {
+                plotX.insert(plotX.end(), {x, x});
+                plotY.insert(plotY.end(), {0.0, 1.0});
+            }
+            plotX.push_back(x);
+            plotY.push_back(level(bucket.last));
         }
-        return {probeComp->getName(), parsedData};
+        plotX.push_back(toSec);
+        plotY.push_back(level(buckets.back().last));
     }
 
     void GraphViewWindow::onDraw() {
@@ -129,21 +162,13 @@ namespace Bess::UI {
                     ImPlot::SetupAxis(ImAxis_X1, "Time");
                 }
 
+                // only the visible window is fetched, at the plot's pixel resolution
                 std::vector<double> plotX;
                 std::vector<double> plotY;
-                const auto dataCount = signal.values.size();
-
-                const auto &data = signal.values;
-                if (dataCount > 0) {
-                    plotX.push_back(signal.values[0].first);
-                    plotY.push_back(signal.values[0].second);
-                }
-
-                for (int i = 1; i < dataCount; ++i) {
-                    plotX.push_back(data[i].first);
-                    plotY.push_back(data[i - 1].second);
-                    plotX.push_back(data[i].first);
-                    plotY.push_back(data[i].second);
+                if (signal.history && !signal.history->empty()) {
+                    const auto limits = ImPlot::GetPlotLimits();
+                    buildSignalSteps(*signal.history, limits.X.Min, limits.X.Max,
+                                     static_cast<int>(ImPlot::GetPlotSize().x), plotX, plotY);
                 }
 
                 ImPlot::PlotLine(name.toString().c_str(), plotX.data(), plotY.data(), (int)plotX.size());
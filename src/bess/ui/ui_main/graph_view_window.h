@@ -1,5 +1,6 @@
 #pragma once
 
+#include "probe/probe_history.h"
 #include "ui_panel.h"
 #include <unordered_map>
 #include <vector>
@@ -7,7 +8,7 @@
 namespace Bess::UI {
     struct LabeledDigitalSignal {
         std::string name;
-        std::vector<std::pair<float, int>> values;
+        const SimEngine::ProbeHistory *history = nullptr; // owned by the probe, valid for the frame
     };
 
     struct GraphViewWindowData {
@@ -7,6 +7,8 @@
 #include "types.h"
 #include "ui/icons/FontAwesomeIcons.h"
 #include "ui/widgets/m_widgets.h"
+#include <algorithm>
+#include <climits>
 
 namespace Bess::UI {
 
@@ -38,15 +40,25 @@ namespace Bess::UI {
                 isDirty = false;
             }
 
-            if (!currentTruthTable.table.empty()) {
+            if (!currentTruthTable.empty()) {
+                if (currentTruthTable.isSpilled()) {
+                    ImGui::TextWrapped("%llu rows, stored in %s",
+                                       (unsigned long long)currentTruthTable.getRowCount(),
+                                       currentTruthTable.getSpillPath().string().c_str());
+                }
+
                 char inp = 'A';
                 char out = 'A';
                 static constexpr auto tableFlags = ImGuiTableFlags_Borders |
                                                    ImGuiTableFlags_RowBg |
                                                    ImGuiTableFlags_SizingStretchProp |
                                                    ImGuiTableFlags_Resizable |
-                                                   ImGuiTableFlags_Reorderable;
-                if (ImGui::BeginTable("TruthTable", (int)currentTruthTable.table[0].size(), tableFlags)) {
+                                                   ImGuiTableFlags_Reorderable |
+                                                   ImGuiTableFlags_ScrollY;
+                const size_t inputCount = currentTruthTable.getInputCount();
+                const size_t columnCount = inputCount + currentTruthTable.getOutputCount();
+                if (ImGui::BeginTable("TruthTable", (int)columnCount, tableFlags)) {
+                    ImGui::TableSetupScrollFreeze(0, 1);
                     for (auto &compId : currentTruthTable.inputUuids) {
                         ImGui::TableSetupColumn(std::format("INPUT {}", inp++).c_str());
                     }
@@ -56,16 +68,25 @@ namespace Bess::UI {
                     }
 
                     ImGui::TableHeadersRow();
-                    for (auto &row : currentTruthTable.table) {
-                        for (int column = 0; column < currentTruthTable.table[0].size(); column++) {
-                            ImGui::TableNextColumn();
-                            const auto &state = row[column];
-                            const char *value = state == SimEngine::LogicState::low
-                                                    ? "LOW"
-                                                    : (state == SimEngine::LogicState::high
-                                                           ? "HIGH"
-                                                           : (state == SimEngine::LogicState::unknown ? "X" : "Z"));
-                            ImGui::Text("%s", value);
+
+                    // tables can have billions of rows, only the visible ones are read
+                    const auto rowCount = currentTruthTable.getRowCount();
+                    ImGuiListClipper clipper;
+                    clipper.Begin((int)std::min<uint64_t>(rowCount, INT_MAX));
+                    while (clipper.Step()) {
+                        for (int row = clipper.DisplayStart; row < clipper.DisplayEnd; row++) {
+                            for (size_t column = 0; column < columnCount; column++) {
+                                ImGui::TableNextColumn();
+                                const auto state = column < inputCount
+                                                       ? currentTruthTable.getInput(row, column)
+                                                       : currentTruthTable.getOutput(row, column - inputCount);
+                                const char *value = state == SimEngine::LogicState::low
+                                                        ? "LOW"
+                                                        : (state == SimEngine::LogicState::high
+                                                               ? "HIGH"
+                                                               : (state == SimEngine::LogicState::unknown ? "X" : "Z"));
+                                ImGui::Text("%s", value);
+                            }
                         }
                     }
                     ImGui::EndTable();
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "common/bess_uuid.h"
+#include "truth_table/truth_table.h"
 #include "types.h"
 #include "ui_panel.h"
 #include <string>
@@ -26,6 +26,8 @@
 #include "ui/ui_main/settings_window.h"
 #include "ui/ui_main/truth_table_window.h"
 #include "ui_main/scene_viewport_panel.h"
+#include <algorithm>
+#include <chrono>
 #include <filesystem>
 #include <vector>
 
@@ -184,6 +186,9 @@ namespace Bess::UI {
                     ImGui::Text("Unknown State");
                 }
 
+                ImGui::SameLine();
+                ImGui::TextDisabled("t = %.3f ms", simEngine.getSimulationTime().count() / 1e6);
+
                 if (!getState()._internalData.statusMessage.empty()) {
                     const auto msg = std::format("{}\t", getState()._internalData.statusMessage);
                     const auto size = ImGui::CalcTextSize(msg.c_str());
@@ -339,6 +344,63 @@ namespace Bess::UI {
             ImGui::EndMenu();
         }
 
+        if (ImGui::BeginMenu("Simulation")) {
+            auto &simEngine = SimEngine::SimulationEngine::instance();
+            const auto pacing = simEngine.getPacing();
+
+            if (ImGui::MenuItem("Real Time", "", pacing == SimEngine::SimulationPacing::realTime)) {
+                simEngine.setPacing(SimEngine::SimulationPacing::realTime);
+            }
+            if (ImGui::MenuItem("Scaled Real Time", "", pacing == SimEngine::SimulationPacing::scaled)) {
+                simEngine.setPacing(SimEngine::SimulationPacing::scaled);
+            }
+            if (ImGui::MenuItem("As Fast As Possible", "", pacing == SimEngine::SimulationPacing::asFastAsPossible)) {
+                simEngine.setPacing(SimEngine::SimulationPacing::asFastAsPossible);
+            }
+
+            ImGui::BeginDisabled(pacing != SimEngine::SimulationPacing::scaled);
+            auto scale = static_cast<float>(simEngine.getTimeScale());
+            if (ImGui::SliderFloat("Time Scale", &scale, 0.001f, 1000.f, "x%.3f", ImGuiSliderFlags_Logarithmic) &&
+                scale > 0.f) {
+                simEngine.setTimeScale(scale);
+            }
+            ImGui::EndDisabled();
+
+            // falls back to event driven for circuits that are not fully synchronous
+            const auto simulationMode = simEngine.getSimulationMode();
+            bool cycleBased = simulationMode != SimEngine::SimulationMode::eventDriven;
+            if (ImGui::MenuItem("Cycle Based", "", &cycleBased)) {
+                simEngine.setSimulationMode(cycleBased ? SimEngine::SimulationMode::cycleBased
+                                                       : SimEngine::SimulationMode::eventDriven);
+            }
+
+            // compiles in the background, logic without a native form keeps sweeping interpreted
+            bool native = simulationMode == SimEngine::SimulationMode::native;
+            if (ImGui::MenuItem("Compile to Native", "", &native,
+                                simulationMode != SimEngine::SimulationMode::eventDriven)) {
+                simEngine.setSimulationMode(native ? SimEngine::SimulationMode::native
+                                                   : SimEngine::SimulationMode::cycleBased);
+            }
+
+            ImGui::Spacing();
+            ImGui::Separator();
+            ImGui::Spacing();
+
+            // resumes and pauses again once the simulation time has advanced by the given amount
+            auto &runForMs = getState()._internalData.runForMs;
+            ImGui::InputFloat("ms", &runForMs, 10.f, 100.f, "%.3f");
+            runForMs = std::max(runForMs, 0.f);
+            ImGui::BeginDisabled(simEngine.isRunningUntil());
+            if (ImGui::MenuItem("Run For", "", false, runForMs > 0.f)) {
+                const auto duration = std::chrono::duration_cast<SimEngine::SimTime>(
+                    std::chrono::duration<float, std::milli>(runForMs));
+                simEngine.requestRunUntil(simEngine.getSimulationTime() + duration);
+            }
+            ImGui::EndDisabled();
+
+            ImGui::EndMenu();
+        }
+
         const auto menubar_size = ImGui::GetWindowSize();
 
         // project name textbox - begin
@@ -13,6 +13,7 @@ namespace Bess::UI {
         bool newFileClicked = false, openFileClicked = false;
         bool exportSchematicClicked = false;
         bool isTbFocused = false;
+        float runForMs = 100.f; // Simulation > Run For
     };
 
     struct UIState {
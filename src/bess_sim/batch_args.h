@@ -0,0 +1,113 @@
+#pragma once
+
+#include "stimulus/stimulus.h"
+#include "trace/trace_writer.h"
+#include "types.h"
+#include <filesystem>
+#include <iostream>
+#include <optional>
+#include <string>
+#include <vector>
+
+struct BatchArgs {
+    std::vector<std::filesystem::path> designFiles; // one .bproj or Verilog sources
+    std::string topModule;
+    std::filesystem::path stimulusFile;
+    std::optional<Bess::SimEngine::SimTime> runTime;
+    std::filesystem::path traceFile;
+    Bess::SimEngine::TraceFormat traceFormat = Bess::SimEngine::TraceFormat::vcd;
+    bool traceInstances = false;
+    bool wordLevel = false; // keep coarse Yosys cells instead of mapping to gates
+    bool cycleBased = false;
+    bool native = false; // cycle based with the logic compiled to a shared library
+    std::filesystem::path summaryFile;
+};
+
+/* Parse command-line arguments and fills outArgs param.
+ Returns false and prints the reason on failure.
+*/
+static bool parseBatchArgs(int argc, char **argv, BatchArgs &outArgs) {
+    for (int i = 1; i < argc; ++i) {
+        const std::string arg = argv[i];
+        if (!arg.starts_with("--")) {
+            outArgs.designFiles.emplace_back(arg);
+            continue;
+        }
+
+        if (arg == "--trace-instances") {
+            outArgs.traceInstances = true;
+            continue;
+        }
+
+        if (arg == "--word-level") {
+            outArgs.wordLevel = true;
+            continue;
+        }
+
+        if (arg == "--cycle-based") {
+            outArgs.cycleBased = true;
+            continue;
+        }
+
+        if (arg == "--native") {
+            outArgs.cycleBased = true;
+            outArgs.native = true;
+            continue;
+        }
+
+        if (i + 1 >= argc) {
+            std::cerr << "Missing value for " << arg << std::endl;
+            return false;
+        }
+        const std::string value = argv[++i];
+        if (arg == "--top") {
+            outArgs.topModule = value;
+        } else if (arg == "--stimulus") {
+            outArgs.stimulusFile = value;
+        } else if (arg == "--time") {
+            Bess::SimEngine::SimTime time;
+            if (!Bess::SimEngine::parseSimTime(value, time)) {
+                std::cerr << "Invalid time " << value << std::endl;
+                return false;
+            }
+            outArgs.runTime = time;
+        } else if (arg == "--trace") {
+            outArgs.traceFile = value;
+        } else if (arg == "--trace-format") {
+            if (value == "vcd") {
+                outArgs.traceFormat = Bess::SimEngine::TraceFormat::vcd;
+            } else if (value == "binary") {
+                outArgs.traceFormat = Bess::SimEngine::TraceFormat::binary;
+            } else {
+                std::cerr << "Unknown trace format " << value << std::endl;
+                return false;
+            }
+        } else if (arg == "--summary") {
+            outArgs.summaryFile = value;
+        } else {
+            std::cerr << "Unknown option " << arg << std::endl;
+            return false;
+        }
+    }
+
+    if (outArgs.designFiles.empty()) {
+        std::cerr << "No design given" << std::endl;
+        return false;
+    }
+    return true;
+}
+
+static void printBatchUsage(const char *exeName) {
+    std::cout << "Usage: " << exeName << " [options] <project.bproj | file.v ...>" << std::endl;
+    std::cout << "Options:" << std::endl;
+    std::cout << "  --top <module>          Top module of the Verilog sources" << std::endl;
+    std::cout << "  --stimulus <file.csv>   Input values over time, see Stimulus" << std::endl;
+    std::cout << "  --time <time>           Simulated time, e.g. 500us, defaults to the last stimulus" << std::endl;
+    std::cout << "  --trace <file>          Write the top level ports as a waveform" << std::endl;
+    std::cout << "  --trace-format <fmt>    vcd (default) or binary" << std::endl;
+    std::cout << "  --trace-instances       Also trace the ports of every imported instance" << std::endl;
+    std::cout << "  --summary <file.json>   Write the run summary as JSON" << std::endl;
+    std::cout << "  --word-level            Import Verilog as word level cells instead of gates" << std::endl;
+    std::cout << "  --cycle-based           Evaluate synchronous designs once per clock edge" << std::endl;
+    std::cout << "  --native                Cycle based with the logic compiled by the system compiler" << std::endl;
+}
@@ -0,0 +1,255 @@
+#include "batch_runner.h"
+
+#include "bverilog/sim_engine_importer.h"
+#include "common/logger.h"
+#include "component_definition.h"
+#include "simulation_engine_serializer.h"
+#include "stimulus/stimulus.h"
+#include <chrono>
+#include <fstream>
+#include <json/json.h>
+#include <stdexcept>
+
+#if defined(_WIN32)
+    #include <windows.h>
+    #include <psapi.h>
+#else
+    #include <sys/resource.h>
+#endif
+
+namespace Bess::Batch {
+    namespace {
+        // scene components carry the names, every one with a simEngineId refers to a component
+        void collectNamedComponents(const Json::Value &json, std::vector<std::pair<std::string, UUID>> &out) {
+            if (json.isObject()) {
+                if (json.isMember("simEngineId") && json.isMember("name")) {
+                    UUID id;
+                    JsonConvert::fromJsonValue(json["simEngineId"], id);
+                    out.emplace_back(json["name"].asString(), id);
+                }
+                for (const auto &member : json) {
+                    collectNamedComponents(member, out);
+                }
+            } else if (json.isArray()) {
+                for (const auto &element : json) {
+                    collectNamedComponents(element, out);
+                }
+            }
+        }
+    } // namespace
+
+    BatchRunner::BatchRunner(SimEngine::SimulationEngine &engine) : m_engine(engine) {}
+
+    BatchDesign BatchRunner::loadProject(const std::filesystem::path &path) {
+        std::ifstream in(path);
+        if (!in.is_open())
+            throw std::runtime_error("Failed to open project " + path.string());
+
+        Json::Value data;
+        std::string errs;
+        Json::CharReaderBuilder builder;
+        if (!Json::parseFromStream(builder, in, &data, &errs))
+            throw std::runtime_error("Failed to parse project " + path.string() + "\n" + errs);
+
+        m_engine.setSimulationState(SimEngine::SimulationState::paused);
+        m_engine.clear();
+        SimEngine::SimEngineSerializer().deserialize(data["sim_engine_data"]);
+
+        BatchDesign design;
+        design.name = data.get("name", path.stem().string()).asString();
+
+        std::vector<std::pair<std::string, UUID>> named;
+        collectNamedComponents(data["scene_data"], named);
+        for (const auto &[name, id] : named) {
+            const auto comp = m_engine.getDigitalComponent(id);
+            if (!comp)
+                continue;
+
+            const auto &kind = comp->definition->getName();
+            const bool isInput = kind == "Input";
+            if (!isInput && kind != "Output")
+                continue;
+
+            if (isInput && !design.inputs.emplace(name, id).second) {
+                BESS_WARN("Input name {} is used more than once, the stimulus drives the first one", name);
+            }
+
+            const auto type = isInput ? SimEngine::SlotType::digitalOutput : SimEngine::SlotType::digitalInput;
+            const auto width = isInput ? comp->state.outputStates.size() : comp->state.inputStates.size();
+            for (size_t i = 0; i < width; i++) {
+                design.traceSignals.push_back({design.name,
+                                               width == 1 ? name : name + "[" + std::to_string(i) + "]",
+                                               id,
+                                               type,
+                                               static_cast<uint32_t>(i)});
+            }
+        }
+        return design;
+    }
+
+    BatchDesign BatchRunner::loadVerilog(const std::vector<std::filesystem::path> &files,
+                                         const std::string &topModule, bool traceInstances,
+                                         bool wordLevel) {
+        m_engine.setSimulationState(SimEngine::SimulationState::paused);
+        m_engine.clear();
+
+        Verilog::YosysRunnerConfig config;
+        if (!topModule.empty())
+            config.topModuleName = topModule;
+        if (wordLevel)
+            config.mappingLevel = Verilog::YosysMappingLevel::word;
+        const auto result = Verilog::importVerilogFilesIntoSimulationEngine(files, m_engine, config);
+
+        BatchDesign design;
+        design.name = result.topModuleName;
+        design.inputs = result.topInputComponents;
+        design.traceSignals = Verilog::collectTraceSignals(result, m_engine, traceInstances);
+        return design;
+    }
+
+    BatchSummary BatchRunner::run(const BatchDesign &design, const BatchArgs &args) {
+        std::optional<SimEngine::Stimulus> stimulus;
+        if (!args.stimulusFile.empty()) {
+            std::ifstream in(args.stimulusFile);
+            if (!in.is_open())
+                throw std::runtime_error("Failed to open stimulus " + args.stimulusFile.string());
+            stimulus = SimEngine::Stimulus::parseCsv(in);
+        }
+
+        const auto until = args.runTime.value_or(stimulus ? stimulus->getEndTime() : SimEngine::SimTime(0));
+
+        m_engine.setSimulationState(SimEngine::SimulationState::paused);
+        m_engine.setPacing(SimEngine::SimulationPacing::asFastAsPossible);
+        if (args.native) {
+            m_engine.setSimulationMode(SimEngine::SimulationMode::native);
+        } else {
+            m_engine.setSimulationMode(args.cycleBased ? SimEngine::SimulationMode::cycleBased
+                                                       : SimEngine::SimulationMode::eventDriven);
+        }
+        if (!args.traceFile.empty() &&
+            !m_engine.startTrace(args.traceFile, design.traceSignals, args.traceFormat)) {
+            throw std::runtime_error("Failed to open trace " + args.traceFile.string());
+        }
+
+        if (args.native) {
+            // the first timestep starts compiling, the timed run then uses the loaded model
+            m_engine.runUntil(m_engine.getSimulationTime());
+            if (!m_engine.waitForNativeModel(std::chrono::minutes(10)))
+                BESS_WARN("Running without the native model: {}", m_engine.getCycleStats().nativeFallbackReason);
+        }
+
+        const auto statsBefore = m_engine.getEventStats();
+        const auto cyclesBefore = m_engine.getCycleStats();
+        const auto wallStart = std::chrono::steady_clock::now();
+        bool completed = true;
+        if (stimulus) {
+            completed = stimulus->apply(m_engine, design.inputs, until);
+        } else if (until > m_engine.getSimulationTime()) {
+            completed = m_engine.runUntil(until);
+        } else {
+            completed = m_engine.runUntilStable(std::chrono::seconds(60));
+        }
+        const auto wallEnd = std::chrono::steady_clock::now();
+        m_engine.stopTrace();
+
+        if (!completed)
+            BESS_WARN("The simulation stopped before reaching {} ns", until.count());
+
+        const auto statsAfter = m_engine.getEventStats();
+        BatchSummary summary;
+        summary.design = design.name;
+        summary.simTime = m_engine.getSimulationTime();
+        summary.events.scheduled = statsAfter.scheduled - statsBefore.scheduled;
+        summary.events.coalesced = statsAfter.coalesced - statsBefore.coalesced;
+        summary.events.processed = statsAfter.processed - statsBefore.processed;
+        summary.events.evaluated = statsAfter.evaluated - statsBefore.evaluated;
+        if (args.cycleBased) {
+            summary.cycles = m_engine.getCycleStats();
+            summary.cycles.cycles -= cyclesBefore.cycles;
+            summary.cycles.sweeps -= cyclesBefore.sweeps;
+        }
+        summary.components = m_engine.getSimEngineState().getDigitalComponents().size();
+        summary.tracedSignals = args.traceFile.empty() ? 0 : design.traceSignals.size();
+        summary.wallSeconds = std::chrono::duration<double>(wallEnd - wallStart).count();
+        summary.peakMemoryBytes = getPeakMemoryBytes();
+        return summary;
+    }
+
+    void BatchRunner::printSummary(const BatchSummary &summary, std::ostream &out) {
+        const double rate = summary.wallSeconds > 0 ? summary.events.processed / summary.wallSeconds : 0;
+        out << "design            " << summary.design << '\n'
+            << "components        " << summary.components << '\n'
+            << "simulated time    " << summary.simTime.count() << " ns\n"
+            << "events processed  " << summary.events.processed << '\n'
+            << "evaluations       " << summary.events.evaluated << '\n'
+            << "wall time         " << summary.wallSeconds << " s\n"
+            << "events per second " << static_cast<uint64_t>(rate) << '\n'
+            << "peak memory       " << (summary.peakMemoryBytes >> 20) << " MiB\n";
+        if (summary.tracedSignals > 0)
+            out << "traced signals    " << summary.tracedSignals << '\n';
+        if (summary.cycles.active) {
+            const double cycleRate = summary.wallSeconds > 0 ? summary.cycles.cycles / summary.wallSeconds : 0;
+            out << "clock cycles      " << summary.cycles.cycles << '\n'
+                << "cycles per second " << static_cast<uint64_t>(cycleRate) << '\n'
+                << "logic depth       " << summary.cycles.depth << '\n';
+            if (summary.cycles.native)
+                out << "native logic      compiled\n";
+            else if (!summary.cycles.nativeFallbackReason.empty())
+                out << "interpreted logic " << summary.cycles.nativeFallbackReason << '\n';
+        } else if (!summary.cycles.fallbackReason.empty()) {
+            out << "event driven      " << summary.cycles.fallbackReason << '\n';
+        }
+    }
+
+    void BatchRunner::writeSummary(const BatchSummary &summary, const std::filesystem::path &path) {
+        Json::Value j(Json::objectValue);
+        j["design"] = summary.design;
+        j["components"] = Json::UInt64(summary.components);
+        j["simTimeNs"] = Json::Int64(summary.simTime.count());
+        j["eventsScheduled"] = Json::UInt64(summary.events.scheduled);
+        j["eventsCoalesced"] = Json::UInt64(summary.events.coalesced);
+        j["eventsProcessed"] = Json::UInt64(summary.events.processed);
+        j["evaluations"] = Json::UInt64(summary.events.evaluated);
+        j["wallSeconds"] = summary.wallSeconds;
+        j["peakMemoryBytes"] = Json::UInt64(summary.peakMemoryBytes);
+        j["tracedSignals"] = Json::UInt64(summary.tracedSignals);
+        j["cycleBased"] = summary.cycles.active;
+        if (summary.cycles.active) {
+            j["clockCycles"] = Json::UInt64(summary.cycles.cycles);
+            j["clockDomains"] = Json::UInt64(summary.cycles.clockDomains);
+            j["logicDepth"] = summary.cycles.depth;
+            j["native"] = summary.cycles.native;
+            if (!summary.cycles.nativeFallbackReason.empty())
+                j["nativeFallback"] = summary.cycles.nativeFallbackReason;
+        } else if (!summary.cycles.fallbackReason.empty()) {
+            j["cycleFallback"] = summary.cycles.fallbackReason;
+        }
+
+        std::ofstream out(path);
+        if (!out.is_open())
+            throw std::runtime_error("Failed to open summary " + path.string());
+        Json::StreamWriterBuilder builder;
+        builder["indentation"] = "    ";
+        std::unique_ptr<Json::StreamWriter> writer(builder.newStreamWriter());
+        writer->write(j, &out);
+        out << '\n';
+    }
+
+    uint64_t BatchRunner::getPeakMemoryBytes() {
+#if defined(_WIN32)
+        PROCESS_MEMORY_COUNTERS counters;
+        if (GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters)))
+            return counters.PeakWorkingSetSize;
+        return 0;
+#else
+        rusage usage{};
+        if (getrusage(RUSAGE_SELF, &usage) != 0)
+            return 0;
+    #if defined(__APPLE__)
+        return static_cast<uint64_t>(usage.ru_maxrss);
+    #else
+        return static_cast<uint64_t>(usage.ru_maxrss) * 1024;
+    #endif
+#endif
+    }
+} // namespace Bess::Batch
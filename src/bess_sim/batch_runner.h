@@ -0,0 +1,54 @@
+#pragma once
+
+#include "batch_args.h"
+#include "common/bess_uuid.h"
+#include "simulation_engine.h"
+#include "trace/trace_writer.h"
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace Bess::Batch {
+    // what a loaded design offers to stimulus and tracing
+    struct BatchDesign {
+        std::string name;
+        std::unordered_map<std::string, UUID> inputs;
+        std::vector<SimEngine::TraceSignal> traceSignals;
+    };
+
+    struct BatchSummary {
+        std::string design;
+        SimEngine::SimTime simTime{0};
+        SimEngine::SimEventStats events;
+        SimEngine::SimCycleStats cycles;
+        size_t components = 0;
+        size_t tracedSignals = 0;
+        double wallSeconds = 0;
+        uint64_t peakMemoryBytes = 0;
+    };
+
+    /**
+     * Loads a design into the engine, applies the stimulus in as fast as possible pacing and
+     * reports what it cost. Loading errors are thrown as std::runtime_error.
+     **/
+    class BatchRunner {
+      public:
+        explicit BatchRunner(SimEngine::SimulationEngine &engine);
+
+        BatchDesign loadProject(const std::filesystem::path &path);
+        BatchDesign loadVerilog(const std::vector<std::filesystem::path> &files,
+                                const std::string &topModule, bool traceInstances,
+                                bool wordLevel = false);
+
+        BatchSummary run(const BatchDesign &design, const BatchArgs &args);
+
+        static void printSummary(const BatchSummary &summary, std::ostream &out);
+        static void writeSummary(const BatchSummary &summary, const std::filesystem::path &path);
+
+        // highest resident set size of the process so far, 0 where unsupported
+        static uint64_t getPeakMemoryBytes();
+
+      private:
+        SimEngine::SimulationEngine &m_engine;
+    };
+} // namespace Bess::Batch
@@ -0,0 +1,36 @@
+#include "batch_args.h"
+#include "batch_runner.h"
+#include "simulation_engine.h"
+#include <iostream>
+
+int main(int argc, char **argv) {
+    BatchArgs args;
+    if (!parseBatchArgs(argc, argv, args)) {
+        printBatchUsage(argv[0]);
+        return 1;
+    }
+
+    auto &engine = Bess::SimEngine::SimulationEngine::instance();
+    Bess::Batch::BatchRunner runner(engine);
+
+    int exitCode = 0;
+    try {
+        const bool isProject = args.designFiles.size() == 1 &&
+                               args.designFiles.front().extension() == ".bproj";
+        const auto design = isProject
+                                ? runner.loadProject(args.designFiles.front())
+                                : runner.loadVerilog(args.designFiles, args.topModule,
+                                                     args.traceInstances, args.wordLevel);
+
+        const auto summary = runner.run(design, args);
+        Bess::Batch::BatchRunner::printSummary(summary, std::cout);
+        if (!args.summaryFile.empty())
+            Bess::Batch::BatchRunner::writeSummary(summary, args.summaryFile);
+    } catch (const std::exception &e) {
+        std::cerr << e.what() << std::endl;
+        exitCode = 1;
+    }
+
+    engine.destroy();
+    return exitCode;
+}
@@ -8,6 +8,7 @@ void bind_renderer_path(py::module_ &m);
 void bind_sim_engine_types(py::module_ &m);
 void bind_sim_functions(py::module_ &m);
 void bind_sim_engine_component_definition(py::module_ &m);
+void bind_simulation_engine(py::module_ &m);
 void bind_scene_schematic_diagram(py::module_ &m);
 void bind_scene_component(py::module_ &m);
 void bind_sim_scene_component(py::module_ &m);
@@ -53,6 +54,7 @@ void bind_api(py::module_ &m) {
     // Sim Engine
     bind_sim_engine_types(simEngine);
     bind_sim_engine_component_definition(simEngine);
+    bind_simulation_engine(simEngine);
     bind_sim_functions(simFn);
 
     // Scene
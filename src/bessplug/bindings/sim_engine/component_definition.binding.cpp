@@ -48,9 +48,14 @@ class PyComponentDefinition : public ComponentDefinition,
         ret->setIOGrowthPolicy(this->getIOGrowthPolicy());
         ret->setOutputExpressions(this->getOutputExpressions());
         ret->setBehaviorType(this->getBehaviorType());
-        ret->setSimulationFunction(this->getSimulationFunction());
+        if (const auto &inPlace = this->getInPlaceSimulationFunction()) {
+            ret->setInPlaceSimulationFunction(inPlace);
+        } else {
+            ret->setSimulationFunction(this->getSimulationFunction());
+        }
         ret->setAuxData(this->getAuxData());
         ret->setShouldAutoReschedule(this->getShouldAutoReschedule());
+        ret->setParallelSafe(this->getParallelSafe());
         ret->setOwnership(this->getOwnership());
         ret->setBaseHash(this->getBaseHash());
         return ret;
@@ -172,7 +177,8 @@ void bind_sim_engine_component_definition(py::module_ &m) {
         comp_def->setOutputSlotsInfo(outputs);
         comp_def->setSimDelay(sim_delay);
         comp_def->setOpInfo(info);
-        comp_def->setSimulationFunction(ExprEval::exprEvalSimFunc);
+        comp_def->setInPlaceSimulationFunction(ExprEval::exprEvalInPlaceSimFunc);
+        comp_def->setParallelSafe(true);
         return comp_def;
     };
 
@@ -190,7 +196,8 @@ void bind_sim_engine_component_definition(py::module_ &m) {
         comp_def->setOutputSlotsInfo(outputs);
         comp_def->setSimDelay(sim_delay);
         comp_def->setOutputExpressions(output_expressions);
-        comp_def->setSimulationFunction(ExprEval::exprEvalSimFunc);
+        comp_def->setInPlaceSimulationFunction(ExprEval::exprEvalInPlaceSimFunc);
+        comp_def->setParallelSafe(true);
         return comp_def;
     };
 
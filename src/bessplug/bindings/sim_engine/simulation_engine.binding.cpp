@@ -0,0 +1,45 @@
+#include "simulation_engine.h"
+#include "types.h"
+
+#include <pybind11/pybind11.h>
+#include <pybind11/stl.h>
+
+namespace py = pybind11;
+
+using namespace Bess::SimEngine;
+
+void bind_simulation_engine(py::module_ &m) {
+    py::class_<SimulationEngine, std::unique_ptr<SimulationEngine, py::nodelete>>(m, "SimulationEngine")
+        .def_static("instance", &SimulationEngine::instance, py::return_value_policy::reference)
+        .def_property("state", &SimulationEngine::getSimulationState, &SimulationEngine::setSimulationState)
+        .def_property("pacing", &SimulationEngine::getPacing, &SimulationEngine::setPacing)
+        .def_property("time_scale", &SimulationEngine::getTimeScale, &SimulationEngine::setTimeScale)
+        .def_property("simulation_mode", &SimulationEngine::getSimulationMode, &SimulationEngine::setSimulationMode)
+        .def(
+            "wait_for_native_model",
+            [](SimulationEngine &self, long long timeoutMs) {
+                return self.waitForNativeModel(std::chrono::milliseconds(timeoutMs));
+            },
+            py::arg("timeout_ms") = 60000, py::call_guard<py::gil_scoped_release>(),
+            "Waits for the compiled model of the NATIVE simulation mode, False if there is none.")
+        .def_property_readonly("sim_time_ns", [](const SimulationEngine &self) {
+            return static_cast<long long>(self.getSimulationTime().count());
+        })
+        .def("step", &SimulationEngine::stepSimulation)
+        // the sim thread may need the GIL for python components while this waits
+        .def(
+            "run_until",
+            [](SimulationEngine &self, long long timeNs) {
+                return self.runUntil(SimTime(timeNs));
+            },
+            py::arg("time_ns"), py::call_guard<py::gil_scoped_release>(),
+            "Runs until every event up to time_ns is simulated, then pauses at time_ns.")
+        .def(
+            "request_run_until",
+            [](SimulationEngine &self, long long timeNs) {
+                self.requestRunUntil(SimTime(timeNs));
+            },
+            py::arg("time_ns"),
+            "Same as run_until, but returns immediately.")
+        .def_property_readonly("is_running_until", &SimulationEngine::isRunningUntil);
+}
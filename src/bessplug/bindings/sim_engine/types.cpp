@@ -49,6 +49,13 @@ void bind_sim_engine_types(py::module_ &m) {
              }),
              py::arg("state"), py::arg("last_change_time_ns"))
         .def_readwrite("state", &SlotState::state)
+        .def_readwrite("value", &SlotState::value)
+        .def_static(
+            "from_word",
+            [](uint64_t value, long long last_change_time_ns) {
+                return SlotState::fromWord(value, SimTime(last_change_time_ns));
+            },
+            py::arg("value"), py::arg("last_change_time_ns") = 0)
         .def_property(
             "last_change_time_ns",
             [](const SlotState &self) { return static_cast<long long>(self.lastChangeTime.count()); },
@@ -156,7 +163,9 @@ void bind_sim_engine_types(py::module_ &m) {
         .def_readwrite("is_resizeable", &SlotsGroupInfo::isResizeable)
         .def_readwrite("count", &SlotsGroupInfo::count)
         .def_readwrite("names", &SlotsGroupInfo::names)
-        .def_readwrite("categories", &SlotsGroupInfo::categories);
+        .def_readwrite("categories", &SlotsGroupInfo::categories)
+        .def_readwrite("widths", &SlotsGroupInfo::widths)
+        .def("get_width", &SlotsGroupInfo::getWidth, py::arg("slot"));
 
     py::class_<OperatorInfo>(m, "OperatorInfo")
         .def(py::init<>())
@@ -173,4 +182,21 @@ void bind_sim_engine_types(py::module_ &m) {
         .value("NONE", CompDefIOGrowthPolicy::none)
         .value("EQ", CompDefIOGrowthPolicy::eq)
         .export_values();
+
+    py::enum_<SimulationState>(m, "SimulationState")
+        .value("RUNNING", SimulationState::running)
+        .value("PAUSED", SimulationState::paused)
+        .export_values();
+
+    py::enum_<SimulationPacing>(m, "SimulationPacing")
+        .value("REAL_TIME", SimulationPacing::realTime)
+        .value("SCALED", SimulationPacing::scaled)
+        .value("AS_FAST_AS_POSSIBLE", SimulationPacing::asFastAsPossible)
+        .export_values();
+
+    py::enum_<SimulationMode>(m, "SimulationMode")
+        .value("EVENT_DRIVEN", SimulationMode::eventDriven)
+        .value("CYCLE_BASED", SimulationMode::cycleBased)
+        .value("NATIVE", SimulationMode::native)
+        .export_values();
 }
@@ -78,4 +78,10 @@ namespace Bess::Verilog {
         const YosysRunnerConfig &config = {});
 
     BESS_API std::shared_ptr<SimEngine::ComponentDefinition> getFromAuxDataJson(Json::Value auxDataJson);
+
+    // Every bit of the top level ports scoped under the top module, with includeInstances
+    // also the ports of every imported instance scoped under its instance path.
+    BESS_API std::vector<SimEngine::TraceSignal> collectTraceSignals(const SimEngineImportResult &result,
+                                                                     const SimEngine::SimulationEngine &engine,
+                                                                     bool includeInstances = false);
 } // namespace Bess::Verilog
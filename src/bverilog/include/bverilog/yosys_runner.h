@@ -1,6 +1,7 @@
 #pragma once
 
 #include "bverilog/types.h"
+#include <cstdint>
 #include <filesystem>
 #include <json/value.h>
 #include <optional>
@@ -8,12 +9,19 @@
 #include <vector>
 
 namespace Bess::Verilog {
+    // How far Yosys lowers the design before it is imported.
+    enum class YosysMappingLevel : uint8_t {
+        gate, // techmap and simplemap, vectors arrive as one cell per bit
+        word  // stops after proc, opt and memory -nomap, coarse cells and memories are kept as words
+    };
+
     struct BESS_API YosysRunnerConfig {
         std::filesystem::path executablePath = "yosys";
         std::optional<std::string> topModuleName;
         std::vector<std::filesystem::path> additionalSourceFiles;
         std::vector<std::filesystem::path> includeDirectories;
         std::vector<std::string> extraPasses;
+        YosysMappingLevel mappingLevel = YosysMappingLevel::gate;
     };
 
     BESS_API std::string getDefaultYosysReleaseUrl();
@@ -6,13 +6,17 @@
 #include "digital_component.h"
 #include "expression_evalutator/expr_evaluator.h"
 #include "init_components.h"
+#include "memory/memory_array.h"
+#include "netlist/cycle_schedule.h"
 #include "types.h"
 #include <fstream>
 #include <algorithm>
+#include <functional>
 #include <cctype>
 #include <memory>
 #include <limits>
 #include <optional>
+#include <span>
 #include <sstream>
 #include <stdexcept>
 #include <string>
@@ -279,7 +283,8 @@ namespace Bess::Verilog {
             created->setInputSlotsInfo({SlotsGroupType::input, false, inputs, {}, {}});
             created->setOutputSlotsInfo({SlotsGroupType::output, false, outputs, {}, {}});
             created->setOutputExpressions(expressions);
-            created->setSimulationFunction(ExprEval::exprEvalSimFunc);
+            created->setInPlaceSimulationFunction(ExprEval::exprEvalInPlaceSimFunc);
+            created->setParallelSafe(true);
             created->setSimDelay(SimDelayNanoSeconds(2));
 
             ComponentCatalog::instance().registerComponent(created);
@@ -327,6 +332,10 @@ namespace Bess::Verilog {
                 return DffParams{true, true, true, false, true, false, true};
             if (cellType == "$sdff")
                 return DffParams{true, true, true, false, false, false, true};
+            if (cellType == "$adffe")
+                return DffParams{true, true, true, false, true, true, true};
+            if (cellType == "$sdffe")
+                return DffParams{true, true, true, false, false, true, true};
 
             // Parse $_DFF_*, $_DFFE_*, $_SDFF_*, $_SDFFE_* naming convention
             if (cellType.size() < 7 || cellType.front() != '$' || cellType.back() != '_') {
@@ -447,6 +456,16 @@ namespace Bess::Verilog {
             return name;
         }
 
+        // a synchronous reset is sampled on the clock edge like D, only an asynchronous one
+        // acts between edges
+        std::shared_ptr<RegisterTrait> makeDffRegisterTrait(const DffParams &p, int clkSlot, int rstSlot) {
+            std::vector<int> asyncSlots;
+            if (p.hasReset && p.asyncReset) {
+                asyncSlots.push_back(rstSlot);
+            }
+            return std::make_shared<RegisterTrait>(std::vector<int>{clkSlot}, std::move(asyncSlots));
+        }
+
         std::shared_ptr<ComponentDefinition> ensureGeneralDffDefinition(const DffParams &p) {
             const auto name = dffDefinitionName(p);
             auto definition = findDefinitionByName(name);
@@ -495,14 +514,13 @@ namespace Bess::Verilog {
 
             const auto rstIdx = p.rstSlotIndex();
             const auto enIdx = p.enSlotIndex();
+            created->addTrait<RegisterTrait>(makeDffRegisterTrait(p, 1, rstIdx));
 
-            created->setSimulationFunction(
-                [p, rstIdx, enIdx](const std::vector<SlotState> &inputs,
+            created->setInPlaceSimulationFunction(
+                [p, rstIdx, enIdx](std::span<const SlotState> inputs,
                                    SimTime simTime,
-                                   const ComponentState &prevState) -> ComponentState {
-                    auto next = prevState;
-                    next.inputStates = inputs;
-                    next.isChanged = false;
+                                   const ComponentState &prevState,
+                                   std::span<SlotState> outputs) {
 
                     const auto currentClock = inputs[1].state == LogicState::high;
                     const auto previousClock = prevState.inputStates.size() > 1 &&
@@ -517,7 +535,7 @@ namespace Bess::Verilog {
                         const bool enabled = p.enableActiveHigh ? enActive : !enActive;
                         if (!enabled && !p.hasReset) {
                             // No reset to check, and not enabled — nothing happens
-                            return next;
+                            return false;
                         }
                         if (!enabled) {
                             // Still need to check async reset below, but clock-triggered
@@ -555,24 +573,24 @@ namespace Bess::Verilog {
                             q = inputs[0];
                             q.lastChangeTime = simTime;
                         } else {
-                            return next;
+                            return false;
                         }
                     } else {
-                        return next;
+                        return false;
                     }
 
-                    next.outputStates[0] = q;
+                    const bool changed = outputs[0].state != q.state;
+                    outputs[0] = q;
                     auto qInv = q;
                     if (qInv.state == LogicState::high) {
                         qInv.state = LogicState::low;
                     } else if (qInv.state == LogicState::low) {
                         qInv.state = LogicState::high;
                     }
-                    next.outputStates[1] = qInv;
-                    next.isChanged = prevState.outputStates.empty() ||
-                                     prevState.outputStates[0].state != next.outputStates[0].state;
-                    return next;
+                    outputs[1] = qInv;
+                    return changed;
                 });
+            created->setParallelSafe(true);
 
             ComponentCatalog::instance().registerComponent(created);
             definition = findDefinitionByName(name);
@@ -737,7 +755,7 @@ namespace Bess::Verilog {
 
         using BitVector = std::vector<uint8_t>;
 
-        BitVector readBitVector(const std::vector<SlotState> &inputs,
+        BitVector readBitVector(std::span<const SlotState> inputs,
                                 size_t offset,
                                 size_t width) {
             BitVector bits(width, 0);
@@ -750,7 +768,7 @@ namespace Bess::Verilog {
             return bits;
         }
 
-        bool sliceAnyHigh(const std::vector<SlotState> &inputs,
+        bool sliceAnyHigh(std::span<const SlotState> inputs,
                           size_t offset,
                           size_t width) {
             for (size_t i = 0; i < width; ++i) {
@@ -762,7 +780,7 @@ namespace Bess::Verilog {
             return false;
         }
 
-        bool sliceAllUnknownOrHighZ(const std::vector<SlotState> &inputs,
+        bool sliceAllUnknownOrHighZ(std::span<const SlotState> inputs,
                                     size_t offset,
                                     size_t width) {
             if (width == 0) {
@@ -783,7 +801,7 @@ namespace Bess::Verilog {
             return true;
         }
 
-        bool isReadEnableActive(const std::vector<SlotState> &inputs,
+        bool isReadEnableActive(std::span<const SlotState> inputs,
                                 size_t offset,
                                 size_t width) {
             if (width == 0) {
@@ -795,7 +813,7 @@ namespace Bess::Verilog {
             return sliceAllUnknownOrHighZ(inputs, offset, width);
         }
 
-        bool isWriteEnableActive(const std::vector<SlotState> &inputs,
+        bool isWriteEnableActive(std::span<const SlotState> inputs,
                                  size_t offset,
                                  size_t width) {
             if (width == 0) {
@@ -897,16 +915,18 @@ namespace Bess::Verilog {
                 return 0;
             }
 
-            const uint8_t signA = bitAt(a, width - 1, aSigned);
-            const uint8_t signB = bitAt(b, width - 1, bSigned);
-            if (signA != signB) {
+            // a mixed comparison is unsigned, as in Verilog
+            const bool isSigned = aSigned && bSigned;
+            const uint8_t signA = bitAt(a, width - 1, isSigned);
+            const uint8_t signB = bitAt(b, width - 1, isSigned);
+            if (isSigned && signA != signB) {
                 return signA ? -1 : 1;
             }
 
             for (size_t i = width; i > 0; --i) {
                 const size_t index = i - 1;
-                const uint8_t av = bitAt(a, index, aSigned);
-                const uint8_t bv = bitAt(b, index, bSigned);
+                const uint8_t av = bitAt(a, index, isSigned);
+                const uint8_t bv = bitAt(b, index, isSigned);
                 if (av == bv) {
                     continue;
                 }
@@ -945,18 +965,91 @@ namespace Bess::Verilog {
             return out;
         }
 
-        bool applyOutputBits(ComponentState &next,
-                             const ComponentState &prevState,
+        // outputs hold the previous values on entry, as passed to in place sim functions
+        bool applyOutputBits(std::span<SlotState> outputs,
                              const BitVector &outputBits,
                              SimTime simTime) {
             bool changed = false;
-            const size_t count = std::min(next.outputStates.size(), outputBits.size());
+            const size_t count = std::min(outputs.size(), outputBits.size());
             for (size_t i = 0; i < count; ++i) {
                 const auto newState = outputBits[i] ? LogicState::high : LogicState::low;
-                changed = changed || prevState.outputStates[i].state != newState;
-                next.outputStates[i] = {newState, simTime};
+                changed = changed || outputs[i].state != newState;
+                outputs[i] = {newState, simTime};
+            }
+            return changed;
+        }
+
+        constexpr size_t maxWordWidth = 64;
+
+        bool fitsWord(std::initializer_list<size_t> widths) {
+            return std::ranges::all_of(widths, [](size_t width) { return width <= maxWordWidth; });
+        }
+
+        // Slots [offset, offset + width) as one word, bit 0 first, width at most 64.
+        // Like readBitVector anything but high reads as 0.
+        uint64_t readWord(std::span<const SlotState> inputs,
+                          size_t offset,
+                          size_t width,
+                          bool signExtend = false) {
+            uint64_t word = 0;
+            const size_t end = std::min(offset + std::min(width, maxWordWidth), inputs.size());
+            for (size_t index = offset; index < end; ++index) {
+                if (inputs[index].state == LogicState::high) {
+                    word |= uint64_t{1} << (index - offset);
+                }
+            }
+            if (signExtend && width > 0 && width < maxWordWidth && ((word >> (width - 1)) & 1U)) {
+                word |= ~uint64_t{0} << width;
+            }
+            return word;
+        }
+
+        // word counterpart of applyOutputBits, outputs past bit 63 are driven low
+        bool applyOutputWord(std::span<SlotState> outputs,
+                             uint64_t word,
+                             SimTime simTime) {
+            bool changed = false;
+            for (size_t i = 0; i < outputs.size(); ++i) {
+                const bool high = i < maxWordWidth && ((word >> i) & 1U);
+                const auto newState = high ? LogicState::high : LogicState::low;
+                changed = changed || outputs[i].state != newState;
+                outputs[i] = {newState, simTime};
+            }
+            return changed;
+        }
+
+        // Constant bits of a parameter such as ARST_VALUE, written MSB first, x and z read as 0.
+        BitVector parseYosysBitsParam(std::string_view value, size_t width) {
+            BitVector bits(width, 0);
+            for (size_t i = 0; i < width && i < value.size(); ++i) {
+                bits[i] = value[value.size() - 1 - i] == '1' ? 1 : 0;
+            }
+            return bits;
+        }
+
+        // Slots [offset, offset + width) packed into words, bit 0 first, words past width are 0.
+        void readWords(std::span<const SlotState> inputs,
+                       size_t offset,
+                       size_t width,
+                       std::span<uint64_t> words) {
+            for (size_t w = 0; w < words.size(); ++w) {
+                const size_t done = w * maxWordWidth;
+                words[w] = done < width ? readWord(inputs, offset + done, width - done) : 0;
+            }
+        }
+
+        // multi word counterpart of applyOutputWord, outputs past the words are driven low
+        bool applyOutputWords(std::span<SlotState> outputs,
+                              std::span<const uint64_t> words,
+                              SimTime simTime) {
+            bool changed = false;
+            for (size_t i = 0; i < outputs.size(); ++i) {
+                const size_t w = i / maxWordWidth;
+                const bool high = w < words.size() && ((words[w] >> (i % maxWordWidth)) & 1U);
+                const auto newState = high ? LogicState::high : LogicState::low;
+                changed = changed || outputs[i].state != newState;
+                outputs[i] = {newState, simTime};
             }
-            next.isChanged = changed;
             return changed;
         }
 
@@ -973,18 +1066,21 @@ namespace Bess::Verilog {
             const std::string &name,
             const SlotsGroupInfo &inputs,
             const SlotsGroupInfo &outputs,
-            const SimulationFunction &simulationFunction) {
+            const InPlaceSimulationFunction &simulationFunction,
+            bool parallelSafe = true,
+            const std::function<std::shared_ptr<ComponentDefinition>()> &makeDefinition = {}) {
             auto definition = findDefinitionByName(name);
             if (definition) {
                 return definition;
             }
 
-            auto created = std::make_shared<ComponentDefinition>();
+            auto created = makeDefinition ? makeDefinition() : std::make_shared<ComponentDefinition>();
             created->setName(name);
             created->setGroupName("Verilog Imported");
             created->setInputSlotsInfo(inputs);
             created->setOutputSlotsInfo(outputs);
-            created->setSimulationFunction(simulationFunction);
+            created->setInPlaceSimulationFunction(simulationFunction);
+            created->setParallelSafe(parallelSafe);
             created->setSimDelay(SimDelayNanoSeconds(2));
 
             ComponentCatalog::instance().registerComponent(created);
@@ -995,6 +1091,19 @@ namespace Bess::Verilog {
             return definition;
         }
 
+        // a custom definition whose outputs only follow its current inputs
+        std::shared_ptr<ComponentDefinition> ensureCombinationalDefinition(
+            const std::string &name,
+            const SlotsGroupInfo &inputs,
+            const SlotsGroupInfo &outputs,
+            const InPlaceSimulationFunction &simulationFunction) {
+            return ensureCustomDefinition(name, inputs, outputs, simulationFunction, true, [] {
+                auto created = std::make_shared<ComponentDefinition>();
+                created->addTrait<CombinationalTrait>();
+                return created;
+            });
+        }
+
         std::shared_ptr<ComponentDefinition> ensureArithmeticDefinition(const std::string &cellType,
                                                                         size_t aWidth,
                                                                         size_t bWidth,
@@ -1025,11 +1134,20 @@ namespace Bess::Verilog {
             };
 
             auto simFn = [cellType, aWidth, bWidth, yWidth, aSigned, bSigned](
-                             const std::vector<SlotState> &inputs,
+                             std::span<const SlotState> inputs,
                              SimTime simTime,
-                             const ComponentState &prevState) {
-                auto next = prevState;
-                next.inputStates = inputs;
+                             const ComponentState &,
+                             std::span<SlotState> outputs) {
+                if (fitsWord({aWidth, bWidth, yWidth})) {
+                    // operands extended to 64 bits, the outputs keep the low yWidth bits
+                    const uint64_t a = readWord(inputs, 0, aWidth, aSigned);
+                    const uint64_t b = readWord(inputs, aWidth, bWidth, bSigned);
+                    const uint64_t y = cellType == "$add"   ? a + b
+                                       : cellType == "$sub" ? a - b
+                                                            : a * b;
+                    return applyOutputWord(outputs, y, simTime);
+                }
+
                 const auto a = readBitVector(inputs, 0, aWidth);
                 const auto b = readBitVector(inputs, aWidth, bWidth);
 
@@ -1042,11 +1160,10 @@ namespace Bess::Verilog {
                     result = mulBitVectors(a, aSigned, b, bSigned, yWidth);
                 }
 
-                applyOutputBits(next, prevState, result, simTime);
-                return next;
+                return applyOutputBits(outputs, result, simTime);
             };
 
-            return ensureCustomDefinition(name, inputs, outputs, simFn);
+            return ensureCombinationalDefinition(name, inputs, outputs, simFn);
         }
 
         std::shared_ptr<ComponentDefinition> ensureComparatorDefinition(const std::string &cellType,
@@ -1079,14 +1196,26 @@ namespace Bess::Verilog {
             };
 
             auto simFn = [cellType, aWidth, bWidth, yWidth, aSigned, bSigned](
-                             const std::vector<SlotState> &inputs,
+                             std::span<const SlotState> inputs,
                              SimTime simTime,
-                             const ComponentState &prevState) {
-                auto next = prevState;
-                next.inputStates = inputs;
-                const auto a = readBitVector(inputs, 0, aWidth);
-                const auto b = readBitVector(inputs, aWidth, bWidth);
-                const int cmp = compareBitVectors(a, aSigned, b, bSigned);
+                             const ComponentState &,
+                             std::span<SlotState> outputs) {
+                int cmp = 0;
+                if (fitsWord({aWidth, bWidth})) {
+                    // signed only when both operands are, as in Verilog
+                    const bool isSigned = aSigned && bSigned;
+                    const uint64_t a = readWord(inputs, 0, aWidth, isSigned);
+                    const uint64_t b = readWord(inputs, aWidth, bWidth, isSigned);
+                    if (isSigned) {
+                        cmp = static_cast<int64_t>(a) < static_cast<int64_t>(b) ? -1 : (a == b ? 0 : 1);
+                    } else {
+                        cmp = a < b ? -1 : (a == b ? 0 : 1);
+                    }
+                } else {
+                    const auto a = readBitVector(inputs, 0, aWidth);
+                    const auto b = readBitVector(inputs, aWidth, bWidth);
+                    cmp = compareBitVectors(a, aSigned, b, bSigned);
+                }
 
                 bool resultBit = false;
                 if (cellType == "$eq") {
@@ -1107,11 +1236,10 @@ namespace Bess::Verilog {
                 if (!out.empty()) {
                     out[0] = resultBit ? 1 : 0;
                 }
-                applyOutputBits(next, prevState, out, simTime);
-                return next;
+                return applyOutputBits(outputs, out, simTime);
             };
 
-            return ensureCustomDefinition(name, inputs, outputs, simFn);
+            return ensureCombinationalDefinition(name, inputs, outputs, simFn);
         }
 
         std::shared_ptr<ComponentDefinition> ensureLogicDefinition(const std::string &cellType,
@@ -1142,11 +1270,10 @@ namespace Bess::Verilog {
             };
 
             auto simFn = [cellType, aWidth, bWidth, yWidth](
-                             const std::vector<SlotState> &inputs,
+                             std::span<const SlotState> inputs,
                              SimTime simTime,
-                             const ComponentState &prevState) {
-                auto next = prevState;
-                next.inputStates = inputs;
+                             const ComponentState &,
+                             std::span<SlotState> outputs) {
 
                 const bool aTrue = sliceAnyHigh(inputs, 0, aWidth);
                 bool resultBit = false;
@@ -1165,11 +1292,10 @@ namespace Bess::Verilog {
                 if (!out.empty()) {
                     out[0] = resultBit ? 1 : 0;
                 }
-                applyOutputBits(next, prevState, out, simTime);
-                return next;
+                return applyOutputBits(outputs, out, simTime);
             };
 
-            return ensureCustomDefinition(name, inputs, outputs, simFn);
+            return ensureCombinationalDefinition(name, inputs, outputs, simFn);
         }
 
         std::shared_ptr<ComponentDefinition> ensureShiftDefinition(const std::string &cellType,
@@ -1200,29 +1326,45 @@ namespace Bess::Verilog {
             };
 
             auto simFn = [cellType, aWidth, bWidth, yWidth, aSigned](
-                             const std::vector<SlotState> &inputs,
+                             std::span<const SlotState> inputs,
                              SimTime simTime,
-                             const ComponentState &prevState) {
-                auto next = prevState;
-                next.inputStates = inputs;
+                             const ComponentState &,
+                             std::span<SlotState> outputs) {
+
+                const bool leftShift = cellType == "$shl" || cellType == "$sshl";
+                const bool arithmetic = (cellType == "$sshr") && aSigned;
+                if (fitsWord({aWidth, bWidth, yWidth})) {
+                    const uint64_t a = readWord(inputs, 0, aWidth, aSigned);
+                    const uint64_t shiftBy = readWord(inputs, aWidth, bWidth);
+                    uint64_t y = 0;
+                    if (leftShift) {
+                        y = shiftBy < maxWordWidth ? a << shiftBy : 0;
+                    } else if (arithmetic) {
+                        y = static_cast<uint64_t>(static_cast<int64_t>(a) >>
+                                                  std::min<uint64_t>(shiftBy, maxWordWidth - 1));
+                    } else {
+                        const uint64_t unsignedA = aWidth < maxWordWidth ? a & ((uint64_t{1} << aWidth) - 1) : a;
+                        y = shiftBy < maxWordWidth ? unsignedA >> shiftBy : 0;
+                    }
+                    return applyOutputWord(outputs, y, simTime);
+                }
 
                 const auto a = readBitVector(inputs, 0, aWidth);
                 const auto b = readBitVector(inputs, aWidth, bWidth);
                 const size_t shiftBy = bitVectorToSize(b);
 
                 BitVector out;
-                if (cellType == "$shl" || cellType == "$sshl" || cellType == "$shiftx") {
+                if (leftShift) {
                     out = shiftLeftBitVector(a, shiftBy, yWidth);
                 } else {
-                    const bool arithmetic = (cellType == "$sshr") && aSigned;
+                    // $shiftx is a part select, out of range bits would be x and read as 0 here
                     out = shiftRightBitVector(a, shiftBy, yWidth, arithmetic);
                 }
 
-                applyOutputBits(next, prevState, out, simTime);
-                return next;
+                return applyOutputBits(outputs, out, simTime);
             };
 
-            return ensureCustomDefinition(name, inputs, outputs, simFn);
+            return ensureCombinationalDefinition(name, inputs, outputs, simFn);
         }
 
         std::shared_ptr<ComponentDefinition> ensureLatchDefinition(size_t width,
@@ -1251,17 +1393,14 @@ namespace Bess::Verilog {
                 {},
             };
 
-            auto simFn = [width, enableActiveHigh](const std::vector<SlotState> &inputs,
+            auto simFn = [width, enableActiveHigh](std::span<const SlotState> inputs,
                                                     SimTime simTime,
-                                                    const ComponentState &prevState) {
-                auto next = prevState;
-                next.inputStates = inputs;
-                next.isChanged = false;
-
+                                                    const ComponentState &,
+                                                    std::span<SlotState> outputs) {
                 const auto enState = inputs[width].state == LogicState::high;
                 const bool enabled = enableActiveHigh ? enState : !enState;
                 if (!enabled) {
-                    return next;
+                    return false;
                 }
 
                 BitVector out(width, 0);
@@ -1269,8 +1408,7 @@ namespace Bess::Verilog {
                     out[i] = inputs[i].state == LogicState::high ? 1 : 0;
                 }
 
-                applyOutputBits(next, prevState, out, simTime);
-                return next;
+                return applyOutputBits(outputs, out, simTime);
             };
 
             return ensureCustomDefinition(name, inputs, outputs, simFn);
@@ -1298,16 +1436,27 @@ namespace Bess::Verilog {
                 {},
             };
 
-            auto simFn = [width, selectWidth](const std::vector<SlotState> &inputs,
+            auto simFn = [width, selectWidth](std::span<const SlotState> inputs,
                                               SimTime simTime,
-                                              const ComponentState &prevState) {
-                auto next = prevState;
-                next.inputStates = inputs;
+                                              const ComponentState &,
+                                              std::span<SlotState> outputs) {
 
                 const size_t aOffset = 0;
                 const size_t bOffset = width;
                 const size_t sOffset = width + (width * selectWidth);
 
+                if (fitsWord({width})) {
+                    size_t offset = aOffset;
+                    for (size_t i = 0; i < selectWidth; ++i) {
+                        if ((sOffset + i) < inputs.size() &&
+                            inputs[sOffset + i].state == LogicState::high) {
+                            offset = bOffset + (i * width);
+                            break;
+                        }
+                    }
+                    return applyOutputWord(outputs, readWord(inputs, offset, width), simTime);
+                }
+
                 BitVector out = readBitVector(inputs, aOffset, width);
                 for (size_t i = 0; i < selectWidth; ++i) {
                     const bool selected = (sOffset + i) < inputs.size() &&
@@ -1320,19 +1469,241 @@ namespace Bess::Verilog {
                     break;
                 }
 
-                applyOutputBits(next, prevState, out, simTime);
-                return next;
+                return applyOutputBits(outputs, out, simTime);
             };
 
-            return ensureCustomDefinition(name, inputs, outputs, simFn);
+            return ensureCombinationalDefinition(name, inputs, outputs, simFn);
+        }
+
+        std::shared_ptr<ComponentDefinition> ensureWordMuxDefinition(size_t width) {
+            const auto name = std::string("Verilog $mux W") + std::to_string(width);
+
+            auto inputNames = makeIndexedSlotNames("A", width);
+            const auto bNames = makeIndexedSlotNames("B", width);
+            inputNames.insert(inputNames.end(), bNames.begin(), bNames.end());
+            inputNames.push_back("S");
+
+            const SlotsGroupInfo inputs{
+                SlotsGroupType::input,
+                false,
+                (width * 2) + 1,
+                inputNames,
+                {},
+            };
+
+            const SlotsGroupInfo outputs{
+                SlotsGroupType::output,
+                false,
+                width,
+                makeIndexedSlotNames("Y", width),
+                {},
+            };
+
+            // copies the selected operand state by state, so unknown bits pass through
+            auto simFn = [width](std::span<const SlotState> inputs,
+                                 SimTime simTime,
+                                 const ComponentState &,
+                                 std::span<SlotState> outputs) {
+                const size_t offset = inputs[width * 2].state == LogicState::high ? width : 0;
+                bool changed = false;
+                for (size_t i = 0; i < width; ++i) {
+                    const auto newState = inputs[offset + i].state;
+                    changed = changed || outputs[i].state != newState;
+                    outputs[i] = {newState, simTime};
+                }
+                return changed;
+            };
+
+            return ensureCombinationalDefinition(name, inputs, outputs, simFn);
+        }
+
+        std::string resetBitsToString(const BitVector &bits) {
+            std::string value;
+            value.reserve(bits.size());
+            for (size_t i = bits.size(); i > 0; --i) {
+                value.push_back(bits[i - 1] ? '1' : '0');
+            }
+            return value;
+        }
+
+        // A coarse $dff family cell kept as one register, all bits share CLK, RST and EN.
+        // Slots are D0..Dn-1, CLK, then RST and EN when present, outputs are Q0..Qn-1.
+        std::shared_ptr<ComponentDefinition> ensureWordDffDefinition(const DffParams &p,
+                                                                     size_t width,
+                                                                     const BitVector &resetBits) {
+            auto name = dffDefinitionName(p) + " W" + std::to_string(width);
+            if (p.hasReset) {
+                name += " V" + resetBitsToString(resetBits);
+            }
+            auto definition = findDefinitionByName(name);
+            if (definition) {
+                return definition;
+            }
+
+            const size_t clkIdx = width;
+            const size_t rstIdx = width + 1;
+            const size_t enIdx = width + 1 + (p.hasReset ? 1 : 0);
+
+            auto inputNames = makeIndexedSlotNames("D", width);
+            SlotsGroupInfo inputs{SlotsGroupType::input, false, 0, {}, {}};
+            inputNames.push_back("CLK");
+            inputs.categories.push_back({static_cast<int>(clkIdx), SlotCatergory::clock});
+            if (p.hasReset) {
+                inputNames.push_back("RST");
+                inputs.categories.push_back({static_cast<int>(rstIdx), SlotCatergory::clear});
+            }
+            if (p.hasEnable) {
+                inputNames.push_back("EN");
+                inputs.categories.push_back({static_cast<int>(enIdx), SlotCatergory::enable});
+            }
+            inputs.count = inputNames.size();
+            inputs.names = inputNames;
+
+            const SlotsGroupInfo outputs{
+                SlotsGroupType::output,
+                false,
+                width,
+                makeIndexedSlotNames("Q", width),
+                {},
+            };
+
+            auto simFn = [p, width, clkIdx, rstIdx, enIdx, resetBits](std::span<const SlotState> inputs,
+                                                                      SimTime simTime,
+                                                                      const ComponentState &prevState,
+                                                                      std::span<SlotState> outputs) {
+                const bool currentClock = inputs[clkIdx].state == LogicState::high;
+                const bool previousClock = clkIdx < prevState.inputStates.size() &&
+                                           prevState.inputStates[clkIdx].state == LogicState::high;
+                const bool clockEdge = p.risingEdge
+                                           ? (!previousClock && currentClock)
+                                           : (previousClock && !currentClock);
+
+                bool resetActive = false;
+                if (p.hasReset) {
+                    const bool rstHigh = inputs[rstIdx].state == LogicState::high;
+                    resetActive = p.resetActiveHigh ? rstHigh : !rstHigh;
+                }
+
+                bool loadReset = false;
+                if (p.asyncReset && resetActive) {
+                    loadReset = true;
+                } else if (clockEdge) {
+                    bool enabled = true;
+                    if (p.hasEnable) {
+                        const bool enHigh = inputs[enIdx].state == LogicState::high;
+                        enabled = p.enableActiveHigh ? enHigh : !enHigh;
+                    }
+                    if (!p.asyncReset && resetActive) {
+                        loadReset = true;
+                    } else if (!enabled) {
+                        return false;
+                    }
+                } else {
+                    return false;
+                }
+
+                bool changed = false;
+                for (size_t i = 0; i < width; ++i) {
+                    const auto newState = loadReset
+                                              ? (resetBits[i] ? LogicState::high : LogicState::low)
+                                              : inputs[i].state;
+                    changed = changed || outputs[i].state != newState;
+                    outputs[i] = {newState, simTime};
+                }
+                return changed;
+            };
+
+            auto created = std::make_shared<ComponentDefinition>();
+            created->setName(name);
+            created->setGroupName("Verilog Imported");
+            created->setInputSlotsInfo(inputs);
+            created->setOutputSlotsInfo(outputs);
+            created->setInPlaceSimulationFunction(simFn);
+            created->setParallelSafe(true);
+            created->setSimDelay(SimDelayNanoSeconds(2));
+            created->addTrait<RegisterTrait>(makeDffRegisterTrait(p, static_cast<int>(clkIdx), static_cast<int>(rstIdx)));
+
+            auto paramsToJson = [p, width, resetBits]() {
+                Json::Value j;
+                j["risingEdge"] = p.risingEdge;
+                j["hasReset"] = p.hasReset;
+                j["resetActiveHigh"] = p.resetActiveHigh;
+                j["asyncReset"] = p.asyncReset;
+                j["hasEnable"] = p.hasEnable;
+                j["enableActiveHigh"] = p.enableActiveHigh;
+                j["width"] = static_cast<Json::UInt64>(width);
+                j["resetValue"] = resetBitsToString(resetBits);
+                return j;
+            };
+
+            created->setAuxData(VerCompDefAuxData{
+                .id = "WordDffParams",
+                .toJsonCb = paramsToJson,
+            });
+
+            ComponentCatalog::instance().registerComponent(created);
+            definition = findDefinitionByName(name);
+            if (!definition) {
+                throw std::runtime_error("Failed to register DFF definition: " + name);
+            }
+            return definition;
         }
 
+        // Address bits backed by storage for memories imported as separate read and write
+        // ports, whose depth is not part of the cells.
+        constexpr size_t maxImportedMemoryAddressBits = 24;
+
         struct ImportedMemoryCore {
-            size_t width = 0;
-            std::unordered_map<size_t, BitVector> words;
+            MemoryArray words;
+            bool hasContentOwner = false;
+
+            // packing buffers, memory ports only run on the sim thread
+            std::vector<uint64_t> data;
+            std::vector<uint64_t> mask;
+            std::vector<uint64_t> value;
+            std::vector<uint8_t> firing;
+
+            void reset(size_t width, size_t depth, size_t writePorts = 1) {
+                words = MemoryArray(width, depth);
+                const size_t wordsPerEntry = words.getWordsPerEntry();
+                data.assign(wordsPerEntry * writePorts, 0);
+                mask.assign(wordsPerEntry * writePorts, 0);
+                value.assign(wordsPerEntry, 0);
+                firing.assign(writePorts, 0);
+            }
+        };
+
+        // The port definitions of an imported memory share its core. The first one created
+        // owns the content and carries it through checkpoints.
+        class ImportedMemoryDefinition : public ComponentDefinition {
+          public:
+            explicit ImportedMemoryDefinition(const std::shared_ptr<ImportedMemoryCore> &memory)
+                : m_memory(memory), m_ownsContent(!memory->hasContentOwner) {
+                memory->hasContentOwner = true;
+            }
+
+            void writeCheckpointState(CheckpointWriter &out) const override {
+                if (m_ownsContent) {
+                    m_memory->words.writeCheckpoint(out);
+                }
+            }
+
+            void readCheckpointState(CheckpointReader &in) override {
+                if (m_ownsContent) {
+                    m_memory->words.readCheckpoint(in);
+                }
+            }
+
+            std::shared_ptr<ComponentDefinition> clone() const override {
+                return std::make_shared<ImportedMemoryDefinition>(*this);
+            }
+
+          private:
+            std::shared_ptr<ImportedMemoryCore> m_memory;
+            bool m_ownsContent = false;
         };
 
-        bool detectClockEdge(const std::vector<SlotState> &inputs,
+        bool detectClockEdge(std::span<const SlotState> inputs,
                              const ComponentState &prevState,
                              size_t clkSlot,
                              bool risingEdge) {
@@ -1346,6 +1717,11 @@ namespace Bess::Verilog {
             return previousClock && !currentClock;
         }
 
+        std::function<std::shared_ptr<ComponentDefinition>()> makeMemoryDefinition(
+            const std::shared_ptr<ImportedMemoryCore> &memory) {
+            return [memory]() { return std::make_shared<ImportedMemoryDefinition>(memory); };
+        }
+
         std::shared_ptr<ComponentDefinition> ensureMemoryReadDefinition(
             const std::string &memoryKey,
             const std::shared_ptr<ImportedMemoryCore> &memory,
@@ -1378,40 +1754,27 @@ namespace Bess::Verilog {
                 {},
             };
 
-            auto simFn = [memory, addrWidth, enWidth, dataWidth, hasClockInput, clockEnabled, risingEdge](
-                             const std::vector<SlotState> &inputs,
+            auto simFn = [memory, addrWidth, enWidth, hasClockInput, clockEnabled, risingEdge](
+                             std::span<const SlotState> inputs,
                              SimTime simTime,
-                             const ComponentState &prevState) {
-                auto next = prevState;
-                next.inputStates = inputs;
-                next.isChanged = false;
-
+                             const ComponentState &prevState,
+                             std::span<SlotState> outputs) {
                 const size_t clkSlot = addrWidth + enWidth;
 
                 if (!isReadEnableActive(inputs, addrWidth, enWidth)) {
-                    return next;
+                    return false;
                 }
 
                 if (clockEnabled && hasClockInput && !detectClockEdge(inputs, prevState, clkSlot, risingEdge)) {
-                    return next;
-                }
-
-                const auto addrBits = readBitVector(inputs, 0, addrWidth);
-                const size_t address = bitVectorToSize(addrBits);
-
-                BitVector out(dataWidth, 0);
-                if (const auto it = memory->words.find(address); it != memory->words.end()) {
-                    const auto &stored = it->second;
-                    for (size_t i = 0; i < dataWidth; ++i) {
-                        out[i] = bitAt(stored, i, false);
-                    }
+                    return false;
                 }
 
-                applyOutputBits(next, prevState, out, simTime);
-                return next;
+                const size_t address = readWord(inputs, 0, addrWidth);
+                return applyOutputWords(outputs, memory->words.read(address), simTime);
             };
 
-            return ensureCustomDefinition(name, inputs, outputs, simFn);
+            // reads the memory core shared with the write ports, so it stays on the sim thread
+            return ensureCustomDefinition(name, inputs, outputs, simFn, false, makeMemoryDefinition(memory));
         }
 
         std::shared_ptr<ComponentDefinition> ensureMemoryWriteDefinition(
@@ -1446,56 +1809,215 @@ namespace Bess::Verilog {
             };
 
             auto simFn = [memory, addrWidth, dataWidth, enWidth, hasClockInput, clockEnabled, risingEdge](
-                             const std::vector<SlotState> &inputs,
+                             std::span<const SlotState> inputs,
                              SimTime simTime,
-                             const ComponentState &prevState) {
-                auto next = prevState;
-                next.inputStates = inputs;
-                next.isChanged = false;
-
+                             const ComponentState &prevState,
+                             std::span<SlotState> outputs) {
                 const size_t dataOffset = addrWidth;
                 const size_t enOffset = dataOffset + dataWidth;
                 const size_t clkSlot = enOffset + enWidth;
 
                 if (!isWriteEnableActive(inputs, enOffset, enWidth)) {
-                    return next;
+                    return false;
                 }
 
                 if (clockEnabled && hasClockInput && !detectClockEdge(inputs, prevState, clkSlot, risingEdge)) {
-                    return next;
-                }
-
-                const auto addrBits = readBitVector(inputs, 0, addrWidth);
-                const size_t address = bitVectorToSize(addrBits);
-                auto &word = memory->words[address];
-                if (word.size() < dataWidth) {
-                    word.resize(dataWidth, 0);
+                    return false;
                 }
 
-                const auto dataBits = readBitVector(inputs, dataOffset, dataWidth);
-                for (size_t i = 0; i < dataWidth; ++i) {
+                // one enable covers the word, several repeat over the data bits
+                auto &mask = memory->mask;
+                std::ranges::fill(mask, 0);
+                for (size_t i = 0; i < dataWidth && i / maxWordWidth < mask.size(); ++i) {
                     bool writeBit = true;
-                    if (enWidth == 1) {
-                        writeBit = (enOffset < inputs.size() && inputs[enOffset].state == LogicState::high);
-                    } else if (enWidth > 1) {
+                    if (enWidth > 0) {
                         const size_t enBitIndex = enOffset + (i % enWidth);
                         writeBit = (enBitIndex < inputs.size() && inputs[enBitIndex].state == LogicState::high);
                     }
-
                     if (writeBit) {
-                        word[i] = bitAt(dataBits, i, false);
+                        mask[i / maxWordWidth] |= uint64_t{1} << (i % maxWordWidth);
                     }
                 }
 
-                const bool previousTick = !prevState.outputStates.empty() &&
-                                          prevState.outputStates[0].state == LogicState::high;
+                readWords(inputs, dataOffset, dataWidth, memory->data);
+                memory->words.write(readWord(inputs, 0, addrWidth), memory->data, mask);
+
+                const bool previousTick = !outputs.empty() &&
+                                          outputs[0].state == LogicState::high;
                 const auto newTick = previousTick ? LogicState::low : LogicState::high;
-                next.outputStates[0] = {newTick, simTime};
-                next.isChanged = true;
-                return next;
+                outputs[0] = {newTick, simTime};
+                return true;
             };
 
-            return ensureCustomDefinition(name, inputs, outputs, simFn);
+            return ensureCustomDefinition(name, inputs, outputs, simFn, false, makeMemoryDefinition(memory));
+        }
+
+        // Port configuration of a $mem / $mem_v2 cell, bit vectors are indexed by port.
+        struct ImportedMemoryPorts {
+            size_t addrWidth = 0;
+            size_t width = 0;
+            size_t offset = 0;
+            size_t readPorts = 0;
+            size_t writePorts = 0;
+            BitVector readClocked;
+            BitVector readRising;
+            BitVector writeClocked;
+            BitVector writeRising;
+            BitVector transparent; // read port * writePorts + write port
+
+            // read port: ADDR, EN, CLK
+            size_t readBase(size_t port) const {
+                return port * (addrWidth + 2);
+            }
+            // write port: ADDR, DATA, EN per data bit, CLK
+            size_t writeBase(size_t port) const {
+                return readBase(readPorts) + port * (addrWidth + (2 * width) + 1);
+            }
+            size_t inputCount() const {
+                return writeBase(writePorts);
+            }
+        };
+
+        /**
+         * A whole $mem / $mem_v2 cell as one component over a dense MemoryArray.
+         * On a clock edge the clocked read ports sample the content before this edge's
+         * writes, except for write ports they are transparent to, then the write ports apply
+         * in port order, then the asynchronous read ports follow the new content.
+         **/
+        std::shared_ptr<ComponentDefinition> ensureMemoryDefinition(const std::string &memoryKey,
+                                                                    const std::shared_ptr<ImportedMemoryCore> &memory,
+                                                                    const ImportedMemoryPorts &ports) {
+            const auto name = std::string("Verilog Memory ") + memoryKey +
+                              " A" + std::to_string(ports.addrWidth) +
+                              " D" + std::to_string(ports.width) +
+                              " R" + std::to_string(ports.readPorts) +
+                              " W" + std::to_string(ports.writePorts);
+
+            std::vector<std::string> inputNames;
+            inputNames.reserve(ports.inputCount());
+            std::vector<std::pair<int, SlotCatergory>> categories;
+            for (size_t p = 0; p < ports.readPorts; ++p) {
+                const auto prefix = "R" + std::to_string(p) + "_";
+                const auto addrNames = makeIndexedSlotNames(prefix + "A", ports.addrWidth);
+                inputNames.insert(inputNames.end(), addrNames.begin(), addrNames.end());
+                inputNames.push_back(prefix + "EN");
+                categories.push_back({static_cast<int>(inputNames.size() - 1), SlotCatergory::enable});
+                inputNames.push_back(prefix + "CLK");
+                categories.push_back({static_cast<int>(inputNames.size() - 1), SlotCatergory::clock});
+            }
+            for (size_t p = 0; p < ports.writePorts; ++p) {
+                const auto prefix = "W" + std::to_string(p) + "_";
+                for (const auto &group : {"A", "D", "EN"}) {
+                    const size_t count = std::string_view(group) == "A" ? ports.addrWidth : ports.width;
+                    const auto names = makeIndexedSlotNames(prefix + group, count);
+                    inputNames.insert(inputNames.end(), names.begin(), names.end());
+                }
+                inputNames.push_back(prefix + "CLK");
+                categories.push_back({static_cast<int>(inputNames.size() - 1), SlotCatergory::clock});
+            }
+
+            SlotsGroupInfo inputs{SlotsGroupType::input, false, inputNames.size(), inputNames, {}};
+            inputs.categories = categories;
+
+            std::vector<std::string> outputNames;
+            for (size_t p = 0; p < ports.readPorts; ++p) {
+                const auto names = makeIndexedSlotNames("R" + std::to_string(p) + "_D", ports.width);
+                outputNames.insert(outputNames.end(), names.begin(), names.end());
+            }
+            const SlotsGroupInfo outputs{SlotsGroupType::output, false, outputNames.size(), outputNames, {}};
+
+            auto simFn = [memory, ports](std::span<const SlotState> inputs,
+                                         SimTime simTime,
+                                         const ComponentState &prevState,
+                                         std::span<SlotState> outputs) {
+                auto &words = memory->words;
+                const size_t wordsPerEntry = words.getWordsPerEntry();
+                const auto addressAt = [&](size_t slot) {
+                    return static_cast<size_t>(readWord(inputs, slot, ports.addrWidth) - ports.offset);
+                };
+
+                for (size_t p = 0; p < ports.writePorts; ++p) {
+                    const size_t base = ports.writeBase(p);
+                    const size_t enOffset = base + ports.addrWidth + ports.width;
+                    const bool clocked = ports.writeClocked[p] != 0;
+                    memory->firing[p] = isWriteEnableActive(inputs, enOffset, ports.width) &&
+                                        (!clocked || detectClockEdge(inputs, prevState, enOffset + ports.width,
+                                                                     ports.writeRising[p] != 0));
+                    if (memory->firing[p]) {
+                        const auto data = std::span(memory->data).subspan(p * wordsPerEntry, wordsPerEntry);
+                        const auto mask = std::span(memory->mask).subspan(p * wordsPerEntry, wordsPerEntry);
+                        readWords(inputs, base + ports.addrWidth, ports.width, data);
+                        readWords(inputs, enOffset, ports.width, mask);
+                    }
+                }
+
+                bool changed = false;
+                for (size_t p = 0; p < ports.readPorts; ++p) {
+                    const size_t base = ports.readBase(p);
+                    if (ports.readClocked[p] == 0 ||
+                        !isReadEnableActive(inputs, base + ports.addrWidth, 1) ||
+                        !detectClockEdge(inputs, prevState, base + ports.addrWidth + 1, ports.readRising[p] != 0)) {
+                        continue;
+                    }
+
+                    const size_t address = addressAt(base);
+                    auto &value = memory->value;
+                    std::ranges::copy(words.read(address), value.begin());
+                    for (size_t w = 0; w < ports.writePorts; ++w) {
+                        if (!memory->firing[w] || ports.transparent[(p * ports.writePorts) + w] == 0 ||
+                            addressAt(ports.writeBase(w)) != address) {
+                            continue;
+                        }
+                        for (size_t i = 0; i < wordsPerEntry; ++i) {
+                            const uint64_t mask = memory->mask[(w * wordsPerEntry) + i];
+                            value[i] = (value[i] & ~mask) | (memory->data[(w * wordsPerEntry) + i] & mask);
+                        }
+                    }
+                    changed = applyOutputWords(outputs.subspan(p * ports.width, ports.width), value, simTime) ||
+                              changed;
+                }
+
+                for (size_t p = 0; p < ports.writePorts; ++p) {
+                    if (!memory->firing[p]) {
+                        continue;
+                    }
+                    words.write(addressAt(ports.writeBase(p)),
+                                std::span(memory->data).subspan(p * wordsPerEntry, wordsPerEntry),
+                                std::span(memory->mask).subspan(p * wordsPerEntry, wordsPerEntry));
+                }
+
+                for (size_t p = 0; p < ports.readPorts; ++p) {
+                    const size_t base = ports.readBase(p);
+                    if (ports.readClocked[p] != 0 || !isReadEnableActive(inputs, base + ports.addrWidth, 1)) {
+                        continue;
+                    }
+                    changed = applyOutputWords(outputs.subspan(p * ports.width, ports.width),
+                                               words.read(addressAt(base)),
+                                               simTime) ||
+                              changed;
+                }
+                return changed;
+            };
+
+            // asynchronous ports follow their inputs between clock edges, such a memory is no register
+            const bool fullyClocked = std::ranges::all_of(ports.readClocked, [](auto clocked) { return clocked != 0; }) &&
+                                      std::ranges::all_of(ports.writeClocked, [](auto clocked) { return clocked != 0; });
+            auto makeDefinition = makeMemoryDefinition(memory);
+            if (fullyClocked) {
+                auto trait = std::make_shared<RegisterTrait>();
+                for (const auto &[slot, category] : categories) {
+                    if (category == SlotCatergory::clock) {
+                        trait->clockSlots.push_back(slot);
+                    }
+                }
+                makeDefinition = [makeDefinition, trait]() {
+                    auto created = makeDefinition();
+                    created->addTrait<RegisterTrait>(trait);
+                    return created;
+                };
+            }
+
+            return ensureCustomDefinition(name, inputs, outputs, simFn, false, makeDefinition);
         }
 
         class Importer {
@@ -1594,16 +2116,23 @@ namespace Bess::Verilog {
                 m_directLoads.emplace_back(signal, endpoint);
             }
 
+            // Ports are created while importing, before anything is stored, so a wider or
+            // deeper port may still replace the storage.
             std::shared_ptr<ImportedMemoryCore> getOrCreateMemoryCore(const std::string &memoryKey,
-                                                                       size_t width) {
+                                                                       size_t width,
+                                                                       size_t addrWidth) {
+                const size_t depth = size_t{1} << std::min(addrWidth, maxImportedMemoryAddressBits);
                 auto it = m_memories.find(memoryKey);
                 if (it != m_memories.end()) {
-                    it->second->width = std::max(it->second->width, width);
+                    auto &words = it->second->words;
+                    if (width > words.getWidth() || depth > words.getDepth()) {
+                        it->second->reset(std::max(width, words.getWidth()), std::max(depth, words.getDepth()));
+                    }
                     return it->second;
                 }
 
                 auto created = std::make_shared<ImportedMemoryCore>();
-                created->width = width;
+                created->reset(width, depth);
                 m_memories.emplace(memoryKey, created);
                 return created;
             }
@@ -1978,6 +2507,71 @@ namespace Bess::Verilog {
                     return;
                 }
 
+                if (cell.type == "$mem" || cell.type == "$mem_v2") {
+                    ImportedMemoryPorts ports;
+                    ports.addrWidth = getCellParamUInt(cell, "ABITS");
+                    ports.width = getCellParamUInt(cell, "WIDTH");
+                    ports.offset = getCellParamUInt(cell, "OFFSET");
+                    ports.readPorts = getCellParamUInt(cell, "RD_PORTS");
+                    ports.writePorts = getCellParamUInt(cell, "WR_PORTS");
+                    const auto portBits = [&](std::string_view key, size_t count) {
+                        return parseYosysBitsParam(getCellParamString(cell, key), count);
+                    };
+                    ports.readClocked = portBits("RD_CLK_ENABLE", ports.readPorts);
+                    ports.readRising = portBits("RD_CLK_POLARITY", ports.readPorts);
+                    ports.writeClocked = portBits("WR_CLK_ENABLE", ports.writePorts);
+                    ports.writeRising = portBits("WR_CLK_POLARITY", ports.writePorts);
+                    if (cell.type == "$mem_v2") {
+                        ports.transparent = portBits("RD_TRANSPARENCY_MASK", ports.readPorts * ports.writePorts);
+                    } else {
+                        // $mem has one transparency bit per read port, covering every write port
+                        const auto transparentReads = portBits("RD_TRANSPARENT", ports.readPorts);
+                        ports.transparent.assign(ports.readPorts * ports.writePorts, 0);
+                        for (size_t p = 0; p < ports.transparent.size(); ++p) {
+                            ports.transparent[p] = transparentReads[p / ports.writePorts];
+                        }
+                    }
+
+                    const auto &connections = cell.connections;
+                    const auto portSlice = [&](const std::string &key, size_t port, size_t width) {
+                        const auto &bits = connections.at(key);
+                        if (bits.size() < (port + 1) * width) {
+                            throw std::runtime_error("Memory port " + key + " is too narrow in " + cell.name);
+                        }
+                        const auto begin = bits.begin() + static_cast<std::ptrdiff_t>(port * width);
+                        return std::vector<SignalBit>(begin, begin + static_cast<std::ptrdiff_t>(width));
+                    };
+
+                    std::vector<SignalBit> inputs;
+                    inputs.reserve(ports.inputCount());
+                    for (size_t p = 0; p < ports.readPorts; ++p) {
+                        const auto addr = portSlice("RD_ADDR", p, ports.addrWidth);
+                        inputs.insert(inputs.end(), addr.begin(), addr.end());
+                        inputs.push_back(portSlice("RD_EN", p, 1).front());
+                        inputs.push_back(portSlice("RD_CLK", p, 1).front());
+                    }
+                    for (size_t p = 0; p < ports.writePorts; ++p) {
+                        for (const auto &key : {"WR_ADDR", "WR_DATA", "WR_EN"}) {
+                            const auto bits = portSlice(key, p, std::string_view(key) == "WR_ADDR" ? ports.addrWidth : ports.width);
+                            inputs.insert(inputs.end(), bits.begin(), bits.end());
+                        }
+                        inputs.push_back(portSlice("WR_CLK", p, 1).front());
+                    }
+
+                    const auto memoryKey = path + ":" + getCellParamString(cell, "MEMID", cell.name);
+                    auto memory = std::make_shared<ImportedMemoryCore>();
+                    memory->reset(ports.width,
+                                  getCellParamUInt(cell, "SIZE",
+                                                   size_t{1} << std::min(ports.addrWidth, maxImportedMemoryAddressBits)),
+                                  ports.writePorts);
+                    memory->words.loadInit(getCellParamString(cell, "INIT"));
+
+                    instantiateVectorPrimitive(ensureMemoryDefinition(memoryKey, memory, ports),
+                                               inputs,
+                                               connections.at("RD_DATA"));
+                    return;
+                }
+
                 if (cell.type == "$memrd" || cell.type == "$memrd_v2") {
                     const auto &addrBits = cell.connections.at("ADDR");
                     const auto &dataBits = cell.connections.at("DATA");
@@ -1991,7 +2585,7 @@ namespace Bess::Verilog {
 
                     const auto memId = getCellParamString(cell, "MEMID", cell.name);
                     const auto memoryKey = path + ":" + memId;
-                    auto memory = getOrCreateMemoryCore(memoryKey, dataBits.size());
+                    auto memory = getOrCreateMemoryCore(memoryKey, dataBits.size(), addrBits.size());
 
                     const bool hasClockInput = !clkBits.empty();
                     const bool clockEnabled = getCellParamBool(cell, "CLK_ENABLE", hasClockInput);
@@ -2056,7 +2650,7 @@ namespace Bess::Verilog {
 
                     const auto memId = getCellParamString(cell, "MEMID", cell.name);
                     const auto memoryKey = path + ":" + memId;
-                    auto memory = getOrCreateMemoryCore(memoryKey, dataBits.size());
+                    auto memory = getOrCreateMemoryCore(memoryKey, dataBits.size(), addrBits.size());
 
                     const bool hasClockInput = !clkBits.empty();
                     const bool clockEnabled = getCellParamBool(cell, "CLK_ENABLE", hasClockInput);
@@ -2196,6 +2790,15 @@ namespace Bess::Verilog {
                     if (sBits.size() != 1 || aBits.size() != bBits.size() || aBits.size() != yBits.size()) {
                         throw std::runtime_error("Unsupported mux width configuration in " + cell.name);
                     }
+                    if (cell.type == "$mux" && yBits.size() > 1) {
+                        std::vector<SignalBit> inputs;
+                        inputs.reserve((yBits.size() * 2) + 1);
+                        inputs.insert(inputs.end(), aBits.begin(), aBits.end());
+                        inputs.insert(inputs.end(), bBits.begin(), bBits.end());
+                        inputs.push_back(sBits[0]);
+                        instantiateVectorPrimitive(ensureWordMuxDefinition(yBits.size()), inputs, yBits);
+                        return;
+                    }
                     for (size_t i = 0; i < yBits.size(); ++i) {
                         const auto componentId = m_engine.addComponent(primitiveDefinition);
                         m_createdComponentIds.push_back(componentId);
@@ -2266,6 +2869,35 @@ namespace Bess::Verilog {
                             return nullptr;
                         }();
 
+                        if (!cell.type.starts_with("$_")) {
+                            // Coarse cells keep the word as one register, polarities and the
+                            // reset value come from the cell parameters.
+                            auto wordParams = dp;
+                            const std::string resetPrefix = dp.asyncReset ? "ARST" : "SRST";
+                            wordParams.risingEdge = getCellParamBool(cell, "CLK_POLARITY", true);
+                            wordParams.resetActiveHigh = getCellParamBool(cell, resetPrefix + "_POLARITY", true);
+                            wordParams.enableActiveHigh = getCellParamBool(cell, "EN_POLARITY", true);
+                            const auto resetValue = parseYosysBitsParam(
+                                getCellParamString(cell, resetPrefix + "_VALUE"), qBits.size());
+
+                            std::vector<SignalBit> inputs(dBits.begin(), dBits.end());
+                            inputs.push_back((*clkBits)[0]);
+                            if (dp.hasReset) {
+                                inputs.push_back(resetBits && !resetBits->empty()
+                                                     ? (*resetBits)[0]
+                                                     : SignalBit::fromConstant(wordParams.resetActiveHigh ? "0" : "1"));
+                            }
+                            if (dp.hasEnable) {
+                                inputs.push_back(enableBits && !enableBits->empty()
+                                                     ? (*enableBits)[0]
+                                                     : SignalBit::fromConstant(wordParams.enableActiveHigh ? "1" : "0"));
+                            }
+                            instantiateVectorPrimitive(ensureWordDffDefinition(wordParams, qBits.size(), resetValue),
+                                                       inputs,
+                                                       qBits);
+                            return;
+                        }
+
                         for (size_t i = 0; i < qBits.size(); ++i) {
                             const auto componentId = m_engine.addComponent(primitiveDefinition);
                             m_createdComponentIds.push_back(componentId);
@@ -2425,6 +3057,76 @@ namespace Bess::Verilog {
             return ensureGeneralDffDefinition(params);
         }
 
+        if (id == "WordDffParams") {
+            DffParams params;
+            params.risingEdge = data["risingEdge"].asBool();
+            params.hasReset = data["hasReset"].asBool();
+            params.resetActiveHigh = data["resetActiveHigh"].asBool();
+            params.asyncReset = data["asyncReset"].asBool();
+            params.hasEnable = data["hasEnable"].asBool();
+            params.enableActiveHigh = data["enableActiveHigh"].asBool();
+            const auto width = static_cast<size_t>(data["width"].asUInt64());
+            return ensureWordDffDefinition(params, width, parseYosysBitsParam(data["resetValue"].asString(), width));
+        }
+
         return nullptr;
     }
+
+    std::vector<SimEngine::TraceSignal> collectTraceSignals(const SimEngineImportResult &result,
+                                                            const SimulationEngine &engine,
+                                                            bool includeInstances) {
+        std::vector<SimEngine::TraceSignal> signals;
+
+        const auto addPort = [&](const std::string &name, const UUID &id, SlotType type) {
+            const auto comp = engine.getDigitalComponent(id);
+            if (!comp) {
+                return;
+            }
+            const auto width = type == SlotType::digitalOutput ? comp->state.outputStates.size()
+                                                               : comp->state.inputStates.size();
+            for (size_t i = 0; i < width; ++i) {
+                signals.push_back({result.top.instancePath,
+                                   width == 1 ? name : name + "[" + std::to_string(i) + "]",
+                                   id,
+                                   type,
+                                   static_cast<uint32_t>(i)});
+            }
+        };
+
+        // a top input drives its nets from output slots, a top output reads them on input slots
+        for (const auto &[name, id] : result.topInputComponents) {
+            addPort(name, id, SlotType::digitalOutput);
+        }
+        for (const auto &[name, id] : result.topOutputComponents) {
+            addPort(name, id, SlotType::digitalInput);
+        }
+
+        if (includeInstances) {
+            for (const auto &[path, instance] : result.instancesByPath) {
+                if (path == result.top.instancePath) {
+                    continue;
+                }
+                // a flattened instance has no component of its own, its ports are traced at the
+                // first slot inside that reads or drives them
+                const auto addSlots = [&](const std::vector<std::string> &names,
+                                          const std::vector<std::vector<ImportedSlotEndpoint>> &endpoints) {
+                    for (size_t i = 0; i < names.size() && i < endpoints.size(); ++i) {
+                        if (endpoints[i].empty()) {
+                            continue;
+                        }
+                        const auto &endpoint = endpoints[i].front();
+                        signals.push_back({path,
+                                           names[i],
+                                           endpoint.componentId,
+                                           endpoint.slotType,
+                                           static_cast<uint32_t>(endpoint.slotIndex)});
+                    }
+                };
+                addSlots(instance.inputSlotNames, instance.internalInputSinks);
+                addSlots(instance.outputSlotNames, instance.internalOutputDrivers);
+            }
+        }
+
+        return signals;
+    }
 } // namespace Bess::Verilog
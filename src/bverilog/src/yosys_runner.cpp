@@ -158,7 +158,10 @@ namespace Bess::Verilog {
         const auto tempRoot = std::filesystem::temp_directory_path() / "bess_yosys";
         std::filesystem::create_directories(tempRoot);
 
-        const auto uniqueStem = buildUniqueStem(sourceFiles);
+        auto uniqueStem = buildUniqueStem(sourceFiles);
+        if (config.mappingLevel == YosysMappingLevel::word) {
+            uniqueStem += "_word";
+        }
         const auto scriptPath = tempRoot / (uniqueStem + ".ys");
         const auto jsonPath = tempRoot / (uniqueStem + ".json");
 
@@ -184,11 +187,14 @@ namespace Bess::Verilog {
         }
         script << "proc\n";
         script << "opt\n";
-        script << "memory\n";
-        script << "opt\n";
-        script << "techmap\n";
+        // word level keeps memories as $mem_v2 cells for the dense memory component
+        script << (config.mappingLevel == YosysMappingLevel::word ? "memory -nomap\n" : "memory\n");
         script << "opt\n";
-        script << "simplemap\n";
+        if (config.mappingLevel == YosysMappingLevel::gate) {
+            script << "techmap\n";
+            script << "opt\n";
+            script << "simplemap\n";
+        }
         for (const auto &extraPass : config.extraPasses) {
             script << extraPass << "\n";
         }
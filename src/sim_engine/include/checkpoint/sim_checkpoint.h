@@ -0,0 +1,111 @@
+#pragma once
+
+#include "bess_api.h"
+#include "digital_component.h"
+#include "net/net.h"
+#include "types.h"
+#include <cstdint>
+#include <cstring>
+#include <istream>
+#include <memory>
+#include <ostream>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <vector>
+
+namespace Bess::SimEngine {
+    class SimEngineState;
+
+    // Appends plain values to a checkpoint section in host byte order.
+    class BESS_API CheckpointWriter {
+      public:
+        template <typename T>
+        void write(const T &value) {
+            static_assert(std::is_trivially_copyable_v<T>);
+            writeBytes(&value, sizeof(T));
+        }
+
+        template <typename T>
+        void writeSpan(std::span<const T> values) {
+            static_assert(std::is_trivially_copyable_v<T>);
+            writeBytes(values.data(), values.size_bytes());
+        }
+
+        void writeString(std::string_view value);
+        void writeBytes(const void *data, size_t size);
+
+        const std::vector<uint8_t> &getData() const;
+        void clear();
+
+      private:
+        std::vector<uint8_t> m_data;
+    };
+
+    // Reads back what a CheckpointWriter wrote, throws std::runtime_error past the end.
+    class BESS_API CheckpointReader {
+      public:
+        explicit CheckpointReader(std::span<const uint8_t> data);
+
+        template <typename T>
+        T read() {
+            static_assert(std::is_trivially_copyable_v<T>);
+            T value;
+            readBytes(&value, sizeof(T));
+            return value;
+        }
+
+        template <typename T>
+        void readSpan(std::span<T> values) {
+            static_assert(std::is_trivially_copyable_v<T>);
+            readBytes(values.data(), values.size_bytes());
+        }
+
+        std::string readString();
+        void readBytes(void *data, size_t size);
+        // the next size bytes, without copying them
+        std::span<const uint8_t> take(size_t size);
+
+        // count elements of elementSize bytes are left, guards sizes read from the file
+        void expect(uint64_t count, size_t elementSize) const;
+        bool atEnd() const;
+
+      private:
+        std::span<const uint8_t> m_data;
+        size_t m_pos = 0;
+    };
+
+    // Everything a checkpoint restores, built before the engine is touched.
+    struct BESS_API SimCheckpoint {
+        SimTime simTime{0};
+        uint64_t nextEventId = 0;
+        std::vector<std::shared_ptr<DigitalComponent>> components;
+        std::vector<Net> nets;
+        std::vector<SimulationEvent> events;
+    };
+
+    /**
+     * Versioned binary image of the whole simulation: components with their definitions,
+     * connections, slot states and definition runtime state (see
+     * ComponentDefinition::writeCheckpointState), nets, the pending events and the
+     * simulation time.
+     * After a header the file is a list of tagged sections. Slot states, connection pins,
+     * events and component records are written as flat arrays, so restoring them is a
+     * handful of bulk copies. Definitions are stored once per distinct content as the JSON
+     * used by projects and cloned for every component.
+     * Checkpoints are meant to skip long initialization sequences on the same machine and
+     * build, they are written in host byte order and refused elsewhere.
+     **/
+    class BESS_API SimCheckpointFormat {
+      public:
+        static constexpr uint32_t version = 3;
+
+        static void write(std::ostream &out, const SimEngineState &state,
+                          std::span<const SimulationEvent> events, SimTime simTime, uint64_t nextEventId);
+
+        // throws std::runtime_error for truncated, foreign or newer files
+        static SimCheckpoint read(std::istream &in);
+    };
+} // namespace Bess::SimEngine
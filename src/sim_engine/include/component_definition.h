@@ -28,6 +28,11 @@ namespace Bess::SimEngine {
         size_t count = 0;
         std::vector<std::string> names;
         std::vector<std::pair<int, SlotCatergory>> categories; // slot_index, category
+        // Slots missing here are one bit wide. A wider slot carries up to 64 bits in
+        // SlotState::value and only connects to slots of the same width.
+        std::vector<std::pair<int, int>> widths; // slot_index, bit width
+
+        int getWidth(size_t slot) const;
     };
 
     struct BESS_API OperatorInfo {
@@ -35,6 +40,9 @@ namespace Bess::SimEngine {
         bool shouldNegateOutput = false;
     };
 
+    class CheckpointWriter;
+    class CheckpointReader;
+
     class BESS_API Trait {
       public:
         virtual ~Trait() = default;
@@ -60,7 +68,21 @@ namespace Bess::SimEngine {
         MAKE_GETTER_SETTER(std::string, Name, m_name)
         MAKE_GETTER_SETTER(std::string, GroupName, m_groupName)
         MAKE_GETTER_SETTER(ComponentBehaviorType, BehaviorType, m_behaviorType)
-        MAKE_VGETTER_VSETTER(SimulationFunction, SimulationFunction, m_simulationFunction)
+        virtual const SimulationFunction &getSimulationFunction() const { return m_simulationFunction; }
+        virtual SimulationFunction &getSimulationFunction() { return m_simulationFunction; }
+
+        // clears the in place function, the engine then falls back to this one
+        virtual void setSimulationFunction(const SimulationFunction &value);
+
+        MAKE_GETTER(InPlaceSimulationFunction, InPlaceSimulationFunction, m_inPlaceSimulationFunction)
+
+        // preferred by the engine, also installs an adapter as the SimulationFunction
+        // so callers of the by-value signature keep working
+        void setInPlaceSimulationFunction(const InPlaceSimulationFunction &value);
+
+        // set when the in place function only reads its arguments, the engine may then
+        // evaluate it on a worker thread together with the rest of the timestep
+        MAKE_GETTER_SETTER(bool, ParallelSafe, m_parallelSafe)
         MAKE_GETTER(std::any, AuxData, m_auxData)
         MAKE_GETTER_SETTER_WC(std::vector<std::string>,
                               OutputExpressions,
@@ -159,6 +181,14 @@ namespace Bess::SimEngine {
 
         virtual void onExpressionsChange();
 
+        /**
+         * Runtime state that simulation checkpoints must keep but the project JSON does not,
+         * e.g. a clock's current phase. Read back in the order it was written, on a clone of
+         * the same definition.
+         **/
+        virtual void writeCheckpointState(CheckpointWriter &out) const {}
+        virtual void readCheckpointState(CheckpointReader &in) {}
+
         virtual std::shared_ptr<ComponentDefinition> clone() const;
 
         virtual void setAuxData(const std::any &data);
@@ -174,6 +204,7 @@ namespace Bess::SimEngine {
 
       protected:
         bool m_shouldAutoReschedule = false;
+        bool m_parallelSafe = false;
         CompDefIOGrowthPolicy m_ioGrowthPolicy = CompDefIOGrowthPolicy::none;
         SlotsGroupInfo m_inputSlotsInfo{}, m_outputSlotsInfo{};
         OperatorInfo m_opInfo{};
@@ -185,6 +216,7 @@ namespace Bess::SimEngine {
         uint64_t m_hash = 0;
         uint64_t m_baseHash = 0; // OG hash before any mutations
         SimulationFunction m_simulationFunction = nullptr;
+        InPlaceSimulationFunction m_inPlaceSimulationFunction = nullptr;
         std::vector<std::string> m_outputExpressions; // A+B or A.B etc.
         TypeMap<std::shared_ptr<Trait>> m_traits;
         CompDefinitionOwnership m_ownership = CompDefinitionOwnership::NativeCpp;
@@ -203,12 +235,18 @@ REFLECT(SlotCategoryPair,
         first,
         second)
 REFLECT_VECTOR(SlotCategoryPair)
+typedef std::pair<int, int> SlotWidthPair;
+REFLECT(SlotWidthPair,
+        first,
+        second)
+REFLECT_VECTOR(SlotWidthPair)
 REFLECT(Bess::SimEngine::SlotsGroupInfo,
         type,
         isResizeable,
         count,
         names,
-        categories)
+        categories,
+        widths)
 
 REFLECT_PROPS(Bess::SimEngine::ComponentDefinition,
               ("name", getName, setName),
@@ -40,15 +40,33 @@ namespace Bess::SimEngine {
 
         void clearCallbacks();
 
+        // Bookkeeping for fanOut, called with the component on the input side
+        // of every connection made from or removed from one of our outputs.
+        void addFanOut(const UUID &dependant);
+        void removeFanOut(const UUID &dependant, uint32_t connectionCount = 1);
+        // Recomputes fanOut from outputConnections, used after bulk changes like loading.
+        void rebuildFanOut();
+
         MAKE_GETTER_SETTER(std::string, Name, m_name)
 
         UUID id;
-        UUID netUuid = UUID::null;
+        UUID netUuid = UUID::null; // as of the last net sync, see SimulationEngine::getNetsMap
         ComponentState state;
         std::shared_ptr<ComponentDefinition> definition;
         Connections inputConnections;
         Connections outputConnections;
 
+        // Components fed by any output slot, each listed once with the number of
+        // connections to it. Kept in sync with outputConnections on every change,
+        // so scheduling dependants never has to deduplicate.
+        std::vector<std::pair<UUID, uint32_t>> fanOut;
+
+        // listeners registered through SimulationEngine::addStateChangeListener, slot changes
+        // are only logged for components that have any
+        uint32_t stateChangeListeners = 0;
+        // has slots written by SimulationEngine::startTrace
+        bool traced = false;
+
       private:
         static std::unordered_map<std::string, int> &getNameCountMap();
 
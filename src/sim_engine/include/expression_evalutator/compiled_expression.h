@@ -0,0 +1,84 @@
+#pragma once
+
+#include "bess_api.h"
+#include "types.h"
+#include <cstdint>
+#include <span>
+#include <string>
+#include <vector>
+
+namespace Bess::SimEngine::ExprEval {
+
+    enum class OpCode : uint8_t {
+        pushInput,
+        notOp,
+        andOp,
+        orOp,
+        xorOp,
+    };
+
+    struct Instruction {
+        OpCode code;
+        uint32_t operand = 0; // input index for pushInput
+    };
+
+    /**
+     * A logic expression compiled once into a form that is cheap to evaluate.
+     * Same grammar as evaluateExpression, but input indices can have any number of digits.
+     * Expressions reading at most `maxTableInputs` inputs are turned into a truth table
+     * bitmask, evaluation is then a single bit lookup.
+     * Wider expressions are kept as postfix bytecode evaluated on a small fixed stack.
+     **/
+    class BESS_API CompiledExpression {
+      public:
+        static constexpr uint32_t maxTableInputs = 16;
+
+        CompiledExpression() = default;
+
+        // throws std::runtime_error for malformed expressions
+        static CompiledExpression compile(const std::string &expr);
+
+        // Packs the first 64 inputs into a bit mask, bit i set if input i is high.
+        static uint64_t packInputs(std::span<const SlotState> inputs);
+
+        // packed: result of packInputs for the same inputs
+        bool evaluate(std::span<const SlotState> inputs, uint64_t packed) const;
+        bool evaluate(std::span<const SlotState> inputs) const;
+
+        // Value of input `input` for the 64 patterns starting at 64 * word,
+        // pattern p drives input i with bit i of p.
+        static uint64_t inputPattern(uint32_t input, uint64_t word);
+
+        // Evaluates 64 patterns at once, bit j of inputs[i] is input i of pattern j.
+        // stack: scratch of at least getMaxStackDepth() words
+        uint64_t evaluateWords(std::span<const uint64_t> inputs, std::span<uint64_t> stack) const;
+
+        // highest referenced input index + 1
+        uint32_t getInputCount() const;
+        uint32_t getMaxStackDepth() const;
+        bool isTruthTable() const;
+        const std::vector<Instruction> &getProgram() const;
+
+      private:
+        bool evaluateProgram(std::span<const SlotState> inputs) const;
+        void buildTruthTable();
+
+        std::vector<Instruction> m_program;
+        std::vector<uint64_t> m_table;
+        uint32_t m_inputCount = 0;
+        uint32_t m_maxStackDepth = 0;
+    };
+
+    // Output expressions of a definition together with their compiled form,
+    // set as definition aux data by ComponentDefinition::onExpressionsChange.
+    struct BESS_API CompiledExpressions {
+        std::vector<std::string> expressions;
+        std::vector<CompiledExpression> compiled;
+
+        // Malformed expressions are reported here instead of throwing,
+        // evaluating such a set throws with this message.
+        std::string error;
+    };
+
+    BESS_API CompiledExpressions compileExpressions(const std::vector<std::string> &expressions);
+} // namespace Bess::SimEngine::ExprEval
@@ -10,6 +10,8 @@
 
 #include "types.h"
 #include "common/logger.h"
+#include "expression_evalutator/compiled_expression.h"
+#include <algorithm>
 #include <stack>
 #include <stdexcept>
 #include <vector>
@@ -117,29 +119,49 @@ namespace Bess::SimEngine::ExprEval {
         return operands.top();
     }
 
+    /// expression evaluator simulation function, in place variant
+    /// auxData is expected to hold CompiledExpressions (see ComponentDefinition::onExpressionsChange),
+    /// a plain std::vector<std::string> is still accepted and compiled in place on the first call.
+    const InPlaceSimulationFunction exprEvalInPlaceSimFunc = [](std::span<const SlotState> inputs, SimTime currentTime,
+                                                                const ComponentState &prevState, std::span<SlotState> outputs) {
+        assert(prevState.auxData && "ExprEvalSimFunc requires auxData to be set with expressions");
+
+        const CompiledExpressions *compiled = std::any_cast<CompiledExpressions>(prevState.auxData);
+        if (!compiled) {
+            const auto *expressions = std::any_cast<std::vector<std::string>>(prevState.auxData);
+            if (!expressions) {
+                throw std::runtime_error(
+                    std::format(
+                        "ExprEvalSimFunc auxData must be CompiledExpressions or std::vector<std::string>, got {}",
+                        prevState.auxData->type().name()));
+            }
+            // the aux data belongs to this component's definition, later calls find it compiled
+            *prevState.auxData = compileExpressions(*expressions);
+            compiled = std::any_cast<CompiledExpressions>(prevState.auxData);
+        }
+
+        if (!compiled->error.empty()) {
+            throw std::runtime_error(compiled->error);
+        }
+
+        bool changed = false;
+        const uint64_t packed = CompiledExpression::packInputs(inputs);
+        const size_t count = std::min(compiled->compiled.size(), outputs.size());
+        for (size_t i = 0; i < count; i++) {
+            const auto value = compiled->compiled[i].evaluate(inputs, packed) ? LogicState::high : LogicState::low;
+            if (outputs[i].state == value)
+                continue;
+            changed = true;
+            outputs[i] = {value, currentTime};
+        }
+        return changed;
+    };
+
     /// expression evaluator simulation function
     const SimulationFunction exprEvalSimFunc = [](const std::vector<SlotState> &inputs, SimTime currentTime, const ComponentState &prevState) {
         auto newState = prevState;
         newState.inputStates = inputs;
-        bool changed = false;
-        assert(prevState.auxData && "ExprEvalSimFunc requires auxData to be set with expressions");
-        if (prevState.auxData->type() != typeid(std::vector<std::string>)) {
-            throw std::runtime_error(
-                std::format(
-                    "ExprEvalSimFunc auxData must be std::vector<std::string>, got {}",
-                    prevState.auxData->type().name()));
-        }
-        auto expressions = std::any_cast<std::vector<std::string>>(prevState.auxData);
-        for (int i = 0; i < (int)expressions->size(); i++) {
-            std::vector<bool> states;
-            states.reserve(inputs.size());
-            for (auto &state : inputs)
-                states.emplace_back((bool)state);
-            bool newStateBool = ExprEval::evaluateExpression(expressions->at(i), states);
-            changed = changed || (bool)prevState.outputStates[i] != newStateBool;
-            newState.outputStates[i] = {newStateBool ? LogicState::high : LogicState::low, currentTime};
-        }
-        newState.isChanged = changed;
+        newState.isChanged = exprEvalInPlaceSimFunc(inputs, currentTime, prevState, newState.outputStates);
         return newState;
     };
 } // namespace Bess::SimEngine::ExprEval
@@ -0,0 +1,162 @@
+#pragma once
+
+#include "bess_api.h"
+#include "checkpoint/sim_checkpoint.h"
+#include "netlist/compiled_netlist.h"
+#include "packed_state/logic_vector.h"
+#include "types.h"
+#include <cstdint>
+#include <deque>
+#include <span>
+#include <utility>
+#include <vector>
+
+namespace Bess::SimEngine {
+    class ComponentDefinition;
+
+    // What the engine has to restore besides the components after SimHistory::rewind.
+    struct BESS_API SimHistoryRewind {
+        SimTime simTime{0};
+        uint64_t nextEventId = 0;             // events from this id on were scheduled after the position
+        std::vector<SimulationEvent> requeue; // popped after the position, scheduled before it
+        std::vector<CompIndex> touched;       // components with restored slots, once each
+    };
+
+    struct BESS_API SimHistoryStats {
+        size_t positions = 0;
+        size_t keyframes = 0;
+        uint64_t dropped = 0; // positions dropped for the memory budget
+        SimTime oldestTime{0};
+        SimTime newestTime{0};
+        uint64_t memoryUsage = 0;
+        uint64_t memoryBudget = 0;
+    };
+
+    /**
+     * Bounded record of the recent past of a simulation, to take it back to an earlier
+     * timestep and simulate on from there.
+     * Every simulated timestep closes a position with its simulation time, the next event id
+     * and what it overwrote: the previous value of every slot it wrote and the runtime state
+     * of definitions, such as clocks, before onStateChange. Writes between timesteps, e.g.
+     * inputs set from the UI, belong to the next position. Going back undoes positions newest
+     * first. Event ids only increase, so the queue is rewound by dropping events scheduled
+     * after the target and queueing again the events popped after it that were scheduled
+     * before it, each position keeps the events its timestep popped for that.
+     * Every keyframeInterval positions a keyframe copies all slot states, packed, going a long
+     * way back restores the nearest later keyframe and only undoes the positions in between.
+     * The oldest positions are dropped to stay within the memory budget. Components are
+     * referred to by their index in one compiled netlist, a recompile invalidates the history.
+     **/
+    class BESS_API SimHistory {
+      public:
+        static constexpr uint64_t defaultMemoryBudget = uint64_t{64} << 20;
+        static constexpr uint32_t defaultKeyframeInterval = 256;
+
+        explicit SimHistory(uint64_t memoryBudgetBytes = defaultMemoryBudget,
+                            uint32_t keyframeInterval = defaultKeyframeInterval);
+
+        // Starts over with a single position for the current state of the netlist.
+        void reset(const CompiledNetlist &netlist, SimTime simTime, uint64_t nextEventId);
+        // Forgets everything, the next closed timestep starts a new history.
+        void clear();
+        // has positions recorded against this compilation of the netlist
+        bool matches(const CompiledNetlist &netlist) const;
+
+        // Value of a slot before a write, repeated writes are undone newest first.
+        void recordSlot(CompIndex idx, SlotType type, uint32_t slot, const SlotState &before);
+        // records the slots whose state or change time differs
+        void recordSlots(CompIndex idx, SlotType type, std::span<const SlotState> before,
+                         std::span<const SlotState> after);
+        // runtime state of the definition before it changes
+        void recordDefinitionState(CompIndex idx, const ComponentDefinition &definition);
+
+        // Closes a position after a timestep that popped events. A history that does not
+        // match the netlist starts over at this position.
+        void closeTimestep(const CompiledNetlist &netlist, SimTime simTime, uint64_t nextEventId,
+                           std::span<const SimulationEvent> events);
+
+        // Takes the components of the netlist back to position, one of
+        // [getFirstPosition(), getLastPosition()], and drops the positions after it.
+        void rewind(uint64_t position, CompiledNetlist &netlist, SimHistoryRewind &out);
+
+        // newest position at or before simTime, false if simTime is older than the history
+        bool findPosition(SimTime simTime, uint64_t &position) const;
+
+        bool empty() const;
+        uint64_t getFirstPosition() const;
+        uint64_t getLastPosition() const;
+        SimTime getTimeAt(uint64_t position) const;
+        SimHistoryStats getStats() const;
+
+        uint64_t getMemoryBudget() const;
+        void setMemoryBudget(uint64_t bytes);
+        uint64_t getMemoryUsage() const;
+
+      private:
+        static constexpr uint32_t outputSlotFlag = 1u << 31;
+
+        struct SlotUndo {
+            SlotState before;
+            CompIndex comp;
+            uint32_t slot; // outputSlotFlag set for outputs
+        };
+
+        // a span of definitionBytes read back by ComponentDefinition::readCheckpointState
+        struct DefinitionUndo {
+            CompIndex comp;
+            uint32_t offset;
+            uint32_t size;
+        };
+
+        struct Position {
+            SimTime simTime{0};
+            uint64_t nextEventId = 0;
+            uint64_t memoryUsage = 0; // counted when the position was closed
+            // undo data of the writes that led here from the previous position
+            std::vector<SlotUndo> slots;
+            std::vector<DefinitionUndo> definitions;
+            std::vector<uint8_t> definitionBytes;
+            std::vector<SimulationEvent> popped;
+
+            void clearUndo();
+            uint64_t computeMemoryUsage() const;
+        };
+
+        struct Keyframe {
+            uint64_t position = 0;
+            uint64_t memoryUsage = 0;
+            // inputs then outputs of every component, in netlist order
+            LogicVector values;
+            std::vector<SimTime> changeTimes;
+            std::vector<std::pair<uint32_t, uint64_t>> words; // slot, SlotState::value of the buses not at 0
+            std::vector<DefinitionUndo> definitions;
+            std::vector<uint8_t> definitionBytes;
+        };
+
+        void appendDefinitionState(CompIndex idx, const ComponentDefinition &definition,
+                                   std::vector<DefinitionUndo> &definitions, std::vector<uint8_t> &bytes);
+        void captureKeyframe(const CompiledNetlist &netlist);
+        void restoreKeyframe(const Keyframe &keyframe, CompiledNetlist &netlist,
+                             std::vector<CompIndex> &touched);
+        void undo(const Position &position, CompiledNetlist &netlist, std::vector<CompIndex> &touched);
+        void touch(CompIndex idx, std::vector<CompIndex> &touched);
+        void dropOldest();
+        void enforceBudget();
+
+        uint64_t m_memoryBudget;
+        uint32_t m_keyframeInterval;
+        uint64_t m_memoryUsage = 0;
+        uint64_t m_dropped = 0;
+
+        bool m_valid = false;
+        uint64_t m_netlistVersion = 0;
+        uint64_t m_firstPosition = 0;
+        std::deque<Position> m_positions;
+        std::deque<Keyframe> m_keyframes;
+        Position m_open;  // writes since the newest position
+        Position m_spare; // buffers of a dropped position, reused by the next one
+
+        CheckpointWriter m_definitionScratch;
+        std::vector<uint8_t> m_touchMarks;
+    };
+} // namespace Bess::SimEngine
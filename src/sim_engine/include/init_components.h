@@ -1,9 +1,16 @@
 #pragma once
 
+#include "checkpoint/sim_checkpoint.h"
 #include "component_catalog.h"
 #include "component_definition.h"
+#include "expression_evalutator/expr_evaluator.h"
+#include "netlist/cycle_schedule.h"
 #include "types.h"
+#include <algorithm>
+#include <array>
+#include <format>
 #include <memory>
+#include <span>
 
 namespace Bess::SimEngine {
     enum class FrequencyUnit : uint8_t {
@@ -33,16 +40,15 @@ namespace Bess::SimEngine {
             m_name = "Clock";
             m_groupName = groupName;
             m_outputSlotsInfo = {SlotsGroupType::output, false, 1, {"1.00Hz"}, {}};
-            setSimulationFunction([](auto &, auto ts, const auto &oldState) -> ComponentState {
-                auto newState = oldState;
-                newState.outputStates[0].state = oldState.outputStates[0].state == LogicState::low
-                                                     ? LogicState::high
-                                                     : LogicState::low;
-                newState.outputStates[0].lastChangeTime = ts;
-                newState.isChanged = true;
-                return newState;
+            setInPlaceSimulationFunction([](auto, SimTime ts, const ComponentState &, std::span<SlotState> outputs) {
+                outputs[0].state = outputs[0].state == LogicState::low
+                                       ? LogicState::high
+                                       : LogicState::low;
+                outputs[0].lastChangeTime = ts;
+                return true;
             });
 
+            m_parallelSafe = true;
             m_shouldAutoReschedule = true;
             m_simDelay = SimDelayNanoSeconds(0);
             addTrait<ClockTrait>();
@@ -77,6 +83,22 @@ namespace Bess::SimEngine {
             clockTrait->high = newState.outputStates[0].state == LogicState::high;
         }
 
+        void writeCheckpointState(CheckpointWriter &out) const override {
+            const auto &clockTrait = getTrait<ClockTrait>();
+            out.write(clockTrait->frequencyUnit);
+            out.write(clockTrait->frequency);
+            out.write(clockTrait->high);
+            out.write(clockTrait->dutyCycle);
+        }
+
+        void readCheckpointState(CheckpointReader &in) override {
+            const auto &clockTrait = getTrait<ClockTrait>();
+            clockTrait->frequencyUnit = in.read<FrequencyUnit>();
+            clockTrait->frequency = in.read<float>();
+            clockTrait->high = in.read<bool>();
+            clockTrait->dutyCycle = in.read<float>();
+        }
+
         std::shared_ptr<ComponentDefinition> clone() const override {
             auto cloned = std::make_shared<ClockDefinition>(*this);
             cloned->m_traits.clear();
@@ -98,11 +120,13 @@ namespace Bess::SimEngine {
         inpDef->setGroupName("IO");
         inpDef->setBehaviorType(ComponentBehaviorType::input);
         inpDef->setOutputSlotsInfo({SlotsGroupType::output, true, 1, {}, {}});
-        inpDef->setSimulationFunction([](auto &, auto ts, const auto &oldState) -> ComponentState {
-            auto newState = oldState;
-						newState.isChanged = true;
-						newState.outputStates[0].lastChangeTime = ts;
-						return newState; });
+        // outputs are driven through setOutputSlotState, evaluation only stamps the time
+        inpDef->setInPlaceSimulationFunction([](auto, SimTime ts, const ComponentState &, std::span<SlotState> outputs) {
+            if (!outputs.empty())
+                outputs[0].lastChangeTime = ts;
+            return true;
+        });
+        inpDef->setParallelSafe(true);
         inpDef->setSimDelay(SimDelayNanoSeconds(0));
         catalog.registerComponent(inpDef);
 
@@ -114,17 +138,203 @@ namespace Bess::SimEngine {
         outDef->setGroupName("IO");
         outDef->setBehaviorType(ComponentBehaviorType::output);
         outDef->setInputSlotsInfo({SlotsGroupType::input, true, 1, {"LSB"}, {}});
-        outDef->setSimulationFunction([](const std::vector<SlotState> &inputs, SimTime,
-                                         const ComponentState &prevState) -> ComponentState {
-						auto newState = prevState;
-						newState.inputStates = inputs;
-						newState.isChanged = true;
-						return newState; });
+        // the engine stores the inputs, reporting a change is all that is needed
+        outDef->setInPlaceSimulationFunction([](auto, SimTime, const ComponentState &, auto) {
+            return true;
+        });
+        outDef->setParallelSafe(true);
         outDef->setSimDelay(SimDelayNanoSeconds(0));
         catalog.registerComponent(outDef);
     }
 
+    /**
+     * Native simulation function for the primitive gates, works for any input count.
+     * op: operator as used in OperatorInfo, '*' and, '+' or, '^' xor, '!' not, '$' buffer;
+     * negateOutput: inverts the result, e.g. '*' with negateOutput is a NAND;
+     * Binary operators reduce all inputs into the single output,
+     * unary operators map input i to output i.
+     **/
+    inline InPlaceSimulationFunction makeGateSimFunction(char op, bool negateOutput) {
+        if (ExprEval::isUninaryOperator(op)) {
+            const bool invert = (op == '!') != negateOutput;
+            return [invert](std::span<const SlotState> inputs, SimTime ts,
+                            const ComponentState &, std::span<SlotState> outputs) {
+                bool changed = false;
+                const size_t count = std::min(inputs.size(), outputs.size());
+                for (size_t i = 0; i < count; i++) {
+                    const bool high = (inputs[i].state == LogicState::high) != invert;
+                    const LogicState next = high ? LogicState::high : LogicState::low;
+                    if (outputs[i].state != next) {
+                        outputs[i] = {next, ts};
+                        changed = true;
+                    }
+                }
+                return changed;
+            };
+        }
+
+        return [op, negateOutput](std::span<const SlotState> inputs, SimTime ts,
+                                  const ComponentState &, std::span<SlotState> outputs) {
+            if (inputs.empty() || outputs.empty())
+                return false;
+
+            const auto isHigh = [](const SlotState &s) { return s.state == LogicState::high; };
+            bool high = false;
+            switch (op) {
+            case '*':
+                high = std::ranges::all_of(inputs, isHigh);
+                break;
+            case '+':
+                high = std::ranges::any_of(inputs, isHigh);
+                break;
+            case '^':
+                high = (std::ranges::count_if(inputs, isHigh) & 1) != 0;
+                break;
+            default:
+                throw std::runtime_error(std::format("Unsupported gate operator '{}'", op));
+            }
+
+            const LogicState next = (high != negateOutput) ? LogicState::high : LogicState::low;
+            if (outputs[0].state == next)
+                return false;
+            outputs[0] = {next, ts};
+            return true;
+        };
+    }
+
+    // Primitive gates, fields must stay in sync with the bess-plugin gate list,
+    // as the plugin schematics and saved projects look them up by hash.
+    inline void initDigitalGates() {
+        struct GateInfo {
+            const char *name;
+            char op;
+            bool negateOutput;
+            size_t inputCount;
+        };
+
+        constexpr std::array<GateInfo, 8> gates = {{
+            {"Buffer Gate", '$', false, 1},
+            {"AND Gate", '*', false, 2},
+            {"OR Gate", '+', false, 2},
+            {"NOT Gate", '!', false, 1},
+            {"NAND Gate", '*', true, 2},
+            {"NOR Gate", '+', true, 2},
+            {"XOR Gate", '^', false, 2},
+            {"XNOR Gate", '^', true, 2},
+        }};
+
+        auto &catalog = ComponentCatalog::instance();
+        for (const auto &gate : gates) {
+            const auto def = std::make_shared<ComponentDefinition>();
+            def->setName(gate.name);
+            def->setGroupName("Digital Gates");
+            def->setInputSlotsInfo({SlotsGroupType::input, true, gate.inputCount, {}, {}});
+            def->setOutputSlotsInfo({SlotsGroupType::output, false, 1, {}, {}});
+            def->setOpInfo({gate.op, gate.negateOutput});
+            def->setSimDelay(SimDelayNanoSeconds(2));
+            def->setInPlaceSimulationFunction(makeGateSimFunction(gate.op, gate.negateOutput));
+            def->setParallelSafe(true);
+            catalog.registerComponent(def);
+        }
+    }
+
+    // One bus input split into width single bit outputs, bit 0 on the first output.
+    inline std::shared_ptr<ComponentDefinition> makeBusSplitterDefinition(int width) {
+        const auto def = std::make_shared<ComponentDefinition>();
+        def->setName(std::format("Bus Splitter {}", width));
+        def->setGroupName("Buses");
+        def->setInputSlotsInfo({SlotsGroupType::input, false, 1, {"BUS"}, {}, {{0, width}}});
+        def->setOutputSlotsInfo({SlotsGroupType::output, false, static_cast<size_t>(width), {}, {}});
+        def->setInPlaceSimulationFunction([](std::span<const SlotState> inputs, SimTime ts,
+                                             const ComponentState &, std::span<SlotState> outputs) {
+            const auto &bus = inputs[0];
+            bool changed = false;
+            for (size_t i = 0; i < outputs.size(); i++) {
+                LogicState next = bus.state;
+                if (next == LogicState::high || next == LogicState::low)
+                    next = ((bus.value >> i) & 1) ? LogicState::high : LogicState::low;
+                if (outputs[i].state != next) {
+                    outputs[i] = {next, ts};
+                    changed = true;
+                }
+            }
+            return changed;
+        });
+        def->setParallelSafe(true);
+        def->setSimDelay(SimDelayNanoSeconds(0));
+        def->addTrait<CombinationalTrait>();
+        return def;
+    }
+
+    // width single bit inputs joined into one bus output, the first input is bit 0.
+    inline std::shared_ptr<ComponentDefinition> makeBusJoinerDefinition(int width) {
+        const auto def = std::make_shared<ComponentDefinition>();
+        def->setName(std::format("Bus Joiner {}", width));
+        def->setGroupName("Buses");
+        def->setInputSlotsInfo({SlotsGroupType::input, false, static_cast<size_t>(width), {}, {}});
+        def->setOutputSlotsInfo({SlotsGroupType::output, false, 1, {"BUS"}, {}, {{0, width}}});
+        def->setInPlaceSimulationFunction([](std::span<const SlotState> inputs, SimTime ts,
+                                             const ComponentState &, std::span<SlotState> outputs) {
+            // any unknown bit makes the whole bus unknown, a bus has no per bit states
+            uint64_t value = 0;
+            bool unknown = false;
+            for (size_t i = 0; i < inputs.size(); i++) {
+                if (inputs[i].state == LogicState::high)
+                    value |= uint64_t{1} << i;
+                else if (inputs[i].state == LogicState::unknown)
+                    unknown = true;
+            }
+            SlotState next = SlotState::fromWord(unknown ? 0 : value, ts);
+            if (unknown)
+                next.state = LogicState::unknown;
+            if (outputs[0].sameValue(next))
+                return false;
+            outputs[0] = next;
+            return true;
+        });
+        def->setParallelSafe(true);
+        def->setSimDelay(SimDelayNanoSeconds(0));
+        def->addTrait<CombinationalTrait>();
+        return def;
+    }
+
+    // Bus counterparts of Input and Output, driven through setOutputSlotWord.
+    inline std::shared_ptr<ComponentDefinition> makeBusIODefinition(int width, ComponentBehaviorType behavior) {
+        const auto def = std::make_shared<ComponentDefinition>();
+        def->setGroupName("Buses");
+        def->setBehaviorType(behavior);
+        if (behavior == ComponentBehaviorType::input) {
+            def->setName(std::format("Bus Input {}", width));
+            def->setOutputSlotsInfo({SlotsGroupType::output, false, 1, {}, {}, {{0, width}}});
+            def->setInPlaceSimulationFunction([](auto, SimTime ts, const ComponentState &, std::span<SlotState> outputs) {
+                outputs[0].lastChangeTime = ts;
+                return true;
+            });
+        } else {
+            def->setName(std::format("Bus Output {}", width));
+            def->setInputSlotsInfo({SlotsGroupType::input, false, 1, {}, {}, {{0, width}}});
+            def->setInPlaceSimulationFunction([](auto, SimTime, const ComponentState &, auto) {
+                return true;
+            });
+        }
+        def->setParallelSafe(true);
+        def->setSimDelay(SimDelayNanoSeconds(0));
+        return def;
+    }
+
+    inline void initBuses() {
+        auto &catalog = ComponentCatalog::instance();
+        for (const int width : {4, 8, 16, 32}) {
+            catalog.registerComponent(makeBusIODefinition(width, ComponentBehaviorType::input));
+            catalog.registerComponent(makeBusIODefinition(width, ComponentBehaviorType::output));
+            catalog.registerComponent(makeBusSplitterDefinition(width));
+            catalog.registerComponent(makeBusJoinerDefinition(width));
+        }
+    }
+
     inline void initComponentCatalog() {
         initIO();
+        initDigitalGates();
+        initBuses();
     }
 } // namespace Bess::SimEngine
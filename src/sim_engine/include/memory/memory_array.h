@@ -0,0 +1,63 @@
+#pragma once
+
+#include "bess_api.h"
+#include <cstdint>
+#include <span>
+#include <string_view>
+#include <vector>
+
+namespace Bess::SimEngine {
+    class CheckpointWriter;
+    class CheckpointReader;
+
+    /**
+     * Word addressed storage for memories, one contiguous array of uint64_t.
+     * Every entry takes ceil(width / 64) words, bit 0 of the entry is bit 0 of its first
+     * word. Storage grows up to depth as entries are written, entries never written read
+     * as 0 and writes past depth are dropped.
+     **/
+    class BESS_API MemoryArray {
+      public:
+        MemoryArray() = default;
+        MemoryArray(size_t width, size_t depth);
+
+        size_t getWidth() const;
+        size_t getDepth() const;
+        size_t getWordsPerEntry() const;
+
+        // entries backed by storage, at most depth
+        size_t getAllocatedDepth() const;
+        uint64_t getMemoryUsage() const;
+
+        // the words of the entry at address, getWordsPerEntry() of them
+        std::span<const uint64_t> read(size_t address) const;
+        // the low 64 bits of the entry
+        uint64_t readWord(size_t address) const;
+
+        // bits set in mask take their value from data, both hold getWordsPerEntry() words
+        void write(size_t address, std::span<const uint64_t> data, std::span<const uint64_t> mask);
+        void writeWord(size_t address, uint64_t data, uint64_t mask = ~uint64_t{0});
+
+        /**
+         * Loads a Yosys INIT parameter: a binary string of entries * width bits, most
+         * significant first, so entry 0 ends the string. x and z bits load as 0 and a
+         * shorter string leaves the remaining entries alone.
+         **/
+        void loadInit(std::string_view bits);
+
+        void clear();
+
+        // bulk copy of the allocated entries, read back into an array of the same width
+        void writeCheckpoint(CheckpointWriter &out) const;
+        void readCheckpoint(CheckpointReader &in);
+
+      private:
+        uint64_t *entry(size_t address);
+
+        size_t m_width = 0;
+        size_t m_depth = 0;
+        size_t m_wordsPerEntry = 0;
+        std::vector<uint64_t> m_data;
+        std::vector<uint64_t> m_zero; // what unallocated entries read as
+    };
+} // namespace Bess::SimEngine
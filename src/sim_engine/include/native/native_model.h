@@ -0,0 +1,87 @@
+#pragma once
+
+#include "bess_api.h"
+#include "netlist/compiled_netlist.h"
+#include "netlist/cycle_schedule.h"
+#include <cstdint>
+#include <filesystem>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace Bess::SimEngine {
+    struct BESS_API NativeModelConfig {
+        // a gcc or clang compatible driver
+        std::filesystem::path compilerPath = "c++";
+        // compiled models are kept here by hash, empty for a per user cache:
+        // $XDG_CACHE_HOME/bess/native (~/.cache/bess/native) or %LOCALAPPDATA%\bess\native.
+        // It must not be writable by other users, see NativeModel::load.
+        std::filesystem::path cacheDirectory;
+        std::vector<std::string> flags = {"-O2"};
+    };
+
+    // C++ for the combinational logic of one netlist, see NativeModel::generate.
+    struct BESS_API NativeModelSource {
+        std::string code;
+        uint64_t hash = 0; // of the code and the compiler flags, names the cached library
+        uint64_t netlistVersion = 0;
+        // net of output slot 0 per component, size n + 1
+        std::vector<uint32_t> outputNetBegin;
+        // components computed by the model, only these can report changes
+        size_t combinational = 0;
+        size_t blocks = 0;
+    };
+
+    /**
+     * The combinational logic of a cycle scheduled netlist compiled to a shared library.
+     *
+     * Every output slot is a net of one byte in a flat array, 1 when high. The generated
+     * code holds one function per block of the levelized logic, gates and expression
+     * definitions are inlined from their operator or OutputExpressions. One evaluate()
+     * call computes all of them in level order and lists the components whose outputs
+     * changed, the engine writes only those back. Sources and registers stay with the
+     * engine, their nets are set before the call.
+     * Libraries are cached by source hash, so a netlist seen before loads without compiling.
+     **/
+    class BESS_API NativeModel {
+      public:
+        using EvaluateFunction = uint32_t (*)(uint8_t *nets, uint32_t *changed);
+
+        static constexpr uint32_t abiVersion = 1;
+        // components per generated function, keeps compile times of wide levels in check
+        static constexpr size_t maxBlockSize = 256;
+
+        // throws std::runtime_error naming the first component without a native form,
+        // e.g. a bus splitter or a cell with a hand written simulation function
+        static NativeModelSource generate(const CompiledNetlist &netlist, const CycleSchedule &schedule);
+
+        // Builds the source with the configured compiler unless it is cached, then loads it.
+        // Throws std::runtime_error if compiling or loading fails, or if the cache directory
+        // or the library belongs to another user or is writable by one.
+        static std::shared_ptr<NativeModel> load(NativeModelSource source, const NativeModelConfig &config = {});
+
+        // throws std::runtime_error if there is no cache directory configured and no per user one
+        static std::filesystem::path getLibraryPath(const NativeModelSource &source, const NativeModelConfig &config);
+
+        NativeModel(const NativeModel &) = delete;
+        NativeModel &operator=(const NativeModel &) = delete;
+        ~NativeModel();
+
+        const NativeModelSource &getSource() const;
+        uint32_t getNet(CompIndex idx, size_t slot) const;
+        uint32_t getNetCount() const;
+        // true if the library came from the cache without running the compiler
+        bool wasCached() const;
+
+        // nets: getNetCount() bytes, changed: room for getSource().combinational indices
+        uint32_t evaluate(uint8_t *nets, uint32_t *changed) const;
+
+      private:
+        NativeModel() = default;
+
+        NativeModelSource m_source;
+        void *m_library = nullptr;
+        EvaluateFunction m_evaluate = nullptr;
+        bool m_cached = false;
+    };
+} // namespace Bess::SimEngine
@@ -0,0 +1,93 @@
+#pragma once
+
+#include "bess_api.h"
+#include "common/bess_uuid.h"
+#include "net/net.h"
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+namespace Bess::SimEngine {
+    /**
+     * Keeps the nets, the groups of components connected by wires, up to date while the
+     * design is edited.
+     * Components are nodes of a union-find with union by size and path halving, so a new
+     * wire merges two nets in near constant time and finding the net of a component is a
+     * lookup and a short walk. Every net also links its nodes in a circular list that two
+     * merging nets splice together.
+     * Union-find can not split, so removing a wire or a component only marks its net dirty.
+     * The net is partitioned again the next time it is queried, by a walk over its own
+     * members with generation stamped visit marks, and the largest part keeps the net id.
+     * Removed components stay behind as dead nodes until then.
+     * The Net objects the UI consumes are rebuilt only for the nets that changed since the
+     * last call to getNets.
+     **/
+    class BESS_API NetTracker {
+      public:
+        void clear();
+
+        // Adds a component in a net of its own, with id netId when it is not null.
+        UUID addComponent(const UUID &comp, const UUID &netId = UUID::null);
+        void removeComponent(const UUID &comp);
+        bool contains(const UUID &comp) const;
+
+        // One more wire between a and b, true if it merged two nets.
+        bool connect(const UUID &a, const UUID &b);
+        // One wire less between a and b, their net is split lazily if it was the last one.
+        void disconnect(const UUID &a, const UUID &b);
+
+        // UUID::null for unknown components
+        UUID getNetOf(const UUID &comp);
+        bool isSameNet(const UUID &a, const UUID &b);
+
+        // Nets by id. When changedNets is given the ids of the nets rebuilt by this call
+        // are appended to it.
+        const std::unordered_map<UUID, Net> &getNets(std::vector<UUID> *changedNets = nullptr);
+
+        // Bumped by every change that may move components between nets.
+        uint64_t getGeneration() const;
+        size_t getComponentCount() const;
+
+      private:
+        static constexpr uint32_t invalidNode = UINT32_MAX;
+
+        struct Node {
+            UUID comp = UUID::null; // null once the component was removed
+            uint32_t parent = 0;    // union-find parent, itself at the root
+            uint32_t next = 0;      // circular list of the net's nodes
+            uint32_t prev = 0;
+            uint32_t nodes = 1;     // at the root, nodes in the list, dead ones included
+            uint32_t live = 1;      // at the root, components in the net
+            uint32_t visited = 0;   // generation of the last split walk through the node
+            bool dirty = false;     // at the root, may have to split
+            bool changed = false;   // at the root, its Net has to be rebuilt
+            UUID net = UUID::null;  // at the root
+            std::vector<uint32_t> adjacent; // one entry per wire
+        };
+
+        uint32_t allocNode(const UUID &comp, const UUID &net);
+        void freeNode(uint32_t node);
+        uint32_t find(uint32_t node);
+        uint32_t findIndex(const UUID &comp) const;
+        uint32_t resolve(uint32_t node); // root after any pending split
+        void markDirty(uint32_t root);
+        void markChanged(uint32_t root);
+        void split(uint32_t root);
+        void flush();
+
+        std::vector<Node> m_nodes;
+        std::vector<uint32_t> m_free;
+        std::unordered_map<UUID, uint32_t> m_index;
+
+        std::vector<uint32_t> m_dirty;   // nodes whose net may have to split
+        std::vector<uint32_t> m_changed; // nodes whose Net may have to be rebuilt
+        std::vector<UUID> m_removedNets;
+        std::unordered_map<UUID, Net> m_nets;
+
+        uint64_t m_generation = 0;
+        uint32_t m_visitGeneration = 0;
+        std::vector<uint32_t> m_members;
+        std::vector<uint32_t> m_stack;
+        std::vector<uint32_t> m_roots;
+    };
+} // namespace Bess::SimEngine
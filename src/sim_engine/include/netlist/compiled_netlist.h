@@ -0,0 +1,90 @@
+#pragma once
+
+#include "bess_api.h"
+#include "common/bess_uuid.h"
+#include "types.h"
+#include <cstdint>
+#include <limits>
+#include <span>
+#include <unordered_map>
+#include <vector>
+
+namespace Bess::SimEngine {
+    class DigitalComponent;
+    class SimEngineState;
+
+    typedef uint32_t CompIndex;
+    constexpr CompIndex invalidCompIndex = std::numeric_limits<CompIndex>::max();
+
+    /**
+     * Flat, index based view of the component graph used by the simulation loop.
+     *
+     * Components get dense indices, slots get global indices and connections
+     * are stored in CSR form, so the hot path never hashes a UUID or touches a
+     * shared_ptr. Output slot values are mirrored into packed arrays which
+     * must be kept in sync through syncOutputs()/setOutput() whenever the
+     * engine writes a component's outputs.
+     *
+     * The netlist is a snapshot of SimEngineState at compile time, it does not
+     * own components and must be recompiled whenever the topology changes.
+     **/
+    class BESS_API CompiledNetlist {
+      public:
+        void compile(const SimEngineState &state);
+        void clear();
+
+        // topology version of SimEngineState this netlist was built from
+        uint64_t getCompiledVersion() const;
+
+        size_t size() const;
+
+        CompIndex indexOf(const UUID &uuid) const;
+        const UUID &uuidOf(CompIndex idx) const;
+        DigitalComponent *componentAt(CompIndex idx) const;
+
+        // false if the component was resized after compilation
+        bool isShapeValid(CompIndex idx) const;
+
+        size_t getInputCount(CompIndex idx) const;
+        size_t getOutputCount(CompIndex idx) const;
+
+        // Resolves the input slots of a component from the packed output states.
+        // Result is appended to `out`, multiple drivers resolve as high > unknown > low
+        // with high_z drivers ignored. The words of several high bus drivers are or-ed.
+        void gatherInputs(CompIndex idx, std::vector<SlotState> &out) const;
+
+        // Unique components driven by any of the outputs of idx.
+        std::span<const CompIndex> getDependants(CompIndex idx) const;
+
+        SlotState getOutput(CompIndex idx, size_t slot) const;
+        void setOutput(CompIndex idx, size_t slot, const SlotState &state);
+
+        // Copies the outputs of the component into the packed arrays,
+        // returns false if the slot count no longer matches.
+        bool syncOutputs(CompIndex idx);
+
+      private:
+        std::vector<UUID> m_uuids;
+        std::vector<DigitalComponent *> m_components;
+        std::unordered_map<UUID, CompIndex> m_indexMap;
+
+        // per component ranges of global slot ids, size n + 1
+        std::vector<uint32_t> m_inputSlotBegin;
+        std::vector<uint32_t> m_outputSlotBegin;
+
+        // per global input slot, range into m_fanIn of driving global output slots
+        std::vector<uint32_t> m_fanInBegin;
+        std::vector<uint32_t> m_fanIn;
+
+        // per component, range into m_dependants
+        std::vector<uint32_t> m_dependantsBegin;
+        std::vector<CompIndex> m_dependants;
+
+        // packed output slot states, indexed by global output slot
+        std::vector<LogicState> m_outputValues;
+        std::vector<SimTime> m_outputChangeTimes;
+        std::vector<uint64_t> m_outputWords; // SlotState::value, zero for one bit slots
+
+        uint64_t m_version = 0;
+    };
+} // namespace Bess::SimEngine
@@ -0,0 +1,101 @@
+#pragma once
+
+#include "bess_api.h"
+#include "component_definition.h"
+#include "netlist/compiled_netlist.h"
+#include <cstdint>
+#include <memory>
+#include <span>
+#include <string>
+#include <vector>
+
+namespace Bess::SimEngine {
+    // The outputs only depend on the current inputs, nothing is kept between evaluations.
+    class BESS_API CombinationalTrait : public Trait {
+      public:
+        std::shared_ptr<Trait> clone() const override {
+            return std::make_shared<CombinationalTrait>(*this);
+        }
+    };
+
+    // The outputs only change on an edge of a clock slot or while an asynchronous slot,
+    // e.g. a reset, is active. Other inputs are only sampled then.
+    class BESS_API RegisterTrait : public Trait {
+      public:
+        RegisterTrait() = default;
+        RegisterTrait(std::vector<int> clockSlots, std::vector<int> asyncSlots)
+            : clockSlots(std::move(clockSlots)), asyncSlots(std::move(asyncSlots)) {}
+
+        std::shared_ptr<Trait> clone() const override {
+            return std::make_shared<RegisterTrait>(*this);
+        }
+
+        std::vector<int> clockSlots;
+        std::vector<int> asyncSlots;
+    };
+
+    // Registers clocked by one output slot of a source component, e.g. a Clock or a top level Input.
+    struct BESS_API ClockDomain {
+        CompIndex source = invalidCompIndex;
+        uint32_t slot = 0;
+        bool freeRunning = false; // the source is a Clock, not driven from outside
+        std::vector<CompIndex> registers;
+    };
+
+    /**
+     * Evaluation order of a fully synchronous netlist for the cycle based simulation mode.
+     *
+     * Every component is a source (no inputs), a register (RegisterTrait) or combinational
+     * (CombinationalTrait, gates, expressions and output components). The combinational
+     * components are levelized once, so a timestep evaluates the clocked registers and then
+     * sweeps the logic behind them in order, each component at most once and without delays.
+     * Clock and asynchronous slots of registers must be driven by sources directly; gated
+     * or derived clocks, latches, combinational loops and anything else keeping state make
+     * build() fail and the engine stays event driven.
+     **/
+    class BESS_API CycleSchedule {
+      public:
+        enum class Role : uint8_t {
+            source,
+            reg,
+            combinational,
+        };
+
+        static bool isCombinational(const ComponentDefinition &definition);
+
+        // false, with the reason in getFallbackReason(), if the netlist needs the event loop
+        bool build(const CompiledNetlist &netlist);
+        void clear();
+
+        bool isBuiltFor(uint64_t netlistVersion) const;
+        bool isValid() const;
+        const std::string &getFallbackReason() const;
+
+        Role getRole(CompIndex idx) const;
+
+        // combinational components, each one after every combinational component driving it
+        std::span<const CompIndex> getCombinationalOrder() const;
+        // position in the combinational order, only for combinational components
+        uint32_t getRank(CompIndex idx) const;
+        // longest chain of combinational components between registers
+        uint32_t getDepth() const;
+
+        const std::vector<ClockDomain> &getClockDomains() const;
+        size_t getRegisterCount() const;
+
+      private:
+        bool fail(std::string reason);
+
+        bool m_built = false;
+        bool m_valid = false;
+        uint64_t m_version = 0;
+        std::string m_fallbackReason;
+
+        std::vector<Role> m_roles;
+        std::vector<uint32_t> m_ranks;
+        std::vector<CompIndex> m_order;
+        uint32_t m_depth = 0;
+        std::vector<ClockDomain> m_domains;
+        size_t m_registerCount = 0;
+    };
+} // namespace Bess::SimEngine
@@ -0,0 +1,59 @@
+#pragma once
+
+#include "bess_api.h"
+#include "types.h"
+#include <cstdint>
+#include <span>
+#include <vector>
+
+namespace Bess::SimEngine {
+    /**
+     * Packed 4-state logic values, 64 per pair of words.
+     * A value plane and a strength plane are interleaved word by word, with the encoding of
+     * Verilog's aval/bval pairs: low 00, high 10, high_z 01, unknown 11 (value, strength).
+     * A strength bit marks a value that is not driven to a plain 0 or 1, so a vector holds
+     * only 0s and 1s when its strength plane is all zero.
+     **/
+    class BESS_API LogicVector {
+      public:
+        LogicVector() = default;
+        explicit LogicVector(size_t size, LogicState fill = LogicState::low);
+
+        size_t size() const;
+        bool empty() const;
+        void resize(size_t size, LogicState fill = LogicState::low);
+        void clear();
+
+        LogicState get(size_t idx) const;
+        void set(size_t idx, LogicState state);
+        void fill(LogicState state);
+
+        // logic states of the slots, their change times are not kept
+        void assign(std::span<const SlotState> slots);
+        void append(std::span<const SlotState> slots);
+        // writes the states into slots[0, size()), leaving their change times alone
+        void copyTo(std::span<SlotState> slots) const;
+
+        // no unknown or high_z value
+        bool isKnown() const;
+
+        // words of the planes, value and strength interleaved
+        std::span<const uint64_t> getWords() const;
+        uint64_t getMemoryUsage() const;
+
+        bool operator==(const LogicVector &other) const;
+
+      private:
+        static constexpr uint64_t valueBit(LogicState state) {
+            return state == LogicState::high || state == LogicState::unknown ? 1 : 0;
+        }
+        static constexpr uint64_t strengthBit(LogicState state) {
+            return state == LogicState::unknown || state == LogicState::high_z ? 1 : 0;
+        }
+
+        void clearTail();
+
+        size_t m_size = 0;
+        std::vector<uint64_t> m_words; // value word then strength word of every 64 values
+    };
+} // namespace Bess::SimEngine
@@ -0,0 +1,72 @@
+#pragma once
+
+#include "bess_api.h"
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace Bess::SimEngine {
+
+    /**
+     * Fixed set of worker threads running index ranges, used for data parallel work
+     * inside one simulation timestep.
+     * Every participant starts on its own contiguous share of the range and takes chunks
+     * of `grain` indices from the front of it. A participant that runs out steals the back
+     * half of another share, so uneven evaluation costs are balanced without a shared queue.
+     * Dispatching does not allocate.
+     **/
+    class BESS_API WorkStealingPool {
+      public:
+        // body(begin, end) runs the indices in [begin, end), it must not throw
+        typedef std::function<void(size_t, size_t)> RangeFunction;
+
+        // threadCount: participants including the calling thread, at least 1
+        explicit WorkStealingPool(size_t threadCount);
+        ~WorkStealingPool();
+
+        WorkStealingPool(const WorkStealingPool &) = delete;
+        WorkStealingPool &operator=(const WorkStealingPool &) = delete;
+
+        size_t getThreadCount() const;
+
+        // Runs body over [0, count) on all participants, blocks until every index ran.
+        // Not reentrant, only one thread may dispatch at a time.
+        void parallelFor(size_t count, size_t grain, const RangeFunction &body);
+
+      private:
+        static constexpr size_t maxSliceSize = size_t{1} << 23;
+
+        // [begin, end) and a job tag packed into one word, owner and thieves race with a single CAS
+        struct alignas(64) Share {
+            std::atomic<uint64_t> range{0};
+        };
+
+        static uint64_t pack(uint64_t tag, uint32_t begin, uint32_t end);
+
+        void workerLoop(size_t self);
+        // runs chunks until no share has work left
+        void participate(size_t self);
+        bool takeOwn(size_t self, uint32_t &begin, uint32_t &end);
+        bool steal(size_t self, uint32_t &begin, uint32_t &end);
+
+        std::unique_ptr<Share[]> m_shares;
+        size_t m_threadCount;
+        std::vector<std::thread> m_workers;
+
+        // atomics because a late participant may still read them while the next job is set up
+        std::atomic<const RangeFunction *> m_body{nullptr};
+        std::atomic<uint32_t> m_grain{1};
+        uint64_t m_tag = 0; // dispatching thread only
+        std::atomic<size_t> m_remaining{0};
+
+        std::mutex m_mutex;
+        std::condition_variable m_cv;
+        std::atomic<uint64_t> m_generation{0};
+        std::atomic<bool> m_stop{false};
+    };
+} // namespace Bess::SimEngine
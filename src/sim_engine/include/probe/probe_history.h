@@ -0,0 +1,111 @@
+#pragma once
+
+#include "bess_api.h"
+#include "types.h"
+#include <cstdint>
+#include <deque>
+#include <vector>
+
+namespace Bess::SimEngine {
+
+    struct BESS_API ProbeTransition {
+        SimTime time{0};
+        LogicState state = LogicState::unknown;
+    };
+
+    // what a signal did inside [begin, end) of a query, one per pixel column of a plot
+    struct BESS_API ProbeBucket {
+        LogicState first = LogicState::unknown; // state entering the bucket
+        LogicState last = LogicState::unknown;  // state leaving it
+        uint8_t stateMask = 0;                  // bit (1 << state) for every state held inside
+        uint32_t transitions = 0;
+    };
+
+    /**
+     * Recorded transitions of one slot, bounded by a memory limit.
+     * Only changes of state are kept, so every entry is the start of a run. Runs are
+     * delta encoded into chunks of up to chunkTransitions entries, each one a varint of
+     * (nanoseconds since the previous run << 2 | state). The limit is checked whenever a
+     * chunk closes, the oldest chunks are dropped then, so the open chunk can go past it.
+     * Every chunk has a summary (transition count, states held, last state) and the summaries
+     * form a pyramid with pyramidFanout children per node, so a query merges fully covered
+     * chunk ranges in O(log chunks) and only decodes the chunks at bucket edges.
+     **/
+    class BESS_API ProbeHistory {
+      public:
+        static constexpr uint64_t defaultMemoryLimit = uint64_t{16} << 20;
+        static constexpr uint32_t chunkTransitions = 4096;
+        static constexpr size_t pyramidFanout = 8;
+
+        explicit ProbeHistory(uint64_t memoryLimitBytes = defaultMemoryLimit);
+
+        // repeated states are ignored, an earlier time than the last one starts a new recording
+        void append(SimTime time, LogicState state);
+        void clear();
+
+        /**
+         * Splits [from, to) into out.size() equal buckets, out must not be empty.
+         * Before the first retained transition the state is LogicState::unknown.
+         **/
+        void query(SimTime from, SimTime to, std::vector<ProbeBucket> &out) const;
+
+        // state in effect at time, LogicState::unknown before the first retained transition
+        LogicState stateAt(SimTime time) const;
+
+        // up to count of the newest transitions, oldest first
+        std::vector<ProbeTransition> getRecent(size_t count) const;
+
+        bool empty() const;
+        uint64_t getTransitionCount() const;
+        uint64_t getDroppedCount() const;
+        SimTime getBeginTime() const;
+        SimTime getEndTime() const;
+        LogicState getLastState() const;
+
+        uint64_t getMemoryLimit() const;
+        void setMemoryLimit(uint64_t bytes);
+        uint64_t getMemoryUsage() const;
+
+      private:
+        struct Summary {
+            uint32_t transitions = 0;
+            uint8_t stateMask = 0;
+            LogicState last = LogicState::unknown;
+
+            void merge(const Summary &other);
+        };
+
+        struct Chunk {
+            SimTime begin{0}, end{0};
+            std::vector<uint8_t> bytes;
+            Summary summary;
+        };
+
+        void closeChunk();
+        void enforceLimit();
+        void rebuildPyramid();
+        void pushSummary(size_t chunk);
+
+        // merged summary of chunks [a, b)
+        Summary mergeChunks(size_t a, size_t b) const;
+        // decodes chunk into the cache, at most one chunk is kept decoded
+        void decode(size_t chunk) const;
+
+        uint64_t m_memoryLimit;
+        uint64_t m_closedBytes = 0;
+        uint64_t m_transitions = 0;
+        uint64_t m_dropped = 0;
+        SimTime m_lastTime{0};
+
+        std::deque<Chunk> m_chunks; // the back one is open
+        // [0] summarizes the closed chunks, [l + 1][i] merges [l][fanout * i, fanout * (i + 1))
+        std::vector<std::vector<Summary>> m_pyramid;
+
+        // identified by m_droppedChunks + index, so drops invalidate it
+        mutable uint64_t m_decodedChunk = UINT64_MAX;
+        mutable uint32_t m_decodedCount = 0;
+        mutable std::vector<SimTime> m_decodedTimes;
+        mutable std::vector<LogicState> m_decodedStates;
+        uint64_t m_droppedChunks = 0;
+    };
+} // namespace Bess::SimEngine
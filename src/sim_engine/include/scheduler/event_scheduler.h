@@ -0,0 +1,69 @@
+#pragma once
+
+#include "bess_api.h"
+#include "types.h"
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <set>
+#include <vector>
+
+namespace Bess::SimEngine {
+
+    enum class EventSchedulerType : uint8_t {
+        orderedSet,
+        timingWheel,
+    };
+
+    // Pending event queue of the simulation engine.
+    // Implementations must hand out events in SimulationEvent order,
+    // i.e. by simTime and then by id, so that every scheduler produces
+    // identical simulation results.
+    class BESS_API EventScheduler {
+      public:
+        virtual ~EventScheduler() = default;
+
+        static std::unique_ptr<EventScheduler> create(EventSchedulerType type);
+
+        virtual EventSchedulerType getType() const = 0;
+
+        virtual void push(const SimulationEvent &event) = 0;
+
+        // Earliest pending event, scheduler must not be empty.
+        virtual const SimulationEvent &top() const = 0;
+
+        // Removes the earliest pending event, scheduler must not be empty.
+        virtual void pop() = 0;
+
+        virtual bool empty() const = 0;
+
+        virtual size_t size() const = 0;
+
+        virtual void clear() = 0;
+
+        // Removes every event matching the predicate, returns the removed count.
+        virtual size_t eraseIf(const std::function<bool(const SimulationEvent &)> &pred) = 0;
+
+        // Appends every pending event to out, in no particular order.
+        virtual void collect(std::vector<SimulationEvent> &out) const = 0;
+    };
+
+    // Balanced tree backed scheduler, O(log n) for every operation.
+    class BESS_API OrderedSetScheduler : public EventScheduler {
+      public:
+        EventSchedulerType getType() const override;
+
+        void push(const SimulationEvent &event) override;
+        const SimulationEvent &top() const override;
+        void pop() override;
+        bool empty() const override;
+        size_t size() const override;
+        void clear() override;
+        size_t eraseIf(const std::function<bool(const SimulationEvent &)> &pred) override;
+        void collect(std::vector<SimulationEvent> &out) const override;
+
+      private:
+        std::set<SimulationEvent> m_events;
+    };
+} // namespace Bess::SimEngine
@@ -0,0 +1,74 @@
+#pragma once
+
+#include "scheduler/event_scheduler.h"
+#include <cstdint>
+#include <vector>
+
+namespace Bess::SimEngine {
+
+    /**
+     * Hierarchy-free timing wheel with an overflow heap.
+     *
+     * The wheel covers a window of `slotCount` nanoseconds starting at the
+     * time of the earliest pending event. Every slot therefore holds events of
+     * a single timestamp, kept in id order, which makes push and pop O(1) for
+     * the short gate delays that dominate digital circuits.
+     * Events outside the window (clocks, long delays or events in the past)
+     * go to a binary heap and migrate into the wheel once the window reaches them.
+     **/
+    class BESS_API TimingWheelScheduler : public EventScheduler {
+      public:
+        static constexpr size_t defaultSlotCount = 4096;
+
+        // slotCount is rounded up to a power of two, minimum 64
+        explicit TimingWheelScheduler(size_t slotCount = defaultSlotCount);
+
+        EventSchedulerType getType() const override;
+
+        void push(const SimulationEvent &event) override;
+        const SimulationEvent &top() const override;
+        void pop() override;
+        bool empty() const override;
+        size_t size() const override;
+        void clear() override;
+        size_t eraseIf(const std::function<bool(const SimulationEvent &)> &pred) override;
+        void collect(std::vector<SimulationEvent> &out) const override;
+
+        size_t getSlotCount() const;
+        size_t getOverflowCount() const;
+
+      private:
+        struct Slot {
+            std::vector<SimulationEvent> events;
+            size_t head = 0;
+
+            bool empty() const { return head == events.size(); }
+        };
+
+        bool isInWindow(int64_t t) const;
+        size_t slotIndexOf(int64_t t) const;
+
+        void insertIntoWheel(const SimulationEvent &event);
+        void pushOverflow(const SimulationEvent &event);
+        void popOverflow();
+
+        // Moves overflow events that now fall inside the window into the wheel.
+        void migrateOverflow();
+
+        // Index of the first occupied slot starting from the window base, -1 if none.
+        int64_t findFirstSlot() const;
+
+        void setSlotOccupied(size_t idx, bool occupied);
+
+        std::vector<Slot> m_slots;
+        std::vector<uint64_t> m_occupied;
+        std::vector<SimulationEvent> m_overflow;
+
+        size_t m_mask = 0;
+        int64_t m_base = 0;
+        size_t m_wheelCount = 0;
+
+        // cached result of findFirstSlot, -2 when stale
+        mutable int64_t m_cachedSlot = -2;
+    };
+} // namespace Bess::SimEngine
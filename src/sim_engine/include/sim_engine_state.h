@@ -3,6 +3,8 @@
 #include "common/bess_uuid.h"
 #include "digital_component.h"
 #include "net/net.h"
+#include <atomic>
+#include <cstdint>
 #include <memory>
 #include <unordered_map>
 
@@ -35,10 +37,27 @@ namespace Bess::SimEngine {
 
         void clearNets();
 
+        // Bumped on every structural change (components or connections),
+        // used to know when derived structures like the compiled netlist are stale.
+        uint64_t getTopologyVersion() const;
+        void markTopologyChanged();
+
       private:
         std::unordered_map<UUID, std::shared_ptr<DigitalComponent>> m_digitalComponents;
         std::unordered_map<UUID, Net> m_nets;
+        std::atomic<uint64_t> m_topologyVersion{1};
     };
+
+    // Definition of a component as stored in projects, with the aux data of Verilog imports.
+    void definitionToJson(const std::shared_ptr<ComponentDefinition> &definition, Json::Value &j);
+
+    // Binds a definition read back from its JSON j to its simulation function, the catalog's
+    // one unless it is a module. nullptr if its base definition is not registered.
+    std::shared_ptr<ComponentDefinition> bindStoredDefinition(const std::shared_ptr<ComponentDefinition> &stored,
+                                                              const Json::Value &j);
+
+    // Rebuilds a definition stored by definitionToJson, see bindStoredDefinition.
+    std::shared_ptr<ComponentDefinition> definitionFromJson(const Json::Value &j);
 } // namespace Bess::SimEngine
 
 namespace Bess::JsonConvert {
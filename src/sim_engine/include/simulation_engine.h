@@ -1,27 +1,66 @@
 #pragma once
 
 #include "bess_api.h"
+#include "checkpoint/sim_checkpoint.h"
 #include "common/bess_uuid.h"
 #include "digital_component.h"
+#include "history/sim_history.h"
+#include "native/native_model.h"
 #include "net/net.h"
+#include "net/net_tracker.h"
+#include "netlist/compiled_netlist.h"
+#include "netlist/cycle_schedule.h"
+#include "parallel/work_stealing_pool.h"
+#include "scheduler/event_scheduler.h"
 #include "sim_engine_state.h"
+#include "snapshot/slot_state_snapshot.h"
+#include "state_change/state_change_log.h"
+#include "trace/trace_recorder.h"
+#include "truth_table/truth_table.h"
 #include "types.h"
 #include <chrono>
 #include <condition_variable>
 #include <cstdint>
+#include <functional>
 #include <memory>
 #include <mutex>
-#include <set>
+#include <optional>
+#include <shared_mutex>
+#include <span>
+#include <string>
 #include <thread>
+#include <unordered_set>
 
 namespace Bess::SimEngine {
     class ComponentDefinition;
 
+    // Event loop counters since the last clear().
+    struct BESS_API SimEventStats {
+        uint64_t scheduled = 0; // events pushed to the scheduler
+        uint64_t coalesced = 0; // dropped at insertion, the component already had an event at that time
+        uint64_t processed = 0; // events popped from the scheduler
+        uint64_t evaluated = 0; // component evaluations, duplicates within a batch run once
+    };
+
+    // Cycle based mode of the netlist last simulated, counters since the last clear().
+    struct BESS_API SimCycleStats {
+        bool active = false;        // the netlist runs cycle based
+        std::string fallbackReason; // why it stays event driven in cycle based mode
+        size_t clockDomains = 0;
+        size_t registers = 0;
+        size_t combinational = 0;
+        uint32_t depth = 0;  // longest chain of combinational components
+        uint64_t cycles = 0; // rising clock edges, summed over the clock domains
+        uint64_t sweeps = 0; // timesteps simulated cycle based
+        bool native = false;              // the logic runs in the compiled model
+        std::string nativeFallbackReason; // why native mode sweeps the logic interpreted
+    };
+
     class BESS_API SimulationEngine {
       public:
         static SimulationEngine &instance();
 
-        SimulationEngine();
+        explicit SimulationEngine(EventSchedulerType schedulerType = EventSchedulerType::timingWheel);
         ~SimulationEngine();
 
         void destroy();
@@ -48,6 +87,8 @@ namespace Bess::SimEngine {
 
         void setInputSlotState(const UUID &uuid, int pinIdx, LogicState state);
         void setOutputSlotState(const UUID &uuid, int pinIdx, LogicState state);
+        // drives a bus slot with value, bits past the slot width are dropped
+        void setOutputSlotWord(const UUID &uuid, int pinIdx, uint64_t value);
         void invertInputSlotState(const UUID &uuid, int pinIdx);
 
         SimTime getSimulationTime() const;
@@ -61,6 +102,34 @@ namespace Bess::SimEngine {
         // only steps if sim state is paused
         void stepSimulation();
 
+        SimulationPacing getPacing() const;
+        void setPacing(SimulationPacing pacing);
+
+        // simulated time per wall clock time in scaled pacing, 2 runs twice as fast as real time
+        double getTimeScale() const;
+        void setTimeScale(double scale);
+
+        // Event driven by default. Cycle based evaluates fully synchronous netlists as one sweep
+        // per clock edge without delays, netlists that need the event queue, see CycleSchedule,
+        // keep running event driven and getCycleStats tells why.
+        SimulationMode getSimulationMode() const;
+        void setSimulationMode(SimulationMode mode);
+        SimCycleStats getCycleStats() const;
+
+        // Native mode compiles the logic in the background and sweeps it interpreted until
+        // the model is loaded. Waits for the model the sim thread started building for the
+        // current netlist, false if none was started, it failed or the timeout passed.
+        bool waitForNativeModel(std::chrono::milliseconds timeout);
+        void setNativeModelConfig(const NativeModelConfig &config);
+
+        // Resumes the simulation until every event at or before `time` is simulated,
+        // then pauses with the simulation time at `time`.
+        // requestRunUntil returns at once, runUntil blocks until the time is reached and
+        // returns false if the engine was destroyed first.
+        void requestRunUntil(SimTime time);
+        bool runUntil(SimTime time);
+        bool isRunningUntil() const;
+
         const ComponentState &getComponentState(const UUID &uuid);
         const std::shared_ptr<ComponentDefinition> &getComponentDefinition(const UUID &uuid) const;
         std::shared_ptr<DigitalComponent> getDigitalComponent(const UUID &uuid) const;
@@ -71,33 +140,210 @@ namespace Bess::SimEngine {
 
         std::vector<std::pair<float, bool>> getStateMonitorData(UUID uuid);
 
-        bool updateNets(const std::vector<UUID> &startCompIds);
-
         friend class SimEngineSerializer;
 
+        // true while nets changed since the last getNetsMap that reset the flag
         bool isNetUpdated() const;
 
-        // if update is false, the sync flag will not be reset
+        // Syncs the nets and the netUuid of the components whose net changed.
+        // If update is false, the sync flag will not be reset.
         const std::unordered_map<UUID, Net> &getNetsMap(bool update = true);
 
-        TruthTable getTruthTableOfNet(const UUID &netUuid);
+        // Net of a component without syncing the others, UUID::null for unknown components.
+        UUID getNetOf(const UUID &compId);
+
+        // Derives the nets from the connections, after the components were replaced.
+        void rebuildNets();
+
+        // Purely combinational nets are evaluated 64 rows per word without touching the
+        // simulation, other nets drive every input combination through the event loop.
+        TruthTable getTruthTableOfNet(const UUID &netUuid, const TruthTableOptions &options = {});
 
+        // Stable when no evaluation is in flight and only free running events, such as
+        // clock edges, are pending.
         bool isSimStable();
 
+        // Blocks until the simulation is stable, false on timeout. Does not resume a paused
+        // simulation, see runUntilStable.
+        bool waitUntilStable(std::chrono::milliseconds timeout);
+
+        // Simulates pending events without pacing, also while paused, until the simulation
+        // is stable. The simulation state is left as it was. False on timeout, e.g. for
+        // circuits that oscillate.
+        bool runUntilStable(std::chrono::milliseconds timeout = std::chrono::seconds(1));
+
+        // incremented every time the simulation becomes stable
+        uint64_t getStableGeneration() const;
+
         const SimEngineState &getSimEngineState() const;
         SimEngineState &getSimEngineState();
 
+        EventSchedulerType getEventSchedulerType() const;
+
+        SimEventStats getEventStats() const;
+
+        // Slot states published by the sim thread, at most every snapshotPublishInterval
+        // while simulating and whenever it goes idle. Only one thread, the UI, may read them:
+        // acquireSlotSnapshot picks up the newest one and it stays valid until the next
+        // acquire, getSlotSnapshot returns it again without touching the atomics.
+        const SlotStateSnapshot &acquireSlotSnapshot();
+        const SlotStateSnapshot &getSlotSnapshot() const;
+
+        // Slot changes of a component are logged by whichever thread makes them and delivered
+        // on the thread calling dispatchStateChanges, the UI once per frame, so listeners never
+        // run inside the simulation loop. Coalesced listeners get the last change of every slot
+        // since the previous dispatch, the others every transition in order.
+        // Listeners are managed and dispatched from that one thread, never from inside a listener.
+        void addStateChangeListener(const UUID &listenerId, const UUID &component,
+                                    const TOnSlotChangeCB &cb, bool everyTransition = false);
+        void removeStateChangeListener(const UUID &listenerId, const UUID &component);
+        // returns the number of changes drained from the log
+        size_t dispatchStateChanges();
+        // changes lost because the log was full
+        uint64_t getDroppedStateChanges() const;
+
+        // Streams the given slots to path until stopTrace(), replacing a running trace.
+        // Changes are written on a background thread, false if path can not be opened.
+        bool startTrace(const std::filesystem::path &path, const std::vector<TraceSignal> &signals,
+                        TraceFormat format = TraceFormat::vcd);
+        void stopTrace();
+        bool isTracing() const;
+
+        // Binary image of the whole simulation, including the pending events and the simulation
+        // time, to skip long initialization sequences. Both pause the simulation and wait for
+        // the timestep in flight, not to be used during runUntil or runUntilStable.
+        // Restoring replaces every component, listeners of components that are restored keep
+        // their registration. Failures throw std::runtime_error and leave the engine as it was
+        // when the checkpoint could not be read.
+        void saveCheckpoint(std::ostream &out);
+        void saveCheckpoint(const std::filesystem::path &path);
+        void restoreCheckpoint(std::istream &in);
+        void restoreCheckpoint(const std::filesystem::path &path);
+
+        // Time travel, off by default. While enabled every timestep keeps what it overwrote, the
+        // oldest ones are dropped past memoryBudget bytes, so the simulation can be taken back
+        // to a recent timestep and resumed from there with setSimulationState or stepSimulation.
+        // Going back pauses the simulation, waits for the timestep in flight and stops a running
+        // trace, the discarded timesteps are simulated again when resuming. Changing the
+        // topology starts the history over. Not to be used during runUntil or runUntilStable.
+        void enableHistory(uint64_t memoryBudget = SimHistory::defaultMemoryBudget);
+        void disableHistory();
+        bool isHistoryEnabled() const;
+        SimHistoryStats getHistoryStats() const;
+        // back to the timestep before the newest one, false if there is none
+        bool stepBack();
+        // back to the state at time, at most the simulation time, false if the history is shorter
+        bool rewindTo(SimTime time);
+        // rewinds to earlier times and runs until later ones
+        bool scrubTo(SimTime time);
+
+        // 1 evaluates everything on the sim thread. More threads evaluate wide timesteps
+        // of parallel safe components on a work stealing pool, with identical results.
+        void setWorkerThreadCount(size_t count);
+        size_t getWorkerThreadCount() const;
+
       private:
         bool isSimStableLocked() const;
 
-        std::vector<UUID> getConnGraph(UUID start);
+        // Pauses the simulation and waits until no timestep is being simulated.
+        void pauseBetweenTimesteps();
 
-        void scheduleEvent(UUID id, UUID schedulerId, SimDelayNanoSeconds simTime);
+        // Takes the simulation back to the newest timestep at or before time, without a time
+        // to the one before the newest.
+        bool rewindHistory(std::optional<SimTime> time);
+        // Closes the history position of the simulated batch, registry and history locks must be held.
+        void closeHistoryTimestep();
+        // Keeps a slot's value before a write from outside the event loop.
+        void recordSlotWrite(const DigitalComponent &comp, SlotType type, int slot);
+        // Writes an output slot from outside the event loop, makeState gets the slot width.
+        // The compiled netlist picks the value up at the start of the next timestep.
+        void writeOutputSlot(const char *caller, const UUID &uuid, int pinIdx,
+                             const std::function<SlotState(int)> &makeState);
+
+        const std::unordered_map<UUID, Net> &syncNets();
+
+        void scheduleEvent(UUID id, UUID schedulerId, SimDelayNanoSeconds simTime, bool freeRunning = false);
         void clearEventsForEntity(const UUID &id);
-        bool simulateComponent(const UUID &compId, const std::vector<SlotState> &inputs);
+        enum class EvalOutcome : uint8_t {
+            unchanged,
+            changed,
+            failed,
+            deferred, // not evaluated on the pool, simulated in the merge loop
+        };
+
+        bool simulateComponent(CompIndex idx, std::span<const SlotState> inputs);
+        // Only reads the component, safe to run concurrently for different components.
+        EvalOutcome evaluateInPlace(CompIndex idx, std::span<const SlotState> inputs,
+                                    std::span<SlotState> outputs, std::string &error) const;
+        bool applyEvaluation(CompIndex idx, std::span<const SlotState> inputs, EvalOutcome outcome,
+                             std::span<const SlotState> outputs, const std::string &error);
+        bool commitStateChange(CompIndex idx);
+        void logStateChange(const DigitalComponent &comp, const ComponentState &oldState,
+                            const ComponentState &newState);
+        // inputs that differ from the component's current ones, before they are stored
+        void logInputChanges(const DigitalComponent &comp, std::span<const SlotState> inputs);
+        void logInputChanges(const DigitalComponent &comp, std::span<const SlotState> inputs,
+                             std::span<const SlotState> previous);
+        // has state change listeners or traced slots
+        bool isObserved(const DigitalComponent &comp) const;
+        void emitSlotChange(const DigitalComponent &comp, const SlotChange &change);
+        static void markSimError(DigitalComponent &comp, const std::string &message);
+        void evaluateBatchInParallel();
+        void evaluateRange(size_t begin, size_t end);
         void scheduleDependantsOf(const UUID &compId);
+        void scheduleDependantsOf(CompIndex idx);
         void run();
 
+        // Pops the next batch of same-time events into m_batchEvents, queue lock must be held.
+        void collectBatch();
+
+        // Wall clock time at which an event at `simTime` is due under the current pacing,
+        // queue lock must be held.
+        std::chrono::steady_clock::time_point pacedWallTime(SimTime simTime);
+
+        // Simulates one batch of same-time events, registry lock must be held.
+        void simulateBatch(const std::vector<SimulationEvent> &events);
+
+        // Builds or drops the cycle schedule of the compiled netlist to match the simulation
+        // mode, registry lock must be held.
+        void ensureCycleSchedule();
+        // Simulates a batch along the cycle schedule: the sources of the batch, then the
+        // registers they clock, then the logic behind them in order. Registry lock must be held.
+        void simulateCycle(const std::vector<SimulationEvent> &events);
+        bool simulateInCycle(CompIndex idx);
+        // queues what idx drives for the rest of the sweep, registers before the logic
+        // only while their clock edge is being collected
+        void markCycleDependants(CompIndex idx, bool clockEdge);
+        // Starts, adopts or drops the native model of the cycle schedule, registry lock must be held.
+        void ensureNativeModel();
+        // what the build slot waits for, 0 for nothing, results of other versions are dropped;
+        // source replaces a request the builder has not picked up yet
+        void requestNativeBuild(uint64_t version, std::optional<NativeModelSource> source = std::nullopt);
+        // m_nativeBuilder, compiles the latest request until destroy() stops it
+        void nativeBuildLoop();
+        // the cycle sweep through the native model, marks and writes back what it changed
+        void sweepNative();
+        void writeBackNative(CompIndex idx);
+
+        // Asks the sim thread to publish the slot states, also while paused.
+        void requestSlotSnapshot();
+        bool needsSlotSnapshot() const;
+        // Takes the registry lock, sim thread only.
+        void publishSlotSnapshot();
+        // Registry lock must be held, sim thread only.
+        void publishSlotSnapshotLocked();
+        void rebuildSnapshotLayout();
+        // false if a component was resized since the layout was built
+        bool fillSlotSnapshot(SlotStateSnapshot &snapshot, uint64_t epoch);
+
+        bool isNetlistFresh() const;
+        // Recompiles the netlist if the topology changed, registry lock must be held.
+        void ensureNetlistCompiled();
+        // copies outputs written by writeOutputSlot into the netlist, sim thread only
+        void applyExternalOutputWrites();
+        // until they are applied the netlist outputs of those components are stale
+        bool hasExternalOutputWrites() const;
+
         std::thread m_simThread;
 
         mutable std::mutex m_queueMutex;
@@ -110,17 +356,153 @@ namespace Bess::SimEngine {
         std::condition_variable m_queueCV;
         std::condition_variable m_stateCV;
 
-        std::set<SimulationEvent> m_eventSet;
+        std::unique_ptr<EventScheduler> m_eventScheduler;
+        std::vector<SimulationEvent> m_batchEvents;
         uint64_t m_nextEventId{0};
         SimTime m_currentSimTime;
 
         SimEngineState m_simEngineState;
 
-        std::unordered_map<UUID, Net> m_nets;
+        // compiled only by the sim thread, other readers take a shared lock
+        CompiledNetlist m_netlist;
+        mutable std::shared_mutex m_netlistMutex;
+        std::vector<CompIndex> m_batchComps;
+        std::vector<SlotState> m_batchInputs;
+        std::vector<uint32_t> m_batchInputBegin; // per batch component, size + 1
+        std::vector<uint64_t> m_batchMarks;
+        uint64_t m_batchCounter{0};
+
+        // cycle based mode, built and used by the sim thread under the registry lock
+        std::atomic<SimulationMode> m_simulationMode{SimulationMode::eventDriven};
+        CycleSchedule m_cycleSchedule;
+        static constexpr uint8_t cycleClocked = 1;
+        static constexpr uint8_t cycleRefresh = 2;
+        std::vector<uint8_t> m_cycleQueued;    // per component, cycleClocked | cycleRefresh
+        std::vector<CompIndex> m_cycleClocked; // registers evaluated before the sweep
+        std::vector<CompIndex> m_cycleRefresh; // registers with new inputs after it
+        std::vector<uint64_t> m_cycleDirty;    // bit per combinational rank
+        std::vector<SlotState> m_cycleInputs;
+        std::vector<LogicState> m_cycleClockLevels; // per clock domain
+        uint64_t m_cycleCount{0};
+        uint64_t m_cycleSweeps{0};
+
+        // native mode, the model is compiled on m_nativeBuilder and adopted at the next timestep
+        NativeModelConfig m_nativeConfig;
+        std::shared_ptr<NativeModel> m_nativeModel;
+        // one request slot shared with the builder, a newer version overwrites a waiting source
+        // so superseded netlists are never compiled
+        struct NativeBuild {
+            std::mutex mutex;
+            std::condition_variable requested; // source set or stop
+            std::condition_variable finished;
+            uint64_t version = 0; // see requestNativeBuild
+            std::optional<NativeModelSource> source;
+            NativeModelConfig config;
+            bool done = false;
+            bool stop = false;
+            std::shared_ptr<NativeModel> model;
+            std::string error;
+        };
+        NativeBuild m_nativeBuild;
+        std::thread m_nativeBuilder;
+        bool m_nativeBuildPending{false}; // a build was started and its result is not adopted yet
+        uint64_t m_nativeVersion{0}; // netlist version of the model, pending or failed build
+        std::string m_nativeFallbackReason;
+        std::vector<uint8_t> m_nativeNets;
+        std::vector<uint32_t> m_nativeChanged;
+        std::vector<CompIndex> m_nativeDrivers; // sources and registers, copied into the nets
+
+        // used by collectBatch, components already in the batch or driven by one of them
+        std::vector<SimulationEvent> m_runEvents;
+        std::vector<uint64_t> m_collectMarks;
+        uint64_t m_collectStamp{0};
+
+        // per component index, time of an event known to be pending for it,
+        // a second event at the same time is coalesced into that one
+        static constexpr SimTime notScheduled = SimTime::min();
+        std::vector<SimTime> m_scheduledAt;
+        SimEventStats m_eventStats; // guarded by m_queueMutex
+        // components with outputs written outside the event loop, guarded by m_queueMutex
+        std::vector<UUID> m_externalOutputWrites;
+        std::vector<UUID> m_appliedOutputWrites; // sim thread only
+
+        // pacing, guarded by m_queueMutex. Deadlines are measured from an anchor so waits
+        // woken early and the time spent simulating do not add up to drift.
+        static constexpr std::chrono::milliseconds maxPacingLag{10};
+        SimulationPacing m_pacing = SimulationPacing::realTime;
+        double m_timeScale = 1.0;
+        bool m_paceAnchorValid = false;
+        std::chrono::steady_clock::time_point m_paceWallAnchor;
+        SimTime m_paceSimAnchor{0};
+        bool m_runUntilActive = false;
+        SimTime m_runUntilTime{0};
+
+        // quiescence, guarded by m_queueMutex. m_settleActive is also read by the sim loop
+        // while it waits for the paused state to change.
+        uint64_t m_pendingEvents{0}; // scheduled events that are not free running
+        uint64_t m_stableGeneration{0};
+        std::atomic<bool> m_settleActive{false};
+
+        // parallel evaluation, outputs of batch component i start at m_batchOutputBegin[i]
+        static constexpr size_t minParallelBatchSize = 128;
+        static constexpr size_t parallelGrainSize = 32;
+        std::unique_ptr<WorkStealingPool> m_workerPool;
+        WorkStealingPool::RangeFunction m_evaluateRange;
+        std::vector<SlotState> m_batchOutputs;
+        std::vector<uint32_t> m_batchOutputBegin;
+        std::vector<EvalOutcome> m_batchOutcomes;
+        std::vector<std::string> m_batchErrors;
+
+        // reused by simulateComponent so steady state evaluation does not allocate
+        std::string m_scratchError;
+        std::vector<SlotState> m_scratchOutputs;
+        ComponentState m_scratchState;
+        ComponentState m_prevStateScratch;
+
+        // slot state snapshots, everything but the buffer's reader side belongs to the sim thread
+        static constexpr std::chrono::milliseconds snapshotPublishInterval{4};
+        SlotSnapshotBuffer m_slotSnapshots;
+        std::shared_ptr<const SlotSnapshotLayout> m_snapshotLayout;
+        std::vector<DigitalComponent *> m_snapshotComponents; // in layout order
+        uint64_t m_snapshotTopologyVersion{0};
+        uint64_t m_snapshotLayoutId{0};
+        uint64_t m_snapshotEpoch{0};
+        bool m_snapshotStale{false}; // simulated since the last publish
+        std::chrono::steady_clock::time_point m_lastSnapshotPublish;
+        std::atomic<bool> m_snapshotRequested{true};
+
+        struct StateChangeListener {
+            UUID id;
+            TOnSlotChangeCB cb;
+            bool everyTransition = false;
+        };
+        StateChangeLog m_stateChangeLog;
+        // dispatching thread only
+        std::unordered_map<UUID, std::vector<StateChangeListener>> m_stateChangeListeners;
+        std::vector<SlotChange> m_drainedChanges;
+        std::vector<uint8_t> m_changeIsLast; // per drained change, no later change of the same slot
+        std::unordered_set<SlotKey, SlotKeyHash> m_seenSlots; // keeps its buckets between dispatches
+        uint64_t m_reportedDroppedChanges{0};
+
+        // guarded by m_registryMutex like the components it marks as traced
+        std::unique_ptr<TraceRecorder> m_traceRecorder;
+
+        // Time travel. Written by the sim thread while it holds the registry and history locks,
+        // recursive because definitions may set slots from inside a timestep.
+        // m_historyEnabled only changes under both locks, so either one is enough to read it.
+        mutable std::recursive_mutex m_historyMutex;
+        SimHistory m_history;
+        bool m_historyEnabled{false};
+        SimHistoryRewind m_historyRewind;
+        std::vector<SimulationEvent> m_historyEvents;
+
+        // guarded by m_registryMutex, edited with the connections
+        NetTracker m_netTracker;
+        uint64_t m_reportedNetGeneration{0};
+        std::vector<UUID> m_changedNets;
 
         bool m_destroyed{false};
 
-        bool m_isNetUpdated{false};
         bool m_isSimulating{false};
     };
 } // namespace Bess::SimEngine
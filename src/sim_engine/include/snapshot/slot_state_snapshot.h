@@ -0,0 +1,106 @@
+#pragma once
+
+#include "bess_api.h"
+#include "common/bess_uuid.h"
+#include "types.h"
+#include <atomic>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+namespace Bess::SimEngine {
+    constexpr uint32_t invalidSnapshotSlot = std::numeric_limits<uint32_t>::max();
+
+    /**
+     * Slot numbering shared by every snapshot taken while the components and their slot
+     * counts stay the same. Input slots of all components come first, then all output slots,
+     * components in UUID order. Immutable once published.
+     **/
+    class BESS_API SlotSnapshotLayout {
+      public:
+        SlotSnapshotLayout() = default;
+        // counts: input and output slot count of every component, in the order of uuids
+        SlotSnapshotLayout(uint64_t id, std::vector<UUID> uuids,
+                           const std::vector<std::pair<uint32_t, uint32_t>> &counts);
+
+        // changes whenever the numbering does, cached slot indices are valid while it matches
+        uint64_t getId() const;
+        uint32_t getSlotCount() const;
+        uint32_t getComponentCount() const;
+
+        const UUID &uuidOf(uint32_t component) const;
+        uint32_t getInputBegin(uint32_t component) const;
+        uint32_t getInputCount(uint32_t component) const;
+        uint32_t getOutputBegin(uint32_t component) const;
+        uint32_t getOutputCount(uint32_t component) const;
+
+        // invalidSnapshotSlot if the component or slot is not part of the layout
+        uint32_t slotIndexOf(const UUID &uuid, SlotType type, int idx) const;
+
+      private:
+        uint64_t m_id = 0;
+        std::vector<UUID> m_uuids;
+        std::unordered_map<UUID, uint32_t> m_indexMap;
+        std::vector<uint32_t> m_inputBegin;  // size n + 1
+        std::vector<uint32_t> m_outputBegin; // size n + 1, offset by the input slot count
+    };
+
+    /**
+     * Logic state and connected flag of every slot at one point of the simulation.
+     * States are packed 2 bits per slot, connected flags 1 bit per slot.
+     **/
+    class BESS_API SlotStateSnapshot {
+      public:
+        // incremented on every publish, 0 until the first one
+        uint64_t getEpoch() const;
+        SimTime getSimTime() const;
+
+        // never null after the first publish
+        const std::shared_ptr<const SlotSnapshotLayout> &getLayout() const;
+        uint64_t getLayoutId() const;
+
+        // invalidSnapshotSlot reads as unknown and not connected
+        LogicState getState(uint32_t slot) const;
+        bool isConnected(uint32_t slot) const;
+
+        // writer side, sizes the packed arrays for the layout and clears them
+        void reset(const std::shared_ptr<const SlotSnapshotLayout> &layout, uint64_t epoch, SimTime simTime);
+        void setSlot(uint32_t slot, LogicState state, bool connected);
+
+      private:
+        uint64_t m_epoch = 0;
+        SimTime m_simTime{0};
+        std::shared_ptr<const SlotSnapshotLayout> m_layout;
+        std::vector<uint64_t> m_states;    // 32 slots per word
+        std::vector<uint64_t> m_connected; // 64 slots per word
+    };
+
+    /**
+     * Hands snapshots from one writer to one reader without locks.
+     * Three buffers rotate: the writer fills the back one and swaps it with the middle
+     * one, the reader swaps the middle one with its front one when a newer snapshot is
+     * waiting. Neither side ever touches the buffer the other one owns, so the reader
+     * may keep using its snapshot until its next acquire().
+     **/
+    class BESS_API SlotSnapshotBuffer {
+      public:
+        // writer only
+        SlotStateSnapshot &back();
+        void publish();
+
+        // reader only, one atomic load when nothing new was published
+        const SlotStateSnapshot &acquire();
+        // reader only, the snapshot returned by the last acquire()
+        const SlotStateSnapshot &front() const;
+
+      private:
+        static constexpr uint8_t freshFlag = 0x4;
+
+        SlotStateSnapshot m_buffers[3];
+        uint8_t m_back = 0;
+        uint8_t m_front = 1;
+        std::atomic<uint8_t> m_middle{2}; // buffer index, with freshFlag once published
+    };
+} // namespace Bess::SimEngine
@@ -0,0 +1,80 @@
+#pragma once
+
+#include "bess_api.h"
+#include "common/bess_uuid.h"
+#include "types.h"
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <vector>
+
+namespace Bess::SimEngine {
+    struct BESS_API SlotChange {
+        UUID component = UUID::null;
+        SlotType type = SlotType::digitalOutput;
+        uint32_t slot = 0;
+        LogicState state = LogicState::low;
+        SimTime time{0}; // lastChangeTime of the slot
+        uint64_t value = 0; // bits of a bus slot, see SlotState::value
+    };
+
+    typedef std::function<void(const SlotChange &)> TOnSlotChangeCB;
+
+    // identifies one slot of a component, e.g. to group or filter slot changes
+    struct BESS_API SlotKey {
+        UUID component = UUID::null;
+        uint64_t slot = 0; // slot index << 1 | SlotType
+
+        SlotKey() = default;
+        SlotKey(const UUID &component, SlotType type, uint32_t slot)
+            : component(component), slot((uint64_t{slot} << 1) | static_cast<uint64_t>(type)) {}
+        explicit SlotKey(const SlotChange &change) : SlotKey(change.component, change.type, change.slot) {}
+
+        bool operator==(const SlotKey &) const = default;
+    };
+
+    struct BESS_API SlotKeyHash {
+        size_t operator()(const SlotKey &key) const {
+            return std::hash<uint64_t>()(static_cast<uint64_t>(key.component) ^ (key.slot * 0x9E3779B97F4A7C15ULL));
+        }
+    };
+
+    /**
+     * Bounded queue of slot changes, any thread may append and one thread drains.
+     * Appending never blocks or allocates: producers claim a cell with a CAS and publish it
+     * through the cell's sequence number. When the log is full the change is dropped and
+     * counted, consumers that need the current values can read a slot snapshot instead.
+     **/
+    class BESS_API StateChangeLog {
+      public:
+        static constexpr size_t defaultCapacity = size_t{1} << 16;
+
+        // capacity is rounded up to a power of two
+        explicit StateChangeLog(size_t capacity = defaultCapacity);
+
+        StateChangeLog(const StateChangeLog &) = delete;
+        StateChangeLog &operator=(const StateChangeLog &) = delete;
+
+        // false if the log was full
+        bool push(const SlotChange &change);
+
+        // consumer only, appends the logged changes to out in order, returns how many
+        size_t drain(std::vector<SlotChange> &out);
+
+        size_t getCapacity() const;
+        uint64_t getDroppedCount() const;
+
+      private:
+        struct Cell {
+            std::atomic<uint64_t> sequence{0};
+            SlotChange change;
+        };
+
+        std::unique_ptr<Cell[]> m_cells;
+        uint64_t m_mask;
+        alignas(64) std::atomic<uint64_t> m_enqueuePos{0};
+        alignas(64) uint64_t m_dequeuePos = 0;
+        std::atomic<uint64_t> m_dropped{0};
+    };
+} // namespace Bess::SimEngine
@@ -0,0 +1,61 @@
+#pragma once
+
+#include "bess_api.h"
+#include "common/bess_uuid.h"
+#include "types.h"
+#include <cstdint>
+#include <istream>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+namespace Bess::SimEngine {
+    class SimulationEngine;
+
+    // "<integer>[unit]" with unit ps, ns, us, ms or s, ns when omitted
+    BESS_API bool parseSimTime(std::string_view text, SimTime &time);
+
+    struct BESS_API StimulusValue {
+        uint32_t signal = 0;           // column in Stimulus::getSignals()
+        std::vector<LogicState> bits; // bits[0] is the least significant one
+    };
+
+    struct BESS_API StimulusStep {
+        SimTime time{0};
+        std::vector<StimulusValue> values;
+    };
+
+    /**
+     * Input values to apply at given simulation times, read from CSV:
+     *   time,a,b,bus
+     *   0,0,1,0x3
+     *   10ns,1,,0101
+     * The first column is the time, ns unless suffixed with ps, ns, us, ms or s; the others name
+     * a top level input each. A value is 0, 1, x or z per bit with the most significant bit
+     * first, or hex with a 0x prefix, narrower values are zero extended. Empty cells keep the
+     * previous value, lines starting with '#' are comments.
+     **/
+    class BESS_API Stimulus {
+      public:
+        // throws std::runtime_error naming the offending line
+        static Stimulus parseCsv(std::istream &in);
+
+        const std::vector<std::string> &getSignals() const;
+        const std::vector<StimulusStep> &getSteps() const;
+        SimTime getEndTime() const;
+
+        /**
+         * Runs the engine to every step, sets the input components' output slots, then runs
+         * on until `until`. inputs maps signal names to input components, one slot per bit.
+         * Throws std::runtime_error for a signal missing from inputs, returns false if the
+         * engine was destroyed while running.
+         **/
+        bool apply(SimulationEngine &engine, const std::unordered_map<std::string, UUID> &inputs,
+                   SimTime until) const;
+
+      private:
+        std::vector<std::string> m_signals;
+        std::vector<StimulusStep> m_steps;
+    };
+} // namespace Bess::SimEngine
@@ -0,0 +1,71 @@
+#pragma once
+
+#include "bess_api.h"
+#include "state_change/state_change_log.h"
+#include "trace/trace_writer.h"
+#include "types.h"
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+namespace Bess::SimEngine {
+
+    /**
+     * Streams slot changes to a TraceWriter on its own thread.
+     * record() only appends to a lock-free StateChangeLog, the writer thread drains it,
+     * drops changes of slots that are not traced and formats the rest. The writer sleeps
+     * until a quarter of the log is filled or flushInterval passed. Unlike the UI's change
+     * log nothing is dropped: a producer finding the log full sleeps until the writer made
+     * room, getStallCount() tells how often that happened.
+     **/
+    class BESS_API TraceRecorder {
+      public:
+        static constexpr size_t defaultCapacity = size_t{1} << 18;
+        static constexpr std::chrono::milliseconds flushInterval{20};
+
+        TraceRecorder(std::unique_ptr<TraceWriter> writer, std::vector<TraceSignal> signals,
+                      size_t capacity = defaultCapacity);
+        ~TraceRecorder();
+
+        TraceRecorder(const TraceRecorder &) = delete;
+        TraceRecorder &operator=(const TraceRecorder &) = delete;
+
+        // initial holds the state of every signal at time
+        void start(SimTime time, const std::vector<SlotState> &initial);
+        // any thread, between start and stop
+        void record(const SlotChange &change);
+        // writes everything recorded so far and ends the trace at time
+        void stop(SimTime time);
+
+        bool isRunning() const;
+        const std::vector<TraceSignal> &getSignals() const;
+        uint64_t getWrittenCount() const;
+        uint64_t getStallCount() const;
+
+      private:
+        void writerLoop();
+        void writeDrained();
+
+        std::unique_ptr<TraceWriter> m_writer;
+        std::vector<TraceSignal> m_signals;
+        std::unordered_map<SlotKey, uint32_t, SlotKeyHash> m_signalIds;
+        StateChangeLog m_log;
+        std::vector<SlotChange> m_drained;
+
+        std::thread m_thread;
+        std::mutex m_wakeMutex;
+        std::condition_variable m_wake;           // writer, high water or stop
+        std::condition_variable m_spaceAvailable; // producers waiting on a full log
+        const int64_t m_highWater;
+        std::atomic<int64_t> m_unwritten{0}; // recorded but not drained yet, may dip below 0 briefly
+        std::atomic<bool> m_stopRequested{false};
+        std::atomic<uint64_t> m_written{0};
+        std::atomic<uint64_t> m_stalls{0};
+        bool m_running = false;
+    };
+} // namespace Bess::SimEngine
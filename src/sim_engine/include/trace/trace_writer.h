@@ -0,0 +1,101 @@
+#pragma once
+
+#include "bess_api.h"
+#include "common/bess_uuid.h"
+#include "types.h"
+#include <cstdint>
+#include <filesystem>
+#include <memory>
+#include <ostream>
+#include <string>
+#include <vector>
+
+namespace Bess::SimEngine {
+
+    enum class TraceFormat : uint8_t {
+        vcd,
+        binary
+    };
+
+    // one traced slot, scope is a '/' separated instance path as produced by the Verilog import
+    struct BESS_API TraceSignal {
+        std::string scope;
+        std::string name;
+        UUID component = UUID::null;
+        SlotType type = SlotType::digitalOutput;
+        uint32_t slot = 0;
+        int width = 1; // bits of a bus slot, SimulationEngine::startTrace fills it in from the definition
+    };
+
+    /**
+     * Receives a trace in time order from the recorder's writer thread.
+     * Signals are referred to by their index in the list given to begin().
+     **/
+    class BESS_API TraceWriter {
+      public:
+        virtual ~TraceWriter() = default;
+
+        virtual void begin(const std::vector<TraceSignal> &signals, SimTime time,
+                           const std::vector<SlotState> &initial) = 0;
+        // value holds the bits of a bus signal and is ignored for single bit ones
+        virtual void change(SimTime time, uint32_t signal, LogicState state, uint64_t value) = 0;
+        virtual void end(SimTime time) = 0;
+    };
+
+    // Value Change Dump with a 1ns timescale, X and Z are written as x and z,
+    // a bus is a vector variable whose X or Z covers all of its bits
+    class BESS_API VcdTraceWriter : public TraceWriter {
+      public:
+        explicit VcdTraceWriter(std::unique_ptr<std::ostream> out);
+
+        void begin(const std::vector<TraceSignal> &signals, SimTime time,
+                   const std::vector<SlotState> &initial) override;
+        void change(SimTime time, uint32_t signal, LogicState state, uint64_t value) override;
+        void end(SimTime time) override;
+
+        // printable identifier code of a signal index
+        static std::string identifierOf(uint32_t signal);
+
+      private:
+        void writeTime(SimTime time);
+        void writeValue(uint32_t signal, LogicState state, uint64_t value);
+
+        std::unique_ptr<std::ostream> m_out;
+        std::vector<std::string> m_ids;
+        std::vector<int> m_widths;
+        SimTime m_time{0};
+    };
+
+    /**
+     * Compact binary trace, integers are LEB128 varints and strings a varint length followed by
+     * the bytes:
+     *   magic, signal count, scope, name and width of every signal, start time,
+     *   one byte per signal with its initial LogicState, followed by its bits for a bus,
+     *   then records: tag 0 followed by the nanoseconds since the previous time,
+     *   or tag ((signal + 1) << 2 | state) for a change at the current time,
+     *   followed by the bits when the signal is a bus.
+     * The file ends with a time record advancing to the end of the trace.
+     **/
+    class BESS_API BinaryTraceWriter : public TraceWriter {
+      public:
+        static constexpr uint64_t magic = 0x3243525453534542ULL; // "BESSTRC2"
+
+        explicit BinaryTraceWriter(std::unique_ptr<std::ostream> out);
+
+        void begin(const std::vector<TraceSignal> &signals, SimTime time,
+                   const std::vector<SlotState> &initial) override;
+        void change(SimTime time, uint32_t signal, LogicState state, uint64_t value) override;
+        void end(SimTime time) override;
+
+      private:
+        void writeVarint(uint64_t value);
+        void writeTime(SimTime time);
+
+        std::unique_ptr<std::ostream> m_out;
+        std::vector<int> m_widths;
+        SimTime m_time{0};
+    };
+
+    // nullptr if path could not be opened for writing
+    BESS_API std::unique_ptr<TraceWriter> makeTraceWriter(TraceFormat format, const std::filesystem::path &path);
+} // namespace Bess::SimEngine
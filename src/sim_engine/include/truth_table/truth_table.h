@@ -0,0 +1,75 @@
+#pragma once
+
+#include "bess_api.h"
+#include "common/bess_uuid.h"
+#include "types.h"
+#include <cstdint>
+#include <filesystem>
+#include <span>
+#include <vector>
+
+namespace Bess::SimEngine {
+
+    struct BESS_API TruthTableOptions {
+        // larger tables are written to a file in spillDirectory instead of memory
+        uint64_t memoryLimitBytes = uint64_t{256} << 20;
+        std::filesystem::path spillDirectory; // empty uses the system temp directory
+        size_t threadCount = 0;               // 0 uses every hardware thread
+    };
+
+    /**
+     * Truth table of a net, row r drives input column c with bit (inputCount - 1 - c) of r,
+     * so the first input column is the most significant one.
+     * Output columns are packed 64 rows per word in two bit planes holding bit 0 and bit 1
+     * of the LogicState, the second plane is only allocated once an X or Z is stored.
+     * Tables above TruthTableOptions::memoryLimitBytes live in getSpillPath(): a header of
+     * magic, input count, output count and row count as uint64_t, followed by both planes
+     * of every output column.
+     **/
+    class BESS_API TruthTable {
+      public:
+        static constexpr uint64_t spillMagic = 0x3130545453534542ULL; // "BESSTT01"
+
+        std::vector<UUID> inputUuids;
+        std::vector<UUID> outputUuids;
+
+        // sizes the table for 2^inputCount rows, throws std::runtime_error if the spill file fails
+        void allocate(size_t inputCount, size_t outputCount, const TruthTableOptions &options);
+
+        /**
+         * Stores rows [64 * firstWord, 64 * (firstWord + wordCount)) of every output column.
+         * low, high: planes of the chunk, column after column, wordCount words each;
+         * high may be empty when every value is either low or high;
+         **/
+        void storeWords(uint64_t firstWord, size_t wordCount,
+                        std::span<const uint64_t> low, std::span<const uint64_t> high);
+
+        bool empty() const;
+        uint64_t getRowCount() const;
+        uint64_t getWordCount() const;
+        size_t getInputCount() const;
+        size_t getOutputCount() const;
+
+        LogicState getInput(uint64_t row, size_t column) const;
+        // reads from the spill file when the table was spilled
+        LogicState getOutput(uint64_t row, size_t column) const;
+
+        bool isSpilled() const;
+        const std::filesystem::path &getSpillPath() const;
+
+        // set when the table was computed 64 rows at a time instead of on the event loop
+        bool isBitParallel() const;
+        void setBitParallel(bool value);
+
+      private:
+        uint64_t planeOffset(size_t column, int plane) const;
+
+        size_t m_inputCount = 0;
+        size_t m_outputCount = 0;
+        uint64_t m_rowCount = 0;
+        uint64_t m_wordCount = 0;
+        std::vector<std::vector<uint64_t>> m_low, m_high; // per output column
+        std::filesystem::path m_spillPath;
+        bool m_bitParallel = false;
+    };
+} // namespace Bess::SimEngine
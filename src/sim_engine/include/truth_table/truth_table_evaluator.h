@@ -0,0 +1,79 @@
+#pragma once
+
+#include "bess_api.h"
+#include "common/bess_uuid.h"
+#include "expression_evalutator/compiled_expression.h"
+#include "sim_engine_state.h"
+#include "truth_table/truth_table.h"
+#include "types.h"
+#include <cstdint>
+#include <span>
+#include <vector>
+
+namespace Bess::SimEngine {
+    class ComponentDefinition;
+
+    /**
+     * Computes the truth table of a purely combinational cone, 64 input patterns per word.
+     * The cone is levelized once, every word then runs its components in that order on
+     * bitwise signals. Native gates and expression based definitions have a bitwise form,
+     * anything else, e.g. sequential or python simulated parts, makes build() fail and the
+     * caller falls back to the event loop.
+     **/
+    class BESS_API TruthTableEvaluator {
+      public:
+        // 2^32 rows, 512 MiB per output column
+        static constexpr size_t maxInputs = 32;
+
+        static bool hasBitwiseForm(const ComponentDefinition &definition);
+
+        /**
+         * components: every component of the cone except the input and output components;
+         * inputs: input pins in table order, input i is bit i of the row;
+         * outputs: output pins in table order;
+         * returns: false if a component has no bitwise form or the components form a loop;
+         **/
+        bool build(const SimEngineState &state, const std::vector<UUID> &components,
+                   const std::vector<ComponentPin> &inputs, const std::vector<ComponentPin> &outputs);
+
+        // outputs[o] receives output o of rows [64 * word, 64 * word + 64)
+        void evaluateWord(uint64_t word, std::span<uint64_t> outputs, std::vector<uint64_t> &scratch) const;
+
+        // fills an allocated table chunk by chunk, the words of a chunk are spread over threads
+        void evaluate(TruthTable &table, const TruthTableOptions &options) const;
+
+      private:
+        static constexpr uint32_t zeroSignal = 0; // undriven input slots read this one
+
+        enum class NodeKind : uint8_t {
+            gate,      // op reduces every input into output 0
+            unaryGate, // op maps input i to output i
+            expressions,
+        };
+
+        struct Node {
+            NodeKind kind = NodeKind::gate;
+            char op = '0';
+            bool negate = false;
+            uint32_t expressions = 0; // index into m_expressions
+            uint32_t slotBegin = 0;   // input slots, index into m_slotDriverBegin
+            uint32_t slotCount = 0;
+            uint32_t outputBegin = 0; // first output signal
+            uint32_t outputCount = 0;
+        };
+
+        // signal word of input slot, the drivers are wired or
+        uint64_t readSlot(uint32_t slot, std::span<const uint64_t> signals) const;
+
+        std::vector<Node> m_nodes;
+        std::vector<std::vector<ExprEval::CompiledExpression>> m_expressions;
+        std::vector<uint32_t> m_slotDriverBegin; // per input slot, size + 1
+        std::vector<uint32_t> m_drivers;         // signal indices
+        uint32_t m_outputSlotBegin = 0;          // slots of the table outputs come last
+        uint32_t m_inputCount = 0;
+        uint32_t m_outputCount = 0;
+        uint32_t m_signalCount = 0;
+        uint32_t m_maxSlotCount = 0;
+        uint32_t m_maxStackDepth = 0;
+    };
+} // namespace Bess::SimEngine
@@ -7,6 +7,8 @@
 #include <chrono>
 #include <cstdint>
 #include <functional>
+#include <memory>
+#include <span>
 #include <string>
 
 namespace Bess::SimEngine {
@@ -28,6 +30,20 @@ namespace Bess::SimEngine {
         paused
     };
 
+    // How simulated time is mapped to wall clock time while running.
+    enum class SimulationPacing : uint8_t {
+        realTime,        // one simulated nanosecond takes one wall clock nanosecond
+        scaled,          // real time multiplied by the engine's time scale
+        asFastAsPossible // events are simulated back to back
+    };
+
+    // How a timestep propagates changes through the netlist.
+    enum class SimulationMode : uint8_t {
+        eventDriven, // every component reacts after its delay through the event queue
+        cycleBased,  // registers, then one levelized sweep of the logic behind them, see CycleSchedule
+        native       // cycle based with the logic compiled to a shared library, see NativeModel
+    };
+
     enum class LogicState : uint8_t {
         low,
         high,
@@ -59,9 +75,17 @@ namespace Bess::SimEngine {
         digitalOutput
     };
 
+    // bits of a bus slot that are part of its value
+    constexpr uint64_t busMask(int width) {
+        return width >= 64 ? ~uint64_t{0} : (uint64_t{1} << width) - 1;
+    }
+
     struct BESS_API SlotState {
         LogicState state = LogicState::low;
         SimTime lastChangeTime{0};
+        // Bits of a slot wider than one bit, see SlotsGroupInfo::widths. state then summarises
+        // the bus: high when any bit is set, unknown or high_z for the whole bus.
+        uint64_t value = 0;
 
         SlotState() = default;
 
@@ -82,6 +106,17 @@ namespace Bess::SimEngine {
             this->state = val ? LogicState::high : LogicState::low;
             return *this;
         }
+
+        static SlotState fromWord(uint64_t value, SimTime time) {
+            SlotState slot(value != 0 ? LogicState::high : LogicState::low, time);
+            slot.value = value;
+            return slot;
+        }
+
+        // same logic value, the change time is not compared
+        bool sameValue(const SlotState &other) const {
+            return state == other.state && value == other.value;
+        }
     };
 
     struct BESS_API SimulationEvent {
@@ -89,6 +124,7 @@ namespace Bess::SimEngine {
         UUID compId;
         UUID schedulerId; // enitity that triggered the change
         uint64_t id;
+        bool freeRunning = false; // rescheduled by the component itself, e.g. a clock edge
         bool operator<(const SimulationEvent &other) const noexcept {
             if (simTime != other.simTime)
                 return simTime < other.simTime;
@@ -103,17 +139,22 @@ namespace Bess::SimEngine {
         std::vector<bool> outputConnected;
         bool isChanged = false;
         std::any *auxData = nullptr;
-        bool simError = false;
-        std::string errorMessage;
+        // message of the failed last evaluation, out of line as most components never fail
+        std::shared_ptr<const std::string> simError;
     };
 
     typedef std::function<ComponentState(const std::vector<SlotState> &, SimTime, const ComponentState &)> SimulationFunction;
 
-    struct BESS_API TruthTable {
-        std::vector<std::vector<LogicState>> table;
-        std::vector<UUID> inputUuids;
-        std::vector<UUID> outputUuids;
-    };
+    /**
+     * Allocation free variant of SimulationFunction, evaluates a component in place.
+     * inputs: resolved input slot states;
+     * currentTime: current simulation time;
+     * prevState: state before this evaluation, inputStates still hold the previous inputs;
+     * outputs: holds the previous outputs on entry, new output values are written here;
+     * returns: true if any output changed, outputs are discarded otherwise;
+     * Throwing marks a simulation error and leaves the outputs untouched.
+     **/
+    typedef std::function<bool(std::span<const SlotState>, SimTime, const ComponentState &, std::span<SlotState>)> InPlaceSimulationFunction;
 } // namespace Bess::SimEngine
 
 REFLECT_ENUM(Bess::SimEngine::SimulationState)
@@ -123,18 +164,41 @@ REFLECT_ENUM(Bess::SimEngine::SlotCatergory)
 REFLECT_ENUM(Bess::SimEngine::ComponentBehaviorType)
 REFLECT_ENUM(Bess::SimEngine::SlotType)
 
-REFLECT(Bess::SimEngine::SlotState, state, lastChangeTime)
+REFLECT(Bess::SimEngine::SlotState, state, lastChangeTime, value)
 REFLECT_VECTOR(Bess::SimEngine::SlotState)
 REFLECT_VECTOR(bool)
 
-REFLECT(Bess::SimEngine::ComponentState,
-        inputStates,
-        inputConnected,
-        outputStates,
-        outputConnected,
-        isChanged,
-        simError,
-        errorMessage)
+namespace Bess::JsonConvert {
+    // keeps the simError flag and errorMessage of projects saved before the error moved out of line
+    inline void toJsonValue(const Bess::SimEngine::ComponentState &obj, Json::Value &j) {
+        j = Json::objectValue;
+        toJsonValue(obj.inputStates, j["inputStates"]);
+        toJsonValue(obj.inputConnected, j["inputConnected"]);
+        toJsonValue(obj.outputStates, j["outputStates"]);
+        toJsonValue(obj.outputConnected, j["outputConnected"]);
+        toJsonValue(obj.isChanged, j["isChanged"]);
+        toJsonValue(obj.simError != nullptr, j["simError"]);
+        toJsonValue(obj.simError ? *obj.simError : std::string(), j["errorMessage"]);
+    }
+
+    inline void fromJsonValue(const Json::Value &j, Bess::SimEngine::ComponentState &obj) {
+        if (!j.isObject())
+            return;
+        if (j.isMember("inputStates"))
+            fromJsonValue(j["inputStates"], obj.inputStates);
+        if (j.isMember("inputConnected"))
+            fromJsonValue(j["inputConnected"], obj.inputConnected);
+        if (j.isMember("outputStates"))
+            fromJsonValue(j["outputStates"], obj.outputStates);
+        if (j.isMember("outputConnected"))
+            fromJsonValue(j["outputConnected"], obj.outputConnected);
+        if (j.isMember("isChanged"))
+            fromJsonValue(j["isChanged"], obj.isChanged);
+        obj.simError.reset();
+        if (j.get("simError", false).asBool())
+            obj.simError = std::make_shared<const std::string>(j.get("errorMessage", "").asString());
+    }
+} // namespace Bess::JsonConvert
 
 REFLECT_VECTOR(Bess::SimEngine::ComponentState)
 
@@ -0,0 +1,534 @@
+#include "checkpoint/sim_checkpoint.h"
+#include "component_definition.h"
+#include "sim_engine_state.h"
+
+#include <algorithm>
+#include <array>
+#include <format>
+#include <iterator>
+#include <json/json.h>
+#include <typeinfo>
+#include <unordered_map>
+
+namespace Bess::SimEngine {
+    namespace {
+        constexpr std::array<char, 8> magic = {'B', 'E', 'S', 'S', 'C', 'K', 'P', 'T'};
+        constexpr uint32_t byteOrderMark = 0x01020304;
+
+        // sections in the order they are written and read
+        enum class Section : uint32_t {
+            definitions = 1,
+            components,
+            names,
+            slots,
+            connections,
+            definitionState,
+            nets,
+            events,
+        };
+
+        struct Header {
+            std::array<char, 8> magic;
+            uint32_t version;
+            uint32_t byteOrderMark;
+            uint32_t slotRecordSize; // guards against builds with a different SlotRecord layout
+            uint32_t reserved;
+            int64_t simTime;
+            uint64_t nextEventId;
+        };
+
+        struct SectionHeader {
+            Section tag;
+            uint32_t reserved;
+            uint64_t size;
+        };
+
+        struct ComponentRecord {
+            uint64_t id;
+            uint64_t netUuid;
+            uint32_t definition;
+            uint32_t inputCount;
+            uint32_t outputCount;
+            uint8_t simError;
+            uint8_t isChanged;
+            uint8_t reserved[2];
+        };
+
+        // a SlotState without its padding, so the file holds no uninitialized bytes
+        struct SlotRecord {
+            int64_t lastChangeTime;
+            uint64_t value;
+            uint8_t state;
+            uint8_t reserved[7];
+        };
+
+        struct PinRecord {
+            uint64_t component;
+            int32_t slot;
+            uint32_t reserved;
+        };
+
+        struct EventRecord {
+            int64_t simTime;
+            uint64_t component;
+            uint64_t scheduler;
+            uint64_t id;
+            uint8_t freeRunning;
+            uint8_t reserved[7];
+        };
+
+        bool sameSlotsInfo(const SlotsGroupInfo &a, const SlotsGroupInfo &b) {
+            return a.type == b.type && a.isResizeable == b.isResizeable && a.count == b.count &&
+                   a.names == b.names && a.categories == b.categories && a.widths == b.widths;
+        }
+
+        // Clones of one definition only differ in their slot layout and runtime state,
+        // the latter is saved per component.
+        bool sameDefinition(const ComponentDefinition &a, const ComponentDefinition &b) {
+            return typeid(a) == typeid(b) && a.getHash() == b.getHash() &&
+                   a.getBaseHash() == b.getBaseHash() && a.getName() == b.getName() &&
+                   sameSlotsInfo(a.getInputSlotsInfo(), b.getInputSlotsInfo()) &&
+                   sameSlotsInfo(a.getOutputSlotsInfo(), b.getOutputSlotsInfo());
+        }
+
+        // Assigns every component a definition table index, one entry per distinct content.
+        class DefinitionTable {
+          public:
+            uint32_t indexOf(const std::shared_ptr<ComponentDefinition> &definition) {
+                if (const auto it = m_byPointer.find(definition.get()); it != m_byPointer.end())
+                    return it->second;
+
+                auto &candidates = m_byHash[definition->getHash()];
+                for (const auto index : candidates) {
+                    if (sameDefinition(*m_definitions[index], *definition)) {
+                        m_byPointer.emplace(definition.get(), index);
+                        return index;
+                    }
+                }
+
+                const auto index = static_cast<uint32_t>(m_definitions.size());
+                m_definitions.push_back(definition);
+                candidates.push_back(index);
+                m_byPointer.emplace(definition.get(), index);
+                return index;
+            }
+
+            void write(CheckpointWriter &out) const {
+                Json::StreamWriterBuilder builder;
+                builder["indentation"] = "";
+                out.write(static_cast<uint32_t>(m_definitions.size()));
+                for (const auto &definition : m_definitions) {
+                    Json::Value j;
+                    definitionToJson(definition, j);
+                    out.writeString(Json::writeString(builder, j));
+                }
+            }
+
+          private:
+            std::vector<std::shared_ptr<ComponentDefinition>> m_definitions;
+            std::unordered_map<const ComponentDefinition *, uint32_t> m_byPointer;
+            std::unordered_map<uint64_t, std::vector<uint32_t>> m_byHash;
+        };
+
+        void writeSection(std::ostream &out, Section tag, const CheckpointWriter &section) {
+            const SectionHeader header{tag, 0, section.getData().size()};
+            out.write(reinterpret_cast<const char *>(&header), sizeof(header));
+            out.write(reinterpret_cast<const char *>(section.getData().data()),
+                      static_cast<std::streamsize>(section.getData().size()));
+        }
+
+        std::runtime_error checkpointError(const std::string &message) {
+            return std::runtime_error("Invalid checkpoint: " + message);
+        }
+    } // namespace
+
+    void CheckpointWriter::writeString(std::string_view value) {
+        write(static_cast<uint32_t>(value.size()));
+        writeBytes(value.data(), value.size());
+    }
+
+    void CheckpointWriter::writeBytes(const void *data, size_t size) {
+        const auto *bytes = static_cast<const uint8_t *>(data);
+        m_data.insert(m_data.end(), bytes, bytes + size);
+    }
+
+    const std::vector<uint8_t> &CheckpointWriter::getData() const {
+        return m_data;
+    }
+
+    void CheckpointWriter::clear() {
+        m_data.clear();
+    }
+
+    CheckpointReader::CheckpointReader(std::span<const uint8_t> data) : m_data(data) {}
+
+    std::string CheckpointReader::readString() {
+        const auto size = read<uint32_t>();
+        expect(size, 1);
+        std::string value(reinterpret_cast<const char *>(m_data.data() + m_pos), size);
+        m_pos += size;
+        return value;
+    }
+
+    void CheckpointReader::readBytes(void *data, size_t size) {
+        expect(size, 1);
+        std::memcpy(data, m_data.data() + m_pos, size);
+        m_pos += size;
+    }
+
+    std::span<const uint8_t> CheckpointReader::take(size_t size) {
+        expect(size, 1);
+        const auto bytes = m_data.subspan(m_pos, size);
+        m_pos += size;
+        return bytes;
+    }
+
+    void CheckpointReader::expect(uint64_t count, size_t elementSize) const {
+        if (count > (m_data.size() - m_pos) / elementSize)
+            throw checkpointError("truncated section");
+    }
+
+    bool CheckpointReader::atEnd() const {
+        return m_pos == m_data.size();
+    }
+
+    void SimCheckpointFormat::write(std::ostream &out, const SimEngineState &state,
+                                    std::span<const SimulationEvent> events, SimTime simTime, uint64_t nextEventId) {
+        const auto &componentsMap = state.getDigitalComponents();
+        std::vector<const DigitalComponent *> components;
+        components.reserve(componentsMap.size());
+        for (const auto &[id, comp] : componentsMap) {
+            components.push_back(comp.get());
+        }
+
+        DefinitionTable definitions;
+        std::vector<ComponentRecord> records;
+        records.reserve(components.size());
+        size_t slotCount = 0;
+        for (const auto *comp : components) {
+            ComponentRecord record{};
+            record.id = comp->id;
+            record.netUuid = comp->netUuid;
+            record.definition = definitions.indexOf(comp->definition);
+            record.inputCount = static_cast<uint32_t>(comp->state.inputStates.size());
+            record.outputCount = static_cast<uint32_t>(comp->state.outputStates.size());
+            record.simError = comp->state.simError != nullptr;
+            record.isChanged = comp->state.isChanged;
+            records.push_back(record);
+            slotCount += record.inputCount + record.outputCount;
+        }
+
+        CheckpointWriter section;
+        const Header header{magic, version, byteOrderMark, sizeof(SlotRecord), 0,
+                            simTime.count(), nextEventId};
+        out.write(reinterpret_cast<const char *>(&header), sizeof(header));
+
+        definitions.write(section);
+        writeSection(out, Section::definitions, section);
+
+        section.clear();
+        section.write(static_cast<uint64_t>(records.size()));
+        section.writeSpan(std::span<const ComponentRecord>(records));
+        writeSection(out, Section::components, section);
+
+        section.clear();
+        for (const auto *comp : components) {
+            section.writeString(comp->getName());
+            section.writeString(comp->state.simError ? *comp->state.simError : std::string());
+        }
+        writeSection(out, Section::names, section);
+
+        // slot states of every component, inputs then outputs, then their connected flags
+        section.clear();
+        std::vector<SlotRecord> slots;
+        slots.reserve(slotCount);
+        std::vector<uint8_t> connected;
+        connected.reserve(slotCount);
+        const auto addSlots = [&slots](const std::vector<SlotState> &states) {
+            for (const auto &slot : states) {
+                slots.push_back({slot.lastChangeTime.count(), slot.value, static_cast<uint8_t>(slot.state), {}});
+            }
+        };
+        for (const auto *comp : components) {
+            addSlots(comp->state.inputStates);
+            addSlots(comp->state.outputStates);
+            for (size_t i = 0; i < comp->state.inputStates.size(); i++) {
+                connected.push_back(i < comp->state.inputConnected.size() && comp->state.inputConnected[i]);
+            }
+            for (size_t i = 0; i < comp->state.outputStates.size(); i++) {
+                connected.push_back(i < comp->state.outputConnected.size() && comp->state.outputConnected[i]);
+            }
+        }
+        section.writeSpan(std::span<const SlotRecord>(slots));
+        section.writeSpan(std::span<const uint8_t>(connected));
+        writeSection(out, Section::slots, section);
+
+        // pin counts of every slot in the same order, then all pins
+        section.clear();
+        std::vector<uint32_t> pinCounts;
+        std::vector<PinRecord> pins;
+        pinCounts.reserve(slotCount);
+        const auto addConnections = [&](const Connections &connections, size_t slots) {
+            for (size_t i = 0; i < slots; i++) {
+                const auto count = i < connections.size() ? connections[i].size() : 0;
+                pinCounts.push_back(static_cast<uint32_t>(count));
+                for (size_t p = 0; p < count; p++) {
+                    const auto &[component, slot] = connections[i][p];
+                    pins.push_back({component, slot, 0});
+                }
+            }
+        };
+        for (const auto *comp : components) {
+            addConnections(comp->inputConnections, comp->state.inputStates.size());
+            addConnections(comp->outputConnections, comp->state.outputStates.size());
+        }
+        section.writeSpan(std::span<const uint32_t>(pinCounts));
+        section.write(static_cast<uint64_t>(pins.size()));
+        section.writeSpan(std::span<const PinRecord>(pins));
+        writeSection(out, Section::connections, section);
+
+        section.clear();
+        CheckpointWriter definitionState;
+        for (uint32_t i = 0; i < components.size(); i++) {
+            definitionState.clear();
+            components[i]->definition->writeCheckpointState(definitionState);
+            if (definitionState.getData().empty())
+                continue;
+            section.write(i);
+            section.write(static_cast<uint32_t>(definitionState.getData().size()));
+            section.writeSpan(std::span<const uint8_t>(definitionState.getData()));
+        }
+        writeSection(out, Section::definitionState, section);
+
+        section.clear();
+        section.write(static_cast<uint64_t>(state.getNetsMap().size()));
+        for (const auto &[id, net] : state.getNetsMap()) {
+            section.write(static_cast<uint64_t>(id));
+            section.write(static_cast<uint64_t>(net.size()));
+            for (const auto &component : net.getComponents()) {
+                section.write(static_cast<uint64_t>(component));
+            }
+        }
+        writeSection(out, Section::nets, section);
+
+        section.clear();
+        std::vector<EventRecord> eventRecords;
+        eventRecords.reserve(events.size());
+        for (const auto &event : events) {
+            eventRecords.push_back({event.simTime.count(), event.compId, event.schedulerId, event.id,
+                                    event.freeRunning, {}});
+        }
+        section.write(static_cast<uint64_t>(eventRecords.size()));
+        section.writeSpan(std::span<const EventRecord>(eventRecords));
+        writeSection(out, Section::events, section);
+
+        if (!out)
+            throw std::runtime_error("Failed to write checkpoint");
+    }
+
+    SimCheckpoint SimCheckpointFormat::read(std::istream &in) {
+        const std::vector<uint8_t> data{std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>()};
+        CheckpointReader file(data);
+
+        Header header{};
+        if (data.size() < sizeof(header))
+            throw checkpointError("not a checkpoint");
+        file.readBytes(&header, sizeof(header));
+        if (header.magic != magic)
+            throw checkpointError("not a checkpoint");
+        if (header.byteOrderMark != byteOrderMark)
+            throw checkpointError("written on a different platform");
+        // before the platform check, older versions stored slots with a different layout
+        if (header.version != version)
+            throw checkpointError(std::format("version {} is not supported", header.version));
+        if (header.slotRecordSize != sizeof(SlotRecord))
+            throw checkpointError("written on a different platform");
+
+        SimCheckpoint checkpoint;
+        checkpoint.simTime = SimTime(header.simTime);
+        checkpoint.nextEventId = header.nextEventId;
+
+        const auto nextSection = [&](Section expected) {
+            const auto sectionHeader = file.read<SectionHeader>();
+            if (sectionHeader.tag != expected)
+                throw checkpointError(std::format("expected section {}", static_cast<uint32_t>(expected)));
+            return file.take(sectionHeader.size);
+        };
+
+        // definitions, bound to their simulation functions once and cloned per component
+        std::vector<std::shared_ptr<ComponentDefinition>> prototypes;
+        {
+            const auto bytes = nextSection(Section::definitions);
+            CheckpointReader section(bytes);
+            const auto count = section.read<uint32_t>();
+            Json::CharReaderBuilder builder;
+            for (uint32_t i = 0; i < count; i++) {
+                const auto text = section.readString();
+                Json::Value j;
+                std::string errors;
+                std::unique_ptr<Json::CharReader> reader(builder.newCharReader());
+                if (!reader->parse(text.data(), text.data() + text.size(), &j, &errors))
+                    throw checkpointError("definition " + std::to_string(i) + ": " + errors);
+                auto definition = definitionFromJson(j);
+                if (!definition)
+                    throw checkpointError(std::format("definition {} is not registered", j["name"].asString()));
+                prototypes.push_back(std::move(definition));
+            }
+        }
+
+        std::vector<ComponentRecord> records;
+        {
+            const auto bytes = nextSection(Section::components);
+            CheckpointReader section(bytes);
+            const auto count = section.read<uint64_t>();
+            section.expect(count, sizeof(ComponentRecord));
+            records.resize(count);
+            section.readSpan(std::span<ComponentRecord>(records));
+        }
+
+        // the slot counts size everything that follows, so they are checked against the
+        // slots section before anything is allocated for them
+        uint64_t slotCount = 0;
+        for (const auto &record : records) {
+            if (record.definition >= prototypes.size())
+                throw checkpointError("component without definition");
+            slotCount += uint64_t{record.inputCount} + record.outputCount;
+        }
+        const auto namesBytes = nextSection(Section::names);
+        CheckpointReader slotsSection(nextSection(Section::slots));
+        slotsSection.expect(slotCount, sizeof(SlotRecord) + sizeof(uint8_t));
+
+        auto &components = checkpoint.components;
+        components.reserve(records.size());
+        for (const auto &record : records) {
+            auto comp = std::make_shared<DigitalComponent>();
+            comp->id = UUID(record.id);
+            comp->netUuid = UUID(record.netUuid);
+            comp->definition = prototypes[record.definition]->clone();
+            comp->state.auxData = &comp->definition->getAuxData();
+            comp->state.isChanged = record.isChanged != 0;
+            comp->state.inputStates.resize(record.inputCount);
+            comp->state.outputStates.resize(record.outputCount);
+            comp->inputConnections.resize(record.inputCount);
+            comp->outputConnections.resize(record.outputCount);
+            components.push_back(std::move(comp));
+        }
+
+        {
+            CheckpointReader section(namesBytes);
+            for (size_t i = 0; i < components.size(); i++) {
+                components[i]->setName(section.readString());
+                auto message = section.readString();
+                if (records[i].simError != 0)
+                    components[i]->state.simError = std::make_shared<const std::string>(std::move(message));
+            }
+        }
+
+        {
+            std::vector<SlotRecord> slots(slotCount);
+            slotsSection.readSpan(std::span<SlotRecord>(slots));
+            auto slot = slots.begin();
+            const auto fill = [&slot](std::vector<SlotState> &states) {
+                for (auto &state : states) {
+                    if (slot->state > static_cast<uint8_t>(LogicState::high_z))
+                        throw checkpointError("invalid slot state");
+                    state.state = static_cast<LogicState>(slot->state);
+                    state.lastChangeTime = SimTime(slot->lastChangeTime);
+                    state.value = slot->value;
+                    ++slot;
+                }
+            };
+            for (const auto &comp : components) {
+                fill(comp->state.inputStates);
+                fill(comp->state.outputStates);
+            }
+            std::vector<uint8_t> connected(slotCount);
+            slotsSection.readSpan(std::span<uint8_t>(connected));
+            auto flag = connected.begin();
+            for (const auto &comp : components) {
+                comp->state.inputConnected.assign(flag, flag + comp->state.inputStates.size());
+                flag += static_cast<std::ptrdiff_t>(comp->state.inputStates.size());
+                comp->state.outputConnected.assign(flag, flag + comp->state.outputStates.size());
+                flag += static_cast<std::ptrdiff_t>(comp->state.outputStates.size());
+            }
+        }
+
+        {
+            const auto bytes = nextSection(Section::connections);
+            CheckpointReader section(bytes);
+            std::vector<uint32_t> pinCounts(slotCount);
+            section.readSpan(std::span<uint32_t>(pinCounts));
+            const auto pinCount = section.read<uint64_t>();
+            section.expect(pinCount, sizeof(PinRecord));
+            std::vector<PinRecord> pins(pinCount);
+            section.readSpan(std::span<PinRecord>(pins));
+
+            size_t slot = 0, pin = 0;
+            const auto fill = [&](Connections &connections) {
+                for (auto &slotConnections : connections) {
+                    const auto count = pinCounts[slot++];
+                    if (count > pins.size() - pin)
+                        throw checkpointError("truncated connections");
+                    slotConnections.reserve(count);
+                    for (uint32_t p = 0; p < count; p++, pin++) {
+                        slotConnections.emplace_back(UUID(pins[pin].component), pins[pin].slot);
+                    }
+                }
+            };
+            for (const auto &comp : components) {
+                fill(comp->inputConnections);
+                fill(comp->outputConnections);
+                comp->rebuildFanOut();
+            }
+        }
+
+        {
+            const auto bytes = nextSection(Section::definitionState);
+            CheckpointReader section(bytes);
+            while (!section.atEnd()) {
+                const auto index = section.read<uint32_t>();
+                const auto size = section.read<uint32_t>();
+                if (index >= components.size())
+                    throw checkpointError("state of an unknown component");
+                CheckpointReader stateReader(section.take(size));
+                components[index]->definition->readCheckpointState(stateReader);
+            }
+        }
+
+        {
+            const auto bytes = nextSection(Section::nets);
+            CheckpointReader section(bytes);
+            const auto count = section.read<uint64_t>();
+            section.expect(count, 2 * sizeof(uint64_t));
+            checkpoint.nets.resize(count);
+            std::vector<UUID> netComponents;
+            for (auto &net : checkpoint.nets) {
+                net.setUUID(UUID(section.read<uint64_t>()));
+                const auto size = section.read<uint64_t>();
+                section.expect(size, sizeof(uint64_t));
+                netComponents.clear();
+                netComponents.reserve(size);
+                for (uint64_t i = 0; i < size; i++) {
+                    netComponents.emplace_back(section.read<uint64_t>());
+                }
+                net.setComponents(netComponents);
+            }
+        }
+
+        {
+            const auto bytes = nextSection(Section::events);
+            CheckpointReader section(bytes);
+            const auto count = section.read<uint64_t>();
+            section.expect(count, sizeof(EventRecord));
+            std::vector<EventRecord> eventRecords(count);
+            section.readSpan(std::span<EventRecord>(eventRecords));
+            checkpoint.events.reserve(count);
+            for (const auto &record : eventRecords) {
+                checkpoint.events.push_back({SimTime(record.simTime), UUID(record.component),
+                                             UUID(record.scheduler), record.id, record.freeRunning != 0});
+            }
+        }
+
+        return checkpoint;
+    }
+} // namespace Bess::SimEngine
@@ -52,6 +52,14 @@ namespace Bess::SimEngine {
         }
     } // namespace
 
+    int SlotsGroupInfo::getWidth(size_t slot) const {
+        for (const auto &[idx, width] : widths) {
+            if (idx == static_cast<int>(slot))
+                return width;
+        }
+        return 1;
+    }
+
     std::shared_ptr<Trait> Trait::clone() const {
         return std::make_shared<Trait>(*this);
     }
@@ -80,6 +88,17 @@ namespace Bess::SimEngine {
             hash = fnv1aPod(hash, m_outputSlotsInfo.count);
         }
 
+        // left out for one bit slots, so their hashes stay as before buses existed
+        const auto hashWidth = [](uint64_t h, const std::pair<int, int> &width) {
+            return fnv1aPod(fnv1aPod(h, width.first), width.second);
+        };
+        if (!m_inputSlotsInfo.widths.empty()) {
+            hash = hashVector(hash, m_inputSlotsInfo.widths, hashWidth);
+        }
+        if (!m_outputSlotsInfo.widths.empty()) {
+            hash = hashVector(hash, m_outputSlotsInfo.widths, hashWidth);
+        }
+
         if (m_opInfo.op != '0') {
             hash = fnv1aPod(hash, m_opInfo.op);
             hash = fnv1aPod(hash, m_opInfo.shouldNegateOutput);
@@ -138,7 +157,35 @@ namespace Bess::SimEngine {
         return true;
     }
 
+    void ComponentDefinition::setSimulationFunction(const SimulationFunction &value) {
+        m_simulationFunction = value;
+        m_inPlaceSimulationFunction = nullptr;
+    }
+
+    void ComponentDefinition::setInPlaceSimulationFunction(const InPlaceSimulationFunction &value) {
+        m_inPlaceSimulationFunction = value;
+        if (!value) {
+            m_simulationFunction = nullptr;
+            return;
+        }
+
+        m_simulationFunction = [value](const std::vector<SlotState> &inputs, SimTime currentTime,
+                                       const ComponentState &prevState) {
+            auto newState = prevState;
+            newState.inputStates = inputs;
+            newState.isChanged = value(inputs, currentTime, prevState, newState.outputStates);
+            if (!newState.isChanged)
+                newState.outputStates = prevState.outputStates;
+            return newState;
+        };
+    }
+
     void ComponentDefinition::setAuxData(const std::any &data) {
+        // raw expression strings are compiled here, not on every evaluation
+        if (const auto *expressions = std::any_cast<std::vector<std::string>>(&data)) {
+            m_auxData = ExprEval::compileExpressions(*expressions);
+            return;
+        }
         m_auxData = data;
     }
 
@@ -149,7 +196,8 @@ namespace Bess::SimEngine {
     }
 
     void ComponentDefinition::onExpressionsChange() {
-        this->setAuxData(m_outputExpressions);
+        // compiled once here so exprEvalSimFunc never re-parses per evaluation
+        this->setAuxData(ExprEval::compileExpressions(m_outputExpressions));
     }
 
     SimTime ComponentDefinition::getRescheduleTime(SimTime currentTime) const {
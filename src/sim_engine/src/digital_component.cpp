@@ -4,6 +4,7 @@
 #include "events/sim_engine_events.h"
 #include "module_def.h"
 #include "types.h"
+#include <algorithm>
 #include <memory>
 
 namespace Bess::SimEngine {
@@ -74,6 +75,8 @@ namespace Bess::SimEngine {
                                       SlotState{LogicState::low, SimTime(0)});
             state.outputConnected.resize(newOutputCount, false);
             outputConnections.resize(newOutputCount);
+            if (newOutputCount < oldOutputCount)
+                rebuildFanOut();
 
             EventSystem::EventDispatcher::instance().queue(
                 Events::CompDefOutputsResizedEvent{this->id});
@@ -151,6 +154,8 @@ namespace Bess::SimEngine {
                                       SlotState{LogicState::low, SimTime(0)});
             state.outputConnected.resize(newOutputCount, false);
             outputConnections.resize(newOutputCount);
+            if (newOutputCount < oldOutputCount)
+                rebuildFanOut();
 
             dispatchOutputSlotCountChange(newOutputCount);
             EventSystem::EventDispatcher::instance().queue(
@@ -177,6 +182,9 @@ namespace Bess::SimEngine {
         definition->getOutputSlotsInfo().count -= 1;
         state.outputStates.pop_back();
         state.outputConnected.pop_back();
+        for (const auto &[dependant, slot] : outputConnections.back()) {
+            removeFanOut(dependant);
+        }
         outputConnections.pop_back();
         definition->computeHash();
 
@@ -253,6 +261,36 @@ namespace Bess::SimEngine {
         });
     }
 
+    void DigitalComponent::addFanOut(const UUID &dependant) {
+        const auto it = std::ranges::find(fanOut, dependant, &std::pair<UUID, uint32_t>::first);
+        if (it != fanOut.end()) {
+            it->second++;
+        } else {
+            fanOut.emplace_back(dependant, 1);
+        }
+    }
+
+    void DigitalComponent::removeFanOut(const UUID &dependant, uint32_t connectionCount) {
+        const auto it = std::ranges::find(fanOut, dependant, &std::pair<UUID, uint32_t>::first);
+        if (it == fanOut.end())
+            return;
+
+        if (it->second > connectionCount) {
+            it->second -= connectionCount;
+        } else {
+            fanOut.erase(it);
+        }
+    }
+
+    void DigitalComponent::rebuildFanOut() {
+        fanOut.clear();
+        for (const auto &slotConnections : outputConnections) {
+            for (const auto &[dependant, slot] : slotConnections) {
+                addFanOut(dependant);
+            }
+        }
+    }
+
     std::unordered_map<std::string, int> &DigitalComponent::getNameCountMap() {
         static std::unordered_map<std::string, int> nameCountMap;
         return nameCountMap;
@@ -296,5 +334,6 @@ namespace Bess::JsonConvert {
         comp.state.auxData = &comp.definition->getAuxData();
         fromJsonValue(j["input_connections"], comp.inputConnections);
         fromJsonValue(j["output_connections"], comp.outputConnections);
+        comp.rebuildFanOut();
     }
 } // namespace Bess::JsonConvert
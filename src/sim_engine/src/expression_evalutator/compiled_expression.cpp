@@ -0,0 +1,308 @@
+#include "expression_evalutator/compiled_expression.h"
+#include "common/logger.h"
+#include "expression_evalutator/expr_evaluator.h"
+
+#include <algorithm>
+#include <cctype>
+#include <stdexcept>
+
+namespace Bess::SimEngine::ExprEval {
+    namespace {
+        int precedence(char op) {
+            switch (op) {
+            case '$':
+                return 5;
+            case '!':
+                return 4;
+            case '*':
+                return 3;
+            case '^':
+                return 2;
+            case '+':
+                return 1;
+            default:
+                return 0;
+            }
+        }
+
+        // value of input k (k < 6) for the 64 patterns packed in one truth table word
+        constexpr uint64_t lanePatterns[6] = {
+            0xAAAAAAAAAAAAAAAAULL,
+            0xCCCCCCCCCCCCCCCCULL,
+            0xF0F0F0F0F0F0F0F0ULL,
+            0xFF00FF00FF00FF00ULL,
+            0xFFFF0000FFFF0000ULL,
+            0xFFFFFFFF00000000ULL,
+        };
+
+        [[noreturn]] void throwInvalid(const std::string &expr, const std::string &reason) {
+            BESS_ERROR("Invalid expression {}: {}", expr, reason);
+            throw std::runtime_error(std::format("Invalid expression '{}': {}", expr, reason));
+        }
+    } // namespace
+
+    CompiledExpression CompiledExpression::compile(const std::string &expr) {
+        CompiledExpression compiled;
+        auto &program = compiled.m_program;
+        std::vector<char> operators;
+        uint32_t depth = 0;
+
+        const auto emit = [&](char op) {
+            if (op == '(') {
+                throwInvalid(expr, "unbalanced parenthesis");
+            }
+
+            if (isUninaryOperator(op)) {
+                if (depth < 1)
+                    throwInvalid(expr, "missing operand");
+                // buffer is a no-op once parsed
+                if (op == '!')
+                    program.push_back({OpCode::notOp});
+                return;
+            }
+
+            if (depth < 2)
+                throwInvalid(expr, "missing operand");
+            depth--;
+            switch (op) {
+            case '*':
+                program.push_back({OpCode::andOp});
+                break;
+            case '+':
+                program.push_back({OpCode::orOp});
+                break;
+            case '^':
+                program.push_back({OpCode::xorOp});
+                break;
+            default:
+                throwInvalid(expr, "unsupported operator");
+            }
+        };
+
+        for (size_t i = 0; i < expr.size(); ++i) {
+            const char ch = expr[i];
+            if (std::isspace(static_cast<unsigned char>(ch)))
+                continue;
+
+            if (std::isdigit(static_cast<unsigned char>(ch))) {
+                uint64_t index = 0;
+                while (i < expr.size() && std::isdigit(static_cast<unsigned char>(expr[i]))) {
+                    index = index * 10 + static_cast<uint64_t>(expr[i] - '0');
+                    if (index > UINT32_MAX - 1)
+                        throwInvalid(expr, "input index too large");
+                    i++;
+                }
+                i--;
+                program.push_back({OpCode::pushInput, static_cast<uint32_t>(index)});
+                compiled.m_inputCount = std::max(compiled.m_inputCount, static_cast<uint32_t>(index) + 1);
+                depth++;
+                compiled.m_maxStackDepth = std::max(compiled.m_maxStackDepth, depth);
+            } else if (ch == '(') {
+                operators.push_back(ch);
+            } else if (ch == ')') {
+                while (!operators.empty() && operators.back() != '(') {
+                    emit(operators.back());
+                    operators.pop_back();
+                }
+                if (operators.empty())
+                    throwInvalid(expr, "unbalanced parenthesis");
+                operators.pop_back();
+            } else if (ch == '+' || ch == '*' || ch == '^') {
+                while (!operators.empty() && precedence(operators.back()) >= precedence(ch)) {
+                    emit(operators.back());
+                    operators.pop_back();
+                }
+                operators.push_back(ch);
+            } else if (isUninaryOperator(ch)) {
+                operators.push_back(ch);
+            } else {
+                throwInvalid(expr, std::format("invalid character '{}'", ch));
+            }
+        }
+
+        while (!operators.empty()) {
+            emit(operators.back());
+            operators.pop_back();
+        }
+
+        if (depth != 1) {
+            throwInvalid(expr, "expected exactly one result");
+        }
+
+        if (compiled.m_inputCount <= maxTableInputs) {
+            compiled.buildTruthTable();
+        }
+
+        return compiled;
+    }
+
+    void CompiledExpression::buildTruthTable() {
+        const uint32_t n = m_inputCount;
+        const size_t words = n <= 6 ? 1 : size_t{1} << (n - 6);
+        m_table.assign(words, 0);
+
+        // evaluates 64 input patterns per pass, one per bit
+        std::vector<uint64_t> inputs(n);
+        std::vector<uint64_t> stack(m_maxStackDepth);
+        for (size_t w = 0; w < words; w++) {
+            for (uint32_t i = 0; i < n; i++) {
+                inputs[i] = inputPattern(i, w);
+            }
+            m_table[w] = evaluateWords(inputs, stack);
+        }
+    }
+
+    uint64_t CompiledExpression::inputPattern(uint32_t input, uint64_t word) {
+        if (input < 6)
+            return lanePatterns[input];
+        if (input - 6 >= 64)
+            return 0;
+        return ((word >> (input - 6)) & 1) ? ~0ULL : 0ULL;
+    }
+
+    uint64_t CompiledExpression::evaluateWords(std::span<const uint64_t> inputs, std::span<uint64_t> stack) const {
+        size_t top = 0;
+        for (const auto &ins : m_program) {
+            switch (ins.code) {
+            case OpCode::pushInput:
+                stack[top++] = inputs[ins.operand];
+                break;
+            case OpCode::notOp:
+                stack[top - 1] = ~stack[top - 1];
+                break;
+            case OpCode::andOp:
+                top--;
+                stack[top - 1] &= stack[top];
+                break;
+            case OpCode::orOp:
+                top--;
+                stack[top - 1] |= stack[top];
+                break;
+            case OpCode::xorOp:
+                top--;
+                stack[top - 1] ^= stack[top];
+                break;
+            }
+        }
+        return stack[0];
+    }
+
+    uint64_t CompiledExpression::packInputs(std::span<const SlotState> inputs) {
+        uint64_t packed = 0;
+        const size_t count = std::min<size_t>(inputs.size(), 64);
+        for (size_t i = 0; i < count; i++) {
+            packed |= static_cast<uint64_t>(inputs[i].state == LogicState::high) << i;
+        }
+        return packed;
+    }
+
+    bool CompiledExpression::evaluate(std::span<const SlotState> inputs, uint64_t packed) const {
+        if (inputs.size() < m_inputCount) {
+            BESS_ERROR("Expression reads input {} but only {} inputs are present",
+                       m_inputCount - 1, inputs.size());
+            throw std::out_of_range("Index out of range in the values array");
+        }
+
+        if (!m_table.empty()) {
+            const uint64_t idx = packed & ((uint64_t{1} << m_inputCount) - 1);
+            return (m_table[idx >> 6] >> (idx & 63)) & 1;
+        }
+
+        return evaluateProgram(inputs);
+    }
+
+    bool CompiledExpression::evaluate(std::span<const SlotState> inputs) const {
+        return evaluate(inputs, m_table.empty() ? 0 : packInputs(inputs));
+    }
+
+    bool CompiledExpression::evaluateProgram(std::span<const SlotState> inputs) const {
+        const auto read = [&](uint32_t idx) {
+            return inputs[idx].state == LogicState::high;
+        };
+
+        // shallow programs keep their whole stack in one word, top at bit 0
+        if (m_maxStackDepth <= 64) {
+            uint64_t stack = 0;
+            for (const auto &ins : m_program) {
+                switch (ins.code) {
+                case OpCode::pushInput:
+                    stack = (stack << 1) | static_cast<uint64_t>(read(ins.operand));
+                    break;
+                case OpCode::notOp:
+                    stack ^= 1;
+                    break;
+                case OpCode::andOp:
+                    stack = (stack >> 1) & (~1ULL | stack);
+                    break;
+                case OpCode::orOp:
+                    stack = (stack >> 1) | (stack & 1);
+                    break;
+                case OpCode::xorOp:
+                    stack = (stack >> 1) ^ (stack & 1);
+                    break;
+                }
+            }
+            return stack & 1;
+        }
+
+        std::vector<uint8_t> stack;
+        stack.reserve(m_maxStackDepth);
+        for (const auto &ins : m_program) {
+            switch (ins.code) {
+            case OpCode::pushInput:
+                stack.push_back(read(ins.operand));
+                break;
+            case OpCode::notOp:
+                stack.back() ^= 1;
+                break;
+            case OpCode::andOp: {
+                const uint8_t b = stack.back();
+                stack.pop_back();
+                stack.back() &= b;
+            } break;
+            case OpCode::orOp: {
+                const uint8_t b = stack.back();
+                stack.pop_back();
+                stack.back() |= b;
+            } break;
+            case OpCode::xorOp: {
+                const uint8_t b = stack.back();
+                stack.pop_back();
+                stack.back() ^= b;
+            } break;
+            }
+        }
+        return stack.back();
+    }
+
+    uint32_t CompiledExpression::getInputCount() const {
+        return m_inputCount;
+    }
+
+    uint32_t CompiledExpression::getMaxStackDepth() const {
+        return m_maxStackDepth;
+    }
+
+    bool CompiledExpression::isTruthTable() const {
+        return !m_table.empty();
+    }
+
+    const std::vector<Instruction> &CompiledExpression::getProgram() const {
+        return m_program;
+    }
+
+    CompiledExpressions compileExpressions(const std::vector<std::string> &expressions) {
+        CompiledExpressions result;
+        result.expressions = expressions;
+        result.compiled.reserve(expressions.size());
+        try {
+            for (const auto &expr : expressions) {
+                result.compiled.push_back(CompiledExpression::compile(expr));
+            }
+        } catch (const std::exception &ex) {
+            result.compiled.clear();
+            result.error = ex.what();
+        }
+        return result;
+    }
+} // namespace Bess::SimEngine::ExprEval
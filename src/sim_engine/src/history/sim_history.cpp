@@ -0,0 +1,321 @@
+#include "history/sim_history.h"
+#include "common/bess_assert.h"
+#include "component_definition.h"
+#include "digital_component.h"
+
+#include <algorithm>
+
+namespace Bess::SimEngine {
+    void SimHistory::Position::clearUndo() {
+        slots.clear();
+        definitions.clear();
+        definitionBytes.clear();
+        popped.clear();
+    }
+
+    uint64_t SimHistory::Position::computeMemoryUsage() const {
+        return sizeof(Position) + slots.capacity() * sizeof(SlotUndo) +
+               definitions.capacity() * sizeof(DefinitionUndo) + definitionBytes.capacity() +
+               popped.capacity() * sizeof(SimulationEvent);
+    }
+
+    SimHistory::SimHistory(uint64_t memoryBudgetBytes, uint32_t keyframeInterval)
+        : m_memoryBudget(memoryBudgetBytes), m_keyframeInterval(std::max<uint32_t>(keyframeInterval, 1)) {}
+
+    void SimHistory::reset(const CompiledNetlist &netlist, SimTime simTime, uint64_t nextEventId) {
+        clear();
+        m_valid = true;
+        m_netlistVersion = netlist.getCompiledVersion();
+
+        auto &origin = m_positions.emplace_back();
+        origin.simTime = simTime;
+        origin.nextEventId = nextEventId;
+        origin.memoryUsage = origin.computeMemoryUsage();
+        m_memoryUsage += origin.memoryUsage;
+        captureKeyframe(netlist);
+    }
+
+    void SimHistory::clear() {
+        m_valid = false;
+        m_positions.clear();
+        m_keyframes.clear();
+        m_open.clearUndo();
+        m_memoryUsage = 0;
+    }
+
+    bool SimHistory::matches(const CompiledNetlist &netlist) const {
+        return m_valid && m_netlistVersion == netlist.getCompiledVersion();
+    }
+
+    void SimHistory::recordSlot(CompIndex idx, SlotType type, uint32_t slot, const SlotState &before) {
+        if (!m_valid)
+            return;
+        m_open.slots.push_back({before, idx, type == SlotType::digitalOutput ? slot | outputSlotFlag : slot});
+    }
+
+    void SimHistory::recordSlots(CompIndex idx, SlotType type, std::span<const SlotState> before,
+                                 std::span<const SlotState> after) {
+        if (!m_valid)
+            return;
+        const uint32_t flag = type == SlotType::digitalOutput ? outputSlotFlag : 0;
+        const size_t count = std::min(before.size(), after.size());
+        for (size_t i = 0; i < count; i++) {
+            if (before[i].sameValue(after[i]) && before[i].lastChangeTime == after[i].lastChangeTime)
+                continue;
+            m_open.slots.push_back({before[i], idx, static_cast<uint32_t>(i) | flag});
+        }
+    }
+
+    void SimHistory::recordDefinitionState(CompIndex idx, const ComponentDefinition &definition) {
+        if (!m_valid)
+            return;
+        appendDefinitionState(idx, definition, m_open.definitions, m_open.definitionBytes);
+    }
+
+    void SimHistory::appendDefinitionState(CompIndex idx, const ComponentDefinition &definition,
+                                           std::vector<DefinitionUndo> &definitions,
+                                           std::vector<uint8_t> &bytes) {
+        // most definitions have no runtime state and write nothing
+        m_definitionScratch.clear();
+        definition.writeCheckpointState(m_definitionScratch);
+        const auto &data = m_definitionScratch.getData();
+        if (data.empty())
+            return;
+        definitions.push_back({idx, static_cast<uint32_t>(bytes.size()), static_cast<uint32_t>(data.size())});
+        bytes.insert(bytes.end(), data.begin(), data.end());
+    }
+
+    void SimHistory::closeTimestep(const CompiledNetlist &netlist, SimTime simTime, uint64_t nextEventId,
+                                   std::span<const SimulationEvent> events) {
+        if (!matches(netlist)) {
+            // undo data recorded against another compilation can not be applied
+            reset(netlist, simTime, nextEventId);
+            return;
+        }
+
+        m_open.simTime = simTime;
+        m_open.nextEventId = nextEventId;
+        m_open.popped.assign(events.begin(), events.end());
+        m_open.memoryUsage = m_open.computeMemoryUsage();
+        m_memoryUsage += m_open.memoryUsage;
+        m_positions.push_back(std::move(m_open));
+
+        m_open = std::move(m_spare);
+        m_open.clearUndo();
+        m_spare = {};
+
+        if (getLastPosition() % m_keyframeInterval == 0)
+            captureKeyframe(netlist);
+        enforceBudget();
+    }
+
+    void SimHistory::captureKeyframe(const CompiledNetlist &netlist) {
+        auto &keyframe = m_keyframes.emplace_back();
+        keyframe.position = getLastPosition();
+        for (CompIndex idx = 0; idx < netlist.size(); idx++) {
+            const auto *comp = netlist.componentAt(idx);
+            keyframe.values.append(comp->state.inputStates);
+            keyframe.values.append(comp->state.outputStates);
+            for (const auto *slots : {&comp->state.inputStates, &comp->state.outputStates}) {
+                for (const auto &slot : *slots) {
+                    if (slot.value != 0)
+                        keyframe.words.emplace_back(static_cast<uint32_t>(keyframe.changeTimes.size()), slot.value);
+                    keyframe.changeTimes.push_back(slot.lastChangeTime);
+                }
+            }
+            appendDefinitionState(idx, *comp->definition, keyframe.definitions, keyframe.definitionBytes);
+        }
+        keyframe.memoryUsage = sizeof(Keyframe) + keyframe.values.getMemoryUsage() - sizeof(LogicVector) +
+                               keyframe.changeTimes.capacity() * sizeof(SimTime) +
+                               keyframe.words.capacity() * sizeof(keyframe.words[0]) +
+                               keyframe.definitions.capacity() * sizeof(DefinitionUndo) +
+                               keyframe.definitionBytes.capacity();
+        m_memoryUsage += keyframe.memoryUsage;
+    }
+
+    void SimHistory::restoreKeyframe(const Keyframe &keyframe, CompiledNetlist &netlist,
+                                     std::vector<CompIndex> &touched) {
+        size_t slot = 0;
+        auto word = keyframe.words.begin();
+        const auto restore = [&](std::vector<SlotState> &slots) {
+            for (auto &state : slots) {
+                state = {keyframe.values.get(slot), keyframe.changeTimes[slot]};
+                if (word != keyframe.words.end() && word->first == slot) {
+                    state.value = word->second;
+                    ++word;
+                }
+                slot++;
+            }
+        };
+        for (CompIndex idx = 0; idx < netlist.size(); idx++) {
+            auto &state = netlist.componentAt(idx)->state;
+            // the shapes can not have changed, that would have recompiled the netlist
+            restore(state.inputStates);
+            restore(state.outputStates);
+            netlist.syncOutputs(idx);
+            touch(idx, touched);
+        }
+
+        for (const auto &definition : keyframe.definitions) {
+            CheckpointReader reader(std::span(keyframe.definitionBytes).subspan(definition.offset, definition.size));
+            netlist.componentAt(definition.comp)->definition->readCheckpointState(reader);
+        }
+    }
+
+    void SimHistory::undo(const Position &position, CompiledNetlist &netlist, std::vector<CompIndex> &touched) {
+        for (auto it = position.slots.rbegin(); it != position.slots.rend(); ++it) {
+            auto &state = netlist.componentAt(it->comp)->state;
+            const uint32_t slot = it->slot & ~outputSlotFlag;
+            if (it->slot & outputSlotFlag) {
+                state.outputStates[slot] = it->before;
+                netlist.setOutput(it->comp, slot, it->before);
+            } else {
+                state.inputStates[slot] = it->before;
+            }
+            touch(it->comp, touched);
+        }
+
+        for (auto it = position.definitions.rbegin(); it != position.definitions.rend(); ++it) {
+            CheckpointReader reader(std::span(position.definitionBytes).subspan(it->offset, it->size));
+            netlist.componentAt(it->comp)->definition->readCheckpointState(reader);
+        }
+    }
+
+    void SimHistory::touch(CompIndex idx, std::vector<CompIndex> &touched) {
+        if (m_touchMarks[idx])
+            return;
+        m_touchMarks[idx] = 1;
+        touched.push_back(idx);
+    }
+
+    void SimHistory::rewind(uint64_t position, CompiledNetlist &netlist, SimHistoryRewind &out) {
+        BESS_ASSERT(matches(netlist) && position >= m_firstPosition && position <= getLastPosition(),
+                    "rewind() called with a position outside the history");
+        out.requeue.clear();
+        out.touched.clear();
+        m_touchMarks.assign(netlist.size(), 0);
+
+        const size_t target = position - m_firstPosition;
+        size_t undoCost = m_open.slots.size();
+        for (size_t i = target + 1; i < m_positions.size(); i++) {
+            undoCost += m_positions[i].slots.size();
+        }
+
+        // a keyframe between the target and the newest position saves undoing everything after it
+        size_t undoFrom = m_positions.size();
+        bool fromKeyframe = false;
+        const auto keyframe = std::ranges::lower_bound(m_keyframes, position, {}, &Keyframe::position);
+        if (keyframe != m_keyframes.end()) {
+            const size_t keyframeIndex = keyframe->position - m_firstPosition;
+            size_t keyframeCost = keyframe->values.size();
+            for (size_t i = target + 1; i <= keyframeIndex; i++) {
+                keyframeCost += m_positions[i].slots.size();
+            }
+            if (keyframeCost < undoCost) {
+                restoreKeyframe(*keyframe, netlist, out.touched);
+                undoFrom = keyframeIndex + 1;
+                fromKeyframe = true;
+            }
+        }
+
+        if (!fromKeyframe)
+            undo(m_open, netlist, out.touched);
+        for (size_t i = undoFrom; i-- > target + 1;) {
+            undo(m_positions[i], netlist, out.touched);
+        }
+
+        const auto &reached = m_positions[target];
+        out.simTime = reached.simTime;
+        out.nextEventId = reached.nextEventId;
+        for (size_t i = target + 1; i < m_positions.size(); i++) {
+            for (const auto &event : m_positions[i].popped) {
+                if (event.id < reached.nextEventId)
+                    out.requeue.push_back(event);
+            }
+        }
+
+        while (m_positions.size() > target + 1) {
+            m_memoryUsage -= m_positions.back().memoryUsage;
+            m_positions.pop_back();
+        }
+        while (!m_keyframes.empty() && m_keyframes.back().position > position) {
+            m_memoryUsage -= m_keyframes.back().memoryUsage;
+            m_keyframes.pop_back();
+        }
+        m_open.clearUndo();
+    }
+
+    bool SimHistory::findPosition(SimTime simTime, uint64_t &position) const {
+        if (m_positions.empty() || m_positions.front().simTime > simTime)
+            return false;
+        // times never decrease along the history
+        const auto it = std::ranges::upper_bound(m_positions, simTime, {}, &Position::simTime);
+        position = m_firstPosition + static_cast<uint64_t>(it - m_positions.begin()) - 1;
+        return true;
+    }
+
+    void SimHistory::dropOldest() {
+        auto &oldest = m_positions.front();
+        m_memoryUsage -= oldest.memoryUsage;
+        if (m_spare.slots.capacity() == 0)
+            m_spare = std::move(oldest);
+        m_positions.pop_front();
+        m_firstPosition++;
+        m_dropped++;
+
+        while (!m_keyframes.empty() && m_keyframes.front().position < m_firstPosition) {
+            m_memoryUsage -= m_keyframes.front().memoryUsage;
+            m_keyframes.pop_front();
+        }
+    }
+
+    void SimHistory::enforceBudget() {
+        // the newest position always stays, it is where the simulation is
+        while (m_memoryUsage > m_memoryBudget && m_positions.size() > 1) {
+            dropOldest();
+        }
+    }
+
+    bool SimHistory::empty() const {
+        return m_positions.empty();
+    }
+
+    uint64_t SimHistory::getFirstPosition() const {
+        return m_firstPosition;
+    }
+
+    uint64_t SimHistory::getLastPosition() const {
+        return m_firstPosition + m_positions.size() - 1;
+    }
+
+    SimTime SimHistory::getTimeAt(uint64_t position) const {
+        return m_positions[position - m_firstPosition].simTime;
+    }
+
+    SimHistoryStats SimHistory::getStats() const {
+        SimHistoryStats stats;
+        stats.positions = m_positions.size();
+        stats.keyframes = m_keyframes.size();
+        stats.dropped = m_dropped;
+        if (!m_positions.empty()) {
+            stats.oldestTime = m_positions.front().simTime;
+            stats.newestTime = m_positions.back().simTime;
+        }
+        stats.memoryUsage = m_memoryUsage;
+        stats.memoryBudget = m_memoryBudget;
+        return stats;
+    }
+
+    uint64_t SimHistory::getMemoryBudget() const {
+        return m_memoryBudget;
+    }
+
+    void SimHistory::setMemoryBudget(uint64_t bytes) {
+        m_memoryBudget = bytes;
+        enforceBudget();
+    }
+
+    uint64_t SimHistory::getMemoryUsage() const {
+        return m_memoryUsage;
+    }
+} // namespace Bess::SimEngine
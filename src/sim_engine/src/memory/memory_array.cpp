@@ -0,0 +1,130 @@
+#include "memory/memory_array.h"
+#include "checkpoint/sim_checkpoint.h"
+#include <algorithm>
+#include <format>
+#include <stdexcept>
+
+namespace Bess::SimEngine {
+    namespace {
+        constexpr size_t wordsFor(size_t width) {
+            return std::max<size_t>((width + 63) / 64, 1);
+        }
+
+        // bits of the last word of an entry that belong to it
+        constexpr uint64_t tailMask(size_t width) {
+            const size_t rest = width % 64;
+            return rest == 0 ? ~uint64_t{0} : (uint64_t{1} << rest) - 1;
+        }
+    } // namespace
+
+    MemoryArray::MemoryArray(size_t width, size_t depth)
+        : m_width(width),
+          m_depth(depth),
+          m_wordsPerEntry(wordsFor(width)),
+          m_zero(wordsFor(width), 0) {}
+
+    size_t MemoryArray::getWidth() const {
+        return m_width;
+    }
+
+    size_t MemoryArray::getDepth() const {
+        return m_depth;
+    }
+
+    size_t MemoryArray::getWordsPerEntry() const {
+        return m_wordsPerEntry;
+    }
+
+    size_t MemoryArray::getAllocatedDepth() const {
+        return m_wordsPerEntry == 0 ? 0 : m_data.size() / m_wordsPerEntry;
+    }
+
+    uint64_t MemoryArray::getMemoryUsage() const {
+        return sizeof(*this) + (m_data.capacity() + m_zero.capacity()) * sizeof(uint64_t);
+    }
+
+    std::span<const uint64_t> MemoryArray::read(size_t address) const {
+        if (address >= getAllocatedDepth())
+            return m_zero;
+        return {m_data.data() + address * m_wordsPerEntry, m_wordsPerEntry};
+    }
+
+    uint64_t MemoryArray::readWord(size_t address) const {
+        if (address >= getAllocatedDepth())
+            return 0;
+        return m_data[address * m_wordsPerEntry];
+    }
+
+    uint64_t *MemoryArray::entry(size_t address) {
+        if (address >= m_depth)
+            return nullptr;
+        if (address >= getAllocatedDepth()) {
+            // doubling keeps sequential fills amortized without reserving the whole depth
+            const size_t grown = std::min(std::max(address + 1, getAllocatedDepth() * 2), m_depth);
+            m_data.resize(grown * m_wordsPerEntry, 0);
+        }
+        return m_data.data() + address * m_wordsPerEntry;
+    }
+
+    void MemoryArray::write(size_t address, std::span<const uint64_t> data, std::span<const uint64_t> mask) {
+        auto *words = entry(address);
+        if (!words)
+            return;
+        const size_t count = std::min({m_wordsPerEntry, data.size(), mask.size()});
+        for (size_t i = 0; i < count; i++) {
+            auto bits = mask[i];
+            if (i + 1 == m_wordsPerEntry)
+                bits &= tailMask(m_width);
+            words[i] = (words[i] & ~bits) | (data[i] & bits);
+        }
+    }
+
+    void MemoryArray::writeWord(size_t address, uint64_t data, uint64_t mask) {
+        auto *words = entry(address);
+        if (!words)
+            return;
+        if (m_wordsPerEntry == 1)
+            mask &= tailMask(m_width);
+        words[0] = (words[0] & ~mask) | (data & mask);
+    }
+
+    void MemoryArray::loadInit(std::string_view bits) {
+        if (m_width == 0)
+            return;
+        const size_t entries = std::min(bits.size() / m_width, m_depth);
+        if (entries == 0)
+            return;
+        entry(entries - 1);
+        std::fill_n(m_data.begin(), entries * m_wordsPerEntry, 0);
+
+        // bit k of the flattened memory is bits[size - 1 - k]
+        for (size_t k = 0; k < entries * m_width; k++) {
+            if (bits[bits.size() - 1 - k] != '1')
+                continue;
+            const size_t address = k / m_width;
+            const size_t bit = k % m_width;
+            m_data[address * m_wordsPerEntry + bit / 64] |= uint64_t{1} << (bit % 64);
+        }
+    }
+
+    void MemoryArray::clear() {
+        m_data.clear();
+    }
+
+    void MemoryArray::writeCheckpoint(CheckpointWriter &out) const {
+        out.write(static_cast<uint64_t>(m_width));
+        out.write(static_cast<uint64_t>(getAllocatedDepth()));
+        out.writeSpan(std::span<const uint64_t>(m_data));
+    }
+
+    void MemoryArray::readCheckpoint(CheckpointReader &in) {
+        const auto width = in.read<uint64_t>();
+        const auto allocated = in.read<uint64_t>();
+        if (width != m_width || allocated > m_depth)
+            throw std::runtime_error(std::format("Memory of width {} and depth {} can not load {} entries of width {}",
+                                                 m_width, m_depth, allocated, width));
+        in.expect(allocated * m_wordsPerEntry, sizeof(uint64_t));
+        m_data.resize(allocated * m_wordsPerEntry);
+        in.readSpan(std::span<uint64_t>(m_data));
+    }
+} // namespace Bess::SimEngine
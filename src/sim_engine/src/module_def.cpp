@@ -35,7 +35,7 @@ namespace Bess::SimEngine {
         bool isInputChanged = false;
         for (size_t i = 0; i < inputs.size(); ++i) {
             newState.inputStates[i] = inputs[i];
-            isInputChanged = isInputChanged || (inputs[i].state != prevState.inputStates[i].state);
+            isInputChanged = isInputChanged || !inputs[i].sameValue(prevState.inputStates[i]);
         }
 
         auto &simEngine = SimulationEngine::instance();
@@ -50,7 +50,7 @@ namespace Bess::SimEngine {
         bool isChanged = false;
         for (size_t i = 0; i < outputState.inputStates.size(); ++i) {
             newState.outputStates[i] = outputState.inputStates[i];
-            if (newState.outputStates[i].state != prevState.outputStates[i].state) {
+            if (!newState.outputStates[i].sameValue(prevState.outputStates[i])) {
                 isChanged = true;
             }
         }
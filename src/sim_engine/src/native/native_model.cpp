@@ -0,0 +1,474 @@
+#include "native/native_model.h"
+#include "common/logger.h"
+#include "digital_component.h"
+#include "expression_evalutator/compiled_expression.h"
+#include "expression_evalutator/expr_evaluator.h"
+
+#include <algorithm>
+#include <cerrno>
+#include <cstdlib>
+#include <format>
+#include <fstream>
+#include <random>
+#include <stdexcept>
+#include <string_view>
+#include <system_error>
+
+#if defined(_WIN32)
+    #define WIN32_LEAN_AND_MEAN
+    #include <windows.h>
+#else
+    #include <dlfcn.h>
+    #include <sys/stat.h>
+    #include <unistd.h>
+#endif
+
+namespace Bess::SimEngine {
+    namespace {
+        std::string quote(const std::filesystem::path &path) {
+            std::string value = path.string();
+            std::string escaped;
+            escaped.reserve(value.size() + 2);
+            escaped.push_back('"');
+            for (const char ch : value) {
+                if (ch == '"' || ch == '\\') {
+                    escaped.push_back('\\');
+                }
+                escaped.push_back(ch);
+            }
+            escaped.push_back('"');
+            return escaped;
+        }
+
+        uint64_t hashText(uint64_t hash, std::string_view text) {
+            for (const char ch : text) {
+                hash ^= static_cast<uint8_t>(ch);
+                hash *= 0x100000001b3ULL;
+            }
+            return hash;
+        }
+
+        std::string commentSafe(std::string text) {
+            std::ranges::replace(text, '\n', ' ');
+            std::ranges::replace(text, '\r', ' ');
+            return text;
+        }
+
+        // one byte per net, so inversion is ^ 1 and never ~
+        std::string invert(const std::string &term) {
+            return std::format("({} ^ 1)", term);
+        }
+
+        const char *libraryExtension() {
+#if defined(_WIN32)
+            return ".dll";
+#elif defined(__APPLE__)
+            return ".dylib";
+#else
+            return ".so";
+#endif
+        }
+
+        // per user, so no other account can place a library there
+        std::filesystem::path defaultCacheDirectory() {
+#if defined(_WIN32)
+            if (const char *localAppData = std::getenv("LOCALAPPDATA"); localAppData && *localAppData)
+                return std::filesystem::path(localAppData) / "bess" / "native";
+#else
+            if (const char *xdgCache = std::getenv("XDG_CACHE_HOME");
+                xdgCache && std::filesystem::path(xdgCache).is_absolute())
+                return std::filesystem::path(xdgCache) / "bess" / "native";
+            if (const char *home = std::getenv("HOME"); home && *home)
+                return std::filesystem::path(home) / ".cache" / "bess" / "native";
+#endif
+            throw std::runtime_error("No per user cache directory for native models, set NativeModelConfig::cacheDirectory");
+        }
+
+        // Libraries from the cache are loaded into the process, so the directory and the
+        // library must belong to the current user and must not be writable by anyone else.
+        // On Windows the cache is under the per user LOCALAPPDATA and its ACLs are not checked.
+        void checkPrivate(const std::filesystem::path &path, bool directory) {
+#if !defined(_WIN32)
+            struct stat info{};
+            if (lstat(path.c_str(), &info) != 0) {
+                throw std::runtime_error(std::format("Failed to inspect {}: {}", path.string(),
+                                                     std::generic_category().message(errno)));
+            }
+            const bool expectedType = directory ? S_ISDIR(info.st_mode) : S_ISREG(info.st_mode);
+            if (!expectedType || info.st_uid != geteuid() || (info.st_mode & (S_IWGRP | S_IWOTH)) != 0) {
+                throw std::runtime_error(std::format("{} is not private to the current user, refusing to use it",
+                                                     path.string()));
+            }
+#else
+            (void)path;
+            (void)directory;
+#endif
+        }
+
+        void prepareCacheDirectory(const std::filesystem::path &directory) {
+#if defined(_WIN32)
+            std::filesystem::create_directories(directory);
+#else
+            if (directory.has_parent_path())
+                std::filesystem::create_directories(directory.parent_path());
+            // created 0700 in one step, an existing directory has to pass the check as it is
+            if (mkdir(directory.c_str(), S_IRWXU) != 0 && errno != EEXIST) {
+                throw std::runtime_error(std::format("Failed to create {}: {}", directory.string(),
+                                                     std::generic_category().message(errno)));
+            }
+#endif
+            checkPrivate(directory, true);
+        }
+
+        // pid and a random part, engines in several processes may build the same model
+        std::string uniqueBuildName() {
+            std::random_device device;
+            const uint64_t random = (uint64_t{device()} << 32) | device();
+#if defined(_WIN32)
+            const auto pid = GetCurrentProcessId();
+#else
+            const auto pid = getpid();
+#endif
+            return std::format("{}.{:016x}", pid, random);
+        }
+
+        void *openLibrary(const std::filesystem::path &path, std::string &error) {
+#if defined(_WIN32)
+            void *library = LoadLibraryW(path.wstring().c_str());
+            if (!library)
+                error = std::format("error {}", GetLastError());
+            return library;
+#else
+            void *library = dlopen(path.string().c_str(), RTLD_NOW | RTLD_LOCAL);
+            if (!library)
+                error = dlerror();
+            return library;
+#endif
+        }
+
+        void *findSymbol(void *library, const char *name) {
+#if defined(_WIN32)
+            return reinterpret_cast<void *>(GetProcAddress(static_cast<HMODULE>(library), name));
+#else
+            return dlsym(library, name);
+#endif
+        }
+
+        void closeLibrary(void *library) {
+#if defined(_WIN32)
+            FreeLibrary(static_cast<HMODULE>(library));
+#else
+            dlclose(library);
+#endif
+        }
+    } // namespace
+
+    NativeModelSource NativeModel::generate(const CompiledNetlist &netlist, const CycleSchedule &schedule) {
+        if (!schedule.isValid())
+            throw std::runtime_error("The netlist is not cycle scheduled");
+
+        NativeModelSource source;
+        source.netlistVersion = netlist.getCompiledVersion();
+
+        const size_t n = netlist.size();
+        source.outputNetBegin.resize(n + 1, 0);
+        for (CompIndex idx = 0; idx < n; idx++) {
+            source.outputNetBegin[idx + 1] = source.outputNetBegin[idx] + static_cast<uint32_t>(netlist.getOutputCount(idx));
+        }
+        const uint32_t netCount = source.outputNetBegin[n];
+
+        // an input is high if any of its drivers is, unconnected inputs read low
+        const auto inputTerm = [&](const DigitalComponent &comp, size_t slot) {
+            std::string term;
+            size_t drivers = 0;
+            for (const auto &[srcId, srcSlot] : comp.inputConnections[slot]) {
+                const auto srcIdx = netlist.indexOf(srcId);
+                if (srcIdx == invalidCompIndex)
+                    continue;
+                if (drivers++ > 0)
+                    term += " | ";
+                term += std::format("v[{}]", source.outputNetBegin[srcIdx] + srcSlot);
+            }
+            if (drivers == 0)
+                return std::string("0");
+            return drivers == 1 ? term : std::format("({})", term);
+        };
+
+        // expressions of the output slots of one component, in the order of its slots
+        const auto outputTerms = [&](CompIndex idx) {
+            const auto &comp = *netlist.componentAt(idx);
+            const auto &def = *comp.definition;
+            const size_t inputCount = netlist.getInputCount(idx);
+            const size_t outputCount = netlist.getOutputCount(idx);
+            for (size_t i = 0; i < inputCount; i++) {
+                if (def.getInputSlotsInfo().getWidth(i) > 1)
+                    throw std::runtime_error(std::format("{} has bus slots", def.getName()));
+            }
+            for (size_t i = 0; i < outputCount; i++) {
+                if (def.getOutputSlotsInfo().getWidth(i) > 1)
+                    throw std::runtime_error(std::format("{} has bus slots", def.getName()));
+            }
+
+            std::vector<std::string> terms;
+            const auto &op = def.getOpInfo();
+            if (op.op != '0') {
+                // same reduction as makeGateSimFunction, for any input count
+                if (ExprEval::isUninaryOperator(op.op)) {
+                    const bool inverted = (op.op == '!') != op.shouldNegateOutput;
+                    for (size_t i = 0; i < std::min(inputCount, outputCount); i++) {
+                        const auto term = inputTerm(comp, i);
+                        terms.push_back(inverted ? invert(term) : term);
+                    }
+                    return terms;
+                }
+
+                const char *joint = nullptr;
+                switch (op.op) {
+                case '*':
+                    joint = " & ";
+                    break;
+                case '+':
+                    joint = " | ";
+                    break;
+                case '^':
+                    joint = " ^ ";
+                    break;
+                default:
+                    throw std::runtime_error(std::format("{} uses the unsupported operator '{}'", def.getName(), op.op));
+                }
+                if (outputCount == 0 || inputCount == 0)
+                    return terms;
+
+                std::string term = "(";
+                for (size_t i = 0; i < inputCount; i++) {
+                    if (i > 0)
+                        term += joint;
+                    term += inputTerm(comp, i);
+                }
+                term += ")";
+                terms.push_back(op.shouldNegateOutput ? invert(term) : term);
+                return terms;
+            }
+
+            const auto *compiled = std::any_cast<ExprEval::CompiledExpressions>(&def.getAuxData());
+            if (def.getOutputExpressions().empty() || !compiled)
+                throw std::runtime_error(std::format("{} has no output expressions", def.getName()));
+            if (!compiled->error.empty())
+                throw std::runtime_error(std::format("{}: {}", def.getName(), compiled->error));
+
+            for (size_t i = 0; i < std::min(compiled->compiled.size(), outputCount); i++) {
+                std::vector<std::string> stack;
+                for (const auto &ins : compiled->compiled[i].getProgram()) {
+                    switch (ins.code) {
+                    case ExprEval::OpCode::pushInput:
+                        if (ins.operand >= inputCount)
+                            throw std::runtime_error(std::format("{} reads input {} of {}", def.getName(), ins.operand, inputCount));
+                        stack.push_back(inputTerm(comp, ins.operand));
+                        break;
+                    case ExprEval::OpCode::notOp:
+                        stack.back() = invert(stack.back());
+                        break;
+                    case ExprEval::OpCode::andOp:
+                    case ExprEval::OpCode::orOp:
+                    case ExprEval::OpCode::xorOp: {
+                        const char *joint = ins.code == ExprEval::OpCode::andOp  ? " & "
+                                            : ins.code == ExprEval::OpCode::orOp ? " | "
+                                                                                 : " ^ ";
+                        auto rhs = std::move(stack.back());
+                        stack.pop_back();
+                        stack.back() = std::format("({}{}{})", stack.back(), joint, rhs);
+                    } break;
+                    }
+                }
+                terms.push_back(std::move(stack.back()));
+            }
+            return terms;
+        };
+
+        // levels again, so each block only reads what earlier blocks computed
+        const auto order = schedule.getCombinationalOrder();
+        std::vector<uint32_t> levels(n, 0);
+        std::vector<std::vector<CompIndex>> byLevel;
+        for (const auto idx : order) {
+            const auto level = levels[idx];
+            if (byLevel.size() <= level)
+                byLevel.resize(level + 1);
+            byLevel[level].push_back(idx);
+            for (const auto dep : netlist.getDependants(idx)) {
+                if (schedule.getRole(dep) == CycleSchedule::Role::combinational)
+                    levels[dep] = std::max(levels[dep], level + 1);
+            }
+        }
+
+        std::string blocks;
+        std::string calls;
+        for (size_t level = 0; level < byLevel.size(); level++) {
+            std::string body;
+            size_t inBlock = 0;
+            const auto flush = [&] {
+                if (inBlock == 0)
+                    return;
+                blocks += std::format("    // level {}\n"
+                                      "    void block{}(u8 *__restrict v, u32 *__restrict changed, u32 &count) {{\n"
+                                      "{}"
+                                      "    }}\n\n",
+                                      level, source.blocks, body);
+                calls += std::format("    block{}(v, changed, count);\n", source.blocks);
+                source.blocks++;
+                body.clear();
+                inBlock = 0;
+            };
+
+            for (const auto idx : byLevel[level]) {
+                const auto &comp = *netlist.componentAt(idx);
+                if (comp.definition->getBehaviorType() == ComponentBehaviorType::output)
+                    continue;
+                const auto terms = outputTerms(idx);
+                if (terms.empty())
+                    continue;
+
+                body += std::format("        {{ // {} {}\n", commentSafe(comp.definition->getName()), idx);
+                body += "            u8 diff = 0;\n";
+                for (size_t slot = 0; slot < terms.size(); slot++) {
+                    const auto net = source.outputNetBegin[idx] + slot;
+                    body += std::format("            const u8 o{} = {};\n"
+                                        "            diff |= v[{}] ^ o{};\n"
+                                        "            v[{}] = o{};\n",
+                                        slot, terms[slot], net, slot, net, slot);
+                }
+                body += std::format("            if (diff)\n"
+                                    "                changed[count++] = {};\n"
+                                    "        }}\n",
+                                    idx);
+                source.combinational++;
+                if (++inBlock == maxBlockSize)
+                    flush();
+            }
+            flush();
+        }
+
+        // the code only depends on the netlist, equal netlists share one library
+        source.code = std::format("// Generated by the Bess simulation engine, do not edit.\n"
+                                  "#include <cstdint>\n\n"
+                                  "#if defined(_WIN32)\n"
+                                  "    #define BESS_NATIVE_EXPORT extern \"C\" __declspec(dllexport)\n"
+                                  "#else\n"
+                                  "    #define BESS_NATIVE_EXPORT extern \"C\" __attribute__((visibility(\"default\")))\n"
+                                  "#endif\n\n"
+                                  "namespace {{\n"
+                                  "    using u8 = std::uint8_t;\n"
+                                  "    using u32 = std::uint32_t;\n\n"
+                                  "{}"
+                                  "}} // namespace\n\n"
+                                  "BESS_NATIVE_EXPORT u32 bess_native_abi() {{\n"
+                                  "    return {};\n"
+                                  "}}\n\n"
+                                  "BESS_NATIVE_EXPORT u32 bess_native_nets() {{\n"
+                                  "    return {};\n"
+                                  "}}\n\n"
+                                  "BESS_NATIVE_EXPORT u32 bess_native_evaluate(u8 *v, u32 *changed) {{\n"
+                                  "    u32 count = 0;\n"
+                                  "{}"
+                                  "    return count;\n"
+                                  "}}\n",
+                                  blocks, abiVersion, netCount, calls);
+        source.hash = hashText(0xcbf29ce484222325ULL, source.code);
+        return source;
+    }
+
+    std::filesystem::path NativeModel::getLibraryPath(const NativeModelSource &source, const NativeModelConfig &config) {
+        uint64_t hash = hashText(source.hash, config.compilerPath.string());
+        for (const auto &flag : config.flags) {
+            hash = hashText(hash, flag);
+        }
+        const auto directory = config.cacheDirectory.empty() ? defaultCacheDirectory() : config.cacheDirectory;
+        return directory / std::format("bess_native_{:016x}{}", hash, libraryExtension());
+    }
+
+    std::shared_ptr<NativeModel> NativeModel::load(NativeModelSource source, const NativeModelConfig &config) {
+        const auto libraryPath = getLibraryPath(source, config);
+        std::shared_ptr<NativeModel> model(new NativeModel());
+        prepareCacheDirectory(libraryPath.parent_path());
+        model->m_cached = std::filesystem::exists(std::filesystem::symlink_status(libraryPath));
+
+        if (!model->m_cached) {
+            auto stem = libraryPath;
+            stem.replace_extension();
+            // built under unique names and renamed once complete, another engine may be building the same model
+            const auto buildName = std::format("{}.{}", stem.string(), uniqueBuildName());
+            const auto sourcePath = std::filesystem::path(buildName + ".cpp");
+            const auto logPath = std::filesystem::path(buildName + ".log");
+            const auto buildPath = std::filesystem::path(buildName + ".tmp");
+
+            {
+                std::ofstream sourceFile(sourcePath);
+                if (!sourceFile.is_open()) {
+                    throw std::runtime_error("Failed to write the native model source " + sourcePath.string());
+                }
+                sourceFile << source.code;
+            }
+
+            std::string command = quote(config.compilerPath);
+            for (const auto &flag : config.flags) {
+                command += " " + flag;
+            }
+            command += " -shared -fPIC -o " + quote(buildPath) + " " + quote(sourcePath) + " > " + quote(logPath) + " 2>&1";
+            BESS_INFO("[NativeModel] Compiling {} components into {}", source.combinational, libraryPath.string());
+            const int exitCode = std::system(command.c_str());
+            if (exitCode != 0) {
+                std::filesystem::remove(buildPath);
+                throw std::runtime_error(std::format("Compiling the native model failed with exit code {}, see {}",
+                                                     exitCode, logPath.string()));
+            }
+            // the umask may leave it group writable, which the check below would refuse
+            std::filesystem::permissions(buildPath, std::filesystem::perms::owner_all,
+                                         std::filesystem::perm_options::replace);
+            std::filesystem::rename(buildPath, libraryPath);
+            std::filesystem::rename(sourcePath, stem.string() + ".cpp");
+            std::filesystem::remove(logPath);
+        }
+
+        checkPrivate(libraryPath, false);
+        std::string error;
+        model->m_library = openLibrary(libraryPath, error);
+        if (!model->m_library) {
+            throw std::runtime_error(std::format("Failed to load the native model {}: {}", libraryPath.string(), error));
+        }
+
+        const auto abi = reinterpret_cast<uint32_t (*)()>(findSymbol(model->m_library, "bess_native_abi"));
+        const auto nets = reinterpret_cast<uint32_t (*)()>(findSymbol(model->m_library, "bess_native_nets"));
+        model->m_evaluate = reinterpret_cast<EvaluateFunction>(findSymbol(model->m_library, "bess_native_evaluate"));
+        if (!abi || !nets || !model->m_evaluate || abi() != abiVersion ||
+            nets() != source.outputNetBegin.back()) {
+            throw std::runtime_error("The native model " + libraryPath.string() + " does not match its netlist");
+        }
+
+        model->m_source = std::move(source);
+        return model;
+    }
+
+    NativeModel::~NativeModel() {
+        if (m_library)
+            closeLibrary(m_library);
+    }
+
+    const NativeModelSource &NativeModel::getSource() const {
+        return m_source;
+    }
+
+    uint32_t NativeModel::getNet(CompIndex idx, size_t slot) const {
+        return m_source.outputNetBegin[idx] + static_cast<uint32_t>(slot);
+    }
+
+    uint32_t NativeModel::getNetCount() const {
+        return m_source.outputNetBegin.back();
+    }
+
+    bool NativeModel::wasCached() const {
+        return m_cached;
+    }
+
+    uint32_t NativeModel::evaluate(uint8_t *nets, uint32_t *changed) const {
+        return m_evaluate(nets, changed);
+    }
+} // namespace Bess::SimEngine
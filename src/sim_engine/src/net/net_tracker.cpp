@@ -0,0 +1,350 @@
+#include "net/net_tracker.h"
+#include <algorithm>
+
+namespace Bess::SimEngine {
+    void NetTracker::clear() {
+        m_nodes.clear();
+        m_free.clear();
+        m_index.clear();
+        m_dirty.clear();
+        m_changed.clear();
+        m_removedNets.clear();
+        m_nets.clear();
+        m_visitGeneration = 0;
+        m_generation++;
+    }
+
+    uint32_t NetTracker::allocNode(const UUID &comp, const UUID &net) {
+        uint32_t node;
+        if (m_free.empty()) {
+            node = static_cast<uint32_t>(m_nodes.size());
+            m_nodes.emplace_back();
+        } else {
+            node = m_free.back();
+            m_free.pop_back();
+        }
+
+        auto &n = m_nodes[node];
+        n.comp = comp;
+        n.parent = n.next = n.prev = node;
+        n.nodes = n.live = 1;
+        n.visited = 0;
+        n.dirty = n.changed = false;
+        n.net = net;
+        n.adjacent.clear();
+        markChanged(node);
+        return node;
+    }
+
+    void NetTracker::freeNode(uint32_t node) {
+        auto &n = m_nodes[node];
+        n.comp = UUID::null;
+        n.parent = n.next = n.prev = node;
+        n.nodes = n.live = 0;
+        n.dirty = n.changed = false;
+        n.net = UUID::null;
+        n.adjacent.clear();
+        m_free.push_back(node);
+    }
+
+    uint32_t NetTracker::find(uint32_t node) {
+        // path halving, every other node on the way skips to its grandparent
+        while (m_nodes[node].parent != node) {
+            auto &n = m_nodes[node];
+            n.parent = m_nodes[n.parent].parent;
+            node = n.parent;
+        }
+        return node;
+    }
+
+    uint32_t NetTracker::findIndex(const UUID &comp) const {
+        const auto it = m_index.find(comp);
+        return it == m_index.end() ? invalidNode : it->second;
+    }
+
+    uint32_t NetTracker::resolve(uint32_t node) {
+        const auto root = find(node);
+        if (!m_nodes[root].dirty)
+            return root;
+        split(root);
+        return find(node);
+    }
+
+    void NetTracker::markDirty(uint32_t root) {
+        auto &n = m_nodes[root];
+        if (n.dirty)
+            return;
+        n.dirty = true;
+        m_dirty.push_back(root);
+    }
+
+    void NetTracker::markChanged(uint32_t root) {
+        auto &n = m_nodes[root];
+        if (n.changed)
+            return;
+        n.changed = true;
+        m_changed.push_back(root);
+
+        // without anyone reading the nets, stale entries of merged roots would pile up
+        if (m_changed.size() > 2 * m_nodes.size() + 64) {
+            std::erase_if(m_changed, [this](uint32_t e) {
+                return m_nodes[e].parent != e || !m_nodes[e].changed;
+            });
+        }
+    }
+
+    UUID NetTracker::addComponent(const UUID &comp, const UUID &netId) {
+        if (contains(comp))
+            return getNetOf(comp);
+
+        const UUID net = netId == UUID::null ? UUID() : netId;
+        m_index[comp] = allocNode(comp, net);
+        m_generation++;
+        return net;
+    }
+
+    void NetTracker::removeComponent(const UUID &comp) {
+        const auto node = findIndex(comp);
+        if (node == invalidNode)
+            return;
+        m_index.erase(comp);
+
+        auto &n = m_nodes[node];
+        for (const auto other : n.adjacent) {
+            if (other != node)
+                std::erase(m_nodes[other].adjacent, node);
+        }
+        n.adjacent.clear();
+        n.comp = UUID::null;
+        m_generation++;
+
+        const auto root = find(node);
+        auto &r = m_nodes[root];
+        if (r.live > 1) {
+            // the node stays in the list as a dead one until the net splits
+            r.live--;
+            markDirty(root);
+            markChanged(root);
+            return;
+        }
+
+        if (m_nets.contains(r.net))
+            m_removedNets.push_back(r.net);
+        m_members.clear();
+        auto it = root;
+        do {
+            m_members.push_back(it);
+            it = m_nodes[it].next;
+        } while (it != root);
+        for (const auto member : m_members) {
+            freeNode(member);
+        }
+    }
+
+    bool NetTracker::contains(const UUID &comp) const {
+        return m_index.contains(comp);
+    }
+
+    bool NetTracker::connect(const UUID &a, const UUID &b) {
+        const auto nodeA = findIndex(a);
+        const auto nodeB = findIndex(b);
+        // a wire from a component to itself changes no net
+        if (nodeA == invalidNode || nodeB == invalidNode || nodeA == nodeB)
+            return false;
+        m_nodes[nodeA].adjacent.push_back(nodeB);
+        m_nodes[nodeB].adjacent.push_back(nodeA);
+
+        auto winner = find(nodeA);
+        auto loser = find(nodeB);
+        if (winner == loser)
+            return false;
+        // union by size, the larger net keeps its id
+        if (m_nodes[winner].nodes < m_nodes[loser].nodes)
+            std::swap(winner, loser);
+
+        auto &w = m_nodes[winner];
+        auto &l = m_nodes[loser];
+        l.parent = winner;
+        w.nodes += l.nodes;
+        w.live += l.live;
+
+        // splice the two circular lists
+        const auto winnerNext = w.next;
+        const auto loserNext = l.next;
+        w.next = loserNext;
+        m_nodes[loserNext].prev = winner;
+        l.next = winnerNext;
+        m_nodes[winnerNext].prev = loser;
+
+        if (m_nets.contains(l.net))
+            m_removedNets.push_back(l.net);
+        if (l.dirty)
+            markDirty(winner);
+        markChanged(winner);
+        m_generation++;
+        return true;
+    }
+
+    void NetTracker::disconnect(const UUID &a, const UUID &b) {
+        const auto nodeA = findIndex(a);
+        const auto nodeB = findIndex(b);
+        if (nodeA == invalidNode || nodeB == invalidNode || nodeA == nodeB)
+            return;
+
+        auto &adjacentA = m_nodes[nodeA].adjacent;
+        auto &adjacentB = m_nodes[nodeB].adjacent;
+        const auto itA = std::ranges::find(adjacentA, nodeB);
+        const auto itB = std::ranges::find(adjacentB, nodeA);
+        if (itA == adjacentA.end() || itB == adjacentB.end())
+            return;
+        *itA = adjacentA.back();
+        adjacentA.pop_back();
+        *itB = adjacentB.back();
+        adjacentB.pop_back();
+
+        // another wire still joins them
+        if (std::ranges::find(adjacentA, nodeB) != adjacentA.end())
+            return;
+        markDirty(find(nodeA));
+        m_generation++;
+    }
+
+    void NetTracker::split(uint32_t root) {
+        const UUID oldNet = m_nodes[root].net;
+
+        m_members.clear();
+        auto it = root;
+        do {
+            m_members.push_back(it);
+            it = m_nodes[it].next;
+        } while (it != root);
+
+        if (++m_visitGeneration == 0) {
+            for (auto &n : m_nodes) {
+                n.visited = 0;
+            }
+            m_visitGeneration = 1;
+        }
+
+        // every part connected by wires becomes a net with its own list
+        m_roots.clear();
+        for (const auto start : m_members) {
+            auto &s = m_nodes[start];
+            if (s.comp == UUID::null || s.visited == m_visitGeneration)
+                continue;
+
+            uint32_t count = 0;
+            uint32_t last = start;
+            s.visited = m_visitGeneration;
+            m_stack.assign(1, start);
+            while (!m_stack.empty()) {
+                const auto node = m_stack.back();
+                m_stack.pop_back();
+                auto &n = m_nodes[node];
+                n.parent = start;
+                n.dirty = n.changed = false;
+                m_nodes[last].next = node;
+                n.prev = last;
+                last = node;
+                count++;
+                for (const auto other : n.adjacent) {
+                    auto &o = m_nodes[other];
+                    if (o.visited == m_visitGeneration)
+                        continue;
+                    o.visited = m_visitGeneration;
+                    m_stack.push_back(other);
+                }
+            }
+            m_nodes[last].next = start;
+            s.prev = last;
+            s.nodes = s.live = count;
+            m_roots.push_back(start);
+        }
+
+        for (const auto member : m_members) {
+            if (m_nodes[member].comp == UUID::null)
+                freeNode(member);
+        }
+
+        if (m_roots.empty()) {
+            if (m_nets.contains(oldNet))
+                m_removedNets.push_back(oldNet);
+            return;
+        }
+
+        // the largest part keeps the id, so a wire cut off the edge of a net does not rename it
+        const auto largest = *std::ranges::max_element(m_roots, {}, [this](uint32_t r) {
+            return m_nodes[r].live;
+        });
+        for (const auto r : m_roots) {
+            m_nodes[r].net = r == largest ? oldNet : UUID();
+            markChanged(r);
+        }
+        m_generation++;
+    }
+
+    void NetTracker::flush() {
+        for (size_t i = 0; i < m_dirty.size(); i++) {
+            const auto node = m_dirty[i];
+            const auto &n = m_nodes[node];
+            // entries of roots merged since then were handed to the new root
+            if (n.parent == node && n.dirty && n.nodes > 0)
+                split(node);
+        }
+        m_dirty.clear();
+    }
+
+    UUID NetTracker::getNetOf(const UUID &comp) {
+        const auto node = findIndex(comp);
+        if (node == invalidNode)
+            return UUID::null;
+        return m_nodes[resolve(node)].net;
+    }
+
+    bool NetTracker::isSameNet(const UUID &a, const UUID &b) {
+        const auto nodeA = findIndex(a);
+        const auto nodeB = findIndex(b);
+        if (nodeA == invalidNode || nodeB == invalidNode)
+            return false;
+        return resolve(nodeA) == find(nodeB);
+    }
+
+    const std::unordered_map<UUID, Net> &NetTracker::getNets(std::vector<UUID> *changedNets) {
+        flush();
+
+        for (const auto &net : m_removedNets) {
+            m_nets.erase(net);
+        }
+        m_removedNets.clear();
+
+        for (const auto node : m_changed) {
+            auto &n = m_nodes[node];
+            if (n.parent != node || !n.changed || n.live == 0)
+                continue;
+            n.changed = false;
+
+            auto &net = m_nets[n.net];
+            net.setUUID(n.net);
+            net.clear();
+            auto it = node;
+            do {
+                if (m_nodes[it].comp != UUID::null)
+                    net.addComponent(m_nodes[it].comp);
+                it = m_nodes[it].next;
+            } while (it != node);
+
+            if (changedNets)
+                changedNets->push_back(n.net);
+        }
+        m_changed.clear();
+        return m_nets;
+    }
+
+    uint64_t NetTracker::getGeneration() const {
+        return m_generation;
+    }
+
+    size_t NetTracker::getComponentCount() const {
+        return m_index.size();
+    }
+} // namespace Bess::SimEngine
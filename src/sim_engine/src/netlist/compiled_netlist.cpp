@@ -0,0 +1,187 @@
+#include "netlist/compiled_netlist.h"
+#include "digital_component.h"
+#include "sim_engine_state.h"
+
+#include <algorithm>
+
+namespace Bess::SimEngine {
+    void CompiledNetlist::clear() {
+        m_uuids.clear();
+        m_components.clear();
+        m_indexMap.clear();
+        m_inputSlotBegin.clear();
+        m_outputSlotBegin.clear();
+        m_fanInBegin.clear();
+        m_fanIn.clear();
+        m_dependantsBegin.clear();
+        m_dependants.clear();
+        m_outputValues.clear();
+        m_outputChangeTimes.clear();
+        m_outputWords.clear();
+        m_version = 0;
+    }
+
+    void CompiledNetlist::compile(const SimEngineState &state) {
+        clear();
+        m_version = state.getTopologyVersion();
+
+        const auto &digitalComponents = state.getDigitalComponents();
+        const size_t n = digitalComponents.size();
+
+        // sorted so that indices do not depend on hash map iteration order
+        m_uuids.reserve(n);
+        for (const auto &[uuid, comp] : digitalComponents) {
+            if (comp)
+                m_uuids.push_back(uuid);
+        }
+        std::ranges::sort(m_uuids, {}, [](const UUID &id) { return static_cast<uint64_t>(id); });
+
+        m_components.reserve(m_uuids.size());
+        m_indexMap.reserve(m_uuids.size());
+        m_inputSlotBegin.reserve(m_uuids.size() + 1);
+        m_outputSlotBegin.reserve(m_uuids.size() + 1);
+
+        uint32_t inputSlots = 0, outputSlots = 0;
+        for (CompIndex i = 0; i < m_uuids.size(); i++) {
+            auto *comp = digitalComponents.at(m_uuids[i]).get();
+            m_components.push_back(comp);
+            m_indexMap.emplace(m_uuids[i], i);
+            m_inputSlotBegin.push_back(inputSlots);
+            m_outputSlotBegin.push_back(outputSlots);
+            inputSlots += static_cast<uint32_t>(comp->inputConnections.size());
+            outputSlots += static_cast<uint32_t>(comp->outputConnections.size());
+        }
+        m_inputSlotBegin.push_back(inputSlots);
+        m_outputSlotBegin.push_back(outputSlots);
+
+        m_outputValues.resize(outputSlots, LogicState::low);
+        m_outputChangeTimes.resize(outputSlots, SimTime(0));
+        m_outputWords.resize(outputSlots, 0);
+        for (CompIndex i = 0; i < m_components.size(); i++) {
+            syncOutputs(i);
+        }
+
+        // fan-in, one entry per connected driver of every input slot
+        m_fanInBegin.reserve(inputSlots + 1);
+        for (const auto *comp : m_components) {
+            for (const auto &slotConnections : comp->inputConnections) {
+                m_fanInBegin.push_back(static_cast<uint32_t>(m_fanIn.size()));
+                for (const auto &[srcId, srcSlot] : slotConnections) {
+                    const CompIndex srcIdx = indexOf(srcId);
+                    if (srcIdx == invalidCompIndex || srcSlot < 0 ||
+                        static_cast<size_t>(srcSlot) >= getOutputCount(srcIdx))
+                        continue;
+                    m_fanIn.push_back(m_outputSlotBegin[srcIdx] + static_cast<uint32_t>(srcSlot));
+                }
+            }
+        }
+        m_fanInBegin.push_back(static_cast<uint32_t>(m_fanIn.size()));
+
+        // fan-out, already deduplicated per component as connections are made
+        m_dependantsBegin.reserve(m_components.size() + 1);
+        for (const auto *comp : m_components) {
+            m_dependantsBegin.push_back(static_cast<uint32_t>(m_dependants.size()));
+            for (const auto &[dstId, connectionCount] : comp->fanOut) {
+                const CompIndex dstIdx = indexOf(dstId);
+                if (dstIdx != invalidCompIndex)
+                    m_dependants.push_back(dstIdx);
+            }
+        }
+        m_dependantsBegin.push_back(static_cast<uint32_t>(m_dependants.size()));
+    }
+
+    uint64_t CompiledNetlist::getCompiledVersion() const {
+        return m_version;
+    }
+
+    size_t CompiledNetlist::size() const {
+        return m_components.size();
+    }
+
+    CompIndex CompiledNetlist::indexOf(const UUID &uuid) const {
+        const auto it = m_indexMap.find(uuid);
+        return it == m_indexMap.end() ? invalidCompIndex : it->second;
+    }
+
+    const UUID &CompiledNetlist::uuidOf(CompIndex idx) const {
+        return m_uuids[idx];
+    }
+
+    DigitalComponent *CompiledNetlist::componentAt(CompIndex idx) const {
+        return m_components[idx];
+    }
+
+    size_t CompiledNetlist::getInputCount(CompIndex idx) const {
+        return m_inputSlotBegin[idx + 1] - m_inputSlotBegin[idx];
+    }
+
+    size_t CompiledNetlist::getOutputCount(CompIndex idx) const {
+        return m_outputSlotBegin[idx + 1] - m_outputSlotBegin[idx];
+    }
+
+    bool CompiledNetlist::isShapeValid(CompIndex idx) const {
+        const auto *comp = m_components[idx];
+        return comp->inputConnections.size() == getInputCount(idx) &&
+               comp->outputConnections.size() == getOutputCount(idx);
+    }
+
+    void CompiledNetlist::gatherInputs(CompIndex idx, std::vector<SlotState> &out) const {
+        for (uint32_t slot = m_inputSlotBegin[idx]; slot < m_inputSlotBegin[idx + 1]; slot++) {
+            SlotState aggregated = {LogicState::low, SimTime(0)};
+
+            for (uint32_t f = m_fanInBegin[slot]; f < m_fanInBegin[slot + 1]; f++) {
+                const uint32_t src = m_fanIn[f];
+                const LogicState value = m_outputValues[src];
+
+                if (value == LogicState::high) {
+                    if (aggregated.state != LogicState::high) {
+                        aggregated = {value, m_outputChangeTimes[src]};
+                        aggregated.value = m_outputWords[src];
+                    } else {
+                        // bus drivers are wired-or
+                        aggregated.value |= m_outputWords[src];
+                        if (m_outputChangeTimes[src] > aggregated.lastChangeTime)
+                            aggregated.lastChangeTime = m_outputChangeTimes[src];
+                    }
+                } else if (value == LogicState::unknown && aggregated.state == LogicState::low) {
+                    aggregated = {value, m_outputChangeTimes[src]};
+                }
+            }
+
+            out.push_back(aggregated);
+        }
+    }
+
+    std::span<const CompIndex> CompiledNetlist::getDependants(CompIndex idx) const {
+        return {m_dependants.data() + m_dependantsBegin[idx],
+                m_dependants.data() + m_dependantsBegin[idx + 1]};
+    }
+
+    SlotState CompiledNetlist::getOutput(CompIndex idx, size_t slot) const {
+        const uint32_t global = m_outputSlotBegin[idx] + static_cast<uint32_t>(slot);
+        SlotState state{m_outputValues[global], m_outputChangeTimes[global]};
+        state.value = m_outputWords[global];
+        return state;
+    }
+
+    void CompiledNetlist::setOutput(CompIndex idx, size_t slot, const SlotState &state) {
+        if (slot >= getOutputCount(idx))
+            return;
+        const uint32_t global = m_outputSlotBegin[idx] + static_cast<uint32_t>(slot);
+        m_outputValues[global] = state.state;
+        m_outputChangeTimes[global] = state.lastChangeTime;
+        m_outputWords[global] = state.value;
+    }
+
+    bool CompiledNetlist::syncOutputs(CompIndex idx) {
+        const auto &outputs = m_components[idx]->state.outputStates;
+        const size_t count = std::min(outputs.size(), getOutputCount(idx));
+        const uint32_t begin = m_outputSlotBegin[idx];
+        for (size_t i = 0; i < count; i++) {
+            m_outputValues[begin + i] = outputs[i].state;
+            m_outputChangeTimes[begin + i] = outputs[i].lastChangeTime;
+            m_outputWords[begin + i] = outputs[i].value;
+        }
+        return outputs.size() == getOutputCount(idx);
+    }
+} // namespace Bess::SimEngine
@@ -0,0 +1,198 @@
+#include "netlist/cycle_schedule.h"
+#include "common/logger.h"
+#include "digital_component.h"
+#include "init_components.h"
+
+#include <algorithm>
+#include <format>
+#include <unordered_map>
+
+namespace Bess::SimEngine {
+    bool CycleSchedule::isCombinational(const ComponentDefinition &definition) {
+        if (definition.getShouldAutoReschedule() || definition.hasTrait<RegisterTrait>())
+            return false;
+        if (definition.hasTrait<CombinationalTrait>() ||
+            definition.getBehaviorType() == ComponentBehaviorType::output)
+            return true;
+        // python definitions may keep state next to their expressions
+        if (definition.getOwnership() == CompDefinitionOwnership::Python)
+            return false;
+        return definition.getOpInfo().op != '0' || !definition.getOutputExpressions().empty();
+    }
+
+    void CycleSchedule::clear() {
+        m_built = false;
+        m_valid = false;
+        m_version = 0;
+        m_fallbackReason.clear();
+        m_roles.clear();
+        m_ranks.clear();
+        m_order.clear();
+        m_depth = 0;
+        m_domains.clear();
+        m_registerCount = 0;
+    }
+
+    bool CycleSchedule::fail(std::string reason) {
+        BESS_DEBUG("[CycleSchedule] Staying event driven: {}", reason);
+        const auto version = m_version;
+        clear();
+        m_built = true;
+        m_version = version;
+        m_fallbackReason = std::move(reason);
+        return false;
+    }
+
+    bool CycleSchedule::build(const CompiledNetlist &netlist) {
+        clear();
+        m_built = true;
+        m_version = netlist.getCompiledVersion();
+
+        const size_t n = netlist.size();
+        m_roles.assign(n, Role::combinational);
+        m_ranks.assign(n, 0);
+
+        for (CompIndex idx = 0; idx < n; idx++) {
+            const auto *comp = netlist.componentAt(idx);
+            const auto &def = comp->definition;
+            if (!def)
+                return fail(std::format("Component {} has no definition", (uint64_t)comp->id));
+            if (comp->inputConnections.empty()) {
+                m_roles[idx] = Role::source;
+            } else if (def->hasTrait<RegisterTrait>()) {
+                m_roles[idx] = Role::reg;
+                m_registerCount++;
+            } else if (!isCombinational(*def)) {
+                return fail(std::format("{} keeps state without a register clock", def->getName()));
+            }
+        }
+
+        // levelize, a component runs after every combinational component driving it
+        std::vector<uint32_t> pendingDrivers(n, 0);
+        for (CompIndex idx = 0; idx < n; idx++) {
+            if (m_roles[idx] != Role::combinational)
+                continue;
+            for (const auto dep : netlist.getDependants(idx)) {
+                if (m_roles[dep] == Role::combinational)
+                    pendingDrivers[dep]++;
+            }
+        }
+
+        std::vector<uint32_t> levels(n, 0);
+        size_t combinationalCount = 0;
+        for (CompIndex idx = 0; idx < n; idx++) {
+            if (m_roles[idx] != Role::combinational)
+                continue;
+            combinationalCount++;
+            if (pendingDrivers[idx] == 0)
+                m_order.push_back(idx);
+        }
+        for (size_t i = 0; i < m_order.size(); i++) {
+            const auto idx = m_order[i];
+            m_ranks[idx] = static_cast<uint32_t>(i);
+            m_depth = std::max(m_depth, levels[idx] + 1);
+            for (const auto dep : netlist.getDependants(idx)) {
+                if (m_roles[dep] != Role::combinational)
+                    continue;
+                levels[dep] = std::max(levels[dep], levels[idx] + 1);
+                if (--pendingDrivers[dep] == 0)
+                    m_order.push_back(dep);
+            }
+        }
+
+        if (m_order.size() != combinationalCount)
+            return fail("The combinational logic has a loop");
+
+        // clock and asynchronous slots must follow a source without logic in between
+        std::unordered_map<uint64_t, size_t> domainOf;
+        for (CompIndex idx = 0; idx < n; idx++) {
+            if (m_roles[idx] != Role::reg)
+                continue;
+            const auto *comp = netlist.componentAt(idx);
+            const auto trait = comp->definition->getTrait<RegisterTrait>();
+
+            const auto sourceOf = [&](int slot, CompIndex &source, uint32_t &sourceSlot) {
+                if (slot < 0 || static_cast<size_t>(slot) >= comp->inputConnections.size())
+                    return true;
+                source = invalidCompIndex;
+                for (const auto &[srcId, srcSlot] : comp->inputConnections[slot]) {
+                    const auto srcIdx = netlist.indexOf(srcId);
+                    if (srcIdx == invalidCompIndex)
+                        continue;
+                    if (source != invalidCompIndex || m_roles[srcIdx] != Role::source)
+                        return false;
+                    source = srcIdx;
+                    sourceSlot = static_cast<uint32_t>(srcSlot);
+                }
+                return true;
+            };
+
+            for (const auto slot : trait->asyncSlots) {
+                CompIndex source = invalidCompIndex;
+                uint32_t sourceSlot = 0;
+                if (!sourceOf(slot, source, sourceSlot))
+                    return fail(std::format("Asynchronous input of {} is driven by logic", comp->definition->getName()));
+            }
+
+            for (const auto slot : trait->clockSlots) {
+                CompIndex source = invalidCompIndex;
+                uint32_t sourceSlot = 0;
+                if (!sourceOf(slot, source, sourceSlot))
+                    return fail(std::format("Clock of {} is derived from logic", comp->definition->getName()));
+                if (source == invalidCompIndex)
+                    continue;
+
+                const uint64_t key = (static_cast<uint64_t>(source) << 32) | sourceSlot;
+                auto [it, inserted] = domainOf.try_emplace(key, m_domains.size());
+                if (inserted) {
+                    const auto &sourceDef = netlist.componentAt(source)->definition;
+                    m_domains.push_back({source, sourceSlot, sourceDef->hasTrait<ClockTrait>(), {}});
+                }
+                auto &registers = m_domains[it->second].registers;
+                if (registers.empty() || registers.back() != idx)
+                    registers.push_back(idx);
+            }
+        }
+
+        m_valid = true;
+        BESS_DEBUG("[CycleSchedule] {} registers in {} clock domains, {} combinational components {} deep",
+                   m_registerCount, m_domains.size(), m_order.size(), m_depth);
+        return true;
+    }
+
+    bool CycleSchedule::isBuiltFor(uint64_t netlistVersion) const {
+        return m_built && m_version == netlistVersion;
+    }
+
+    bool CycleSchedule::isValid() const {
+        return m_valid;
+    }
+
+    const std::string &CycleSchedule::getFallbackReason() const {
+        return m_fallbackReason;
+    }
+
+    CycleSchedule::Role CycleSchedule::getRole(CompIndex idx) const {
+        return m_roles[idx];
+    }
+
+    std::span<const CompIndex> CycleSchedule::getCombinationalOrder() const {
+        return m_order;
+    }
+
+    uint32_t CycleSchedule::getRank(CompIndex idx) const {
+        return m_ranks[idx];
+    }
+
+    uint32_t CycleSchedule::getDepth() const {
+        return m_depth;
+    }
+
+    const std::vector<ClockDomain> &CycleSchedule::getClockDomains() const {
+        return m_domains;
+    }
+
+    size_t CycleSchedule::getRegisterCount() const {
+        return m_registerCount;
+    }
+} // namespace Bess::SimEngine
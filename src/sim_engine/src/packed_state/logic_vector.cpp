@@ -0,0 +1,125 @@
+#include "packed_state/logic_vector.h"
+#include <algorithm>
+
+namespace Bess::SimEngine {
+    namespace {
+        constexpr size_t wordPairs(size_t size) {
+            return (size + 63) / 64;
+        }
+
+        constexpr LogicState decode(uint64_t value, uint64_t strength) {
+            if (strength == 0)
+                return value == 0 ? LogicState::low : LogicState::high;
+            return value == 0 ? LogicState::high_z : LogicState::unknown;
+        }
+    } // namespace
+
+    LogicVector::LogicVector(size_t size, LogicState fill) {
+        resize(size, fill);
+    }
+
+    size_t LogicVector::size() const {
+        return m_size;
+    }
+
+    bool LogicVector::empty() const {
+        return m_size == 0;
+    }
+
+    void LogicVector::resize(size_t size, LogicState fill) {
+        const size_t oldSize = m_size;
+        if (size < oldSize) {
+            m_size = size;
+            m_words.resize(wordPairs(size) * 2);
+            clearTail();
+            return;
+        }
+
+        m_words.resize(wordPairs(size) * 2, 0);
+        m_size = size;
+        for (size_t i = oldSize; i < size; i++) {
+            set(i, fill);
+        }
+    }
+
+    void LogicVector::clear() {
+        m_size = 0;
+        m_words.clear();
+    }
+
+    LogicState LogicVector::get(size_t idx) const {
+        const size_t word = (idx / 64) * 2;
+        const uint64_t bit = idx % 64;
+        return decode((m_words[word] >> bit) & 1, (m_words[word + 1] >> bit) & 1);
+    }
+
+    void LogicVector::set(size_t idx, LogicState state) {
+        const size_t word = (idx / 64) * 2;
+        const uint64_t mask = uint64_t{1} << (idx % 64);
+        m_words[word] = (m_words[word] & ~mask) | (valueBit(state) ? mask : 0);
+        m_words[word + 1] = (m_words[word + 1] & ~mask) | (strengthBit(state) ? mask : 0);
+    }
+
+    void LogicVector::fill(LogicState state) {
+        const uint64_t value = valueBit(state) ? ~uint64_t{0} : 0;
+        const uint64_t strength = strengthBit(state) ? ~uint64_t{0} : 0;
+        for (size_t w = 0; w < m_words.size(); w += 2) {
+            m_words[w] = value;
+            m_words[w + 1] = strength;
+        }
+        clearTail();
+    }
+
+    void LogicVector::clearTail() {
+        // bits past the end stay zero, so equality can compare whole words
+        if (m_size % 64 == 0)
+            return;
+        const uint64_t mask = (uint64_t{1} << (m_size % 64)) - 1;
+        m_words[m_words.size() - 2] &= mask;
+        m_words.back() &= mask;
+    }
+
+    void LogicVector::assign(std::span<const SlotState> slots) {
+        clear();
+        append(slots);
+    }
+
+    void LogicVector::append(std::span<const SlotState> slots) {
+        const size_t begin = m_size;
+        m_size += slots.size();
+        m_words.resize(wordPairs(m_size) * 2, 0);
+        for (size_t i = 0; i < slots.size(); i++) {
+            const size_t idx = begin + i;
+            const uint64_t bit = idx % 64;
+            m_words[(idx / 64) * 2] |= valueBit(slots[i].state) << bit;
+            m_words[(idx / 64) * 2 + 1] |= strengthBit(slots[i].state) << bit;
+        }
+    }
+
+    void LogicVector::copyTo(std::span<SlotState> slots) const {
+        const size_t count = std::min(slots.size(), m_size);
+        for (size_t i = 0; i < count; i++) {
+            slots[i].state = get(i);
+        }
+    }
+
+    bool LogicVector::isKnown() const {
+        for (size_t w = 1; w < m_words.size(); w += 2) {
+            if (m_words[w] != 0)
+                return false;
+        }
+        return true;
+    }
+
+    std::span<const uint64_t> LogicVector::getWords() const {
+        return m_words;
+    }
+
+    uint64_t LogicVector::getMemoryUsage() const {
+        return sizeof(LogicVector) + m_words.capacity() * sizeof(uint64_t);
+    }
+
+    bool LogicVector::operator==(const LogicVector &other) const {
+        return m_size == other.m_size && m_words == other.m_words;
+    }
+} // namespace Bess::SimEngine
@@ -0,0 +1,180 @@
+#include "parallel/work_stealing_pool.h"
+
+#include <algorithm>
+
+namespace Bess::SimEngine {
+    namespace {
+        // yields before a worker goes to sleep, timesteps follow each other closely
+        constexpr int idleSpins = 1000;
+
+        // range layout: job tag (16 bits) | begin (24 bits) | end (24 bits)
+        constexpr uint64_t indexMask = (uint64_t{1} << 24) - 1;
+
+        uint32_t beginOf(uint64_t range) {
+            return static_cast<uint32_t>((range >> 24) & indexMask);
+        }
+
+        uint32_t endOf(uint64_t range) {
+            return static_cast<uint32_t>(range & indexMask);
+        }
+
+        uint64_t tagOf(uint64_t range) {
+            return range >> 48;
+        }
+    } // namespace
+
+    WorkStealingPool::WorkStealingPool(size_t threadCount)
+        : m_shares(std::make_unique<Share[]>(std::max<size_t>(threadCount, 1))),
+          m_threadCount(std::max<size_t>(threadCount, 1)) {
+        m_workers.reserve(m_threadCount - 1);
+        for (size_t i = 1; i < m_threadCount; i++) {
+            m_workers.emplace_back(&WorkStealingPool::workerLoop, this, i);
+        }
+    }
+
+    WorkStealingPool::~WorkStealingPool() {
+        {
+            std::lock_guard lk(m_mutex);
+            m_stop.store(true);
+        }
+        m_cv.notify_all();
+        for (auto &worker : m_workers) {
+            worker.join();
+        }
+    }
+
+    size_t WorkStealingPool::getThreadCount() const {
+        return m_threadCount;
+    }
+
+    uint64_t WorkStealingPool::pack(uint64_t tag, uint32_t begin, uint32_t end) {
+        return (tag << 48) | (static_cast<uint64_t>(begin) << 24) | end;
+    }
+
+    void WorkStealingPool::parallelFor(size_t count, size_t grain, const RangeFunction &body) {
+        if (count == 0)
+            return;
+
+        grain = std::max<size_t>(grain, 1);
+        if (m_threadCount == 1 || count <= grain) {
+            body(0, count);
+            return;
+        }
+
+        // indices are packed in 24 bits, larger ranges run in slices
+        if (count > maxSliceSize) {
+            for (size_t offset = 0; offset < count; offset += maxSliceSize) {
+                const size_t slice = std::min(maxSliceSize, count - offset);
+                const RangeFunction shifted = [&body, offset](size_t begin, size_t end) {
+                    body(begin + offset, end + offset);
+                };
+                parallelFor(slice, grain, shifted);
+            }
+            return;
+        }
+
+        m_body.store(&body, std::memory_order_relaxed);
+        m_grain.store(static_cast<uint32_t>(std::min(grain, maxSliceSize)), std::memory_order_relaxed);
+        m_remaining.store(count, std::memory_order_relaxed);
+
+        // the tag makes a thief still holding a range of the previous job fail its CAS
+        m_tag = (m_tag + 1) & 0xFFFF;
+        for (size_t i = 0; i < m_threadCount; i++) {
+            const auto begin = static_cast<uint32_t>(count * i / m_threadCount);
+            const auto end = static_cast<uint32_t>(count * (i + 1) / m_threadCount);
+            m_shares[i].range.store(pack(m_tag, begin, end), std::memory_order_release);
+        }
+
+        {
+            std::lock_guard lk(m_mutex);
+            m_generation.fetch_add(1, std::memory_order_release);
+        }
+        m_cv.notify_all();
+
+        participate(0);
+        while (m_remaining.load(std::memory_order_acquire) != 0) {
+            std::this_thread::yield();
+        }
+    }
+
+    void WorkStealingPool::workerLoop(size_t self) {
+        uint64_t seen = 0;
+        while (true) {
+            for (int i = 0; i < idleSpins && m_generation.load(std::memory_order_acquire) == seen; i++) {
+                std::this_thread::yield();
+            }
+
+            if (m_generation.load(std::memory_order_acquire) == seen) {
+                std::unique_lock lk(m_mutex);
+                m_cv.wait(lk, [&] {
+                    return m_stop.load() || m_generation.load(std::memory_order_acquire) != seen;
+                });
+            }
+
+            if (m_stop.load())
+                return;
+
+            seen = m_generation.load(std::memory_order_acquire);
+            participate(self);
+        }
+    }
+
+    void WorkStealingPool::participate(size_t self) {
+        uint32_t begin = 0, end = 0;
+        while (takeOwn(self, begin, end) || steal(self, begin, end)) {
+            (*m_body.load(std::memory_order_relaxed))(begin, end);
+            m_remaining.fetch_sub(end - begin, std::memory_order_acq_rel);
+        }
+    }
+
+    bool WorkStealingPool::takeOwn(size_t self, uint32_t &begin, uint32_t &end) {
+        auto &range = m_shares[self].range;
+        const uint32_t grain = m_grain.load(std::memory_order_relaxed);
+        uint64_t current = range.load(std::memory_order_acquire);
+        while (beginOf(current) < endOf(current)) {
+            const uint32_t next = std::min(endOf(current), beginOf(current) + grain);
+            if (range.compare_exchange_weak(current, pack(tagOf(current), next, endOf(current)),
+                                            std::memory_order_acq_rel, std::memory_order_acquire)) {
+                begin = beginOf(current);
+                end = next;
+                return true;
+            }
+        }
+        return false;
+    }
+
+    bool WorkStealingPool::steal(size_t self, uint32_t &begin, uint32_t &end) {
+        const uint32_t grain = m_grain.load(std::memory_order_relaxed);
+        for (size_t k = 1; k < m_threadCount; k++) {
+            auto &victim = m_shares[(self + k) % m_threadCount].range;
+            uint64_t current = victim.load(std::memory_order_acquire);
+            while (beginOf(current) < endOf(current)) {
+                const uint32_t b = beginOf(current), e = endOf(current);
+                const uint64_t tag = tagOf(current);
+
+                // small leftovers are run directly, otherwise the back half becomes our share
+                if (e - b <= grain) {
+                    if (victim.compare_exchange_weak(current, pack(tag, e, e),
+                                                     std::memory_order_acq_rel, std::memory_order_acquire)) {
+                        begin = b;
+                        end = e;
+                        return true;
+                    }
+                    continue;
+                }
+
+                const uint32_t mid = b + (e - b) / 2;
+                if (victim.compare_exchange_weak(current, pack(tag, b, mid),
+                                                 std::memory_order_acq_rel, std::memory_order_acquire)) {
+                    m_shares[self].range.store(pack(tag, mid, e), std::memory_order_release);
+                    if (takeOwn(self, begin, end))
+                        return true;
+                    // robbed in between, scan all victims again
+                    k = 0;
+                    break;
+                }
+            }
+        }
+        return false;
+    }
+} // namespace Bess::SimEngine
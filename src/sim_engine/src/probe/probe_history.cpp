@@ -0,0 +1,319 @@
+#include "probe/probe_history.h"
+
+#include <algorithm>
+
+namespace Bess::SimEngine {
+    namespace {
+        void writeVarint(std::vector<uint8_t> &bytes, uint64_t value) {
+            while (value >= 0x80) {
+                bytes.push_back(static_cast<uint8_t>(value) | 0x80);
+                value >>= 7;
+            }
+            bytes.push_back(static_cast<uint8_t>(value));
+        }
+
+        uint64_t readVarint(const uint8_t *&pos) {
+            uint64_t value = 0;
+            for (int shift = 0;; shift += 7) {
+                const uint8_t byte = *pos++;
+                value |= static_cast<uint64_t>(byte & 0x7F) << shift;
+                if (!(byte & 0x80))
+                    return value;
+            }
+        }
+
+        uint8_t stateBit(LogicState state) {
+            return static_cast<uint8_t>(1u << static_cast<uint8_t>(state));
+        }
+    } // namespace
+
+    void ProbeHistory::Summary::merge(const Summary &other) {
+        transitions += other.transitions;
+        stateMask |= other.stateMask;
+        last = other.last;
+    }
+
+    ProbeHistory::ProbeHistory(uint64_t memoryLimitBytes) : m_memoryLimit(memoryLimitBytes) {}
+
+    void ProbeHistory::append(SimTime time, LogicState state) {
+        if (!m_chunks.empty()) {
+            if (time < m_lastTime) {
+                clear();
+            } else if (state == getLastState()) {
+                return;
+            }
+        }
+
+        if (m_chunks.empty() || m_chunks.back().summary.transitions >= chunkTransitions) {
+            if (!m_chunks.empty())
+                closeChunk();
+            m_chunks.emplace_back();
+            m_chunks.back().begin = time;
+            m_chunks.back().end = time;
+            enforceLimit();
+        }
+
+        auto &chunk = m_chunks.back();
+        const auto delta = static_cast<uint64_t>((time - chunk.end).count());
+        writeVarint(chunk.bytes, (delta << 2) | static_cast<uint8_t>(state));
+        chunk.end = time;
+        chunk.summary.transitions++;
+        chunk.summary.stateMask |= stateBit(state);
+        chunk.summary.last = state;
+
+        m_lastTime = time;
+        m_transitions++;
+    }
+
+    void ProbeHistory::clear() {
+        m_chunks.clear();
+        m_pyramid.clear();
+        m_closedBytes = 0;
+        m_transitions = 0;
+        m_dropped = 0;
+        m_lastTime = SimTime(0);
+        m_decodedChunk = UINT64_MAX;
+    }
+
+    void ProbeHistory::closeChunk() {
+        auto &chunk = m_chunks.back();
+        chunk.bytes.shrink_to_fit();
+        m_closedBytes += chunk.bytes.size();
+        pushSummary(m_chunks.size() - 1);
+    }
+
+    void ProbeHistory::enforceLimit() {
+        bool dropped = false;
+        while (m_chunks.size() > 1 && getMemoryUsage() > m_memoryLimit) {
+            const auto &oldest = m_chunks.front();
+            m_closedBytes -= oldest.bytes.size();
+            m_transitions -= oldest.summary.transitions;
+            m_dropped += oldest.summary.transitions;
+            m_chunks.pop_front();
+            m_droppedChunks++;
+            dropped = true;
+        }
+
+        if (dropped)
+            rebuildPyramid();
+    }
+
+    void ProbeHistory::rebuildPyramid() {
+        m_pyramid.clear();
+        for (size_t i = 0; i + 1 < m_chunks.size(); i++) {
+            pushSummary(i);
+        }
+    }
+
+    void ProbeHistory::pushSummary(size_t chunk) {
+        if (m_pyramid.empty())
+            m_pyramid.emplace_back();
+        m_pyramid[0].push_back(m_chunks[chunk].summary);
+
+        size_t i = m_pyramid[0].size() - 1;
+        for (size_t level = 0; m_pyramid[level].size() > 1; level++) {
+            if (level + 1 == m_pyramid.size())
+                m_pyramid.emplace_back();
+
+            const auto &children = m_pyramid[level];
+            const size_t parent = i / pyramidFanout;
+            const size_t end = std::min(children.size(), (parent + 1) * pyramidFanout);
+            Summary merged;
+            for (size_t c = parent * pyramidFanout; c < end; c++) {
+                merged.merge(children[c]);
+            }
+
+            auto &parents = m_pyramid[level + 1];
+            if (parent == parents.size()) {
+                parents.push_back(merged);
+            } else {
+                parents[parent] = merged;
+            }
+            i = parent;
+        }
+    }
+
+    ProbeHistory::Summary ProbeHistory::mergeChunks(size_t a, size_t b) const {
+        Summary result;
+        if (a >= b)
+            return result;
+
+        // counts and masks do not depend on the merge order, the last state is taken directly
+        const LogicState last = m_chunks[b - 1].summary.last;
+        const size_t closed = m_chunks.size() - 1;
+        if (b > closed) {
+            result.merge(m_chunks.back().summary);
+            b = closed;
+        }
+
+        for (size_t level = 0; a < b; level++) {
+            const auto &summaries = m_pyramid[level];
+            if (level + 1 == m_pyramid.size()) {
+                for (; a < b; a++) {
+                    result.merge(summaries[a]);
+                }
+                break;
+            }
+            while (a < b && a % pyramidFanout)
+                result.merge(summaries[a++]);
+            while (a < b && b % pyramidFanout)
+                result.merge(summaries[--b]);
+            a /= pyramidFanout;
+            b /= pyramidFanout;
+        }
+
+        result.last = last;
+        return result;
+    }
+
+    void ProbeHistory::decode(size_t chunk) const {
+        const auto &source = m_chunks[chunk];
+        const uint64_t id = m_droppedChunks + chunk;
+        if (id == m_decodedChunk && m_decodedCount == source.summary.transitions)
+            return;
+
+        m_decodedTimes.resize(source.summary.transitions);
+        m_decodedStates.resize(source.summary.transitions);
+        const uint8_t *pos = source.bytes.data();
+        SimTime time = source.begin;
+        for (uint32_t i = 0; i < source.summary.transitions; i++) {
+            const uint64_t value = readVarint(pos);
+            time += SimTime(static_cast<int64_t>(value >> 2));
+            m_decodedTimes[i] = time;
+            m_decodedStates[i] = static_cast<LogicState>(value & 0x3);
+        }
+        m_decodedChunk = id;
+        m_decodedCount = source.summary.transitions;
+    }
+
+    void ProbeHistory::query(SimTime from, SimTime to, std::vector<ProbeBucket> &out) const {
+        const size_t count = out.size();
+        const size_t chunks = m_chunks.size();
+
+        // first chunk with a transition at or after from
+        size_t c = static_cast<size_t>(std::ranges::partition_point(m_chunks, [from](const Chunk &chunk) {
+                                           return chunk.end < from;
+                                       }) -
+                                       m_chunks.begin());
+        uint32_t idx = 0;
+        LogicState state = c > 0 ? m_chunks[c - 1].summary.last : LogicState::unknown;
+        if (c < chunks && m_chunks[c].begin < from) {
+            decode(c);
+            idx = static_cast<uint32_t>(std::lower_bound(m_decodedTimes.begin(), m_decodedTimes.begin() + m_decodedCount, from) -
+                                        m_decodedTimes.begin());
+            state = m_decodedStates[idx - 1];
+        }
+
+        const int64_t span = std::max<int64_t>((to - from).count(), 0);
+        const auto n = static_cast<int64_t>(count);
+        for (size_t i = 0; i < count; i++) {
+            const auto k = static_cast<int64_t>(i + 1);
+            const SimTime end = from + SimTime(span / n * k + span % n * k / n);
+
+            auto &bucket = out[i];
+            bucket = {};
+            bucket.first = state;
+            bucket.stateMask = stateBit(state);
+
+            while (c < chunks) {
+                if (idx == 0 && m_chunks[c].end < end) {
+                    // whole chunks inside the bucket come from the pyramid
+                    const auto last = std::partition_point(m_chunks.begin() + static_cast<ptrdiff_t>(c), m_chunks.end(),
+                                                           [end](const Chunk &chunk) { return chunk.end < end; });
+                    const auto e = static_cast<size_t>(last - m_chunks.begin());
+                    const auto summary = mergeChunks(c, e);
+                    bucket.transitions += summary.transitions;
+                    bucket.stateMask |= summary.stateMask;
+                    state = summary.last;
+                    c = e;
+                    continue;
+                }
+                if (idx == 0 && m_chunks[c].begin >= end)
+                    break;
+
+                decode(c);
+                while (idx < m_decodedCount && m_decodedTimes[idx] < end) {
+                    state = m_decodedStates[idx++];
+                    bucket.transitions++;
+                    bucket.stateMask |= stateBit(state);
+                }
+                if (idx < m_decodedCount)
+                    break;
+                c++;
+                idx = 0;
+            }
+            bucket.last = state;
+        }
+    }
+
+    LogicState ProbeHistory::stateAt(SimTime time) const {
+        const auto it = std::ranges::partition_point(m_chunks, [time](const Chunk &chunk) {
+            return chunk.begin <= time;
+        });
+        if (it == m_chunks.begin())
+            return LogicState::unknown;
+
+        const auto c = static_cast<size_t>(it - m_chunks.begin()) - 1;
+        if (m_chunks[c].end <= time)
+            return m_chunks[c].summary.last;
+
+        decode(c);
+        const auto next = std::upper_bound(m_decodedTimes.begin(), m_decodedTimes.begin() + m_decodedCount, time);
+        return m_decodedStates[static_cast<size_t>(next - m_decodedTimes.begin()) - 1];
+    }
+
+    std::vector<ProbeTransition> ProbeHistory::getRecent(size_t count) const {
+        std::vector<ProbeTransition> recent;
+        for (size_t c = m_chunks.size(); c-- > 0 && recent.size() < count;) {
+            decode(c);
+            for (size_t i = m_decodedCount; i-- > 0 && recent.size() < count;) {
+                recent.push_back({m_decodedTimes[i], m_decodedStates[i]});
+            }
+        }
+        std::ranges::reverse(recent);
+        return recent;
+    }
+
+    bool ProbeHistory::empty() const {
+        return m_chunks.empty();
+    }
+
+    uint64_t ProbeHistory::getTransitionCount() const {
+        return m_transitions;
+    }
+
+    uint64_t ProbeHistory::getDroppedCount() const {
+        return m_dropped;
+    }
+
+    SimTime ProbeHistory::getBeginTime() const {
+        return m_chunks.empty() ? SimTime(0) : m_chunks.front().begin;
+    }
+
+    SimTime ProbeHistory::getEndTime() const {
+        return m_lastTime;
+    }
+
+    LogicState ProbeHistory::getLastState() const {
+        return m_chunks.empty() ? LogicState::unknown : m_chunks.back().summary.last;
+    }
+
+    uint64_t ProbeHistory::getMemoryLimit() const {
+        return m_memoryLimit;
+    }
+
+    void ProbeHistory::setMemoryLimit(uint64_t bytes) {
+        m_memoryLimit = bytes;
+        enforceLimit();
+    }
+
+    uint64_t ProbeHistory::getMemoryUsage() const {
+        uint64_t bytes = m_closedBytes + m_chunks.size() * sizeof(Chunk);
+        if (!m_chunks.empty())
+            bytes += m_chunks.back().bytes.capacity();
+        for (const auto &level : m_pyramid) {
+            bytes += level.size() * sizeof(Summary);
+        }
+        return bytes;
+    }
+} // namespace Bess::SimEngine
@@ -0,0 +1,50 @@
+#include "scheduler/event_scheduler.h"
+#include "scheduler/timing_wheel_scheduler.h"
+
+namespace Bess::SimEngine {
+    std::unique_ptr<EventScheduler> EventScheduler::create(EventSchedulerType type) {
+        switch (type) {
+        case EventSchedulerType::orderedSet:
+            return std::make_unique<OrderedSetScheduler>();
+        case EventSchedulerType::timingWheel:
+            return std::make_unique<TimingWheelScheduler>();
+        }
+        return std::make_unique<TimingWheelScheduler>();
+    }
+
+    EventSchedulerType OrderedSetScheduler::getType() const {
+        return EventSchedulerType::orderedSet;
+    }
+
+    void OrderedSetScheduler::push(const SimulationEvent &event) {
+        m_events.insert(event);
+    }
+
+    const SimulationEvent &OrderedSetScheduler::top() const {
+        return *m_events.begin();
+    }
+
+    void OrderedSetScheduler::pop() {
+        m_events.erase(m_events.begin());
+    }
+
+    bool OrderedSetScheduler::empty() const {
+        return m_events.empty();
+    }
+
+    size_t OrderedSetScheduler::size() const {
+        return m_events.size();
+    }
+
+    void OrderedSetScheduler::clear() {
+        m_events.clear();
+    }
+
+    size_t OrderedSetScheduler::eraseIf(const std::function<bool(const SimulationEvent &)> &pred) {
+        return std::erase_if(m_events, pred);
+    }
+
+    void OrderedSetScheduler::collect(std::vector<SimulationEvent> &out) const {
+        out.insert(out.end(), m_events.begin(), m_events.end());
+    }
+} // namespace Bess::SimEngine
@@ -0,0 +1,248 @@
+#include "scheduler/timing_wheel_scheduler.h"
+#include "common/bess_assert.h"
+
+#include <algorithm>
+#include <bit>
+
+namespace Bess::SimEngine {
+    namespace {
+        // min-heap ordering for the overflow events
+        bool isLater(const SimulationEvent &a, const SimulationEvent &b) {
+            return b < a;
+        }
+    } // namespace
+
+    TimingWheelScheduler::TimingWheelScheduler(size_t slotCount) {
+        slotCount = std::bit_ceil(std::max<size_t>(slotCount, 64));
+        m_slots.resize(slotCount);
+        m_occupied.resize(slotCount / 64, 0);
+        m_mask = slotCount - 1;
+    }
+
+    EventSchedulerType TimingWheelScheduler::getType() const {
+        return EventSchedulerType::timingWheel;
+    }
+
+    bool TimingWheelScheduler::isInWindow(int64_t t) const {
+        return t >= m_base && static_cast<uint64_t>(t - m_base) <= m_mask;
+    }
+
+    size_t TimingWheelScheduler::slotIndexOf(int64_t t) const {
+        return static_cast<size_t>(static_cast<uint64_t>(t) & m_mask);
+    }
+
+    void TimingWheelScheduler::setSlotOccupied(size_t idx, bool occupied) {
+        const uint64_t bit = 1ULL << (idx & 63);
+        if (occupied) {
+            m_occupied[idx >> 6] |= bit;
+        } else {
+            m_occupied[idx >> 6] &= ~bit;
+        }
+    }
+
+    void TimingWheelScheduler::insertIntoWheel(const SimulationEvent &event) {
+        const size_t idx = slotIndexOf(event.simTime.count());
+        auto &slot = m_slots[idx];
+
+        // ids are handed out in increasing order, so appending is the common case
+        if (slot.empty() || slot.events.back().id < event.id) {
+            slot.events.push_back(event);
+        } else {
+            const auto it = std::upper_bound(slot.events.begin() + static_cast<std::ptrdiff_t>(slot.head),
+                                             slot.events.end(), event);
+            slot.events.insert(it, event);
+        }
+
+        setSlotOccupied(idx, true);
+        m_wheelCount++;
+        m_cachedSlot = -2;
+    }
+
+    void TimingWheelScheduler::pushOverflow(const SimulationEvent &event) {
+        m_overflow.push_back(event);
+        std::push_heap(m_overflow.begin(), m_overflow.end(), isLater);
+    }
+
+    void TimingWheelScheduler::popOverflow() {
+        std::pop_heap(m_overflow.begin(), m_overflow.end(), isLater);
+        m_overflow.pop_back();
+    }
+
+    void TimingWheelScheduler::migrateOverflow() {
+        if (m_wheelCount == 0 && !m_overflow.empty()) {
+            m_base = m_overflow.front().simTime.count();
+        }
+
+        while (!m_overflow.empty() && isInWindow(m_overflow.front().simTime.count())) {
+            insertIntoWheel(m_overflow.front());
+            popOverflow();
+        }
+    }
+
+    int64_t TimingWheelScheduler::findFirstSlot() const {
+        if (m_cachedSlot != -2)
+            return m_cachedSlot;
+
+        m_cachedSlot = -1;
+        if (m_wheelCount == 0)
+            return m_cachedSlot;
+
+        const size_t wordCount = m_occupied.size();
+        const size_t start = slotIndexOf(m_base);
+        size_t word = start >> 6;
+        uint64_t bits = m_occupied[word] & (~0ULL << (start & 63));
+
+        // one extra iteration revisits the start word for slots that wrapped around
+        for (size_t i = 0; i <= wordCount; i++) {
+            if (bits != 0) {
+                m_cachedSlot = static_cast<int64_t>((word << 6) + std::countr_zero(bits));
+                break;
+            }
+            word = (word + 1) % wordCount;
+            bits = m_occupied[word];
+        }
+
+        return m_cachedSlot;
+    }
+
+    void TimingWheelScheduler::push(const SimulationEvent &event) {
+        const int64_t t = event.simTime.count();
+        if (empty()) {
+            m_base = t;
+        }
+
+        if (isInWindow(t)) {
+            insertIntoWheel(event);
+        } else {
+            pushOverflow(event);
+        }
+    }
+
+    const SimulationEvent &TimingWheelScheduler::top() const {
+        BESS_ASSERT(!empty(), "top() called on an empty scheduler");
+        const int64_t slotIdx = findFirstSlot();
+        if (slotIdx < 0) {
+            return m_overflow.front();
+        }
+
+        const auto &slot = m_slots[slotIdx];
+        const auto &wheelTop = slot.events[slot.head];
+        if (!m_overflow.empty() && m_overflow.front() < wheelTop) {
+            return m_overflow.front();
+        }
+        return wheelTop;
+    }
+
+    void TimingWheelScheduler::pop() {
+        BESS_ASSERT(!empty(), "pop() called on an empty scheduler");
+        const int64_t slotIdx = findFirstSlot();
+        const bool fromWheel = slotIdx >= 0 &&
+                               (m_overflow.empty() ||
+                                !(m_overflow.front() < m_slots[slotIdx].events[m_slots[slotIdx].head]));
+
+        if (!fromWheel) {
+            popOverflow();
+            migrateOverflow();
+            return;
+        }
+
+        auto &slot = m_slots[slotIdx];
+        // nothing earlier is pending, so the window can start at the popped time
+        m_base = slot.events[slot.head].simTime.count();
+        slot.head++;
+        m_wheelCount--;
+
+        if (slot.empty()) {
+            slot.events.clear();
+            slot.head = 0;
+            setSlotOccupied(static_cast<size_t>(slotIdx), false);
+            m_cachedSlot = -2;
+        }
+
+        migrateOverflow();
+    }
+
+    bool TimingWheelScheduler::empty() const {
+        return m_wheelCount == 0 && m_overflow.empty();
+    }
+
+    size_t TimingWheelScheduler::size() const {
+        return m_wheelCount + m_overflow.size();
+    }
+
+    void TimingWheelScheduler::clear() {
+        for (size_t word = 0; word < m_occupied.size(); word++) {
+            uint64_t bits = m_occupied[word];
+            while (bits != 0) {
+                auto &slot = m_slots[(word << 6) + std::countr_zero(bits)];
+                slot.events.clear();
+                slot.head = 0;
+                bits &= bits - 1;
+            }
+            m_occupied[word] = 0;
+        }
+
+        m_overflow.clear();
+        m_wheelCount = 0;
+        m_base = 0;
+        m_cachedSlot = -2;
+    }
+
+    size_t TimingWheelScheduler::eraseIf(const std::function<bool(const SimulationEvent &)> &pred) {
+        size_t removed = 0;
+
+        for (size_t word = 0; word < m_occupied.size(); word++) {
+            uint64_t bits = m_occupied[word];
+            while (bits != 0) {
+                const size_t idx = (word << 6) + std::countr_zero(bits);
+                bits &= bits - 1;
+
+                auto &slot = m_slots[idx];
+                slot.events.erase(slot.events.begin(),
+                                  slot.events.begin() + static_cast<std::ptrdiff_t>(slot.head));
+                slot.head = 0;
+
+                const size_t count = std::erase_if(slot.events, pred);
+                removed += count;
+                m_wheelCount -= count;
+
+                if (slot.empty()) {
+                    setSlotOccupied(idx, false);
+                }
+            }
+        }
+
+        const size_t overflowRemoved = std::erase_if(m_overflow, pred);
+        if (overflowRemoved != 0) {
+            std::make_heap(m_overflow.begin(), m_overflow.end(), isLater);
+            removed += overflowRemoved;
+        }
+
+        m_cachedSlot = -2;
+        migrateOverflow();
+        return removed;
+    }
+
+    void TimingWheelScheduler::collect(std::vector<SimulationEvent> &out) const {
+        out.reserve(out.size() + size());
+        for (size_t word = 0; word < m_occupied.size(); word++) {
+            uint64_t bits = m_occupied[word];
+            while (bits != 0) {
+                const auto &slot = m_slots[(word << 6) + std::countr_zero(bits)];
+                bits &= bits - 1;
+                out.insert(out.end(),
+                           slot.events.begin() + static_cast<std::ptrdiff_t>(slot.head),
+                           slot.events.end());
+            }
+        }
+        out.insert(out.end(), m_overflow.begin(), m_overflow.end());
+    }
+
+    size_t TimingWheelScheduler::getSlotCount() const {
+        return m_slots.size();
+    }
+
+    size_t TimingWheelScheduler::getOverflowCount() const {
+        return m_overflow.size();
+    }
+} // namespace Bess::SimEngine
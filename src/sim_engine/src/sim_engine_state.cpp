@@ -14,10 +14,12 @@ namespace Bess::SimEngine {
 
     void SimEngineState::addDigitalComponent(const std::shared_ptr<DigitalComponent> &comp) {
         m_digitalComponents[comp->id] = comp;
+        markTopologyChanged();
     }
 
     void SimEngineState::removeDigitalComponent(const UUID &uuid) {
         m_digitalComponents.erase(uuid);
+        markTopologyChanged();
     }
 
     const std::unordered_map<UUID, std::shared_ptr<DigitalComponent>> &SimEngineState::getDigitalComponents() const {
@@ -26,6 +28,7 @@ namespace Bess::SimEngine {
 
     void SimEngineState::clearDigitalComponents() {
         m_digitalComponents.clear();
+        markTopologyChanged();
     }
 
     std::shared_ptr<DigitalComponent> SimEngineState::getDigitalComponent(const UUID &uuid) const {
@@ -52,6 +55,14 @@ namespace Bess::SimEngine {
         m_nets.clear();
     }
 
+    uint64_t SimEngineState::getTopologyVersion() const {
+        return m_topologyVersion.load(std::memory_order_acquire);
+    }
+
+    void SimEngineState::markTopologyChanged() {
+        m_topologyVersion.fetch_add(1, std::memory_order_acq_rel);
+    }
+
     void SimEngineState::reset() {
         clearNets();
         clearDigitalComponents();
@@ -72,6 +83,70 @@ namespace Bess::SimEngine {
         return result;
     }
 
+    void definitionToJson(const std::shared_ptr<ComponentDefinition> &definition, Json::Value &j) {
+        auto moduleDef = std::dynamic_pointer_cast<ModuleDefinition>(definition);
+        if (moduleDef) {
+            JsonConvert::toJsonValue(*moduleDef, j);
+            j["is_module"] = true;
+        } else {
+            JsonConvert::toJsonValue(*definition, j);
+        }
+
+        const auto auxData = definition->getAuxData();
+        if (auxData.has_value() && auxData.type() == typeid(Bess::Verilog::VerCompDefAuxData)) {
+            auto verAuxData = std::any_cast<Bess::Verilog::VerCompDefAuxData>(auxData);
+            j["aux_data"] = verAuxData.toJson();
+        }
+    }
+
+    std::shared_ptr<ComponentDefinition> bindStoredDefinition(const std::shared_ptr<ComponentDefinition> &stored,
+                                                              const Json::Value &j) {
+        std::shared_ptr<ComponentDefinition> definition;
+        if (j.isMember("is_module")) {
+            auto moduleDef = std::dynamic_pointer_cast<ModuleDefinition>(stored);
+            auto simFn = [moduleDef](const std::vector<SlotState> &inputs,
+                                     SimTime simTime,
+                                     const ComponentState &prevState) {
+                return moduleDef->simulationFunction(inputs, simTime, prevState);
+            };
+            moduleDef->setSimulationFunction(simFn);
+            definition = stored;
+        } else {
+            if (j.isMember("aux_data")) {
+                // Just to register it in catalog
+                auto def = Bess::Verilog::getFromAuxDataJson(j["aux_data"]);
+            }
+
+            const auto &compCatalog = ComponentCatalog::instance();
+            if (!compCatalog.isRegistered(stored->getBaseHash())) {
+                BESS_ERROR("Component definition with hash {} is not registered in the catalog.",
+                           stored->getBaseHash());
+                return nullptr;
+            }
+
+            definition = compCatalog.getComponentDefinition(stored->getBaseHash())->clone();
+            definition->setInputSlotsInfo(stored->getInputSlotsInfo());
+            definition->setOutputSlotsInfo(stored->getOutputSlotsInfo());
+        }
+
+        // Very important, do no change the order of following ops
+        // As expressions need to be set in auxData
+        definition->computeExpressionsIfNeeded();
+        definition->computeHash();
+        return definition;
+    }
+
+    std::shared_ptr<ComponentDefinition> definitionFromJson(const Json::Value &j) {
+        if (j.isMember("is_module")) {
+            auto moduleDef = std::make_shared<ModuleDefinition>();
+            JsonConvert::fromJsonValue(j, moduleDef);
+            return bindStoredDefinition(moduleDef, j);
+        }
+
+        auto stored = std::make_shared<ComponentDefinition>();
+        JsonConvert::fromJsonValue(j, stored);
+        return bindStoredDefinition(stored, j);
+    }
 } // namespace Bess::SimEngine
 
 namespace Bess::JsonConvert {
@@ -97,51 +172,23 @@ namespace Bess::JsonConvert {
     void fromJsonValue(const Json::Value &j, Bess::SimEngine::SimEngineState &state) {
         state.reset();
 
-        const auto &compCatalog = SimEngine::ComponentCatalog::instance();
         for (const auto &compJson : j["digital_components"]) {
             auto comp = std::make_shared<SimEngine::DigitalComponent>();
             JsonConvert::fromJsonValue(compJson, *comp);
 
-            bool isModule = compJson["definition"].isMember("is_module");
-
-            if (isModule) {
-                auto moduleDef = std::dynamic_pointer_cast<SimEngine::ModuleDefinition>(comp->definition);
-                auto simFn = [moduleDef](const std::vector<SimEngine::SlotState> &inputs,
-                                         SimEngine::SimTime simTime,
-                                         const SimEngine::ComponentState &prevState) {
-                    return moduleDef->simulationFunction(inputs, simTime, prevState);
-                };
-                comp->definition->setSimulationFunction(simFn);
-            } else {
-                if (compJson["definition"].isMember("aux_data")) {
-                    auto auxDataJson = compJson["definition"]["aux_data"];
-                    // Just to register it in catalog
-                    auto def = Bess::Verilog::getFromAuxDataJson(auxDataJson);
-                }
-
-                if (!compCatalog.isRegistered(comp->definition->getBaseHash())) {
-                    BESS_ERROR("Component definition with hash {} is not registered in the catalog. Skipping.",
-                               comp->definition->getBaseHash());
-
-                    // temp
-                    BESS_ASSERT(false, compJson.toStyledString());
-                    continue;
-                }
-
-                auto baseDef = compCatalog.getComponentDefinition(comp->definition->getBaseHash())->clone();
-                baseDef->setInputSlotsInfo(comp->definition->getInputSlotsInfo());
-                baseDef->setOutputSlotsInfo(comp->definition->getOutputSlotsInfo());
-
-                comp->definition = std::move(baseDef);
+            auto definition = SimEngine::bindStoredDefinition(comp->definition, compJson["definition"]);
+            if (!definition) {
+                BESS_ERROR("Skipping component {}", comp->getName());
+
+                // temp
+                BESS_ASSERT(false, compJson.toStyledString());
+                continue;
             }
 
-            // Very important, do no change the order of following ops
-            // As expressions need to be set in auxData
-            comp->definition->computeExpressionsIfNeeded();
+            comp->definition = std::move(definition);
             if (comp->definition->getAuxData().has_value()) {
                 comp->state.auxData = &comp->definition->getAuxData();
             }
-            comp->definition->computeHash();
 
             state.addDigitalComponent(comp);
         }
@@ -11,16 +11,23 @@
 #include "types.h"
 
 #include "plugin_manager.h"
+#include "truth_table/truth_table_evaluator.h"
 
 #include <algorithm>
+#include <bit>
 #include <cassert>
 #include <chrono>
+#include <cmath>
 #include <condition_variable>
 #include <cstdint>
 #include <exception>
+#include <fstream>
 #include <memory>
 #include <mutex>
 #include <ranges>
+#include <set>
+#include <unordered_set>
+#include <stdexcept>
 #include <thread>
 
 // #define BESS_ENABLE_LOG_EVENTS
@@ -37,7 +44,9 @@ namespace Bess::SimEngine {
         return inst;
     }
 
-    SimulationEngine::SimulationEngine() {
+    SimulationEngine::SimulationEngine(EventSchedulerType schedulerType)
+        : m_eventScheduler(EventScheduler::create(schedulerType)),
+          m_evaluateRange([this](size_t begin, size_t end) { evaluateRange(begin, end); }) {
         initComponentCatalog();
         const auto &pluginMangaer = Plugins::PluginManager::getInstance();
 
@@ -53,16 +62,34 @@ namespace Bess::SimEngine {
         }
         Plugins::savePyThreadState();
         m_simThread = std::thread(&SimulationEngine::run, this);
+        m_nativeBuilder = std::thread(&SimulationEngine::nativeBuildLoop, this);
     }
 
     void SimulationEngine::clear() {
-        std::lock_guard lkEventQueue(m_queueMutex);
-        m_eventSet.clear();
+        // the trace's timeline ends with the current simulation
+        stopTrace();
+        {
+            // registry before queue, same order as the sim loop
+            std::lock_guard lkRegistry(m_registryMutex);
+            std::lock_guard lkHistory(m_historyMutex);
+            std::lock_guard lkEventQueue(m_queueMutex);
+            m_eventScheduler->clear();
+            std::ranges::fill(m_scheduledAt, notScheduled);
+            m_eventStats = {};
+            m_paceAnchorValid = false;
+            m_pendingEvents = 0;
+            m_externalOutputWrites.clear();
+            m_queueCV.notify_all();
 
-        std::lock_guard lkRegistry(m_registryMutex);
-        m_simEngineState.reset();
-        m_nextEventId = 0;
-        m_currentSimTime = {};
+            m_history.clear();
+            m_simEngineState.reset();
+            m_netTracker.clear();
+            m_cycleCount = 0;
+            m_cycleSweeps = 0;
+            m_nextEventId = 0;
+            m_currentSimTime = {};
+        }
+        requestSlotSnapshot();
     }
 
     SimulationEngine::~SimulationEngine() {
@@ -77,6 +104,18 @@ namespace Bess::SimEngine {
         m_stateCV.notify_all();
         if (m_simThread.joinable())
             m_simThread.join();
+        {
+            // a build already compiling finishes, nothing waiting is started
+            std::lock_guard lk(m_nativeBuild.mutex);
+            m_nativeBuild.stop = true;
+            m_nativeBuild.source.reset();
+            m_nativeBuild.requested.notify_all();
+            m_nativeBuild.finished.notify_all();
+        }
+        if (m_nativeBuilder.joinable())
+            m_nativeBuilder.join();
+        m_workerPool.reset();
+        stopTrace();
 
         Plugins::restorePyThreadState();
         ComponentCatalog::instance().destroy();
@@ -85,35 +124,43 @@ namespace Bess::SimEngine {
         m_simEngineState.reset();
     }
 
-    void SimulationEngine::scheduleEvent(UUID id, UUID schedulerId, SimDelayNanoSeconds simTime) {
-        const auto &digiComp = m_simEngineState.getDigitalComponent(id);
+    void SimulationEngine::scheduleEvent(UUID id, UUID schedulerId, SimDelayNanoSeconds simTime,
+                                         bool freeRunning) {
         std::lock_guard lk(m_queueMutex);
-        static uint64_t eventId = 0;
-        SimulationEvent ev{simTime, id, schedulerId, eventId++};
-        m_eventSet.insert(ev);
+        m_eventScheduler->push({simTime, id, schedulerId, m_nextEventId++, freeRunning});
+        m_eventStats.scheduled++;
+        if (!freeRunning)
+            m_pendingEvents++;
         m_queueCV.notify_all();
     }
 
     void SimulationEngine::clearEventsForEntity(const UUID &id) {
         std::lock_guard lk(m_queueMutex);
-        std::erase_if(m_eventSet, [id](auto it) {
-            return it.compId == id;
+        // one pass, the predicate sees every event once and counts what it erases
+        uint64_t pendingErased = 0;
+        m_eventScheduler->eraseIf([id, &pendingErased](const SimulationEvent &ev) {
+            if (ev.compId != id)
+                return false;
+            if (!ev.freeRunning)
+                pendingErased++;
+            return true;
         });
+        m_pendingEvents -= pendingErased;
+        m_queueCV.notify_all();
     }
 
     const UUID &SimulationEngine::addComponent(const std::shared_ptr<ComponentDefinition> &definition,
                                                bool cloneDef) {
         auto digiComp = std::make_shared<DigitalComponent>(definition, cloneDef);
+        // the sim thread walks the registry when it recompiles the netlist
+        std::lock_guard lk(m_registryMutex);
         m_simEngineState.addDigitalComponent(digiComp);
 
-        // create a new net for new component
-        Net newNet{};
-        digiComp->netUuid = newNet.getUUID();
-        newNet.addComponent(digiComp->id);
-        m_nets[digiComp->netUuid] = newNet;
-        m_isNetUpdated = true;
+        // a new component is a net of its own
+        digiComp->netUuid = m_netTracker.addComponent(digiComp->id);
 
         scheduleEvent(digiComp->id, UUID::null, m_currentSimTime + definition->getSimDelay());
+        requestSlotSnapshot();
 
         EventSystem::EventDispatcher::instance().queue<Events::ComponentAddedEvent>({digiComp->id});
         BESS_INFO("Added component {} with id {} | base hash {}",
@@ -155,6 +202,17 @@ namespace Bess::SimEngine {
             return {false, "Invalid destination pin index. Valid range: 0 to " + std::to_string(inPins.size() - 1)};
         }
 
+        const auto slotWidth = [](const DigitalComponent &comp, SlotType type, int slot) {
+            const auto &info = type == SlotType::digitalInput ? comp.definition->getInputSlotsInfo()
+                                                              : comp.definition->getOutputSlotsInfo();
+            return info.getWidth(slot);
+        };
+        const int srcWidth = slotWidth(*srcComp, srcType, srcSlot);
+        const int dstWidth = slotWidth(*dstComp, dstType, dstSlot);
+        if (srcWidth != dstWidth) {
+            return {false, std::format("Cannot connect a {} bit pin to a {} bit pin", srcWidth, dstWidth)};
+        }
+
         // Check for duplicate connection.
         auto &conns = outPins[srcSlot];
         bool exists = std::ranges::any_of(conns, [&](const auto &conn) {
@@ -173,6 +231,8 @@ namespace Bess::SimEngine {
             return false;
         }
 
+        std::lock_guard lk(m_registryMutex);
+
         const auto srcComp = m_simEngineState.getDigitalComponent(src);
         const auto dstComp = m_simEngineState.getDigitalComponent(dst);
 
@@ -208,42 +268,19 @@ namespace Bess::SimEngine {
         if (srcType == SlotType::digitalOutput) {
             srcComp->state.outputConnected[srcSlot] = true;
             dstComp->state.inputConnected[dstSlot] = true;
+            srcComp->addFanOut(dst);
         } else {
             srcComp->state.inputConnected[srcSlot] = true;
             dstComp->state.outputConnected[dstSlot] = true;
+            dstComp->addFanOut(src);
         }
+        m_simEngineState.markTopologyChanged();
 
-        // Mix two nets
-        // Final net will have id of net with most components initially
-        if (srcComp->netUuid != dstComp->netUuid) {
-            UUID finalNetId = UUID::null;
-            UUID changedNetId = UUID::null;
-            auto &srcNet = m_nets[srcComp->netUuid];
-            auto &dstNet = m_nets[dstComp->netUuid];
-
-            if (srcNet.size() > dstNet.size()) {
-                finalNetId = srcComp->netUuid;
-                changedNetId = dstComp->netUuid;
-            } else {
-                finalNetId = dstComp->netUuid;
-                changedNetId = srcComp->netUuid;
-            }
-
-            auto &finalNet = m_nets[finalNetId];
-            auto &changedNet = m_nets[changedNetId];
-
-            for (const auto &compUuid : changedNet.getComponents()) {
-                if (compUuid != UUID::null) {
-                    const auto &comp = m_simEngineState.getDigitalComponent(compUuid);
-                    comp->netUuid = finalNetId;
-                }
-                finalNet.addComponent(compUuid);
-            }
-            m_nets.erase(changedNetId);
-            m_isNetUpdated = true;
-        }
+        // merges the two nets, the components learn their net id when the nets are synced
+        m_netTracker.connect(src, dst);
 
         scheduleEvent(dst, src, m_currentSimTime + dstComp->definition->getSimDelay());
+        requestSlotSnapshot();
         BESS_INFO("Connected components");
         return true;
     }
@@ -286,22 +323,15 @@ namespace Bess::SimEngine {
                     connections.erase(removeIt.begin(), removeIt.end());
 
                     comp->state.outputConnected[otherPinIdx] = !connections.empty();
+                    comp->removeFanOut(uuid);
                     affected.insert(otherPin.first);
                 }
             }
+            m_simEngineState.markTopologyChanged();
         }
 
-        // update the nets
-        {
-            auto comp = m_simEngineState.getDigitalComponent(uuid);
-            auto &ogNet = m_nets[comp->netUuid];
-            ogNet.removeComponent(uuid);
-            if (ogNet.size() == 0) {
-                m_nets.erase(comp->netUuid);
-            }
-
-            updateNets(std::vector<UUID>(affected.begin(), affected.end()));
-        }
+        // the net splits lazily, the next time it is queried
+        m_netTracker.removeComponent(uuid);
 
         m_simEngineState.removeDigitalComponent(uuid);
 
@@ -312,52 +342,11 @@ namespace Bess::SimEngine {
             const auto &dc = m_simEngineState.getDigitalComponent(e);
             scheduleEvent(e, UUID::null, m_currentSimTime + dc->definition->getSimDelay());
         }
+        requestSlotSnapshot();
 
         BESS_INFO("Deleted component {}", (uint64_t)uuid);
     }
 
-    bool SimulationEngine::updateNets(const std::vector<UUID> &startCompIds) {
-        std::unordered_map<UUID, std::vector<UUID>> connGraphs;
-        std::unordered_map<UUID, bool> visited;
-
-        for (const UUID &e : startCompIds) {
-            if (visited[e])
-                continue;
-            connGraphs[e] = getConnGraph(e);
-
-            for (const auto &entInGraph : connGraphs[e]) {
-                visited[entInGraph] = true;
-            }
-        }
-
-        if (connGraphs.size() <= 1) {
-            return false;
-        }
-
-        for (const auto &graphPair : connGraphs) {
-            Net newNet{};
-            for (const auto &entInGraph : graphPair.second) {
-                const auto &compInGraph = m_simEngineState.getDigitalComponent(entInGraph);
-
-                if (m_nets.contains(compInGraph->netUuid)) {
-                    auto &prevNet = m_nets[compInGraph->netUuid];
-                    prevNet.removeComponent(entInGraph);
-                    if (prevNet.size() == 0) {
-                        m_nets.erase(prevNet.getUUID());
-                    }
-                }
-
-                compInGraph->netUuid = newNet.getUUID();
-                newNet.addComponent(entInGraph);
-            }
-            m_nets[newNet.getUUID()] = newNet;
-        }
-
-        m_isNetUpdated = connGraphs.size() > 1;
-
-        return true;
-    }
-
     SlotState SimulationEngine::getDigitalSlotState(const UUID &uuid, SlotType type, int idx) {
         if (!m_simEngineState.isComponentValid(uuid)) {
             BESS_WARN("[getDigitalPinState] Component with UUID {} is invalid", (uint64_t)uuid);
@@ -414,30 +403,62 @@ namespace Bess::SimEngine {
             return;
         }
 
+        recordSlotWrite(*comp, SlotType::digitalInput, pinIdx);
         comp->state.inputStates[pinIdx].state = state;
         comp->state.inputStates[pinIdx].lastChangeTime = m_currentSimTime;
         scheduleEvent(uuid, UUID::null, m_currentSimTime + comp->definition->getSimDelay());
+        requestSlotSnapshot();
     }
 
     void SimulationEngine::setOutputSlotState(const UUID &uuid, int pinIdx, LogicState state) {
+        writeOutputSlot("setOutputSlotState", uuid, pinIdx, [state](int width) {
+            // a bus driven high has all of its bits set
+            SlotState slot(state, SimTime(0));
+            if (width > 1 && state == LogicState::high)
+                slot.value = busMask(width);
+            return slot;
+        });
+    }
+
+    void SimulationEngine::setOutputSlotWord(const UUID &uuid, int pinIdx, uint64_t value) {
+        writeOutputSlot("setOutputSlotWord", uuid, pinIdx, [value](int width) {
+            if (width == 1)
+                return SlotState((value & 1) != 0);
+            return SlotState::fromWord(value & busMask(width), SimTime(0));
+        });
+    }
+
+    void SimulationEngine::writeOutputSlot(const char *caller, const UUID &uuid, int pinIdx,
+                                           const std::function<SlotState(int)> &makeState) {
         const auto comp = m_simEngineState.getDigitalComponent(uuid);
         if (!comp) {
-            BESS_WARN("[setOutputSlotState] Component with UUID {} is invalid", (uint64_t)uuid);
+            BESS_WARN("[{}] Component with UUID {} is invalid", caller, (uint64_t)uuid);
             return;
         }
 
         if (pinIdx < 0 || static_cast<size_t>(pinIdx) >= comp->state.outputStates.size()) {
-            BESS_WARN("[setOutputSlotState] Output slot index {} out of range for component {}",
+            BESS_WARN("[{}] Output slot index {} out of range for component {}",
+                      caller,
                       pinIdx,
                       (uint64_t)uuid);
             return;
         }
 
+        recordSlotWrite(*comp, SlotType::digitalOutput, pinIdx);
         auto oldState = comp->state;
-        comp->state.outputStates[pinIdx].state = state;
+        comp->state.outputStates[pinIdx] = makeState(comp->definition->getOutputSlotsInfo().getWidth(pinIdx));
         comp->state.outputStates[pinIdx].lastChangeTime = m_currentSimTime;
+
+        {
+            // the sim thread reads the netlist unlocked, so it copies the value in itself
+            std::lock_guard queueLock(m_queueMutex);
+            m_externalOutputWrites.push_back(uuid);
+        }
+
         comp->dispatchStateChange(oldState, comp->state);
+        logStateChange(*comp, oldState, comp->state);
         scheduleDependantsOf(uuid);
+        requestSlotSnapshot();
     }
 
     void SimulationEngine::invertInputSlotState(const UUID &uuid, int pinIdx) {
@@ -458,9 +479,11 @@ namespace Bess::SimEngine {
                                ? LogicState::low
                                : LogicState::high;
 
+        recordSlotWrite(*comp, SlotType::digitalInput, pinIdx);
         comp->state.inputStates[pinIdx].state = state;
         comp->state.inputStates[pinIdx].lastChangeTime = m_currentSimTime;
         scheduleEvent(uuid, UUID::null, m_currentSimTime + comp->definition->getSimDelay());
+        requestSlotSnapshot();
     }
 
     const ComponentState &SimulationEngine::getComponentState(const UUID &uuid) {
@@ -490,10 +513,19 @@ namespace Bess::SimEngine {
                           : compBRef->outputConnections;
 
         // Erase connection from A -> B
+        const auto sizeBefore = pinsA[idxA].size();
         pinsA[idxA].erase(
             std::remove_if(pinsA[idxA].begin(), pinsA[idxA].end(),
                            [&](auto &c) { return c.first == compB && c.second == idxB; }),
             pinsA[idxA].end());
+        const auto removed = static_cast<uint32_t>(sizeBefore - pinsA[idxA].size());
+        if (removed > 0) {
+            if (pinAType == SlotType::digitalOutput) {
+                compARef->removeFanOut(compB, removed);
+            } else {
+                compBRef->removeFanOut(compA, removed);
+            }
+        }
         // Erase connection from B -> A
         pinsB[idxB].erase(
             std::remove_if(pinsB[idxB].begin(), pinsB[idxB].end(),
@@ -515,27 +547,42 @@ namespace Bess::SimEngine {
                 compBRef->state.inputConnected[idxB] = false;
             }
         }
+        m_simEngineState.markTopologyChanged();
 
         // Schedule next simulation on the appropriate side
         const UUID toSchedule = pinAType == SlotType::digitalOutput ? compB : compA;
 
-        updateNets({compA, compB});
+        // the net splits lazily, the next time it is queried
+        for (uint32_t i = 0; i < removed; i++) {
+            m_netTracker.disconnect(compA, compB);
+        }
 
         const auto &dc = m_simEngineState.getDigitalComponent(toSchedule);
         scheduleEvent(toSchedule, UUID::null, m_currentSimTime + dc->definition->getSimDelay());
+        requestSlotSnapshot();
 
         BESS_INFO("Deleted connection");
     }
 
     std::vector<SlotState> SimulationEngine::getInputSlotsState(UUID compId) const {
+        std::vector<SlotState> states;
+
+        {
+            std::shared_lock netlistLock(m_netlistMutex);
+            if (isNetlistFresh() && !hasExternalOutputWrites()) {
+                const auto idx = m_netlist.indexOf(compId);
+                if (idx != invalidCompIndex && m_netlist.isShapeValid(idx)) {
+                    m_netlist.gatherInputs(idx, states);
+                    return states;
+                }
+            }
+        }
 
         if (!m_simEngineState.isComponentValid(compId)) {
             BESS_WARN("Component with UUID {} is invalid", (uint64_t)compId);
             return {};
         }
 
-        std::vector<SlotState> states;
-
         const auto &comp = m_simEngineState.getDigitalComponent(compId);
         for (const auto &pinConnections : comp->inputConnections) {
             SlotState aggregatedPinState = {LogicState::low, SimTime(0)};
@@ -560,8 +607,11 @@ namespace Bess::SimEngine {
                 if (sourcePin.state == LogicState::high) {
                     if (aggregatedPinState.state != LogicState::high) {
                         aggregatedPinState = sourcePin;
-                    } else if (sourcePin.lastChangeTime > aggregatedPinState.lastChangeTime) {
-                        aggregatedPinState.lastChangeTime = sourcePin.lastChangeTime;
+                    } else {
+                        // bus drivers are wired-or, like their single bit counterparts
+                        aggregatedPinState.value |= sourcePin.value;
+                        if (sourcePin.lastChangeTime > aggregatedPinState.lastChangeTime)
+                            aggregatedPinState.lastChangeTime = sourcePin.lastChangeTime;
                     }
                 } else if (sourcePin.state == LogicState::unknown && aggregatedPinState.state == LogicState::low) {
                     aggregatedPinState = sourcePin;
@@ -573,10 +623,10 @@ namespace Bess::SimEngine {
         return states;
     }
 
-    bool SimulationEngine::simulateComponent(const UUID &compId, const std::vector<SlotState> &inputs) {
-        const auto &comp = m_simEngineState.getDigitalComponent(compId);
+    bool SimulationEngine::simulateComponent(CompIndex idx, std::span<const SlotState> inputs) {
+        auto *comp = m_netlist.componentAt(idx);
         BESS_ASSERT(comp,
-                    std::format("Component {} is invalid", (uint64_t)compId));
+                    std::format("Component {} is invalid", (uint64_t)m_netlist.uuidOf(idx)));
         const auto &def = comp->definition;
         BESS_ASSERT(def,
                     std::format("Component definition of {} is invalid", (uint64_t)comp->id));
@@ -589,39 +639,156 @@ namespace Bess::SimEngine {
         BESS_LOG_EVENT("");
 #endif // BESS_ENABLE_LOG_EVENTS
 
-        auto &simFunction = def->getSimulationFunction();
-
-        if (!simFunction) {
+        // in place functions write into scratch outputs, by-value ones into a scratch state
+        const auto &inPlaceFunction = def->getInPlaceSimulationFunction();
+        if (!inPlaceFunction && !def->getSimulationFunction()) {
             BESS_ERROR("Component {} does not have a simulation function defined. Skipping simulation.", def->getName());
             assert(false && "Simulation function not defined for component");
             return false;
         }
 
-        comp->state.simError = false;
-        auto oldState = comp->state;
-        ComponentState newState;
+        auto &state = comp->state;
+        if (inPlaceFunction) {
+            m_scratchOutputs.assign(state.outputStates.begin(), state.outputStates.end());
+            const auto outcome = evaluateInPlace(idx, inputs, m_scratchOutputs, m_scratchError);
+            return applyEvaluation(idx, inputs, outcome, m_scratchOutputs, m_scratchError);
+        }
+
+        state.simError.reset();
+        bool changed = false;
         try {
-            newState = def->getSimulationFunction()(inputs, m_currentSimTime, comp->state);
+            m_scratchState = def->getSimulationFunction()(
+                std::vector<SlotState>(inputs.begin(), inputs.end()), m_currentSimTime, state);
+            changed = m_scratchState.isChanged;
         } catch (std::exception &ex) {
-            BESS_ERROR("Exception during simulation of component {}. Output won't be updated: {}",
-                       def->getName(), ex.what());
-            comp->state.simError = true;
-            comp->state.errorMessage = ex.what();
-            comp->state.isChanged = false;
+            markSimError(*comp, ex.what());
         }
 
-        comp->state.inputStates = inputs;
+        BESS_LOG_EVENT("\tState changed: {}", changed ? "YES" : "NO");
+
+        if (!changed) {
+            logInputChanges(*comp, inputs);
+            if (m_historyEnabled)
+                m_history.recordSlots(idx, SlotType::digitalInput, state.inputStates, inputs);
+            state.inputStates.assign(inputs.begin(), inputs.end());
+            return false;
+        }
 
-        BESS_LOG_EVENT("\tState changed: {}", newState.isChanged ? "YES" : "NO");
+        m_prevStateScratch = state;
+        std::swap(state, m_scratchState);
+        return commitStateChange(idx);
+    }
 
-        if (newState.isChanged && !comp->state.simError) {
-            comp->state = newState;
-            comp->definition->onStateChange(oldState, comp->state);
-            comp->dispatchStateChange(oldState, newState);
-            BESS_LOG_EVENT("\tOutputs changed to:");
-            for (auto &outp : newState.outputStates) {
-                BESS_LOG_EVENT("\t\t{}", (bool)outp.state);
-            }
+    SimulationEngine::EvalOutcome SimulationEngine::evaluateInPlace(CompIndex idx,
+                                                                    std::span<const SlotState> inputs,
+                                                                    std::span<SlotState> outputs,
+                                                                    std::string &error) const {
+        const auto *comp = m_netlist.componentAt(idx);
+        try {
+            return comp->definition->getInPlaceSimulationFunction()(inputs, m_currentSimTime, comp->state, outputs)
+                       ? EvalOutcome::changed
+                       : EvalOutcome::unchanged;
+        } catch (std::exception &ex) {
+            error = ex.what();
+            return EvalOutcome::failed;
+        }
+    }
+
+    bool SimulationEngine::applyEvaluation(CompIndex idx, std::span<const SlotState> inputs,
+                                           EvalOutcome outcome, std::span<const SlotState> outputs,
+                                           const std::string &error) {
+        auto *comp = m_netlist.componentAt(idx);
+        auto &state = comp->state;
+        state.simError.reset();
+        if (outcome == EvalOutcome::failed) {
+            markSimError(*comp, error);
+        }
+
+        BESS_LOG_EVENT("\tState changed: {}", outcome == EvalOutcome::changed ? "YES" : "NO");
+
+        if (outcome != EvalOutcome::changed) {
+            logInputChanges(*comp, inputs);
+            if (m_historyEnabled)
+                m_history.recordSlots(idx, SlotType::digitalInput, state.inputStates, inputs);
+            state.inputStates.assign(inputs.begin(), inputs.end());
+            return false;
+        }
+
+        // assignment reuses the scratch capacity, no allocation once warmed up
+        m_prevStateScratch = state;
+        state.inputStates.assign(inputs.begin(), inputs.end());
+        std::ranges::copy(outputs, state.outputStates.begin());
+        state.isChanged = true;
+        return commitStateChange(idx);
+    }
+
+    void SimulationEngine::logStateChange(const DigitalComponent &comp, const ComponentState &oldState,
+                                          const ComponentState &newState) {
+        if (!isObserved(comp))
+            return;
+        logInputChanges(comp, newState.inputStates, oldState.inputStates);
+        const auto &before = oldState.outputStates;
+        const auto &after = newState.outputStates;
+        for (size_t i = 0; i < after.size(); i++) {
+            if (i < before.size() && before[i].sameValue(after[i]))
+                continue;
+            emitSlotChange(comp, {comp.id, SlotType::digitalOutput, static_cast<uint32_t>(i),
+                                  after[i].state, after[i].lastChangeTime, after[i].value});
+        }
+    }
+
+    void SimulationEngine::logInputChanges(const DigitalComponent &comp, std::span<const SlotState> inputs,
+                                           std::span<const SlotState> previous) {
+        if (!isObserved(comp))
+            return;
+        for (size_t i = 0; i < inputs.size(); i++) {
+            if (i < previous.size() && previous[i].sameValue(inputs[i]))
+                continue;
+            emitSlotChange(comp, {comp.id, SlotType::digitalInput, static_cast<uint32_t>(i),
+                                  inputs[i].state, inputs[i].lastChangeTime, inputs[i].value});
+        }
+    }
+
+    void SimulationEngine::logInputChanges(const DigitalComponent &comp, std::span<const SlotState> inputs) {
+        logInputChanges(comp, inputs, comp.state.inputStates);
+    }
+
+    bool SimulationEngine::isObserved(const DigitalComponent &comp) const {
+        return comp.stateChangeListeners != 0 || comp.traced;
+    }
+
+    void SimulationEngine::emitSlotChange(const DigitalComponent &comp, const SlotChange &change) {
+        if (comp.stateChangeListeners != 0)
+            m_stateChangeLog.push(change);
+        if (comp.traced && m_traceRecorder)
+            m_traceRecorder->record(change);
+    }
+
+    void SimulationEngine::markSimError(DigitalComponent &comp, const std::string &message) {
+        BESS_ERROR("Exception during simulation of component {}. Output won't be updated: {}",
+                   comp.definition->getName(), message);
+        comp.state.simError = std::make_shared<const std::string>(message);
+        comp.state.isChanged = false;
+    }
+
+    bool SimulationEngine::commitStateChange(CompIndex idx) {
+        auto *comp = m_netlist.componentAt(idx);
+        auto &state = comp->state;
+        if (!m_netlist.syncOutputs(idx)) {
+            // outputs were resized, dependants need a fresh layout
+            m_simEngineState.markTopologyChanged();
+        }
+        if (m_historyEnabled) {
+            m_history.recordSlots(idx, SlotType::digitalInput, m_prevStateScratch.inputStates, state.inputStates);
+            m_history.recordSlots(idx, SlotType::digitalOutput, m_prevStateScratch.outputStates, state.outputStates);
+            m_history.recordDefinitionState(idx, *comp->definition);
+        }
+        comp->definition->onStateChange(m_prevStateScratch, state);
+        comp->dispatchStateChange(m_prevStateScratch, state);
+        logStateChange(*comp, m_prevStateScratch, state);
+        BESS_LOG_EVENT("\tOutputs changed to:");
+        for (auto &outp : state.outputStates) {
+            BESS_LOG_EVENT("\t\t{}", (bool)outp.state);
         }
 
         // FIXME: State monitor logic
@@ -631,7 +798,7 @@ namespace Bess::SimEngine {
         // }
         //
 
-        return newState.isChanged;
+        return true;
     }
 
     SimulationState SimulationEngine::getSimulationState() const {
@@ -683,197 +850,1385 @@ namespace Bess::SimEngine {
         while (!m_stopFlag.load()) {
             std::unique_lock queueLock(m_queueMutex);
 
-            m_queueCV.wait(queueLock, [&] { return m_stopFlag.load() || !m_eventSet.empty(); });
+            const auto hasWork = [&] {
+                return m_stopFlag.load() || !m_eventScheduler->empty() || m_runUntilActive ||
+                       m_settleActive.load();
+            };
+            // the slot states are published before going idle
+            while (true) {
+                m_queueCV.wait(queueLock, [&] { return hasWork() || needsSlotSnapshot(); });
+                if (hasWork())
+                    break;
+                queueLock.unlock();
+                publishSlotSnapshot();
+                queueLock.lock();
+            }
             if (m_stopFlag.load())
                 break;
 
             std::unique_lock stateLock(m_stateMutex);
-            if (m_simState.load() == SimulationState::paused) {
+            if (m_simState.load() == SimulationState::paused && !m_settleActive.load()) {
                 queueLock.unlock();
                 m_stepFlag.store(false);
-                m_stateCV.wait(stateLock, [&] { return m_stopFlag.load() ||
-                                                       m_simState.load() == SimulationState::running ||
-                                                       m_stepFlag.load(); });
+                const auto canSimulate = [&] {
+                    return m_stopFlag.load() || m_simState.load() == SimulationState::running ||
+                           m_stepFlag.load() || m_settleActive.load();
+                };
+                while (true) {
+                    m_stateCV.wait(stateLock, [&] { return canSimulate() || needsSlotSnapshot(); });
+                    if (canSimulate())
+                        break;
+                    stateLock.unlock();
+                    publishSlotSnapshot();
+                    stateLock.lock();
+                }
+                // queue before state, same order as everywhere else
+                stateLock.unlock();
                 queueLock.lock();
+                stateLock.lock();
+                // the time spent paused is not caught up on
+                m_paceAnchorValid = false;
             }
 
             if (m_stopFlag.load())
                 break;
 
-            if (m_eventSet.empty())
+            // settling ignores the paused state and pacing, it ends before the next clock edge
+            const bool settling = m_settleActive.load();
+            if (settling && m_pendingEvents == 0) {
+                m_settleActive.store(false);
+                m_queueCV.notify_all();
                 continue;
-
-            auto deltaTime = m_eventSet.begin()->simTime - m_currentSimTime;
-            m_currentSimTime = m_eventSet.begin()->simTime;
-
-            std::set<SimulationEvent> eventsToSim = {};
-            while (!m_eventSet.empty() && m_eventSet.begin()->simTime == m_currentSimTime) {
-                auto ev = *m_eventSet.begin();
-                if (!eventsToSim.empty() && eventsToSim.rbegin()->schedulerId != ev.schedulerId)
-                    break;
-                eventsToSim.insert(ev);
-                m_eventSet.erase(m_eventSet.begin());
             }
 
-            BESS_LOG_EVENT("");
-            BESS_LOG_EVENT("[SimulationEngine][t = {}ns][dt = {}ns] Picked {} events to simulate",
-                           m_currentSimTime.count(), deltaTime.count(), eventsToSim.size());
+            if (m_runUntilActive && (m_eventScheduler->empty() ||
+                                     m_eventScheduler->top().simTime > m_runUntilTime)) {
+                // nothing is left before the target, time still passes up to it
+                m_currentSimTime = std::max(m_currentSimTime, m_runUntilTime);
+                m_runUntilActive = false;
+                m_simState.store(SimulationState::paused);
+                BESS_DEBUG("[SimulationEngine] Reached {}ns, simulation paused", m_currentSimTime.count());
+                m_queueCV.notify_all();
+                continue;
+            }
 
-            std::unordered_map<UUID, std::vector<SlotState>> inputsMap = {};
+            if (m_eventScheduler->empty())
+                continue;
 
-            for (auto &ev : eventsToSim) {
-                inputsMap[ev.compId] = getInputSlotsState(ev.compId);
+            // a single step is never delayed
+            if (m_simState.load() == SimulationState::running && !settling) {
+                const auto dueAt = pacedWallTime(m_eventScheduler->top().simTime);
+                if (dueAt > std::chrono::steady_clock::now()) {
+                    stateLock.unlock();
+                    if (needsSlotSnapshot()) {
+                        queueLock.unlock();
+                        publishSlotSnapshot();
+                        continue;
+                    }
+                    // woken early by new events, state or pacing changes, so everything is checked again
+                    m_queueCV.wait_until(queueLock, dueAt);
+                    continue;
+                }
             }
-            BESS_LOG_EVENT("[SimulationEngine] Selected {} unique entites to simulate", inputsMap.size());
-
-            m_isSimulating = true;
-            for (auto &[compId, inputs] : inputsMap) {
-                queueLock.unlock();
-                stateLock.unlock();
 
-                {
-                    std::lock_guard regLock(m_registryMutex);
+            auto deltaTime = m_eventScheduler->top().simTime - m_currentSimTime;
+            m_currentSimTime = m_eventScheduler->top().simTime;
 
-                    const bool changed = simulateComponent(compId, inputs);
-                    const auto &dc = m_simEngineState.getDigitalComponent(compId);
+            collectBatch();
+            m_eventStats.processed += m_batchEvents.size();
 
-                    if (changed) {
-                        scheduleDependantsOf(compId);
-                    }
+            BESS_LOG_EVENT("");
+            BESS_LOG_EVENT("[SimulationEngine][t = {}ns][dt = {}ns] Picked {} events to simulate",
+                           m_currentSimTime.count(), deltaTime.count(), m_batchEvents.size());
 
-                    if (dc->definition->getShouldAutoReschedule()) {
-                        scheduleEvent(compId,
-                                      UUID::null,
-                                      dc->definition->getRescheduleTime(m_currentSimTime));
-                    }
-                }
+            m_isSimulating = true;
+            queueLock.unlock();
+            stateLock.unlock();
 
-                queueLock.lock();
-                stateLock.lock();
+            {
+                std::lock_guard regLock(m_registryMutex);
+                // slot writes from other threads are recorded under the history lock, they
+                // wait for the timestep instead of landing in the middle of it
+                std::unique_lock historyLock(m_historyMutex, std::defer_lock);
+                if (m_historyEnabled)
+                    historyLock.lock();
+                simulateBatch(m_batchEvents);
+                if (historyLock.owns_lock())
+                    closeHistoryTimestep();
+                m_snapshotStale = true;
+                if (std::chrono::steady_clock::now() - m_lastSnapshotPublish >= snapshotPublishInterval)
+                    publishSlotSnapshotLocked();
             }
+
+            queueLock.lock();
+            stateLock.lock();
             m_isSimulating = false;
+            m_eventStats.evaluated += m_batchComps.size();
+            if (m_pendingEvents == 0)
+                m_stableGeneration++;
             m_queueCV.notify_all();
 
             BESS_LOG_EVENT("[BessSimEngine] Sim Cycle End");
             BESS_LOG_EVENT("");
 
-            if (!m_eventSet.empty()) {
-                m_queueCV.wait_until(queueLock, std::chrono::steady_clock::now() +
-                                                    (m_eventSet.begin()->simTime - m_currentSimTime));
-            } else {
+            if (m_eventScheduler->empty()) {
                 BESS_DEBUG("[BessSimEngine] Event queue empty, waiting for new events");
+                // events scheduled while idle are paced from the moment they arrive
+                m_paceAnchorValid = false;
                 m_queueCV.notify_all();
             }
         }
     }
 
-    bool SimulationEngine::updateInputCount(const UUID &uuid, int n) {
+    std::chrono::steady_clock::time_point SimulationEngine::pacedWallTime(SimTime simTime) {
+        if (m_pacing == SimulationPacing::asFastAsPossible)
+            return std::chrono::steady_clock::time_point::min();
 
-        throw std::runtime_error("updateInputCount is not implemented yet");
+        const auto now = std::chrono::steady_clock::now();
+        if (!m_paceAnchorValid) {
+            m_paceWallAnchor = now;
+            m_paceSimAnchor = m_currentSimTime;
+            m_paceAnchorValid = true;
+        }
 
-        if (!m_simEngineState.isComponentValid(uuid))
-            return false;
+        const double scale = m_pacing == SimulationPacing::scaled ? m_timeScale : 1.0;
+        // clamped so very slow scales do not overflow the clock
+        const double wallNs = std::min(static_cast<double>((simTime - m_paceSimAnchor).count()) / scale,
+                                       static_cast<double>(std::chrono::nanoseconds(std::chrono::hours(24)).count()));
+        const auto dueAt = m_paceWallAnchor + std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+                                                  std::chrono::duration<double, std::nano>(wallNs));
+
+        // the simulation cannot keep up, continue from here instead of catching up in a burst
+        if (now - dueAt > maxPacingLag) {
+            m_paceWallAnchor = now;
+            m_paceSimAnchor = simTime;
+            return now;
+        }
+        return dueAt;
+    }
 
-        const auto digiComp = m_simEngineState.getDigitalComponent(uuid);
-        // digiComp->updateInputCount(n);
-        return true;
+    SimulationPacing SimulationEngine::getPacing() const {
+        std::lock_guard lk(m_queueMutex);
+        return m_pacing;
     }
 
-    std::vector<std::pair<float, bool>> SimulationEngine::getStateMonitorData(UUID uuid) {
-        if (!m_simEngineState.isComponentValid(uuid)) {
-            BESS_WARN("[SimulationEngine] getStateMonitorData was called on entity with no StateMonitorComponent: {}", (uint64_t)uuid);
-            return {};
+    void SimulationEngine::setPacing(SimulationPacing pacing) {
+        std::lock_guard lk(m_queueMutex);
+        m_pacing = pacing;
+        m_paceAnchorValid = false;
+        m_queueCV.notify_all();
+    }
+
+    double SimulationEngine::getTimeScale() const {
+        std::lock_guard lk(m_queueMutex);
+        return m_timeScale;
+    }
+
+    void SimulationEngine::setTimeScale(double scale) {
+        if (!std::isfinite(scale) || scale <= 0.0) {
+            throw std::runtime_error(std::format("Time scale must be a positive number, got {}", scale));
         }
+        std::lock_guard lk(m_queueMutex);
+        m_timeScale = scale;
+        m_paceAnchorValid = false;
+        m_queueCV.notify_all();
+    }
 
-        // FIXME: State monitor is not implemented yet
-        // auto comp = m_simEngineState.getDigitalComponent(uuid);
-        // return comp->timestepedBoolData;
-        return {};
+    SimulationMode SimulationEngine::getSimulationMode() const {
+        return m_simulationMode.load();
     }
 
-    std::vector<UUID> SimulationEngine::getConnGraph(UUID start) {
-        std::vector<UUID> graph;
-        std::set<UUID> visited;
-        std::vector<UUID> toVisit;
-        toVisit.push_back(start);
+    void SimulationEngine::setSimulationMode(SimulationMode mode) {
+        // picked up by the next timestep, never in the middle of one
+        std::lock_guard lk(m_registryMutex);
+        m_simulationMode.store(mode);
+    }
 
-        while (!toVisit.empty()) {
-            auto current = toVisit.back();
-            toVisit.pop_back();
+    SimCycleStats SimulationEngine::getCycleStats() const {
+        std::lock_guard lk(m_registryMutex);
+        SimCycleStats stats;
+        stats.active = m_cycleSchedule.isValid();
+        stats.fallbackReason = m_cycleSchedule.getFallbackReason();
+        stats.clockDomains = m_cycleSchedule.getClockDomains().size();
+        stats.registers = m_cycleSchedule.getRegisterCount();
+        stats.combinational = m_cycleSchedule.getCombinationalOrder().size();
+        stats.depth = m_cycleSchedule.getDepth();
+        stats.cycles = m_cycleCount;
+        stats.sweeps = m_cycleSweeps;
+        stats.native = m_nativeModel != nullptr;
+        stats.nativeFallbackReason = m_nativeFallbackReason;
+        return stats;
+    }
 
-            if (visited.contains(current))
-                continue;
+    bool SimulationEngine::waitForNativeModel(std::chrono::milliseconds timeout) {
+        {
+            std::lock_guard lk(m_registryMutex);
+            if (m_nativeModel)
+                return true;
+        }
+        // adopted by the sim thread at its next timestep
+        std::unique_lock lk(m_nativeBuild.mutex);
+        m_nativeBuild.finished.wait_for(lk, timeout, [this] {
+            return m_nativeBuild.version == 0 || m_nativeBuild.done || m_nativeBuild.stop;
+        });
+        return m_nativeBuild.done && m_nativeBuild.model != nullptr;
+    }
+
+    void SimulationEngine::setNativeModelConfig(const NativeModelConfig &config) {
+        std::lock_guard lk(m_registryMutex);
+        m_nativeConfig = config;
+    }
+
+    void SimulationEngine::requestRunUntil(SimTime time) {
+        // queue before state, same order as the sim loop
+        std::lock_guard queueLock(m_queueMutex);
+        m_runUntilTime = time;
+        m_runUntilActive = true;
+        m_paceAnchorValid = false;
+        {
+            std::lock_guard stateLock(m_stateMutex);
+            m_simState.store(SimulationState::running);
+        }
+        m_stateCV.notify_all();
+        m_queueCV.notify_all();
+    }
+
+    bool SimulationEngine::runUntil(SimTime time) {
+        requestRunUntil(time);
+        std::unique_lock queueLock(m_queueMutex);
+        m_queueCV.wait(queueLock, [&] { return m_stopFlag.load() || !m_runUntilActive; });
+        return !m_runUntilActive;
+    }
 
-            visited.insert(current);
-            graph.push_back(current);
+    bool SimulationEngine::isRunningUntil() const {
+        std::lock_guard lk(m_queueMutex);
+        return m_runUntilActive;
+    }
 
-            const auto &comp = m_simEngineState.getDigitalComponent(current);
+    void SimulationEngine::collectBatch() {
+        // events come out of the scheduler in order, so the batch stays sorted
+        m_batchEvents.clear();
+        const bool canMerge = isNetlistFresh();
+        m_collectStamp++;
+
+        while (!m_eventScheduler->empty() && m_eventScheduler->top().simTime == m_currentSimTime) {
+            // a run of same time events from one scheduler is always simulated together
+            m_runEvents.clear();
+            const auto schedulerId = m_eventScheduler->top().schedulerId;
+            while (!m_eventScheduler->empty() && m_eventScheduler->top().simTime == m_currentSimTime &&
+                   m_eventScheduler->top().schedulerId == schedulerId) {
+                m_runEvents.push_back(m_eventScheduler->top());
+                m_eventScheduler->pop();
+                if (!m_runEvents.back().freeRunning)
+                    m_pendingEvents--;
+            }
 
-            for (const auto &pinConnections : comp->inputConnections) {
-                for (const auto &conn : pinConnections) {
-                    if (conn.first != UUID::null && !visited.contains(conn.first)) {
-                        toVisit.push_back(conn.first);
+            // Later runs used to get a batch of their own, so they saw the outputs of the
+            // earlier ones. Joining the batch only gives the same result when none of their
+            // components is already in it or driven by something in it.
+            if (!m_batchEvents.empty()) {
+                const bool independent = canMerge && std::ranges::none_of(m_runEvents, [&](const auto &ev) {
+                    const auto idx = m_netlist.indexOf(ev.compId);
+                    return idx == invalidCompIndex || m_collectMarks[idx] == m_collectStamp;
+                });
+                if (!independent) {
+                    for (const auto &ev : m_runEvents) {
+                        m_eventScheduler->push(ev);
+                        if (!ev.freeRunning)
+                            m_pendingEvents++;
                     }
+                    break;
                 }
             }
 
-            for (const auto &pinConnections : comp->outputConnections) {
-                for (const auto &conn : pinConnections) {
-                    if (conn.first != UUID::null && !visited.contains(conn.first)) {
-                        toVisit.push_back(conn.first);
+            for (const auto &ev : m_runEvents) {
+                const auto idx = m_netlist.indexOf(ev.compId);
+                if (idx == invalidCompIndex || idx >= m_scheduledAt.size())
+                    continue;
+                // later events for this component at this time must be queued again
+                if (m_scheduledAt[idx] == ev.simTime)
+                    m_scheduledAt[idx] = notScheduled;
+                if (canMerge) {
+                    m_collectMarks[idx] = m_collectStamp;
+                    for (const auto dep : m_netlist.getDependants(idx)) {
+                        m_collectMarks[dep] = m_collectStamp;
                     }
                 }
             }
-        }
+            m_batchEvents.insert(m_batchEvents.end(), m_runEvents.begin(), m_runEvents.end());
 
-        return graph;
+            if (!canMerge)
+                break;
+        }
     }
 
-    bool SimulationEngine::isNetUpdated() const {
-        return m_isNetUpdated;
-    }
+    void SimulationEngine::simulateBatch(const std::vector<SimulationEvent> &events) {
+        ensureNetlistCompiled();
+        applyExternalOutputWrites();
 
-    const std::unordered_map<UUID, Net> &SimulationEngine::getNetsMap(bool update) {
+        // a component resized since the last compile invalidates the slot layout
+        for (const auto &ev : events) {
+            const auto idx = m_netlist.indexOf(ev.compId);
+            if (idx != invalidCompIndex && !m_netlist.isShapeValid(idx)) {
+                m_simEngineState.markTopologyChanged();
+                ensureNetlistCompiled();
+                break;
+            }
+        }
 
-        // using clean code rather than short on purpose ;)
-        if (update)
-            m_isNetUpdated = false;
+        ensureCycleSchedule();
+        ensureNativeModel();
+        if (m_cycleSchedule.isValid()) {
+            simulateCycle(events);
+            return;
+        }
 
-        return m_nets;
-    }
+        m_batchCounter++;
+        m_batchComps.clear();
+        for (const auto &ev : events) {
+            const auto idx = m_netlist.indexOf(ev.compId);
+            if (idx == invalidCompIndex || m_batchMarks[idx] == m_batchCounter)
+                continue;
+            m_batchMarks[idx] = m_batchCounter;
+            m_batchComps.push_back(idx);
+        }
 
-    TruthTable SimulationEngine::getTruthTableOfNet(const UUID &netUuid) {
-        if (!m_nets.contains(netUuid))
-            return {};
+        // all inputs are sampled before any component of the batch is updated,
+        // back to back in one buffer that is reset every timestep
+        m_batchInputs.clear();
+        m_batchInputBegin.clear();
+        for (const auto idx : m_batchComps) {
+            m_batchInputBegin.push_back(static_cast<uint32_t>(m_batchInputs.size()));
+            m_netlist.gatherInputs(idx, m_batchInputs);
+        }
+        m_batchInputBegin.push_back(static_cast<uint32_t>(m_batchInputs.size()));
+        BESS_LOG_EVENT("[SimulationEngine] Selected {} unique entites to simulate", m_batchComps.size());
+
+        // wide timesteps are evaluated on the pool first, everything that touches shared
+        // state below still runs here in batch order, so results match the serial mode
+        const bool parallel = m_workerPool && m_batchComps.size() >= minParallelBatchSize;
+        if (parallel) {
+            evaluateBatchInParallel();
+        }
 
-        BESS_INFO("\nGenerating truth table for net {}", (uint64_t)netUuid);
-        const auto &net = m_nets.at(netUuid);
+        for (size_t i = 0; i < m_batchComps.size(); i++) {
+            const auto idx = m_batchComps[i];
+            const std::span<const SlotState> inputs(m_batchInputs.data() + m_batchInputBegin[i],
+                                                    m_batchInputBegin[i + 1] - m_batchInputBegin[i]);
+            bool changed = false;
+            if (parallel && m_batchOutcomes[i] != EvalOutcome::deferred) {
+                const std::span<const SlotState> outputs(m_batchOutputs.data() + m_batchOutputBegin[i],
+                                                         m_batchOutputBegin[i + 1] - m_batchOutputBegin[i]);
+                changed = applyEvaluation(idx, inputs, m_batchOutcomes[i], outputs, m_batchErrors[i]);
+            } else {
+                changed = simulateComponent(idx, inputs);
+            }
 
-        TruthTable truthTable;
+            if (changed) {
+                scheduleDependantsOf(idx);
+            }
 
-        std::vector<UUID> components;
+            const auto &def = m_netlist.componentAt(idx)->definition;
+            if (def->getShouldAutoReschedule()) {
+                scheduleEvent(m_netlist.uuidOf(idx),
+                              UUID::null,
+                              def->getRescheduleTime(m_currentSimTime),
+                              true);
+            }
+        }
+    }
 
-        std::vector<std::pair<UUID, int>> inputs;
-        std::vector<std::pair<UUID, int>> outputs;
-        std::unordered_map<UUID, size_t> inputSlotCounts;
+    void SimulationEngine::ensureCycleSchedule() {
+        if (m_simulationMode.load() == SimulationMode::eventDriven) {
+            m_cycleSchedule.clear();
+            return;
+        }
+        if (m_cycleSchedule.isBuiltFor(m_netlist.getCompiledVersion()))
+            return;
 
-        for (const auto &compUuid : net.getComponents()) {
-            if (compUuid == UUID::null)
-                continue;
+        if (!m_cycleSchedule.build(m_netlist)) {
+            BESS_INFO("[SimulationEngine] Simulating event driven, {}", m_cycleSchedule.getFallbackReason());
+            return;
+        }
 
-            const auto &comp = m_simEngineState.getDigitalComponent(compUuid);
-            bool isInput = comp->definition->getBehaviorType() == ComponentBehaviorType::input;
-            bool isOutput = comp->definition->getBehaviorType() == ComponentBehaviorType::output;
+        m_cycleQueued.assign(m_netlist.size(), 0);
+        m_cycleDirty.assign((m_cycleSchedule.getCombinationalOrder().size() + 63) / 64, 0);
+        m_cycleClockLevels.clear();
+        for (const auto &domain : m_cycleSchedule.getClockDomains()) {
+            m_cycleClockLevels.push_back(m_netlist.getOutput(domain.source, domain.slot).state);
+        }
+        BESS_INFO("[SimulationEngine] Simulating cycle based, {} registers in {} clock domains",
+                  m_cycleSchedule.getRegisterCount(), m_cycleSchedule.getClockDomains().size());
+    }
 
-            if (isInput) {
-                for (int i = 0; i < comp->definition->getOutputSlotsInfo().count; i++) {
-                    inputs.emplace_back(compUuid, i);
-                    truthTable.inputUuids.push_back(compUuid);
+    bool SimulationEngine::simulateInCycle(CompIndex idx) {
+        m_cycleInputs.clear();
+        m_netlist.gatherInputs(idx, m_cycleInputs);
+        m_batchComps.push_back(idx);
+        return simulateComponent(idx, m_cycleInputs);
+    }
+
+    void SimulationEngine::markCycleDependants(CompIndex idx, bool clockEdge) {
+        for (const auto dep : m_netlist.getDependants(idx)) {
+            switch (m_cycleSchedule.getRole(dep)) {
+            case CycleSchedule::Role::combinational: {
+                const auto rank = m_cycleSchedule.getRank(dep);
+                m_cycleDirty[rank / 64] |= uint64_t{1} << (rank % 64);
+                break;
+            }
+            case CycleSchedule::Role::reg: {
+                const auto flag = clockEdge ? cycleClocked : cycleRefresh;
+                if ((m_cycleQueued[dep] & flag) == 0) {
+                    m_cycleQueued[dep] |= flag;
+                    (clockEdge ? m_cycleClocked : m_cycleRefresh).push_back(dep);
                 }
-            } else if (isOutput) {
-                for (int i = 0; i < comp->definition->getInputSlotsInfo().count; i++) {
-                    outputs.emplace_back(compUuid, i);
-                    truthTable.outputUuids.push_back(compUuid);
+                break;
+            }
+            case CycleSchedule::Role::source:
+                break;
+            }
+        }
+    }
+
+    void SimulationEngine::ensureNativeModel() {
+        if (m_simulationMode.load() != SimulationMode::native || !m_cycleSchedule.isValid()) {
+            if (m_nativeVersion != 0)
+                requestNativeBuild(0);
+            m_nativeModel.reset();
+            m_nativeBuildPending = false;
+            m_nativeVersion = 0;
+            m_nativeFallbackReason.clear();
+            return;
+        }
+
+        const auto version = m_netlist.getCompiledVersion();
+        if (m_nativeVersion != version) {
+            m_nativeModel.reset();
+            m_nativeBuildPending = false;
+            m_nativeVersion = version;
+            m_nativeFallbackReason.clear();
+
+            std::optional<NativeModelSource> source;
+            try {
+                source = NativeModel::generate(m_netlist, m_cycleSchedule);
+            } catch (const std::exception &ex) {
+                m_nativeFallbackReason = ex.what();
+                BESS_INFO("[SimulationEngine] Sweeping the logic interpreted, {}", m_nativeFallbackReason);
+            }
+            if (!source) {
+                requestNativeBuild(0);
+                return;
+            }
+            // the builder compiles it, neither the sim thread nor a newer build waits for the compiler
+            requestNativeBuild(version, std::move(source));
+            m_nativeBuildPending = true;
+        }
+
+        if (!m_nativeBuildPending)
+            return;
+        {
+            std::lock_guard lk(m_nativeBuild.mutex);
+            if (!m_nativeBuild.done)
+                return;
+            m_nativeModel = m_nativeBuild.model;
+            m_nativeFallbackReason = m_nativeBuild.error;
+        }
+        m_nativeBuildPending = false;
+        if (!m_nativeModel) {
+            BESS_WARN("[SimulationEngine] Sweeping the logic interpreted, {}", m_nativeFallbackReason);
+            return;
+        }
+
+        // the interpreted sweeps so far left the outputs consistent, the model starts from them
+        m_nativeNets.assign(m_nativeModel->getNetCount(), 0);
+        m_nativeDrivers.clear();
+        for (CompIndex idx = 0; idx < m_netlist.size(); idx++) {
+            for (size_t slot = 0; slot < m_netlist.getOutputCount(idx); slot++) {
+                m_nativeNets[m_nativeModel->getNet(idx, slot)] = m_netlist.getOutput(idx, slot).state == LogicState::high;
+            }
+            if (m_cycleSchedule.getRole(idx) != CycleSchedule::Role::combinational)
+                m_nativeDrivers.push_back(idx);
+        }
+        m_nativeChanged.resize(m_nativeModel->getSource().combinational);
+        BESS_INFO("[SimulationEngine] Sweeping the logic natively, {} components in {} blocks{}",
+                  m_nativeModel->getSource().combinational, m_nativeModel->getSource().blocks,
+                  m_nativeModel->wasCached() ? ", cached" : "");
+    }
+
+    void SimulationEngine::requestNativeBuild(uint64_t version, std::optional<NativeModelSource> source) {
+        std::lock_guard lk(m_nativeBuild.mutex);
+        m_nativeBuild.version = version;
+        m_nativeBuild.source = std::move(source);
+        m_nativeBuild.config = m_nativeConfig;
+        m_nativeBuild.done = false;
+        m_nativeBuild.model.reset();
+        m_nativeBuild.error.clear();
+        m_nativeBuild.requested.notify_all();
+        m_nativeBuild.finished.notify_all();
+    }
+
+    void SimulationEngine::nativeBuildLoop() {
+        std::unique_lock lk(m_nativeBuild.mutex);
+        while (true) {
+            m_nativeBuild.requested.wait(lk, [this] { return m_nativeBuild.stop || m_nativeBuild.source; });
+            if (m_nativeBuild.stop)
+                return;
+
+            auto source = std::move(*m_nativeBuild.source);
+            m_nativeBuild.source.reset();
+            const auto version = m_nativeBuild.version;
+            const auto config = m_nativeBuild.config;
+            lk.unlock();
+
+            std::shared_ptr<NativeModel> model;
+            std::string error;
+            try {
+                model = NativeModel::load(std::move(source), config);
+            } catch (const std::exception &ex) {
+                error = ex.what();
+            }
+
+            lk.lock();
+            // superseded while compiling, the newer request is picked up by the next wait
+            if (m_nativeBuild.version != version)
+                continue;
+            m_nativeBuild.done = true;
+            m_nativeBuild.model = std::move(model);
+            m_nativeBuild.error = std::move(error);
+            m_nativeBuild.finished.notify_all();
+        }
+    }
+
+    void SimulationEngine::sweepNative() {
+        for (const auto idx : m_nativeDrivers) {
+            for (size_t slot = 0; slot < m_netlist.getOutputCount(idx); slot++) {
+                m_nativeNets[m_nativeModel->getNet(idx, slot)] = m_netlist.getOutput(idx, slot).state == LogicState::high;
+            }
+        }
+
+        const auto count = m_nativeModel->evaluate(m_nativeNets.data(), m_nativeChanged.data());
+        for (uint32_t i = 0; i < count; i++) {
+            const auto idx = m_nativeChanged[i];
+            const auto rank = m_cycleSchedule.getRank(idx);
+            m_cycleDirty[rank / 64] |= uint64_t{1} << (rank % 64);
+            markCycleDependants(idx, false);
+        }
+
+        // in rank order, so every component gathers inputs that are already written back
+        const auto order = m_cycleSchedule.getCombinationalOrder();
+        for (size_t w = 0; w < m_cycleDirty.size(); w++) {
+            while (m_cycleDirty[w] != 0) {
+                const auto bit = static_cast<size_t>(std::countr_zero(m_cycleDirty[w]));
+                m_cycleDirty[w] &= m_cycleDirty[w] - 1;
+                writeBackNative(order[(w * 64) + bit]);
+            }
+        }
+    }
+
+    void SimulationEngine::writeBackNative(CompIndex idx) {
+        m_cycleInputs.clear();
+        m_netlist.gatherInputs(idx, m_cycleInputs);
+        m_batchComps.push_back(idx);
+
+        // outputs the model does not compute, e.g. of an Output component, stay as they are
+        const auto &state = m_netlist.componentAt(idx)->state;
+        m_scratchOutputs.assign(state.outputStates.begin(), state.outputStates.end());
+        auto outcome = m_netlist.componentAt(idx)->definition->getBehaviorType() == ComponentBehaviorType::output
+                           ? EvalOutcome::changed
+                           : EvalOutcome::unchanged;
+        for (size_t slot = 0; slot < m_scratchOutputs.size(); slot++) {
+            const auto next = m_nativeNets[m_nativeModel->getNet(idx, slot)] ? LogicState::high : LogicState::low;
+            if (m_scratchOutputs[slot].state == next)
+                continue;
+            m_scratchOutputs[slot] = {next, m_currentSimTime};
+            outcome = EvalOutcome::changed;
+        }
+        applyEvaluation(idx, m_cycleInputs, outcome, m_scratchOutputs, m_scratchError);
+    }
+
+    void SimulationEngine::simulateCycle(const std::vector<SimulationEvent> &events) {
+        m_batchCounter++;
+        m_batchComps.clear();
+        m_cycleClocked.clear();
+        m_cycleRefresh.clear();
+        const auto order = m_cycleSchedule.getCombinationalOrder();
+
+        // sources first, the registers of this edge see whatever they drive
+        for (const auto &ev : events) {
+            const auto idx = m_netlist.indexOf(ev.compId);
+            if (idx == invalidCompIndex || m_batchMarks[idx] == m_batchCounter)
+                continue;
+            m_batchMarks[idx] = m_batchCounter;
+
+            switch (m_cycleSchedule.getRole(idx)) {
+            case CycleSchedule::Role::source: {
+                if (simulateInCycle(idx))
+                    markCycleDependants(idx, true);
+                const auto &def = m_netlist.componentAt(idx)->definition;
+                if (def->getShouldAutoReschedule()) {
+                    scheduleEvent(m_netlist.uuidOf(idx), UUID::null, def->getRescheduleTime(m_currentSimTime), true);
+                }
+                break;
+            }
+            case CycleSchedule::Role::reg:
+                if ((m_cycleQueued[idx] & cycleClocked) == 0) {
+                    m_cycleQueued[idx] |= cycleClocked;
+                    m_cycleClocked.push_back(idx);
+                }
+                break;
+            case CycleSchedule::Role::combinational: {
+                const auto rank = m_cycleSchedule.getRank(idx);
+                m_cycleDirty[rank / 64] |= uint64_t{1} << (rank % 64);
+                break;
+            }
+            }
+        }
+
+        const auto &domains = m_cycleSchedule.getClockDomains();
+        for (size_t d = 0; d < domains.size(); d++) {
+            const auto level = m_netlist.getOutput(domains[d].source, domains[d].slot).state;
+            if (level == LogicState::high && m_cycleClockLevels[d] != LogicState::high)
+                m_cycleCount++;
+            m_cycleClockLevels[d] = level;
+        }
+        m_cycleSweeps++;
+
+        // registers sample their inputs together, before any of them is updated
+        m_batchInputs.clear();
+        m_batchInputBegin.clear();
+        for (const auto idx : m_cycleClocked) {
+            m_batchInputBegin.push_back(static_cast<uint32_t>(m_batchInputs.size()));
+            m_netlist.gatherInputs(idx, m_batchInputs);
+        }
+        m_batchInputBegin.push_back(static_cast<uint32_t>(m_batchInputs.size()));
+        for (size_t i = 0; i < m_cycleClocked.size(); i++) {
+            const auto idx = m_cycleClocked[i];
+            const std::span<const SlotState> inputs(m_batchInputs.data() + m_batchInputBegin[i],
+                                                    m_batchInputBegin[i + 1] - m_batchInputBegin[i]);
+            m_batchComps.push_back(idx);
+            if (simulateComponent(idx, inputs))
+                markCycleDependants(idx, false);
+        }
+
+        // dependants always rank later, so one pass in rank order settles the logic
+        if (m_nativeModel) {
+            sweepNative();
+        } else {
+            for (size_t w = 0; w < m_cycleDirty.size(); w++) {
+                while (m_cycleDirty[w] != 0) {
+                    const auto bit = static_cast<size_t>(std::countr_zero(m_cycleDirty[w]));
+                    m_cycleDirty[w] &= m_cycleDirty[w] - 1;
+                    const auto idx = order[(w * 64) + bit];
+                    if (simulateInCycle(idx))
+                        markCycleDependants(idx, false);
+                }
+            }
+        }
+
+        // without an edge registers only take their new inputs, anything else goes to the queue
+        for (const auto idx : m_cycleRefresh) {
+            if (simulateInCycle(idx))
+                scheduleDependantsOf(idx);
+        }
+
+        for (const auto idx : m_cycleClocked)
+            m_cycleQueued[idx] = 0;
+        for (const auto idx : m_cycleRefresh)
+            m_cycleQueued[idx] = 0;
+    }
+
+    void SimulationEngine::evaluateBatchInParallel() {
+        const size_t count = m_batchComps.size();
+        m_batchOutcomes.assign(count, EvalOutcome::deferred);
+        if (m_batchErrors.size() < count)
+            m_batchErrors.resize(count);
+
+        m_batchOutputBegin.clear();
+        uint32_t outputCount = 0;
+        for (const auto idx : m_batchComps) {
+            m_batchOutputBegin.push_back(outputCount);
+            outputCount += static_cast<uint32_t>(m_netlist.componentAt(idx)->state.outputStates.size());
+        }
+        m_batchOutputBegin.push_back(outputCount);
+        m_batchOutputs.resize(outputCount);
+
+        m_workerPool->parallelFor(count, parallelGrainSize, m_evaluateRange);
+    }
+
+    void SimulationEngine::evaluateRange(size_t begin, size_t end) {
+        for (size_t i = begin; i < end; i++) {
+            const auto idx = m_batchComps[i];
+            const auto *comp = m_netlist.componentAt(idx);
+            const auto &def = comp->definition;
+            // left for the merge loop, it runs them on the sim thread in order
+            if (!def || !def->getParallelSafe() || !def->getInPlaceSimulationFunction())
+                continue;
+
+            const std::span<const SlotState> inputs(m_batchInputs.data() + m_batchInputBegin[i],
+                                                    m_batchInputBegin[i + 1] - m_batchInputBegin[i]);
+            const std::span<SlotState> outputs(m_batchOutputs.data() + m_batchOutputBegin[i],
+                                               m_batchOutputBegin[i + 1] - m_batchOutputBegin[i]);
+            std::ranges::copy(comp->state.outputStates, outputs.begin());
+            m_batchOutcomes[i] = evaluateInPlace(idx, inputs, outputs, m_batchErrors[i]);
+        }
+    }
+
+    void SimulationEngine::setWorkerThreadCount(size_t count) {
+        std::lock_guard lk(m_registryMutex);
+        if (count <= 1) {
+            m_workerPool.reset();
+            return;
+        }
+
+        if (m_workerPool && m_workerPool->getThreadCount() == count)
+            return;
+
+        m_workerPool = std::make_unique<WorkStealingPool>(count);
+        BESS_INFO("[SimulationEngine] Evaluating wide timesteps on {} threads", count);
+    }
+
+    size_t SimulationEngine::getWorkerThreadCount() const {
+        std::lock_guard lk(m_registryMutex);
+        return m_workerPool ? m_workerPool->getThreadCount() : 1;
+    }
+
+    bool SimulationEngine::isNetlistFresh() const {
+        return m_netlist.getCompiledVersion() == m_simEngineState.getTopologyVersion();
+    }
+
+    void SimulationEngine::ensureNetlistCompiled() {
+        if (isNetlistFresh())
+            return;
+
+        std::unique_lock netlistLock(m_netlistMutex);
+        m_netlist.compile(m_simEngineState);
+        m_batchMarks.assign(m_netlist.size(), 0);
+        m_batchCounter = 0;
+        // events queued before the compile are not tracked, they are at worst run twice
+        m_scheduledAt.assign(m_netlist.size(), notScheduled);
+        m_collectMarks.assign(m_netlist.size(), 0);
+        m_collectStamp = 0;
+        BESS_DEBUG("[SimulationEngine] Compiled netlist with {} components", m_netlist.size());
+    }
+
+    bool SimulationEngine::hasExternalOutputWrites() const {
+        std::lock_guard queueLock(m_queueMutex);
+        return !m_externalOutputWrites.empty();
+    }
+
+    void SimulationEngine::applyExternalOutputWrites() {
+        {
+            std::lock_guard queueLock(m_queueMutex);
+            if (m_externalOutputWrites.empty())
+                return;
+        }
+
+        bool resized = false;
+        {
+            // taken before the swap, readers that saw pending writes are done before they land
+            std::unique_lock netlistLock(m_netlistMutex);
+            m_appliedOutputWrites.clear();
+            {
+                std::lock_guard queueLock(m_queueMutex);
+                m_appliedOutputWrites.swap(m_externalOutputWrites);
+            }
+            for (const auto &uuid : m_appliedOutputWrites) {
+                const auto idx = m_netlist.indexOf(uuid);
+                if (idx != invalidCompIndex && !m_netlist.syncOutputs(idx))
+                    resized = true;
+            }
+        }
+        if (resized) {
+            // the recompile reads every output from the components
+            m_simEngineState.markTopologyChanged();
+            ensureNetlistCompiled();
+        }
+    }
+
+    void SimulationEngine::addStateChangeListener(const UUID &listenerId, const UUID &component,
+                                                  const TOnSlotChangeCB &cb, bool everyTransition) {
+        {
+            std::lock_guard lk(m_registryMutex);
+            const auto comp = m_simEngineState.getDigitalComponent(component);
+            if (!comp) {
+                BESS_WARN("[addStateChangeListener] Component with UUID {} is invalid", (uint64_t)component);
+                return;
+            }
+            comp->stateChangeListeners++;
+        }
+        m_stateChangeListeners[component].push_back({listenerId, cb, everyTransition});
+    }
+
+    void SimulationEngine::removeStateChangeListener(const UUID &listenerId, const UUID &component) {
+        const auto it = m_stateChangeListeners.find(component);
+        if (it == m_stateChangeListeners.end())
+            return;
+
+        const auto removed = static_cast<uint32_t>(std::erase_if(it->second, [&](const auto &listener) {
+            return listener.id == listenerId;
+        }));
+        if (it->second.empty())
+            m_stateChangeListeners.erase(it);
+        if (removed == 0)
+            return;
+
+        std::lock_guard lk(m_registryMutex);
+        if (const auto comp = m_simEngineState.getDigitalComponent(component)) {
+            comp->stateChangeListeners -= std::min(comp->stateChangeListeners, removed);
+        }
+    }
+
+    size_t SimulationEngine::dispatchStateChanges() {
+        m_drainedChanges.clear();
+        const size_t count = m_stateChangeLog.drain(m_drainedChanges);
+
+        const uint64_t dropped = m_stateChangeLog.getDroppedCount();
+        if (dropped != m_reportedDroppedChanges) {
+            BESS_WARN("[SimulationEngine] State change log was full, {} changes were dropped",
+                      dropped - m_reportedDroppedChanges);
+            m_reportedDroppedChanges = dropped;
+        }
+
+        if (count == 0 || m_stateChangeListeners.empty())
+            return count;
+
+        // coalescing, walking backwards the first change seen of a slot is its last one
+        m_seenSlots.clear();
+        m_changeIsLast.assign(count, 0);
+        for (size_t i = count; i-- > 0;) {
+            const auto &change = m_drainedChanges[i];
+            if (!m_stateChangeListeners.contains(change.component))
+                continue;
+            m_changeIsLast[i] = m_seenSlots.insert(SlotKey(change)).second;
+        }
+
+        for (size_t i = 0; i < count; i++) {
+            const auto &change = m_drainedChanges[i];
+            const auto it = m_stateChangeListeners.find(change.component);
+            if (it == m_stateChangeListeners.end())
+                continue;
+            for (const auto &listener : it->second) {
+                if (listener.everyTransition || m_changeIsLast[i])
+                    listener.cb(change);
+            }
+        }
+        return count;
+    }
+
+    uint64_t SimulationEngine::getDroppedStateChanges() const {
+        return m_stateChangeLog.getDroppedCount();
+    }
+
+    bool SimulationEngine::startTrace(const std::filesystem::path &path, const std::vector<TraceSignal> &signals,
+                                      TraceFormat format) {
+        stopTrace();
+
+        auto writer = makeTraceWriter(format, path);
+        if (!writer) {
+            BESS_ERROR("[SimulationEngine] Failed to open trace file {}", path.string());
+            return false;
+        }
+
+        std::lock_guard lk(m_registryMutex);
+        auto traced = signals;
+        std::vector<SlotState> initial;
+        initial.reserve(traced.size());
+        for (auto &signal : traced) {
+            const auto comp = m_simEngineState.getDigitalComponent(signal.component);
+            if (!comp) {
+                BESS_WARN("[startTrace] Component with UUID {} is invalid", (uint64_t)signal.component);
+                initial.emplace_back(LogicState::unknown, m_currentSimTime);
+                continue;
+            }
+            const bool isInput = signal.type == SlotType::digitalInput;
+            const auto &slots = isInput ? comp->state.inputStates : comp->state.outputStates;
+            const auto &info = isInput ? comp->definition->getInputSlotsInfo()
+                                       : comp->definition->getOutputSlotsInfo();
+            signal.width = info.getWidth(static_cast<size_t>(signal.slot));
+            initial.push_back(signal.slot < slots.size() ? slots[signal.slot]
+                                                         : SlotState(LogicState::unknown, m_currentSimTime));
+            comp->traced = true;
+        }
+
+        auto recorder = std::make_unique<TraceRecorder>(std::move(writer), std::move(traced));
+        recorder->start(m_currentSimTime, initial);
+        m_traceRecorder = std::move(recorder);
+        return true;
+    }
+
+    void SimulationEngine::stopTrace() {
+        std::unique_ptr<TraceRecorder> recorder;
+        SimTime endTime{0};
+        {
+            std::lock_guard lk(m_registryMutex);
+            if (!m_traceRecorder)
+                return;
+            for (const auto &signal : m_traceRecorder->getSignals()) {
+                if (const auto comp = m_simEngineState.getDigitalComponent(signal.component))
+                    comp->traced = false;
+            }
+            recorder = std::move(m_traceRecorder);
+            endTime = m_currentSimTime;
+        }
+        // joins the writer thread, outside the lock so the simulation is not held up
+        recorder->stop(endTime);
+    }
+
+    bool SimulationEngine::isTracing() const {
+        std::lock_guard lk(m_registryMutex);
+        return m_traceRecorder != nullptr;
+    }
+
+    void SimulationEngine::pauseBetweenTimesteps() {
+        setSimulationState(SimulationState::paused);
+        std::unique_lock queueLock(m_queueMutex);
+        m_queueCV.wait(queueLock, [&] { return !m_isSimulating; });
+    }
+
+    void SimulationEngine::saveCheckpoint(std::ostream &out) {
+        // the stored net ids of the components
+        syncNets();
+        pauseBetweenTimesteps();
+
+        // registry before queue, same order as the sim loop
+        std::lock_guard lkRegistry(m_registryMutex);
+        std::vector<SimulationEvent> events;
+        SimTime simTime;
+        uint64_t nextEventId = 0;
+        {
+            std::lock_guard lkEventQueue(m_queueMutex);
+            m_eventScheduler->collect(events);
+            simTime = m_currentSimTime;
+            nextEventId = m_nextEventId;
+        }
+        SimCheckpointFormat::write(out, m_simEngineState, events, simTime, nextEventId);
+    }
+
+    void SimulationEngine::saveCheckpoint(const std::filesystem::path &path) {
+        std::ofstream out(path, std::ios::binary);
+        if (!out.is_open())
+            throw std::runtime_error("Failed to open checkpoint " + path.string());
+        saveCheckpoint(out);
+    }
+
+    void SimulationEngine::restoreCheckpoint(std::istream &in) {
+        // built completely before the engine is touched
+        auto checkpoint = SimCheckpointFormat::read(in);
+
+        // the trace's timeline ends with the current simulation
+        stopTrace();
+        pauseBetweenTimesteps();
+        {
+            std::lock_guard lkRegistry(m_registryMutex);
+            for (const auto &comp : checkpoint.components) {
+                if (const auto current = m_simEngineState.getDigitalComponent(comp->id))
+                    comp->stateChangeListeners = current->stateChangeListeners;
+            }
+
+            {
+                std::lock_guard lkHistory(m_historyMutex);
+                m_history.clear();
+            }
+
+            m_simEngineState.reset();
+            for (const auto &comp : checkpoint.components) {
+                m_simEngineState.addDigitalComponent(comp);
+            }
+            for (const auto &net : checkpoint.nets) {
+                m_simEngineState.addNet(net);
+            }
+
+            std::lock_guard lkEventQueue(m_queueMutex);
+            m_eventScheduler->clear();
+            std::ranges::fill(m_scheduledAt, notScheduled);
+            m_eventStats = {};
+            m_paceAnchorValid = false;
+            m_pendingEvents = 0;
+            for (const auto &event : checkpoint.events) {
+                m_eventScheduler->push(event);
+                if (!event.freeRunning)
+                    m_pendingEvents++;
+            }
+            m_nextEventId = checkpoint.nextEventId;
+            m_currentSimTime = checkpoint.simTime;
+            m_queueCV.notify_all();
+        }
+        // nets follow from the restored connections
+        rebuildNets();
+        requestSlotSnapshot();
+        BESS_INFO("[SimulationEngine] Restored {} components and {} events at {}ns",
+                  checkpoint.components.size(), checkpoint.events.size(), checkpoint.simTime.count());
+    }
+
+    void SimulationEngine::restoreCheckpoint(const std::filesystem::path &path) {
+        std::ifstream in(path, std::ios::binary);
+        if (!in.is_open())
+            throw std::runtime_error("Failed to open checkpoint " + path.string());
+        restoreCheckpoint(in);
+    }
+
+    void SimulationEngine::enableHistory(uint64_t memoryBudget) {
+        std::lock_guard lkRegistry(m_registryMutex);
+        std::lock_guard lkHistory(m_historyMutex);
+        m_history.setMemoryBudget(memoryBudget);
+        if (m_historyEnabled)
+            return;
+        m_historyEnabled = true;
+
+        // without a compiled netlist the history starts with the next timestep
+        if (isNetlistFresh()) {
+            std::lock_guard lkEventQueue(m_queueMutex);
+            m_history.reset(m_netlist, m_currentSimTime, m_nextEventId);
+        } else {
+            m_history.clear();
+        }
+    }
+
+    void SimulationEngine::disableHistory() {
+        std::lock_guard lkRegistry(m_registryMutex);
+        std::lock_guard lkHistory(m_historyMutex);
+        m_historyEnabled = false;
+        m_history.clear();
+    }
+
+    bool SimulationEngine::isHistoryEnabled() const {
+        std::lock_guard lk(m_historyMutex);
+        return m_historyEnabled;
+    }
+
+    SimHistoryStats SimulationEngine::getHistoryStats() const {
+        std::lock_guard lk(m_historyMutex);
+        return m_history.getStats();
+    }
+
+    bool SimulationEngine::stepBack() {
+        return rewindHistory(std::nullopt);
+    }
+
+    bool SimulationEngine::rewindTo(SimTime time) {
+        return rewindHistory(time);
+    }
+
+    bool SimulationEngine::scrubTo(SimTime time) {
+        if (time < getSimulationTime())
+            return rewindTo(time);
+        return runUntil(time);
+    }
+
+    bool SimulationEngine::rewindHistory(std::optional<SimTime> time) {
+        pauseBetweenTimesteps();
+
+        bool wasTracing = false;
+        {
+            // registry before history before queue, same order as the sim loop
+            std::lock_guard lkRegistry(m_registryMutex);
+            std::lock_guard lkHistory(m_historyMutex);
+            std::lock_guard lkEventQueue(m_queueMutex);
+            if (!m_historyEnabled || m_history.empty() || !isNetlistFresh() || !m_history.matches(m_netlist))
+                return false;
+
+            // a component resized since the netlist was compiled no longer fits the recorded slots
+            for (CompIndex idx = 0; idx < m_netlist.size(); idx++) {
+                if (!m_netlist.isShapeValid(idx)) {
+                    m_simEngineState.markTopologyChanged();
+                    m_history.clear();
+                    return false;
+                }
+            }
+
+            uint64_t position = 0;
+            SimTime simTime;
+            if (time) {
+                if (*time > m_currentSimTime || !m_history.findPosition(*time, position))
+                    return false;
+                simTime = *time;
+            } else {
+                if (m_history.getFirstPosition() == m_history.getLastPosition())
+                    return false;
+                position = m_history.getLastPosition() - 1;
+                simTime = m_history.getTimeAt(position);
+            }
+
+            m_history.rewind(position, m_netlist, m_historyRewind);
+
+            // listeners see the restored values, the trace is stopped below instead
+            for (const auto idx : m_historyRewind.touched) {
+                const auto *comp = m_netlist.componentAt(idx);
+                if (comp->stateChangeListeners == 0)
+                    continue;
+                const auto &inputs = comp->state.inputStates;
+                for (size_t i = 0; i < inputs.size(); i++) {
+                    m_stateChangeLog.push({comp->id, SlotType::digitalInput, static_cast<uint32_t>(i),
+                                           inputs[i].state, inputs[i].lastChangeTime, inputs[i].value});
+                }
+                const auto &outputs = comp->state.outputStates;
+                for (size_t i = 0; i < outputs.size(); i++) {
+                    m_stateChangeLog.push({comp->id, SlotType::digitalOutput, static_cast<uint32_t>(i),
+                                           outputs[i].state, outputs[i].lastChangeTime, outputs[i].value});
+                }
+            }
+
+            // events scheduled after the position go, the ones it had pending come back
+            m_historyEvents.clear();
+            m_eventScheduler->collect(m_historyEvents);
+            std::erase_if(m_historyEvents, [&](const SimulationEvent &ev) {
+                return ev.id >= m_historyRewind.nextEventId;
+            });
+            m_historyEvents.insert(m_historyEvents.end(), m_historyRewind.requeue.begin(),
+                                   m_historyRewind.requeue.end());
+
+            m_eventScheduler->clear();
+            std::ranges::fill(m_scheduledAt, notScheduled);
+            m_pendingEvents = 0;
+            for (const auto &event : m_historyEvents) {
+                m_eventScheduler->push(event);
+                if (!event.freeRunning)
+                    m_pendingEvents++;
+            }
+            m_nextEventId = m_historyRewind.nextEventId;
+            m_currentSimTime = simTime;
+            m_paceAnchorValid = false;
+            m_queueCV.notify_all();
+            wasTracing = m_traceRecorder != nullptr;
+        }
+
+        // the trace's timeline can not go backwards
+        if (wasTracing)
+            stopTrace();
+        requestSlotSnapshot();
+        BESS_DEBUG("[SimulationEngine] Rewound to {}ns", getSimulationTime().count());
+        return true;
+    }
+
+    void SimulationEngine::closeHistoryTimestep() {
+        SimTime simTime;
+        uint64_t nextEventId = 0;
+        {
+            std::lock_guard lk(m_queueMutex);
+            simTime = m_currentSimTime;
+            nextEventId = m_nextEventId;
+        }
+        m_history.closeTimestep(m_netlist, simTime, nextEventId, m_batchEvents);
+    }
+
+    void SimulationEngine::recordSlotWrite(const DigitalComponent &comp, SlotType type, int slot) {
+        std::lock_guard historyLock(m_historyMutex);
+        if (!m_historyEnabled)
+            return;
+
+        std::shared_lock netlistLock(m_netlistMutex);
+        const auto idx = isNetlistFresh() ? m_netlist.indexOf(comp.id) : invalidCompIndex;
+        if (idx == invalidCompIndex) {
+            // the topology changed, the next timestep starts a new history
+            m_history.clear();
+            return;
+        }
+        const auto &slots = type == SlotType::digitalOutput ? comp.state.outputStates : comp.state.inputStates;
+        m_history.recordSlot(idx, type, static_cast<uint32_t>(slot), slots[slot]);
+    }
+
+    const SlotStateSnapshot &SimulationEngine::acquireSlotSnapshot() {
+        return m_slotSnapshots.acquire();
+    }
+
+    const SlotStateSnapshot &SimulationEngine::getSlotSnapshot() const {
+        return m_slotSnapshots.front();
+    }
+
+    void SimulationEngine::requestSlotSnapshot() {
+        // under both locks, so neither of the sim loop's waits misses it
+        std::lock_guard queueLock(m_queueMutex);
+        std::lock_guard stateLock(m_stateMutex);
+        m_snapshotRequested.store(true);
+        m_queueCV.notify_all();
+        m_stateCV.notify_all();
+    }
+
+    bool SimulationEngine::needsSlotSnapshot() const {
+        return m_snapshotStale || m_snapshotRequested.load();
+    }
+
+    void SimulationEngine::publishSlotSnapshot() {
+        std::lock_guard lk(m_registryMutex);
+        publishSlotSnapshotLocked();
+    }
+
+    void SimulationEngine::publishSlotSnapshotLocked() {
+        m_snapshotRequested.store(false);
+        m_snapshotStale = false;
+        m_lastSnapshotPublish = std::chrono::steady_clock::now();
+
+        auto &snapshot = m_slotSnapshots.back();
+        const uint64_t epoch = ++m_snapshotEpoch;
+        if (!m_snapshotLayout || m_snapshotTopologyVersion != m_simEngineState.getTopologyVersion() ||
+            !fillSlotSnapshot(snapshot, epoch)) {
+            rebuildSnapshotLayout();
+            fillSlotSnapshot(snapshot, epoch);
+        }
+        m_slotSnapshots.publish();
+    }
+
+    void SimulationEngine::rebuildSnapshotLayout() {
+        m_snapshotTopologyVersion = m_simEngineState.getTopologyVersion();
+
+        // UUID order like the netlist, so layouts do not depend on hash map iteration order
+        std::vector<UUID> uuids;
+        for (const auto &[uuid, comp] : m_simEngineState.getDigitalComponents()) {
+            if (comp)
+                uuids.push_back(uuid);
+        }
+        std::ranges::sort(uuids, {}, [](const UUID &id) { return static_cast<uint64_t>(id); });
+
+        std::vector<std::pair<uint32_t, uint32_t>> counts;
+        counts.reserve(uuids.size());
+        m_snapshotComponents.clear();
+        for (const auto &uuid : uuids) {
+            auto *comp = m_simEngineState.getDigitalComponent(uuid).get();
+            m_snapshotComponents.push_back(comp);
+            counts.emplace_back(static_cast<uint32_t>(comp->state.inputStates.size()),
+                                static_cast<uint32_t>(comp->state.outputStates.size()));
+        }
+
+        m_snapshotLayout = std::make_shared<const SlotSnapshotLayout>(++m_snapshotLayoutId, std::move(uuids), counts);
+    }
+
+    bool SimulationEngine::fillSlotSnapshot(SlotStateSnapshot &snapshot, uint64_t epoch) {
+        const auto &layout = *m_snapshotLayout;
+        snapshot.reset(m_snapshotLayout, epoch, m_currentSimTime);
+
+        for (uint32_t k = 0; k < m_snapshotComponents.size(); k++) {
+            const auto &state = m_snapshotComponents[k]->state;
+            if (state.inputStates.size() != layout.getInputCount(k) ||
+                state.outputStates.size() != layout.getOutputCount(k))
+                return false;
+
+            const uint32_t inputBegin = layout.getInputBegin(k);
+            for (uint32_t i = 0; i < state.inputStates.size(); i++) {
+                const bool connected = i < state.inputConnected.size() && state.inputConnected[i];
+                snapshot.setSlot(inputBegin + i, state.inputStates[i].state, connected);
+            }
+
+            const uint32_t outputBegin = layout.getOutputBegin(k);
+            for (uint32_t i = 0; i < state.outputStates.size(); i++) {
+                const bool connected = i < state.outputConnected.size() && state.outputConnected[i];
+                snapshot.setSlot(outputBegin + i, state.outputStates[i].state, connected);
+            }
+        }
+        return true;
+    }
+
+    bool SimulationEngine::updateInputCount(const UUID &uuid, int n) {
+
+        throw std::runtime_error("updateInputCount is not implemented yet");
+
+        if (!m_simEngineState.isComponentValid(uuid))
+            return false;
+
+        const auto digiComp = m_simEngineState.getDigitalComponent(uuid);
+        // digiComp->updateInputCount(n);
+        return true;
+    }
+
+    std::vector<std::pair<float, bool>> SimulationEngine::getStateMonitorData(UUID uuid) {
+        if (!m_simEngineState.isComponentValid(uuid)) {
+            BESS_WARN("[SimulationEngine] getStateMonitorData was called on entity with no StateMonitorComponent: {}", (uint64_t)uuid);
+            return {};
+        }
+
+        // FIXME: State monitor is not implemented yet
+        // auto comp = m_simEngineState.getDigitalComponent(uuid);
+        // return comp->timestepedBoolData;
+        return {};
+    }
+
+    const std::unordered_map<UUID, Net> &SimulationEngine::syncNets() {
+        std::lock_guard lk(m_registryMutex);
+        m_changedNets.clear();
+        const auto &nets = m_netTracker.getNets(&m_changedNets);
+        // only the components of nets that changed since the last sync learn their id
+        for (const auto &netId : m_changedNets) {
+            for (const auto &compId : nets.at(netId).getComponents()) {
+                if (const auto comp = m_simEngineState.getDigitalComponent(compId))
+                    comp->netUuid = netId;
+            }
+        }
+        return nets;
+    }
+
+    void SimulationEngine::rebuildNets() {
+        {
+            std::lock_guard lk(m_registryMutex);
+            m_netTracker.clear();
+            // stored net ids are kept where they still name one net
+            std::unordered_set<UUID> usedNets;
+            const auto &components = m_simEngineState.getDigitalComponents();
+            for (const auto &[id, comp] : components) {
+                const bool keep = comp->netUuid != UUID::null && usedNets.insert(comp->netUuid).second;
+                m_netTracker.addComponent(id, keep ? comp->netUuid : UUID::null);
+            }
+            // every wire is in the output pins of one of its ends
+            for (const auto &[id, comp] : components) {
+                for (const auto &pin : comp->outputConnections) {
+                    for (const auto &conn : pin) {
+                        m_netTracker.connect(id, conn.first);
+                    }
+                }
+            }
+        }
+        syncNets();
+    }
+
+    UUID SimulationEngine::getNetOf(const UUID &compId) {
+        std::lock_guard lk(m_registryMutex);
+        return m_netTracker.getNetOf(compId);
+    }
+
+    bool SimulationEngine::isNetUpdated() const {
+        std::lock_guard lk(m_registryMutex);
+        return m_netTracker.getGeneration() != m_reportedNetGeneration;
+    }
+
+    const std::unordered_map<UUID, Net> &SimulationEngine::getNetsMap(bool update) {
+        const auto &nets = syncNets();
+        if (update) {
+            std::lock_guard lk(m_registryMutex);
+            m_reportedNetGeneration = m_netTracker.getGeneration();
+        }
+        return nets;
+    }
+
+    TruthTable SimulationEngine::getTruthTableOfNet(const UUID &netUuid, const TruthTableOptions &options) {
+        const auto &nets = syncNets();
+        if (!nets.contains(netUuid))
+            return {};
+
+        BESS_INFO("\nGenerating truth table for net {}", (uint64_t)netUuid);
+        const auto &net = nets.at(netUuid);
+
+        TruthTable truthTable;
+
+        std::vector<UUID> components;
+
+        std::vector<std::pair<UUID, int>> inputs;
+        std::vector<std::pair<UUID, int>> outputs;
+
+        for (const auto &compUuid : net.getComponents()) {
+            if (compUuid == UUID::null)
+                continue;
+
+            const auto &comp = m_simEngineState.getDigitalComponent(compUuid);
+            bool isInput = comp->definition->getBehaviorType() == ComponentBehaviorType::input;
+            bool isOutput = comp->definition->getBehaviorType() == ComponentBehaviorType::output;
+
+            if (isInput) {
+                for (int i = 0; i < comp->definition->getOutputSlotsInfo().count; i++) {
+                    inputs.emplace_back(compUuid, i);
+                    truthTable.inputUuids.push_back(compUuid);
+                }
+            } else if (isOutput) {
+                for (int i = 0; i < comp->definition->getInputSlotsInfo().count; i++) {
+                    outputs.emplace_back(compUuid, i);
+                    truthTable.outputUuids.push_back(compUuid);
                 }
             } else {
                 components.emplace_back(compUuid);
@@ -886,64 +2241,75 @@ namespace Bess::SimEngine {
             return {};
         }
 
+        if (inputs.size() > TruthTableEvaluator::maxInputs) {
+            BESS_WARN("Cannot generate truth table for net {}, {} inputs exceed the limit of {}",
+                      (uint64_t)netUuid, inputs.size(), TruthTableEvaluator::maxInputs);
+            return {};
+        }
+
         BESS_INFO("Truth table will have {} inputs and {} outputs", inputs.size(), outputs.size());
 
         const size_t numInputs = inputs.size();
-        const size_t numCombinations = 1 << numInputs;
+        truthTable.allocate(numInputs, outputs.size(), options);
+        std::ranges::reverse(truthTable.inputUuids);
+
+        BESS_INFO("Total combinations to evaluate: {}", truthTable.getRowCount());
 
-        std::vector<std::vector<LogicState>> tableData(numCombinations,
-                                                       std::vector<LogicState>(
-                                                           numInputs + outputs.size(),
-                                                           LogicState::low));
+        TruthTableEvaluator evaluator;
+        bool isBitParallel;
+        {
+            std::lock_guard lk(m_registryMutex);
+            isBitParallel = evaluator.build(m_simEngineState, components, inputs, outputs);
+        }
 
-        BESS_INFO("Truth table dimensions: {} rows x {} columns",
-                  tableData.size(),
-                  tableData[0].size());
+        if (isBitParallel) {
+            const auto start = std::chrono::steady_clock::now();
+            evaluator.evaluate(truthTable, options);
+            truthTable.setBitParallel(true);
+            BESS_INFO("Truth table generation completed for net {} in {} ms (bit parallel)\n",
+                      (uint64_t)netUuid,
+                      std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - start).count());
+            return truthTable;
+        }
 
-        BESS_INFO("Total combinations to simulate: {}", numCombinations);
+        // sequential or python simulated parts, every combination runs through the simulation.
+        // states are collected 64 rows at a time, low bit and high bit of LogicState per plane
+        const size_t numOutputs = outputs.size();
+        std::vector<uint64_t> low(numOutputs, 0);
+        std::vector<uint64_t> high(numOutputs, 0);
 
-        for (size_t comb = 0; comb < numCombinations; comb++) {
-            BESS_INFO("Simulating combination {}/{}: ", comb + 1, numCombinations);
-            size_t runningIdx = numInputs - 1, i = 0;
-            for (const auto &[inpUuid, slotIdx] : inputs) {
+        for (uint64_t comb = 0; comb < truthTable.getRowCount(); comb++) {
+            BESS_DEBUG("Simulating combination {}/{}: ", comb + 1, truthTable.getRowCount());
+            for (size_t i = 0; i < numInputs; i++) {
                 std::lock_guard lk(m_registryMutex);
-                const LogicState state = (comb & (1 << i)) ? LogicState::high : LogicState::low;
-                setOutputSlotState(inpUuid, slotIdx, state);
-                tableData[comb][runningIdx] = state;
-                runningIdx--;
-                i++;
+                const LogicState state = ((comb >> i) & 1) ? LogicState::high : LogicState::low;
+                setOutputSlotState(inputs[i].first, inputs[i].second, state);
             }
 
-            BESS_INFO("Waiting for simulation to stabilize...");
+            if (!runUntilStable()) {
+                BESS_WARN("Net {} did not stabilize for combination {}, recording current outputs",
+                          (uint64_t)netUuid, comb);
+            }
 
-            // Wait for simulation to stabilize
+            const uint64_t bit = comb % 64;
             {
-                std::unique_lock<std::mutex> lock(m_queueMutex);
-                m_queueCV.wait(lock, [&] {
-                    return isSimStableLocked();
-                });
+                std::lock_guard lk(m_registryMutex);
+                for (size_t i = 0; i < numOutputs; i++) {
+                    const auto states = getInputSlotsState(outputs[i].first);
+                    const auto value = static_cast<uint8_t>(states[outputs[i].second].state);
+                    low[i] |= uint64_t{value & 1u} << bit;
+                    high[i] |= uint64_t{(value >> 1) & 1u} << bit;
+                }
             }
 
-            BESS_INFO("Simulation stabilized. Recording outputs");
-
-            // FIXME: Temporary sleep to ensure all events are processed
-            std::this_thread::sleep_for(std::chrono::milliseconds(1));
-
-            std::lock_guard lk(m_queueMutex);
-            for (size_t i = 0; i < outputs.size(); i++) {
-                const auto states = getInputSlotsState(outputs[i].first);
-                tableData[comb][numInputs + i] = states[outputs[i].second].state;
-                BESS_DEBUG("Output component {} slot {} state: {}",
-                           (uint64_t)outputs[i].first,
-                           outputs[i].second,
-                           (int)tableData[comb][numInputs + i]);
+            if (bit == 63 || comb + 1 == truthTable.getRowCount()) {
+                truthTable.storeWords(comb / 64, 1, low, high);
+                std::ranges::fill(low, 0);
+                std::ranges::fill(high, 0);
             }
         }
 
         BESS_INFO("Truth table generation completed for net {}\n", (uint64_t)netUuid);
-        std::ranges::reverse(truthTable.inputUuids);
-        truthTable.table = tableData;
-
         return truthTable;
     }
 
@@ -953,14 +2319,44 @@ namespace Bess::SimEngine {
     }
 
     bool SimulationEngine::isSimStableLocked() const {
-        if (m_isSimulating)
-            return false;
+        return !m_isSimulating && m_pendingEvents == 0;
+    }
 
-        if (m_eventSet.empty()) {
-            return true;
+    bool SimulationEngine::waitUntilStable(std::chrono::milliseconds timeout) {
+        std::unique_lock lk(m_queueMutex);
+        return m_queueCV.wait_for(lk, timeout, [&] {
+            return m_stopFlag.load() || isSimStableLocked();
+        }) && !m_stopFlag.load();
+    }
+
+    bool SimulationEngine::runUntilStable(std::chrono::milliseconds timeout) {
+        {
+            std::lock_guard queueLock(m_queueMutex);
+            if (isSimStableLocked())
+                return true;
+            m_settleActive.store(true);
+            m_queueCV.notify_all();
+        }
+        {
+            // wakes the sim loop if it waits for the paused state to change
+            std::lock_guard stateLock(m_stateMutex);
+            m_stateCV.notify_all();
         }
 
-        return true;
+        std::unique_lock lk(m_queueMutex);
+        const bool settled = m_queueCV.wait_for(lk, timeout, [&] {
+            return m_stopFlag.load() || (!m_settleActive.load() && !m_isSimulating);
+        });
+        if (!settled || m_stopFlag.load()) {
+            m_settleActive.store(false);
+            return false;
+        }
+        return isSimStableLocked();
+    }
+
+    uint64_t SimulationEngine::getStableGeneration() const {
+        std::lock_guard lk(m_queueMutex);
+        return m_stableGeneration;
     }
 
     std::shared_ptr<DigitalComponent> SimulationEngine::getDigitalComponent(const UUID &uuid) const {
@@ -975,28 +2371,71 @@ namespace Bess::SimEngine {
         return m_simEngineState;
     }
 
+    EventSchedulerType SimulationEngine::getEventSchedulerType() const {
+        return m_eventScheduler->getType();
+    }
+
+    SimEventStats SimulationEngine::getEventStats() const {
+        std::lock_guard lk(m_queueMutex);
+        return m_eventStats;
+    }
+
     SimTime SimulationEngine::getSimulationTime() const {
         return m_currentSimTime;
     }
 
     void SimulationEngine::scheduleDependantsOf(const UUID &compId) {
+        {
+            std::shared_lock netlistLock(m_netlistMutex);
+            if (isNetlistFresh()) {
+                const auto idx = m_netlist.indexOf(compId);
+                if (idx != invalidCompIndex) {
+                    scheduleDependantsOf(idx);
+                    return;
+                }
+            }
+        }
+
         const auto &dc = m_simEngineState.getDigitalComponent(compId);
         if (!dc) {
             return;
         }
-        for (auto &pin : dc->outputConnections) {
-            const auto &keyView = pin | std::views::keys;
-            const std::set<UUID> uniqueEntities = std::set<UUID>(keyView.begin(), keyView.end());
-            for (auto &ent : uniqueEntities) {
-                const auto dependant = m_simEngineState.getDigitalComponent(ent);
-                if (!dependant || !dependant->definition) {
-                    continue;
-                }
-                const auto simDelay = dependant->definition->getSimDelay();
-                scheduleEvent(ent,
-                              compId,
-                              m_currentSimTime + simDelay);
+        for (const auto &[ent, connectionCount] : dc->fanOut) {
+            const auto dependant = m_simEngineState.getDigitalComponent(ent);
+            if (!dependant || !dependant->definition) {
+                continue;
+            }
+            const auto simDelay = dependant->definition->getSimDelay();
+            scheduleEvent(ent,
+                          compId,
+                          m_currentSimTime + simDelay);
+        }
+    }
+
+    void SimulationEngine::scheduleDependantsOf(CompIndex idx) {
+        const auto dependants = m_netlist.getDependants(idx);
+        if (dependants.empty())
+            return;
+
+        const auto &schedulerId = m_netlist.uuidOf(idx);
+        std::lock_guard lk(m_queueMutex);
+        for (const auto dep : dependants) {
+            const auto &def = m_netlist.componentAt(dep)->definition;
+            if (!def)
+                continue;
+            const auto simTime = m_currentSimTime + def->getSimDelay();
+            if (m_scheduledAt[dep] == simTime) {
+                m_eventStats.coalesced++;
+                continue;
             }
+            m_scheduledAt[dep] = simTime;
+            m_eventScheduler->push({simTime,
+                                    m_netlist.uuidOf(dep),
+                                    schedulerId,
+                                    m_nextEventId++});
+            m_eventStats.scheduled++;
+            m_pendingEvents++;
         }
+        m_queueCV.notify_all();
     }
 } // namespace Bess::SimEngine
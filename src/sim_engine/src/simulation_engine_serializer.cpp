@@ -39,6 +39,7 @@ namespace Bess::SimEngine {
     void SimEngineSerializer::deserialize(const Json::Value &json) {
         auto &simEngine = SimEngine::SimulationEngine::instance();
         JsonConvert::fromJsonValue(json["sim_engine_state"], simEngine.getSimEngineState());
+        simEngine.rebuildNets();
         simAutoReschedulableComponents();
     }
 
@@ -0,0 +1,142 @@
+#include "snapshot/slot_state_snapshot.h"
+
+#include <algorithm>
+#include <utility>
+
+namespace Bess::SimEngine {
+    SlotSnapshotLayout::SlotSnapshotLayout(uint64_t id, std::vector<UUID> uuids,
+                                           const std::vector<std::pair<uint32_t, uint32_t>> &counts)
+        : m_id(id), m_uuids(std::move(uuids)) {
+        const auto n = static_cast<uint32_t>(m_uuids.size());
+        m_indexMap.reserve(n);
+        m_inputBegin.reserve(n + 1);
+        m_outputBegin.reserve(n + 1);
+
+        uint32_t inputSlots = 0;
+        for (uint32_t i = 0; i < n; i++) {
+            m_indexMap.emplace(m_uuids[i], i);
+            m_inputBegin.push_back(inputSlots);
+            inputSlots += counts[i].first;
+        }
+        m_inputBegin.push_back(inputSlots);
+
+        uint32_t outputSlots = inputSlots;
+        for (uint32_t i = 0; i < n; i++) {
+            m_outputBegin.push_back(outputSlots);
+            outputSlots += counts[i].second;
+        }
+        m_outputBegin.push_back(outputSlots);
+    }
+
+    uint64_t SlotSnapshotLayout::getId() const {
+        return m_id;
+    }
+
+    uint32_t SlotSnapshotLayout::getSlotCount() const {
+        return m_outputBegin.empty() ? 0 : m_outputBegin.back();
+    }
+
+    uint32_t SlotSnapshotLayout::getComponentCount() const {
+        return static_cast<uint32_t>(m_uuids.size());
+    }
+
+    const UUID &SlotSnapshotLayout::uuidOf(uint32_t component) const {
+        return m_uuids[component];
+    }
+
+    uint32_t SlotSnapshotLayout::getInputBegin(uint32_t component) const {
+        return m_inputBegin[component];
+    }
+
+    uint32_t SlotSnapshotLayout::getInputCount(uint32_t component) const {
+        return m_inputBegin[component + 1] - m_inputBegin[component];
+    }
+
+    uint32_t SlotSnapshotLayout::getOutputBegin(uint32_t component) const {
+        return m_outputBegin[component];
+    }
+
+    uint32_t SlotSnapshotLayout::getOutputCount(uint32_t component) const {
+        return m_outputBegin[component + 1] - m_outputBegin[component];
+    }
+
+    uint32_t SlotSnapshotLayout::slotIndexOf(const UUID &uuid, SlotType type, int idx) const {
+        const auto it = m_indexMap.find(uuid);
+        if (it == m_indexMap.end() || idx < 0)
+            return invalidSnapshotSlot;
+
+        const auto slot = static_cast<uint32_t>(idx);
+        if (type == SlotType::digitalInput) {
+            return slot < getInputCount(it->second) ? getInputBegin(it->second) + slot : invalidSnapshotSlot;
+        }
+        return slot < getOutputCount(it->second) ? getOutputBegin(it->second) + slot : invalidSnapshotSlot;
+    }
+
+    uint64_t SlotStateSnapshot::getEpoch() const {
+        return m_epoch;
+    }
+
+    SimTime SlotStateSnapshot::getSimTime() const {
+        return m_simTime;
+    }
+
+    const std::shared_ptr<const SlotSnapshotLayout> &SlotStateSnapshot::getLayout() const {
+        return m_layout;
+    }
+
+    uint64_t SlotStateSnapshot::getLayoutId() const {
+        return m_layout ? m_layout->getId() : 0;
+    }
+
+    LogicState SlotStateSnapshot::getState(uint32_t slot) const {
+        if (slot / 32 >= m_states.size())
+            return LogicState::unknown;
+        return static_cast<LogicState>((m_states[slot / 32] >> ((slot % 32) * 2)) & 0x3);
+    }
+
+    bool SlotStateSnapshot::isConnected(uint32_t slot) const {
+        if (slot / 64 >= m_connected.size())
+            return false;
+        return (m_connected[slot / 64] >> (slot % 64)) & 1;
+    }
+
+    void SlotStateSnapshot::reset(const std::shared_ptr<const SlotSnapshotLayout> &layout, uint64_t epoch,
+                                  SimTime simTime) {
+        m_epoch = epoch;
+        m_simTime = simTime;
+        if (m_layout != layout)
+            m_layout = layout;
+
+        // assign keeps the capacity, the same layout never reallocates
+        const uint32_t slots = layout ? layout->getSlotCount() : 0;
+        m_states.assign((slots + 31) / 32, 0);
+        m_connected.assign((slots + 63) / 64, 0);
+    }
+
+    void SlotStateSnapshot::setSlot(uint32_t slot, LogicState state, bool connected) {
+        m_states[slot / 32] |= static_cast<uint64_t>(state) << ((slot % 32) * 2);
+        if (connected)
+            m_connected[slot / 64] |= uint64_t{1} << (slot % 64);
+    }
+
+    SlotStateSnapshot &SlotSnapshotBuffer::back() {
+        return m_buffers[m_back];
+    }
+
+    void SlotSnapshotBuffer::publish() {
+        const uint8_t previous = m_middle.exchange(m_back | freshFlag, std::memory_order_acq_rel);
+        m_back = previous & ~freshFlag;
+    }
+
+    const SlotStateSnapshot &SlotSnapshotBuffer::acquire() {
+        if (m_middle.load(std::memory_order_relaxed) & freshFlag) {
+            const uint8_t previous = m_middle.exchange(m_front, std::memory_order_acq_rel);
+            m_front = previous & ~freshFlag;
+        }
+        return m_buffers[m_front];
+    }
+
+    const SlotStateSnapshot &SlotSnapshotBuffer::front() const {
+        return m_buffers[m_front];
+    }
+} // namespace Bess::SimEngine
@@ -0,0 +1,62 @@
+#include "state_change/state_change_log.h"
+
+#include <algorithm>
+#include <bit>
+
+namespace Bess::SimEngine {
+    StateChangeLog::StateChangeLog(size_t capacity) {
+        const size_t size = std::bit_ceil(std::max<size_t>(capacity, 2));
+        m_cells = std::make_unique<Cell[]>(size);
+        m_mask = size - 1;
+        for (size_t i = 0; i < size; i++) {
+            m_cells[i].sequence.store(i, std::memory_order_relaxed);
+        }
+    }
+
+    bool StateChangeLog::push(const SlotChange &change) {
+        uint64_t pos = m_enqueuePos.load(std::memory_order_relaxed);
+        Cell *cell = nullptr;
+        while (true) {
+            cell = &m_cells[pos & m_mask];
+            const uint64_t sequence = cell->sequence.load(std::memory_order_acquire);
+            const auto diff = static_cast<int64_t>(sequence - pos);
+            if (diff == 0) {
+                if (m_enqueuePos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+                    break;
+            } else if (diff < 0) {
+                // the consumer has not freed this cell yet
+                m_dropped.fetch_add(1, std::memory_order_relaxed);
+                return false;
+            } else {
+                pos = m_enqueuePos.load(std::memory_order_relaxed);
+            }
+        }
+
+        cell->change = change;
+        cell->sequence.store(pos + 1, std::memory_order_release);
+        return true;
+    }
+
+    size_t StateChangeLog::drain(std::vector<SlotChange> &out) {
+        size_t count = 0;
+        while (true) {
+            auto &cell = m_cells[m_dequeuePos & m_mask];
+            if (cell.sequence.load(std::memory_order_acquire) != m_dequeuePos + 1)
+                break;
+            out.push_back(cell.change);
+            // free for the producer one lap later
+            cell.sequence.store(m_dequeuePos + m_mask + 1, std::memory_order_release);
+            m_dequeuePos++;
+            count++;
+        }
+        return count;
+    }
+
+    size_t StateChangeLog::getCapacity() const {
+        return static_cast<size_t>(m_mask + 1);
+    }
+
+    uint64_t StateChangeLog::getDroppedCount() const {
+        return m_dropped.load(std::memory_order_relaxed);
+    }
+} // namespace Bess::SimEngine
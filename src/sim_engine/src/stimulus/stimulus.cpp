@@ -0,0 +1,194 @@
+#include "stimulus/stimulus.h"
+#include "simulation_engine.h"
+
+#include <algorithm>
+#include <cctype>
+#include <charconv>
+#include <format>
+#include <stdexcept>
+#include <string_view>
+
+namespace Bess::SimEngine {
+    namespace {
+        std::string_view trim(std::string_view value) {
+            while (!value.empty() && std::isspace(static_cast<unsigned char>(value.front())))
+                value.remove_prefix(1);
+            while (!value.empty() && std::isspace(static_cast<unsigned char>(value.back())))
+                value.remove_suffix(1);
+            return value;
+        }
+
+        std::vector<std::string_view> splitCells(std::string_view line) {
+            std::vector<std::string_view> cells;
+            size_t start = 0;
+            while (true) {
+                const auto comma = line.find(',', start);
+                cells.push_back(trim(line.substr(start, comma - start)));
+                if (comma == std::string_view::npos)
+                    return cells;
+                start = comma + 1;
+            }
+        }
+
+        bool parseValue(std::string_view text, std::vector<LogicState> &bits) {
+            bits.clear();
+            if (text.size() > 2 && text[0] == '0' && (text[1] == 'x' || text[1] == 'X')) {
+                for (size_t i = text.size(); i-- > 2;) {
+                    const char c = static_cast<char>(std::tolower(static_cast<unsigned char>(text[i])));
+                    int digit = 0;
+                    if (c >= '0' && c <= '9') {
+                        digit = c - '0';
+                    } else if (c >= 'a' && c <= 'f') {
+                        digit = c - 'a' + 10;
+                    } else {
+                        return false;
+                    }
+                    for (int b = 0; b < 4; b++) {
+                        bits.push_back((digit >> b) & 1 ? LogicState::high : LogicState::low);
+                    }
+                }
+                return true;
+            }
+
+            for (size_t i = text.size(); i-- > 0;) {
+                switch (text[i]) {
+                case '0':
+                    bits.push_back(LogicState::low);
+                    break;
+                case '1':
+                    bits.push_back(LogicState::high);
+                    break;
+                case 'x':
+                case 'X':
+                    bits.push_back(LogicState::unknown);
+                    break;
+                case 'z':
+                case 'Z':
+                    bits.push_back(LogicState::high_z);
+                    break;
+                case '_':
+                    break;
+                default:
+                    return false;
+                }
+            }
+            return !bits.empty();
+        }
+    } // namespace
+
+    bool parseSimTime(std::string_view text, SimTime &time) {
+        int64_t value = 0;
+        const auto [end, ec] = std::from_chars(text.data(), text.data() + text.size(), value);
+        if (ec != std::errc() || value < 0)
+            return false;
+
+        const auto unit = trim(std::string_view(end, text.data() + text.size() - end));
+        if (unit == "ps") {
+            time = SimTime(value / 1000);
+        } else if (unit.empty() || unit == "ns") {
+            time = SimTime(value);
+        } else if (unit == "us") {
+            time = std::chrono::microseconds(value);
+        } else if (unit == "ms") {
+            time = std::chrono::milliseconds(value);
+        } else if (unit == "s") {
+            time = std::chrono::seconds(value);
+        } else {
+            return false;
+        }
+        return true;
+    }
+
+    Stimulus Stimulus::parseCsv(std::istream &in) {
+        Stimulus stimulus;
+        bool hasHeader = false;
+        std::string line;
+        size_t lineNumber = 0;
+        while (std::getline(in, line)) {
+            lineNumber++;
+            const auto text = trim(line);
+            if (text.empty() || text.front() == '#')
+                continue;
+
+            const auto cells = splitCells(text);
+            if (!hasHeader) {
+                if (cells.size() < 2)
+                    throw std::runtime_error(std::format("Stimulus line {}: expected a time column and at least one signal",
+                                                         lineNumber));
+                for (size_t i = 1; i < cells.size(); i++) {
+                    stimulus.m_signals.emplace_back(cells[i]);
+                }
+                hasHeader = true;
+                continue;
+            }
+
+            if (cells.size() > stimulus.m_signals.size() + 1)
+                throw std::runtime_error(std::format("Stimulus line {}: more values than signals", lineNumber));
+
+            StimulusStep step;
+            if (!parseSimTime(cells[0], step.time))
+                throw std::runtime_error(std::format("Stimulus line {}: invalid time '{}'", lineNumber, cells[0]));
+            if (!stimulus.m_steps.empty() && step.time < stimulus.m_steps.back().time)
+                throw std::runtime_error(std::format("Stimulus line {}: time goes backwards", lineNumber));
+
+            for (size_t i = 1; i < cells.size(); i++) {
+                if (cells[i].empty())
+                    continue;
+                StimulusValue value;
+                value.signal = static_cast<uint32_t>(i - 1);
+                if (!parseValue(cells[i], value.bits))
+                    throw std::runtime_error(std::format("Stimulus line {}: invalid value '{}' for {}",
+                                                         lineNumber, cells[i], stimulus.m_signals[i - 1]));
+                step.values.push_back(std::move(value));
+            }
+            stimulus.m_steps.push_back(std::move(step));
+        }
+        return stimulus;
+    }
+
+    const std::vector<std::string> &Stimulus::getSignals() const {
+        return m_signals;
+    }
+
+    const std::vector<StimulusStep> &Stimulus::getSteps() const {
+        return m_steps;
+    }
+
+    SimTime Stimulus::getEndTime() const {
+        return m_steps.empty() ? SimTime(0) : m_steps.back().time;
+    }
+
+    bool Stimulus::apply(SimulationEngine &engine, const std::unordered_map<std::string, UUID> &inputs,
+                         SimTime until) const {
+        std::vector<UUID> targets;
+        targets.reserve(m_signals.size());
+        for (const auto &signal : m_signals) {
+            const auto it = inputs.find(signal);
+            if (it == inputs.end())
+                throw std::runtime_error(std::format("Stimulus signal '{}' is not an input of the design", signal));
+            targets.push_back(it->second);
+        }
+
+        for (const auto &step : m_steps) {
+            if (step.time > until)
+                break;
+            if (step.time > engine.getSimulationTime() && !engine.runUntil(step.time))
+                return false;
+
+            for (const auto &value : step.values) {
+                const auto &id = targets[value.signal];
+                const auto comp = engine.getDigitalComponent(id);
+                const size_t width = comp ? comp->state.outputStates.size() : 0;
+                // narrower values are extended like in Verilog, with 0 unless the top bit is x or z
+                const auto top = value.bits.back();
+                const auto fill = top == LogicState::high ? LogicState::low : top;
+                for (size_t bit = 0; bit < width; bit++) {
+                    engine.setOutputSlotState(id, static_cast<int>(bit),
+                                              bit < value.bits.size() ? value.bits[bit] : fill);
+                }
+            }
+        }
+
+        return until <= engine.getSimulationTime() || engine.runUntil(until);
+    }
+} // namespace Bess::SimEngine
@@ -0,0 +1,108 @@
+#include "trace/trace_recorder.h"
+
+#include <algorithm>
+
+namespace Bess::SimEngine {
+    TraceRecorder::TraceRecorder(std::unique_ptr<TraceWriter> writer, std::vector<TraceSignal> signals,
+                                 size_t capacity)
+        : m_writer(std::move(writer)), m_signals(std::move(signals)), m_log(capacity),
+          m_highWater(std::max<int64_t>(1, static_cast<int64_t>(m_log.getCapacity() / 4))) {
+        m_signalIds.reserve(m_signals.size());
+        for (uint32_t i = 0; i < m_signals.size(); i++) {
+            const auto &signal = m_signals[i];
+            m_signalIds.emplace(SlotKey(signal.component, signal.type, signal.slot), i);
+        }
+    }
+
+    TraceRecorder::~TraceRecorder() {
+        if (m_running)
+            stop(SimTime(0));
+    }
+
+    void TraceRecorder::start(SimTime time, const std::vector<SlotState> &initial) {
+        if (m_running)
+            return;
+        m_writer->begin(m_signals, time, initial);
+        m_stopRequested.store(false);
+        m_running = true;
+        m_thread = std::thread(&TraceRecorder::writerLoop, this);
+    }
+
+    void TraceRecorder::record(const SlotChange &change) {
+        if (m_log.push(change)) {
+            // one producer sees the count reach the mark, a missed wake is covered by flushInterval
+            if (m_unwritten.fetch_add(1, std::memory_order_relaxed) + 1 == m_highWater)
+                m_wake.notify_one();
+            return;
+        }
+
+        // the caller may hold the engine's locks, sleep instead of spinning until there is room
+        m_stalls.fetch_add(1, std::memory_order_relaxed);
+        std::unique_lock lk(m_wakeMutex);
+        m_wake.notify_one();
+        m_spaceAvailable.wait(lk, [&] { return m_log.push(change); });
+        m_unwritten.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    void TraceRecorder::stop(SimTime time) {
+        if (!m_running)
+            return;
+        {
+            std::lock_guard lk(m_wakeMutex);
+            m_stopRequested.store(true);
+        }
+        m_wake.notify_one();
+        if (m_thread.joinable())
+            m_thread.join();
+        writeDrained();
+        m_writer->end(time);
+        m_running = false;
+    }
+
+    void TraceRecorder::writerLoop() {
+        while (!m_stopRequested.load(std::memory_order_acquire)) {
+            writeDrained();
+            std::unique_lock lk(m_wakeMutex);
+            m_wake.wait_for(lk, flushInterval, [this] {
+                return m_stopRequested.load(std::memory_order_relaxed) ||
+                       m_unwritten.load(std::memory_order_relaxed) >= m_highWater;
+            });
+        }
+    }
+
+    void TraceRecorder::writeDrained() {
+        m_drained.clear();
+        m_log.drain(m_drained);
+        if (!m_drained.empty()) {
+            m_unwritten.fetch_sub(static_cast<int64_t>(m_drained.size()), std::memory_order_relaxed);
+            // under the lock, so a producer between its failed push and its wait is not missed
+            std::lock_guard lk(m_wakeMutex);
+            m_spaceAvailable.notify_all();
+        }
+        uint64_t written = 0;
+        for (const auto &change : m_drained) {
+            const auto it = m_signalIds.find(SlotKey(change));
+            if (it == m_signalIds.end())
+                continue;
+            m_writer->change(change.time, it->second, change.state, change.value);
+            written++;
+        }
+        m_written.fetch_add(written, std::memory_order_relaxed);
+    }
+
+    bool TraceRecorder::isRunning() const {
+        return m_running;
+    }
+
+    const std::vector<TraceSignal> &TraceRecorder::getSignals() const {
+        return m_signals;
+    }
+
+    uint64_t TraceRecorder::getWrittenCount() const {
+        return m_written.load(std::memory_order_relaxed);
+    }
+
+    uint64_t TraceRecorder::getStallCount() const {
+        return m_stalls.load(std::memory_order_relaxed);
+    }
+} // namespace Bess::SimEngine
@@ -0,0 +1,213 @@
+#include "trace/trace_writer.h"
+
+#include <algorithm>
+#include <bit>
+#include <cctype>
+#include <fstream>
+#include <numeric>
+#include <ranges>
+#include <string_view>
+
+namespace Bess::SimEngine {
+    namespace {
+        char vcdValue(LogicState state) {
+            switch (state) {
+            case LogicState::low:
+                return '0';
+            case LogicState::high:
+                return '1';
+            case LogicState::high_z:
+                return 'z';
+            default:
+                return 'x';
+            }
+        }
+
+        // VCD references and scopes end at whitespace
+        std::string vcdName(std::string_view name) {
+            std::string result(name.empty() ? std::string_view("_") : name);
+            std::ranges::replace_if(result, [](unsigned char c) { return std::isspace(c); }, '_');
+            return result;
+        }
+
+        std::vector<std::string> splitScope(std::string_view scope) {
+            std::vector<std::string> parts;
+            for (const auto part : std::views::split(scope, '/')) {
+                if (!part.empty())
+                    parts.push_back(vcdName(std::string_view(part.begin(), part.end())));
+            }
+            if (parts.empty())
+                parts.emplace_back("bess");
+            return parts;
+        }
+    } // namespace
+
+    VcdTraceWriter::VcdTraceWriter(std::unique_ptr<std::ostream> out) : m_out(std::move(out)) {}
+
+    std::string VcdTraceWriter::identifierOf(uint32_t signal) {
+        // base 94 over the printable characters '!' to '~'
+        std::string id;
+        do {
+            id.push_back(static_cast<char>('!' + signal % 94));
+            signal /= 94;
+        } while (signal > 0);
+        return id;
+    }
+
+    void VcdTraceWriter::begin(const std::vector<TraceSignal> &signals, SimTime time,
+                               const std::vector<SlotState> &initial) {
+        auto &out = *m_out;
+        out << "$version BESS $end\n";
+        out << "$timescale 1ns $end\n";
+
+        m_ids.clear();
+        m_ids.reserve(signals.size());
+        m_widths.clear();
+        m_widths.reserve(signals.size());
+        for (uint32_t i = 0; i < signals.size(); i++) {
+            m_ids.push_back(identifierOf(i));
+            m_widths.push_back(std::max(signals[i].width, 1));
+        }
+
+        // scopes are opened and closed once, so signals are declared grouped by scope
+        std::vector<uint32_t> order(signals.size());
+        std::iota(order.begin(), order.end(), 0);
+        std::vector<std::vector<std::string>> scopes;
+        scopes.reserve(signals.size());
+        for (const auto &signal : signals) {
+            scopes.push_back(splitScope(signal.scope));
+        }
+        std::ranges::stable_sort(order, {}, [&](uint32_t i) -> const auto & { return scopes[i]; });
+
+        std::vector<std::string> open;
+        for (const auto i : order) {
+            const auto &scope = scopes[i];
+            size_t common = 0;
+            while (common < open.size() && common < scope.size() && open[common] == scope[common])
+                common++;
+            for (; open.size() > common; open.pop_back()) {
+                out << "$upscope $end\n";
+            }
+            for (; open.size() < scope.size(); open.push_back(scope[open.size()])) {
+                out << "$scope module " << scope[open.size()] << " $end\n";
+            }
+            out << "$var wire " << m_widths[i] << ' ' << m_ids[i] << ' ' << vcdName(signals[i].name) << " $end\n";
+        }
+        for (; !open.empty(); open.pop_back()) {
+            out << "$upscope $end\n";
+        }
+        out << "$enddefinitions $end\n";
+
+        m_time = time;
+        out << '#' << time.count() << "\n$dumpvars\n";
+        for (uint32_t i = 0; i < signals.size(); i++) {
+            if (i < initial.size())
+                writeValue(i, initial[i].state, initial[i].value);
+            else
+                writeValue(i, LogicState::unknown, 0);
+        }
+        out << "$end\n";
+    }
+
+    void VcdTraceWriter::writeTime(SimTime time) {
+        if (time > m_time) {
+            m_time = time;
+            *m_out << '#' << time.count() << '\n';
+        }
+    }
+
+    void VcdTraceWriter::writeValue(uint32_t signal, LogicState state, uint64_t value) {
+        auto &out = *m_out;
+        if (m_widths[signal] == 1) {
+            out << vcdValue(state) << m_ids[signal] << '\n';
+            return;
+        }
+
+        out << 'b';
+        if (state == LogicState::low || state == LogicState::high) {
+            // leading zeros are implied by the declared width
+            int bit = std::bit_width(value);
+            if (bit == 0)
+                out << '0';
+            while (bit-- > 0)
+                out << ((value >> bit) & 1 ? '1' : '0');
+        } else {
+            out << vcdValue(state);
+        }
+        out << ' ' << m_ids[signal] << '\n';
+    }
+
+    void VcdTraceWriter::change(SimTime time, uint32_t signal, LogicState state, uint64_t value) {
+        writeTime(time);
+        writeValue(signal, state, value);
+    }
+
+    void VcdTraceWriter::end(SimTime time) {
+        writeTime(time);
+        m_out->flush();
+    }
+
+    BinaryTraceWriter::BinaryTraceWriter(std::unique_ptr<std::ostream> out) : m_out(std::move(out)) {}
+
+    void BinaryTraceWriter::writeVarint(uint64_t value) {
+        while (value >= 0x80) {
+            m_out->put(static_cast<char>(static_cast<uint8_t>(value) | 0x80));
+            value >>= 7;
+        }
+        m_out->put(static_cast<char>(value));
+    }
+
+    void BinaryTraceWriter::begin(const std::vector<TraceSignal> &signals, SimTime time,
+                                  const std::vector<SlotState> &initial) {
+        m_out->write(reinterpret_cast<const char *>(&magic), sizeof(magic));
+        writeVarint(signals.size());
+        m_widths.clear();
+        m_widths.reserve(signals.size());
+        for (const auto &signal : signals) {
+            writeVarint(signal.scope.size());
+            m_out->write(signal.scope.data(), static_cast<std::streamsize>(signal.scope.size()));
+            writeVarint(signal.name.size());
+            m_out->write(signal.name.data(), static_cast<std::streamsize>(signal.name.size()));
+            m_widths.push_back(std::max(signal.width, 1));
+            writeVarint(static_cast<uint64_t>(m_widths.back()));
+        }
+
+        m_time = time;
+        writeVarint(static_cast<uint64_t>(time.count()));
+        for (uint32_t i = 0; i < signals.size(); i++) {
+            m_out->put(static_cast<char>(i < initial.size() ? initial[i].state : LogicState::unknown));
+            if (m_widths[i] > 1)
+                writeVarint(i < initial.size() ? initial[i].value : 0);
+        }
+    }
+
+    void BinaryTraceWriter::writeTime(SimTime time) {
+        if (time > m_time) {
+            writeVarint(0);
+            writeVarint(static_cast<uint64_t>((time - m_time).count()));
+            m_time = time;
+        }
+    }
+
+    void BinaryTraceWriter::change(SimTime time, uint32_t signal, LogicState state, uint64_t value) {
+        writeTime(time);
+        writeVarint(((uint64_t{signal} + 1) << 2) | static_cast<uint8_t>(state));
+        if (m_widths[signal] > 1)
+            writeVarint(value);
+    }
+
+    void BinaryTraceWriter::end(SimTime time) {
+        writeTime(time);
+        m_out->flush();
+    }
+
+    std::unique_ptr<TraceWriter> makeTraceWriter(TraceFormat format, const std::filesystem::path &path) {
+        auto out = std::make_unique<std::ofstream>(path, std::ios::binary | std::ios::trunc);
+        if (!out->is_open())
+            return nullptr;
+
+        if (format == TraceFormat::binary)
+            return std::make_unique<BinaryTraceWriter>(std::move(out));
+        return std::make_unique<VcdTraceWriter>(std::move(out));
+    }
+} // namespace Bess::SimEngine
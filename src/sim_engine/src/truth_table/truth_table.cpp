@@ -0,0 +1,152 @@
+#include "truth_table/truth_table.h"
+#include "common/logger.h"
+
+#include <algorithm>
+#include <format>
+#include <fstream>
+#include <stdexcept>
+
+namespace Bess::SimEngine {
+    namespace {
+        constexpr uint64_t headerSize = 4 * sizeof(uint64_t);
+
+        LogicState fromPlanes(bool low, bool high) {
+            return static_cast<LogicState>(static_cast<uint8_t>(low) | (static_cast<uint8_t>(high) << 1));
+        }
+    } // namespace
+
+    void TruthTable::allocate(size_t inputCount, size_t outputCount, const TruthTableOptions &options) {
+        m_inputCount = inputCount;
+        m_outputCount = outputCount;
+        m_rowCount = uint64_t{1} << inputCount;
+        m_wordCount = (m_rowCount + 63) / 64;
+        m_low.clear();
+        m_high.clear();
+        m_spillPath.clear();
+
+        const uint64_t bytes = m_wordCount * sizeof(uint64_t) * outputCount;
+        if (bytes <= options.memoryLimitBytes) {
+            m_low.assign(outputCount, std::vector<uint64_t>(m_wordCount, 0));
+            m_high.resize(outputCount);
+            return;
+        }
+
+        const auto directory = options.spillDirectory.empty() ? std::filesystem::temp_directory_path()
+                                                              : options.spillDirectory;
+        m_spillPath = directory / std::format("bess_truth_table_{}.btt", (uint64_t)UUID());
+        {
+            std::ofstream file(m_spillPath, std::ios::binary | std::ios::trunc);
+            const uint64_t header[4] = {spillMagic, inputCount, outputCount, m_rowCount};
+            file.write(reinterpret_cast<const char *>(header), sizeof(header));
+            if (!file) {
+                throw std::runtime_error(std::format("Failed to create truth table file {}", m_spillPath.string()));
+            }
+        }
+        // both planes of every column, zero filled
+        std::filesystem::resize_file(m_spillPath, planeOffset(outputCount, 0));
+        BESS_INFO("[TruthTable] {} rows x {} outputs exceed the memory limit, writing to {}",
+                  m_rowCount, outputCount, m_spillPath.string());
+    }
+
+    void TruthTable::storeWords(uint64_t firstWord, size_t wordCount,
+                                std::span<const uint64_t> low, std::span<const uint64_t> high) {
+        if (firstWord + wordCount > m_wordCount) {
+            throw std::out_of_range("Truth table words out of range");
+        }
+
+        if (!isSpilled()) {
+            for (size_t c = 0; c < m_outputCount; c++) {
+                const auto lowColumn = low.subspan(c * wordCount, wordCount);
+                std::ranges::copy(lowColumn, m_low[c].begin() + firstWord);
+
+                if (high.empty())
+                    continue;
+                const auto highColumn = high.subspan(c * wordCount, wordCount);
+                if (m_high[c].empty()) {
+                    if (std::ranges::all_of(highColumn, [](uint64_t w) { return w == 0; }))
+                        continue;
+                    m_high[c].assign(m_wordCount, 0);
+                }
+                std::ranges::copy(highColumn, m_high[c].begin() + firstWord);
+            }
+            return;
+        }
+
+        std::fstream file(m_spillPath, std::ios::binary | std::ios::in | std::ios::out);
+        for (size_t c = 0; c < m_outputCount; c++) {
+            file.seekp(static_cast<std::streamoff>(planeOffset(c, 0) + firstWord * sizeof(uint64_t)));
+            file.write(reinterpret_cast<const char *>(low.data() + c * wordCount),
+                       static_cast<std::streamsize>(wordCount * sizeof(uint64_t)));
+            if (!high.empty()) {
+                file.seekp(static_cast<std::streamoff>(planeOffset(c, 1) + firstWord * sizeof(uint64_t)));
+                file.write(reinterpret_cast<const char *>(high.data() + c * wordCount),
+                           static_cast<std::streamsize>(wordCount * sizeof(uint64_t)));
+            }
+        }
+        if (!file) {
+            throw std::runtime_error(std::format("Failed to write truth table file {}", m_spillPath.string()));
+        }
+    }
+
+    bool TruthTable::empty() const {
+        return m_rowCount == 0 || m_outputCount == 0;
+    }
+
+    uint64_t TruthTable::getRowCount() const {
+        return m_rowCount;
+    }
+
+    uint64_t TruthTable::getWordCount() const {
+        return m_wordCount;
+    }
+
+    size_t TruthTable::getInputCount() const {
+        return m_inputCount;
+    }
+
+    size_t TruthTable::getOutputCount() const {
+        return m_outputCount;
+    }
+
+    LogicState TruthTable::getInput(uint64_t row, size_t column) const {
+        return ((row >> (m_inputCount - 1 - column)) & 1) ? LogicState::high : LogicState::low;
+    }
+
+    LogicState TruthTable::getOutput(uint64_t row, size_t column) const {
+        const uint64_t word = row / 64;
+        const uint64_t bit = row % 64;
+
+        if (!isSpilled()) {
+            const bool high = !m_high[column].empty() && ((m_high[column][word] >> bit) & 1);
+            return fromPlanes((m_low[column][word] >> bit) & 1, high);
+        }
+
+        std::ifstream file(m_spillPath, std::ios::binary);
+        uint64_t planes[2] = {0, 0};
+        for (int plane = 0; plane < 2; plane++) {
+            file.seekg(static_cast<std::streamoff>(planeOffset(column, plane) + word * sizeof(uint64_t)));
+            file.read(reinterpret_cast<char *>(&planes[plane]), sizeof(uint64_t));
+        }
+        return fromPlanes((planes[0] >> bit) & 1, (planes[1] >> bit) & 1);
+    }
+
+    bool TruthTable::isSpilled() const {
+        return !m_spillPath.empty();
+    }
+
+    const std::filesystem::path &TruthTable::getSpillPath() const {
+        return m_spillPath;
+    }
+
+    bool TruthTable::isBitParallel() const {
+        return m_bitParallel;
+    }
+
+    void TruthTable::setBitParallel(bool value) {
+        m_bitParallel = value;
+    }
+
+    uint64_t TruthTable::planeOffset(size_t column, int plane) const {
+        return headerSize + ((column * 2 + plane) * m_wordCount * sizeof(uint64_t));
+    }
+} // namespace Bess::SimEngine
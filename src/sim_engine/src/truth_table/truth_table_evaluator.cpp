@@ -0,0 +1,274 @@
+#include "truth_table/truth_table_evaluator.h"
+#include "common/logger.h"
+#include "component_definition.h"
+#include "expression_evalutator/expr_evaluator.h"
+#include "parallel/work_stealing_pool.h"
+
+#include <algorithm>
+#include <memory>
+#include <thread>
+#include <unordered_map>
+
+namespace Bess::SimEngine {
+    namespace {
+        // words evaluated between two stores into the table, bounds the chunk buffer
+        constexpr size_t chunkWordCount = 4096;
+        constexpr size_t wordGrainSize = 16;
+
+        bool isBinaryGateOp(char op) {
+            return op == '*' || op == '+' || op == '^';
+        }
+    } // namespace
+
+    bool TruthTableEvaluator::hasBitwiseForm(const ComponentDefinition &definition) {
+        // python definitions run their own simulation function, their expressions may not be all of it
+        if (definition.getShouldAutoReschedule() || definition.getOwnership() == CompDefinitionOwnership::Python)
+            return false;
+
+        const char op = definition.getOpInfo().op;
+        if (isBinaryGateOp(op) || ExprEval::isUninaryOperator(op))
+            return true;
+
+        const auto &expressions = definition.getOutputExpressions();
+        return !expressions.empty() && ExprEval::compileExpressions(expressions).error.empty();
+    }
+
+    bool TruthTableEvaluator::build(const SimEngineState &state, const std::vector<UUID> &components,
+                                    const std::vector<ComponentPin> &inputs,
+                                    const std::vector<ComponentPin> &outputs) {
+        *this = {};
+        if (inputs.size() > maxInputs)
+            return false;
+
+        m_inputCount = static_cast<uint32_t>(inputs.size());
+        m_outputCount = static_cast<uint32_t>(outputs.size());
+        m_signalCount = 1 + m_inputCount;
+
+        // signal of every output slot in the cone
+        std::unordered_map<UUID, std::vector<uint32_t>> pinSignals;
+        for (uint32_t i = 0; i < m_inputCount; i++) {
+            auto &signals = pinSignals[inputs[i].first];
+            const auto slot = static_cast<size_t>(inputs[i].second);
+            if (signals.size() <= slot)
+                signals.resize(slot + 1, zeroSignal);
+            signals[slot] = 1 + i;
+        }
+
+        std::vector<std::shared_ptr<DigitalComponent>> comps;
+        std::unordered_map<UUID, uint32_t> compIndex;
+        comps.reserve(components.size());
+        for (const auto &uuid : components) {
+            auto comp = state.getDigitalComponent(uuid);
+            if (!comp || !comp->definition || !hasBitwiseForm(*comp->definition)) {
+                return false;
+            }
+            compIndex[uuid] = static_cast<uint32_t>(comps.size());
+            auto &signals = pinSignals[uuid];
+            signals.resize(comp->outputConnections.size());
+            for (auto &signal : signals) {
+                signal = m_signalCount++;
+            }
+            comps.push_back(std::move(comp));
+        }
+
+        // levelize, a component runs after every component driving it
+        std::vector<std::vector<uint32_t>> dependants(comps.size());
+        std::vector<uint32_t> pendingDrivers(comps.size(), 0);
+        for (uint32_t k = 0; k < comps.size(); k++) {
+            for (const auto &slot : comps[k]->inputConnections) {
+                for (const auto &[src, srcSlot] : slot) {
+                    const auto it = compIndex.find(src);
+                    if (it == compIndex.end())
+                        continue;
+                    dependants[it->second].push_back(k);
+                    pendingDrivers[k]++;
+                }
+            }
+        }
+
+        std::vector<uint32_t> order;
+        order.reserve(comps.size());
+        for (uint32_t k = 0; k < comps.size(); k++) {
+            if (pendingDrivers[k] == 0)
+                order.push_back(k);
+        }
+        for (size_t i = 0; i < order.size(); i++) {
+            for (const auto dep : dependants[order[i]]) {
+                if (--pendingDrivers[dep] == 0)
+                    order.push_back(dep);
+            }
+        }
+
+        if (order.size() != comps.size()) {
+            BESS_DEBUG("[TruthTableEvaluator] Cone has a combinational loop");
+            return false;
+        }
+
+        const auto addSlot = [&](const std::vector<ComponentPin> &drivers) {
+            m_slotDriverBegin.push_back(static_cast<uint32_t>(m_drivers.size()));
+            for (const auto &[src, srcSlot] : drivers) {
+                const auto it = pinSignals.find(src);
+                const bool known = it != pinSignals.end() && srcSlot >= 0 &&
+                                   static_cast<size_t>(srcSlot) < it->second.size();
+                m_drivers.push_back(known ? it->second[srcSlot] : zeroSignal);
+            }
+        };
+
+        m_nodes.reserve(order.size());
+        for (const auto k : order) {
+            const auto &comp = comps[k];
+            const auto &def = comp->definition;
+
+            Node node;
+            node.op = def->getOpInfo().op;
+            node.negate = def->getOpInfo().shouldNegateOutput;
+            node.slotBegin = static_cast<uint32_t>(m_slotDriverBegin.size());
+            node.slotCount = static_cast<uint32_t>(comp->inputConnections.size());
+            node.outputBegin = pinSignals[comp->id].empty() ? 0 : pinSignals[comp->id].front();
+            node.outputCount = static_cast<uint32_t>(comp->outputConnections.size());
+
+            if (isBinaryGateOp(node.op)) {
+                node.kind = NodeKind::gate;
+            } else if (ExprEval::isUninaryOperator(node.op)) {
+                node.kind = NodeKind::unaryGate;
+            } else {
+                auto compiled = ExprEval::compileExpressions(def->getOutputExpressions());
+                for (const auto &expr : compiled.compiled) {
+                    if (expr.getInputCount() > node.slotCount)
+                        return false;
+                    m_maxStackDepth = std::max(m_maxStackDepth, expr.getMaxStackDepth());
+                }
+                node.kind = NodeKind::expressions;
+                node.expressions = static_cast<uint32_t>(m_expressions.size());
+                m_expressions.push_back(std::move(compiled.compiled));
+            }
+
+            for (const auto &slot : comp->inputConnections) {
+                addSlot(slot);
+            }
+            m_maxSlotCount = std::max(m_maxSlotCount, node.slotCount);
+            m_nodes.push_back(node);
+        }
+
+        m_outputSlotBegin = static_cast<uint32_t>(m_slotDriverBegin.size());
+        for (const auto &[uuid, slot] : outputs) {
+            const auto comp = state.getDigitalComponent(uuid);
+            if (!comp || slot < 0 || static_cast<size_t>(slot) >= comp->inputConnections.size()) {
+                addSlot({});
+                continue;
+            }
+            addSlot(comp->inputConnections[slot]);
+        }
+        m_slotDriverBegin.push_back(static_cast<uint32_t>(m_drivers.size()));
+
+        return true;
+    }
+
+    uint64_t TruthTableEvaluator::readSlot(uint32_t slot, std::span<const uint64_t> signals) const {
+        uint64_t value = 0;
+        for (uint32_t d = m_slotDriverBegin[slot]; d < m_slotDriverBegin[slot + 1]; d++) {
+            value |= signals[m_drivers[d]];
+        }
+        return value;
+    }
+
+    void TruthTableEvaluator::evaluateWord(uint64_t word, std::span<uint64_t> outputs,
+                                           std::vector<uint64_t> &scratch) const {
+        scratch.resize(m_signalCount + m_maxSlotCount + m_maxStackDepth);
+        const std::span<uint64_t> signals(scratch.data(), m_signalCount);
+        const std::span<uint64_t> slots(scratch.data() + m_signalCount, m_maxSlotCount);
+        const std::span<uint64_t> stack(scratch.data() + m_signalCount + m_maxSlotCount, m_maxStackDepth);
+
+        signals[zeroSignal] = 0;
+        for (uint32_t i = 0; i < m_inputCount; i++) {
+            signals[1 + i] = ExprEval::CompiledExpression::inputPattern(i, word);
+        }
+
+        for (const auto &node : m_nodes) {
+            for (uint32_t s = 0; s < node.slotCount; s++) {
+                slots[s] = readSlot(node.slotBegin + s, signals);
+            }
+
+            const auto out = signals.subspan(node.outputBegin, node.outputCount);
+            std::ranges::fill(out, 0);
+
+            switch (node.kind) {
+            case NodeKind::gate: {
+                // same as the native gates, no inputs leaves the output low
+                if (node.slotCount == 0 || out.empty())
+                    break;
+                uint64_t value = slots[0];
+                for (uint32_t s = 1; s < node.slotCount; s++) {
+                    switch (node.op) {
+                    case '*':
+                        value &= slots[s];
+                        break;
+                    case '+':
+                        value |= slots[s];
+                        break;
+                    default:
+                        value ^= slots[s];
+                        break;
+                    }
+                }
+                out[0] = node.negate ? ~value : value;
+            } break;
+            case NodeKind::unaryGate: {
+                const bool invert = (node.op == '!') != node.negate;
+                const size_t count = std::min<size_t>(node.slotCount, out.size());
+                for (size_t i = 0; i < count; i++) {
+                    out[i] = invert ? ~slots[i] : slots[i];
+                }
+            } break;
+            case NodeKind::expressions: {
+                const auto &expressions = m_expressions[node.expressions];
+                const size_t count = std::min(expressions.size(), out.size());
+                for (size_t i = 0; i < count; i++) {
+                    out[i] = expressions[i].evaluateWords(slots.first(node.slotCount), stack);
+                }
+            } break;
+            }
+        }
+
+        for (uint32_t o = 0; o < m_outputCount; o++) {
+            outputs[o] = readSlot(m_outputSlotBegin + o, signals);
+        }
+    }
+
+    void TruthTableEvaluator::evaluate(TruthTable &table, const TruthTableOptions &options) const {
+        const uint64_t wordCount = table.getWordCount();
+        const size_t chunkWords = static_cast<size_t>(std::min<uint64_t>(wordCount, chunkWordCount));
+        // rows past the end of tables shorter than a word stay low
+        const uint64_t lastWordMask = table.getRowCount() >= 64 ? ~0ULL : (uint64_t{1} << table.getRowCount()) - 1;
+
+        const size_t threadCount = options.threadCount != 0 ? options.threadCount
+                                                            : std::max(1u, std::thread::hardware_concurrency());
+        std::unique_ptr<WorkStealingPool> pool;
+        if (threadCount > 1 && wordCount > wordGrainSize)
+            pool = std::make_unique<WorkStealingPool>(threadCount);
+
+        std::vector<uint64_t> chunk(static_cast<size_t>(m_outputCount) * chunkWords);
+        for (uint64_t first = 0; first < wordCount; first += chunkWords) {
+            const size_t count = static_cast<size_t>(std::min<uint64_t>(chunkWords, wordCount - first));
+
+            const WorkStealingPool::RangeFunction body = [&](size_t begin, size_t end) {
+                std::vector<uint64_t> scratch;
+                std::vector<uint64_t> outputs(m_outputCount);
+                for (size_t w = begin; w < end; w++) {
+                    evaluateWord(first + w, outputs, scratch);
+                    for (uint32_t o = 0; o < m_outputCount; o++) {
+                        chunk[o * count + w] = outputs[o] & lastWordMask;
+                    }
+                }
+            };
+
+            if (pool) {
+                pool->parallelFor(count, wordGrainSize, body);
+            } else {
+                body(0, count);
+            }
+
+            table.storeWords(first, count, std::span(chunk.data(), m_outputCount * count), {});
+        }
+    }
+} // namespace Bess::SimEngine
@@ -0,0 +1,66 @@
+#include "expression_evalutator/compiled_expression.h"
+#include "expression_evalutator/expr_evaluator.h"
+#include "gtest/gtest.h"
+#include "types.h"
+#include <chrono>
+#include <cstdint>
+#include <format>
+#include <string>
+#include <vector>
+
+namespace {
+    using namespace Bess::SimEngine;
+    using namespace Bess::SimEngine::ExprEval;
+
+    std::vector<SlotState> toSlots(uint64_t pattern, size_t count) {
+        std::vector<SlotState> slots(count);
+        for (size_t i = 0; i < count; i++) {
+            slots[i].state = ((pattern >> i) & 1) ? LogicState::high : LogicState::low;
+        }
+        return slots;
+    }
+
+    std::vector<bool> toBools(uint64_t pattern, size_t count) {
+        std::vector<bool> values(count);
+        for (size_t i = 0; i < count; i++) {
+            values[i] = (pattern >> i) & 1;
+        }
+        return values;
+    }
+} // namespace
+
+TEST(ExprEvalBenchmark, InterpretedVsCompiled) {
+    const std::vector<std::string> cases = {"0*1", "!(0^1) * (2 + !3)", "((0*1)+(2*3))^(4+5*!6)"};
+    constexpr int iterations = 200000;
+
+    for (size_t c = 0; c < cases.size(); c++) {
+        const auto &expr = cases[c];
+        const auto compiled = CompiledExpression::compile(expr);
+        const size_t n = compiled.getInputCount();
+
+        std::vector<std::vector<SlotState>> slotPatterns;
+        std::vector<std::vector<bool>> boolPatterns;
+        for (uint64_t p = 0; p < (uint64_t{1} << n); p++) {
+            slotPatterns.push_back(toSlots(p, n));
+            boolPatterns.push_back(toBools(p, n));
+        }
+
+        size_t legacyHigh = 0, compiledHigh = 0;
+        auto start = std::chrono::steady_clock::now();
+        for (int i = 0; i < iterations; i++) {
+            legacyHigh += evaluateExpression(expr, boolPatterns[i % boolPatterns.size()]);
+        }
+        const double legacy = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+        start = std::chrono::steady_clock::now();
+        for (int i = 0; i < iterations; i++) {
+            compiledHigh += compiled.evaluate(slotPatterns[i % slotPatterns.size()]);
+        }
+        const double fast = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+        EXPECT_EQ(legacyHigh, compiledHigh);
+        RecordProperty(std::format("case_{}_expression", c), expr);
+        RecordProperty(std::format("case_{}_interpreted_eval_per_s", c), std::format("{:.0f}", iterations / legacy));
+        RecordProperty(std::format("case_{}_compiled_eval_per_s", c), std::format("{:.0f}", iterations / fast));
+    }
+}
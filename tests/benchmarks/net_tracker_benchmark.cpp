@@ -0,0 +1,62 @@
+#include "gtest/gtest.h"
+#include "net/net_tracker.h"
+#include "types.h"
+#include <chrono>
+#include <format>
+#include <random>
+#include <vector>
+
+namespace {
+    using Bess::UUID;
+    using namespace Bess::SimEngine;
+
+    std::vector<UUID> addComponents(NetTracker &tracker, size_t count) {
+        std::vector<UUID> comps;
+        for (size_t i = 0; i < count; i++) {
+            comps.emplace_back(i + 1);
+            tracker.addComponent(comps.back());
+        }
+        return comps;
+    }
+} // namespace
+
+TEST(NetTrackerBenchmark, EditLatency) {
+    // gates in chains of 16, every chain tied to a shared bus, like the fanout of a design's clock
+    for (const size_t gates : {1'000u, 10'000u, 100'000u}) {
+        NetTracker tracker;
+        const auto comps = addComponents(tracker, gates + 1);
+        const auto bus = comps.back();
+
+        const auto connectStart = std::chrono::steady_clock::now();
+        for (size_t i = 0; i < gates; i++) {
+            tracker.connect(i % 16 == 0 ? bus : comps[i - 1], comps[i]);
+        }
+        const auto connectTime = std::chrono::steady_clock::now() - connectStart;
+        tracker.getNets();
+
+        // cut one wire inside a chain and query its net, like the UI does after an edit
+        constexpr int edits = 50;
+        std::mt19937 rng(3);
+        const auto editStart = std::chrono::steady_clock::now();
+        for (int e = 0; e < edits; e++) {
+            const auto i = 1 + rng() % (gates - 1);
+            const auto prev = i % 16 == 0 ? bus : comps[i - 1];
+            tracker.disconnect(prev, comps[i]);
+            EXPECT_NE(tracker.getNetOf(comps[i]), UUID::null);
+            tracker.connect(prev, comps[i]);
+        }
+        const auto editTime = std::chrono::steady_clock::now() - editStart;
+
+        const auto removeStart = std::chrono::steady_clock::now();
+        for (int e = 0; e < edits; e++) {
+            tracker.removeComponent(comps[rng() % gates]);
+            tracker.getNets();
+        }
+        const auto removeTime = std::chrono::steady_clock::now() - removeStart;
+
+        using us = std::chrono::duration<double, std::micro>;
+        RecordProperty(std::format("gates_{}_connect_us", gates), std::format("{:.3f}", us(connectTime).count() / gates));
+        RecordProperty(std::format("gates_{}_cut_wire_us", gates), std::format("{:.1f}", us(editTime).count() / edits));
+        RecordProperty(std::format("gates_{}_delete_gate_us", gates), std::format("{:.1f}", us(removeTime).count() / edits));
+    }
+}
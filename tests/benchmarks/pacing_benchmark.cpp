@@ -0,0 +1,48 @@
+#include "gtest/gtest.h"
+#include "init_components.h"
+#include "simulation_engine.h"
+#include "types.h"
+#include <chrono>
+#include <format>
+#include <memory>
+
+using namespace std::chrono_literals;
+
+namespace {
+    using namespace Bess::SimEngine;
+} // namespace
+
+TEST(PacingBenchmark, WallClockPerSimulatedSpan) {
+    auto &engine = SimulationEngine::instance();
+    engine.setSimulationState(SimulationState::paused);
+    engine.clear();
+
+    // a 1 kHz clock, so every mode has events to pace
+    const auto clock = engine.addComponent(std::make_shared<ClockDefinition>("Tests"));
+    const auto clockTrait = engine.getComponentDefinition(clock)->getTrait<ClockTrait>();
+    ASSERT_NE(clockTrait, nullptr);
+    clockTrait->frequency = 1.f;
+    clockTrait->frequencyUnit = FrequencyUnit::kHz;
+
+    const auto runFor = [&](SimTime duration) {
+        const auto target = engine.getSimulationTime() + duration;
+        const auto start = std::chrono::steady_clock::now();
+        EXPECT_TRUE(engine.runUntil(target));
+        return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    };
+
+    engine.setPacing(SimulationPacing::asFastAsPossible);
+    RecordProperty("fast_2s_ms", std::format("{:.1f}", runFor(2s)));
+
+    engine.setPacing(SimulationPacing::realTime);
+    RecordProperty("real_time_100ms_ms", std::format("{:.1f}", runFor(100ms)));
+
+    engine.setPacing(SimulationPacing::scaled);
+    engine.setTimeScale(4.0);
+    RecordProperty("scaled_x4_200ms_ms", std::format("{:.1f}", runFor(200ms)));
+
+    engine.setTimeScale(1.0);
+    engine.setPacing(SimulationPacing::realTime);
+    engine.setSimulationState(SimulationState::paused);
+    engine.clear();
+}
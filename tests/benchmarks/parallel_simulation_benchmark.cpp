@@ -0,0 +1,85 @@
+#include "component_definition.h"
+#include "gtest/gtest.h"
+#include "sim_engine_test_fixture.h"
+#include "simulation_engine.h"
+#include "types.h"
+#include <chrono>
+#include <format>
+#include <memory>
+#include <random>
+#include <thread>
+#include <vector>
+
+using namespace std::chrono_literals;
+
+namespace {
+    using Bess::UUID;
+    using namespace Bess::SimEngine;
+    using namespace Bess::Tests;
+
+    // width inputs feeding `depth` layers of randomly wired gates, returns the inputs
+    std::vector<UUID> buildRandomCircuit(SimulationEngine &engine, size_t width, size_t depth, uint32_t seed) {
+        const std::vector<std::shared_ptr<ComponentDefinition>> gates = {
+            findDefinitionByName("AND Gate"),
+            findDefinitionByName("OR Gate"),
+            findDefinitionByName("XOR Gate"),
+            findDefinitionByName("NAND Gate"),
+            findDefinitionByName("XNOR Gate"),
+        };
+        const auto inputDef = findDefinitionByName("Input");
+
+        std::mt19937 rng(seed);
+        std::vector<UUID> inputs;
+        for (size_t i = 0; i < width; i++) {
+            inputs.push_back(engine.addComponent(inputDef));
+        }
+
+        std::vector<UUID> previous = inputs;
+        for (size_t layer = 0; layer < depth; layer++) {
+            std::vector<UUID> current;
+            for (size_t i = 0; i < width; i++) {
+                const auto gate = engine.addComponent(gates[rng() % gates.size()]);
+                engine.connectComponent(previous[i], 0, SlotType::digitalOutput, gate, 0, SlotType::digitalInput);
+                engine.connectComponent(previous[rng() % width], 0, SlotType::digitalOutput,
+                                        gate, 1, SlotType::digitalInput);
+                current.push_back(gate);
+            }
+            previous = std::move(current);
+        }
+        return inputs;
+    }
+} // namespace
+
+TEST(ParallelSimulationBenchmark, Scaling) {
+    constexpr size_t width = 1024;
+    constexpr size_t depth = 16;
+    constexpr int toggles = 6;
+
+    auto &engine = SimulationEngine::instance();
+    RecordProperty("hardware_concurrency", static_cast<int>(std::thread::hardware_concurrency()));
+    for (const size_t threads : {1u, 2u, 4u, 8u, 16u}) {
+        engine.setSimulationState(SimulationState::paused);
+        engine.clear();
+        engine.setWorkerThreadCount(threads);
+
+        const auto inputs = buildRandomCircuit(engine, width, depth, 11);
+        engine.setSimulationState(SimulationState::running);
+        ASSERT_TRUE(engine.waitUntilStable(20s));
+
+        const auto before = engine.getEventStats();
+        const auto start = std::chrono::steady_clock::now();
+        for (int t = 0; t < toggles; t++) {
+            for (const auto &input : inputs) {
+                engine.setOutputSlotState(input, 0, t % 2 == 0 ? LogicState::high : LogicState::low);
+            }
+            ASSERT_TRUE(engine.waitUntilStable(20s));
+        }
+        const auto elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        const auto evaluated = engine.getEventStats().evaluated - before.evaluated;
+        RecordProperty(std::format("threads_{}_evals_per_s", threads), std::format("{:.0f}", evaluated / elapsed));
+
+        engine.setSimulationState(SimulationState::paused);
+        engine.setWorkerThreadCount(1);
+        engine.clear();
+    }
+}
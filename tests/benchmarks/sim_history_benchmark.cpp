@@ -0,0 +1,65 @@
+#include "component_definition.h"
+#include "gtest/gtest.h"
+#include "sim_engine_test_fixture.h"
+#include "simulation_engine.h"
+#include "types.h"
+#include <chrono>
+#include <format>
+#include <memory>
+
+using namespace std::chrono_literals;
+
+namespace {
+    using Bess::UUID;
+    using namespace Bess::SimEngine;
+    using namespace Bess::Tests;
+} // namespace
+
+TEST(SimHistoryBenchmark, RecordingOverhead) {
+    constexpr int chains = 100;
+    constexpr int depth = 100;
+    constexpr int toggles = 40;
+
+    auto &engine = SimulationEngine::instance();
+    engine.setPacing(SimulationPacing::asFastAsPossible);
+    for (const bool withHistory : {false, true}) {
+        engine.setSimulationState(SimulationState::paused);
+        engine.disableHistory();
+        engine.clear();
+
+        const auto input = engine.addComponent(findDefinitionByName("Input"));
+        for (int c = 0; c < chains; c++) {
+            UUID prev = input;
+            for (int d = 0; d < depth; d++) {
+                const auto gate = engine.addComponent(findDefinitionByName("NOT Gate"));
+                ASSERT_TRUE(engine.connectComponent(prev, 0, SlotType::digitalOutput,
+                                                    gate, 0, SlotType::digitalInput));
+                prev = gate;
+            }
+        }
+        engine.setSimulationState(SimulationState::running);
+        ASSERT_TRUE(engine.waitUntilStable(20s));
+        if (withHistory)
+            engine.enableHistory();
+
+        const auto before = engine.getEventStats();
+        const auto start = std::chrono::steady_clock::now();
+        for (int t = 0; t < toggles; t++) {
+            engine.setOutputSlotState(input, 0, t % 2 == 0 ? LogicState::high : LogicState::low);
+            ASSERT_TRUE(engine.waitUntilStable(20s));
+        }
+        const auto elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        const auto processed = engine.getEventStats().processed - before.processed;
+
+        const auto stats = engine.getHistoryStats();
+        const auto key = withHistory ? "history_on" : "history_off";
+        RecordProperty(std::format("{}_events_per_s", key), std::format("{:.0f}", processed / elapsed));
+        RecordProperty(std::format("{}_positions", key), std::format("{}", stats.positions));
+        RecordProperty(std::format("{}_memory_kib", key), std::format("{}", stats.memoryUsage >> 10));
+    }
+
+    engine.setSimulationState(SimulationState::paused);
+    engine.disableHistory();
+    engine.clear();
+    engine.setPacing(SimulationPacing::realTime);
+}
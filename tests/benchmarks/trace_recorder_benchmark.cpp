@@ -0,0 +1,79 @@
+#include "component_definition.h"
+#include "gtest/gtest.h"
+#include "sim_engine_test_fixture.h"
+#include "simulation_engine.h"
+#include "trace/trace_writer.h"
+#include "types.h"
+#include <chrono>
+#include <filesystem>
+#include <format>
+#include <memory>
+#include <vector>
+
+using namespace std::chrono_literals;
+
+namespace {
+    using Bess::UUID;
+    using namespace Bess::SimEngine;
+    using namespace Bess::Tests;
+
+    // evaluations per second while toggling every input, traced or not
+    double toggleThroughput(SimulationEngine &engine, const std::vector<UUID> &inputs, int toggles) {
+        const auto before = engine.getEventStats();
+        const auto start = std::chrono::steady_clock::now();
+        for (int t = 0; t < toggles; t++) {
+            for (const auto &input : inputs) {
+                engine.setOutputSlotState(input, 0, t % 2 == 0 ? LogicState::high : LogicState::low);
+            }
+            if (!engine.runUntilStable(20s))
+                return 0;
+        }
+        const auto elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        return (engine.getEventStats().evaluated - before.evaluated) / elapsed;
+    }
+} // namespace
+
+TEST(TraceRecorderBenchmark, TracingOnVersusOff) {
+    // inputs each driving a chain of inverters, every inverter output is traced
+    constexpr size_t chains = 256;
+    constexpr size_t length = 16;
+    constexpr int toggles = 20;
+
+    auto &engine = SimulationEngine::instance();
+    engine.setSimulationState(SimulationState::paused);
+    engine.clear();
+
+    const auto inputDef = findDefinitionByName("Input");
+    const auto notDef = findDefinitionByName("NOT Gate");
+    std::vector<UUID> inputs;
+    std::vector<TraceSignal> signals;
+    for (size_t c = 0; c < chains; c++) {
+        auto previous = engine.addComponent(inputDef);
+        inputs.push_back(previous);
+        for (size_t i = 0; i < length; i++) {
+            const auto gate = engine.addComponent(notDef);
+            ASSERT_TRUE(engine.connectComponent(previous, 0, SlotType::digitalOutput, gate, 0, SlotType::digitalInput));
+            signals.push_back({std::format("top/chain{}", c), std::format("n{}", i), gate, SlotType::digitalOutput, 0});
+            previous = gate;
+        }
+    }
+    ASSERT_TRUE(engine.runUntilStable(20s));
+
+    const auto off = toggleThroughput(engine, inputs, toggles);
+    ASSERT_GT(off, 0);
+
+    const auto path = std::filesystem::temp_directory_path() / std::format("bess_trace_benchmark_{}.vcd", UUID().toString());
+    ASSERT_TRUE(engine.startTrace(path, signals, TraceFormat::vcd));
+    const auto on = toggleThroughput(engine, inputs, toggles);
+    engine.stopTrace();
+    ASSERT_GT(on, 0);
+
+    RecordProperty("signals", static_cast<int>(signals.size()));
+    RecordProperty("trace_off_evals_per_s", std::format("{:.0f}", off));
+    RecordProperty("trace_on_evals_per_s", std::format("{:.0f}", on));
+    RecordProperty("trace_on_slowdown", std::format("{:.2f}", off / on));
+    RecordProperty("trace_file_bytes", std::format("{}", std::filesystem::file_size(path)));
+
+    std::filesystem::remove(path);
+    engine.clear();
+}
@@ -0,0 +1,216 @@
+#include "component_definition.h"
+#include "gtest/gtest.h"
+#include "init_components.h"
+#include "sim_engine_test_fixture.h"
+#include "simulation_engine.h"
+#include "trace/trace_writer.h"
+#include "types.h"
+#include <filesystem>
+#include <format>
+#include <fstream>
+#include <iterator>
+#include <memory>
+#include <vector>
+
+namespace {
+    using Bess::UUID;
+    using namespace Bess::SimEngine;
+    using namespace Bess::Tests;
+
+    // evaluates a definition on its own, outputs start out low
+    std::vector<SlotState> evaluate(const ComponentDefinition &def, const std::vector<SlotState> &inputs) {
+        ComponentState state;
+        state.inputStates = inputs;
+        std::vector<SlotState> outputs(def.getOutputSlotsInfo().count);
+        def.getInPlaceSimulationFunction()(inputs, SimTime(5), state, outputs);
+        return outputs;
+    }
+
+    class BusSlotTest : public SimEngineTestBase {};
+} // namespace
+
+TEST(SlotsGroupInfoTest, SlotsAreOneBitUnlessDeclaredWider) {
+    const SlotsGroupInfo info{SlotsGroupType::input, false, 3, {}, {}, {{1, 16}}};
+    EXPECT_EQ(info.getWidth(0), 1);
+    EXPECT_EQ(info.getWidth(1), 16);
+    EXPECT_EQ(info.getWidth(2), 1);
+
+    Json::Value j;
+    Bess::JsonConvert::toJsonValue(info, j);
+    SlotsGroupInfo restored;
+    Bess::JsonConvert::fromJsonValue(j, restored);
+    EXPECT_EQ(restored.widths, info.widths);
+}
+
+TEST(SlotsGroupInfoTest, WidthsTellDefinitionsApart) {
+    ComponentDefinition bit;
+    bit.setName("Register");
+    bit.setInputSlotsInfo({SlotsGroupType::input, false, 1, {}, {}});
+    ComponentDefinition bus(bit);
+    bus.setInputSlotsInfo({SlotsGroupType::input, false, 1, {}, {}, {{0, 8}}});
+    bit.computeHash();
+    bus.computeHash();
+    EXPECT_NE(bit.getHash(), bus.getHash());
+
+    // one bit slots hash as they did before slots had a width
+    ComponentDefinition explicitBit(bit);
+    explicitBit.setInputSlotsInfo({SlotsGroupType::input, false, 1, {}, {}, {}});
+    explicitBit.computeHash();
+    EXPECT_EQ(explicitBit.getHash(), bit.getHash());
+}
+
+TEST(BusSlotStateTest, WordsSurviveJson) {
+    ComponentState state;
+    state.inputStates = {SlotState::fromWord(0xbeef, SimTime(3)), {LogicState::high, SimTime(4)}};
+    state.outputStates = {SlotState::fromWord(0, SimTime(0)), SlotState::fromWord(0x80, SimTime(9))};
+    state.inputConnected = {true, false};
+    state.outputConnected = {false, true};
+
+    Json::Value j;
+    Bess::JsonConvert::toJsonValue(state, j);
+    ComponentState restored;
+    Bess::JsonConvert::fromJsonValue(j, restored);
+    EXPECT_EQ(restored.inputStates[0].value, 0xbeefu);
+    EXPECT_EQ(restored.outputStates[1].value, 0x80u);
+}
+
+TEST(BusComponentsTest, SplitterAndJoinerAreInverses) {
+    const auto splitter = makeBusSplitterDefinition(8);
+    const auto joiner = makeBusJoinerDefinition(8);
+
+    const auto bits = evaluate(*splitter, {SlotState::fromWord(0xa5, SimTime(1))});
+    ASSERT_EQ(bits.size(), 8u);
+    for (size_t i = 0; i < bits.size(); i++) {
+        EXPECT_EQ(bits[i].state, ((0xa5 >> i) & 1) ? LogicState::high : LogicState::low) << "bit " << i;
+    }
+
+    const auto bus = evaluate(*joiner, bits);
+    EXPECT_EQ(bus[0].state, LogicState::high);
+    EXPECT_EQ(bus[0].value, 0xa5u);
+
+    // a bus has no per bit states, one unknown bit makes all of it unknown
+    auto withUnknown = bits;
+    withUnknown[3].state = LogicState::unknown;
+    EXPECT_EQ(evaluate(*joiner, withUnknown)[0].state, LogicState::unknown);
+    for (const auto &bit : evaluate(*splitter, evaluate(*joiner, withUnknown))) {
+        EXPECT_EQ(bit.state, LogicState::unknown);
+    }
+}
+
+TEST_F(BusSlotTest, ConnectionsNeedMatchingWidths) {
+    const auto bus = engine->addComponent(findDefinitionByName("Bus Input 8"));
+    const auto narrow = engine->addComponent(findDefinitionByName("Bus Output 4"));
+    const auto bit = engine->addComponent(findDefinitionByName("Output"));
+    const auto wide = engine->addComponent(findDefinitionByName("Bus Output 8"));
+
+    const auto [narrowOk, narrowError] =
+        engine->canConnectComponents(bus, 0, SlotType::digitalOutput, narrow, 0, SlotType::digitalInput);
+    EXPECT_FALSE(narrowOk);
+    EXPECT_NE(narrowError.find("8 bit"), std::string::npos);
+    EXPECT_FALSE(engine->connectComponent(bus, 0, SlotType::digitalOutput, bit, 0, SlotType::digitalInput));
+    EXPECT_TRUE(engine->connectComponent(bus, 0, SlotType::digitalOutput, wide, 0, SlotType::digitalInput));
+}
+
+TEST_F(BusSlotTest, AWordPropagatesAsOneSlot) {
+    const auto bus = engine->addComponent(findDefinitionByName("Bus Input 8"));
+    const auto splitter = engine->addComponent(findDefinitionByName("Bus Splitter 8"));
+    const auto sink = engine->addComponent(findDefinitionByName("Bus Output 8"));
+    ASSERT_TRUE(engine->connectComponent(bus, 0, SlotType::digitalOutput, splitter, 0, SlotType::digitalInput));
+    ASSERT_TRUE(engine->connectComponent(bus, 0, SlotType::digitalOutput, sink, 0, SlotType::digitalInput));
+    ASSERT_TRUE(engine->runUntilStable());
+
+    std::vector<uint64_t> seen;
+    const UUID listenerId;
+    engine->addStateChangeListener(listenerId, sink, [&seen](const SlotChange &change) {
+        if (change.type == SlotType::digitalInput)
+            seen.push_back(change.value);
+    });
+
+    // bits past the width are dropped
+    engine->setOutputSlotWord(bus, 0, 0x1c3);
+    ASSERT_TRUE(engine->runUntilStable());
+    EXPECT_EQ(engine->getDigitalComponent(sink)->state.inputStates[0].value, 0xc3u);
+    const auto &bits = engine->getDigitalComponent(splitter)->state.outputStates;
+    for (size_t i = 0; i < bits.size(); i++) {
+        EXPECT_EQ(bits[i].state, ((0xc3 >> i) & 1) ? LogicState::high : LogicState::low) << "bit " << i;
+    }
+
+    // same word again, nothing changes downstream
+    engine->setOutputSlotWord(bus, 0, 0xc3);
+    ASSERT_TRUE(engine->runUntilStable());
+    engine->dispatchStateChanges();
+    EXPECT_EQ(seen, std::vector<uint64_t>{0xc3});
+    engine->removeStateChangeListener(listenerId, sink);
+
+    // a bus driven high or low by state sets all of its bits
+    engine->setOutputSlotState(bus, 0, LogicState::high);
+    ASSERT_TRUE(engine->runUntilStable());
+    EXPECT_EQ(engine->getDigitalComponent(sink)->state.inputStates[0].value, 0xffu);
+    engine->setOutputSlotState(bus, 0, LogicState::low);
+    ASSERT_TRUE(engine->runUntilStable());
+    EXPECT_EQ(engine->getDigitalComponent(sink)->state.inputStates[0].value, 0u);
+}
+
+TEST_F(BusSlotTest, DriversOfOneBusAreOred) {
+    const auto a = engine->addComponent(findDefinitionByName("Bus Input 4"));
+    const auto b = engine->addComponent(findDefinitionByName("Bus Input 4"));
+    const auto sink = engine->addComponent(findDefinitionByName("Bus Output 4"));
+    ASSERT_TRUE(engine->connectComponent(a, 0, SlotType::digitalOutput, sink, 0, SlotType::digitalInput));
+    ASSERT_TRUE(engine->connectComponent(b, 0, SlotType::digitalOutput, sink, 0, SlotType::digitalInput));
+
+    engine->setOutputSlotWord(a, 0, 0b0011);
+    engine->setOutputSlotWord(b, 0, 0b1000);
+    ASSERT_TRUE(engine->runUntilStable());
+    EXPECT_EQ(engine->getDigitalComponent(sink)->state.inputStates[0].value, 0b1011u);
+    EXPECT_EQ(engine->getInputSlotsState(sink)[0].value, 0b1011u);
+}
+
+TEST_F(BusSlotTest, TracesCarryTheWord) {
+    const auto bus = engine->addComponent(findDefinitionByName("Bus Input 8"));
+    const auto sink = engine->addComponent(findDefinitionByName("Bus Output 8"));
+    ASSERT_TRUE(engine->connectComponent(bus, 0, SlotType::digitalOutput, sink, 0, SlotType::digitalInput));
+    engine->setOutputSlotWord(bus, 0, 0x5a);
+    ASSERT_TRUE(engine->runUntilStable());
+
+    const auto path = std::filesystem::temp_directory_path() / std::format("bess_bus_trace_{}.vcd", UUID().toString());
+    ASSERT_TRUE(engine->startTrace(path, {{"top", "data", sink, SlotType::digitalInput, 0}}, TraceFormat::vcd));
+    engine->setOutputSlotWord(bus, 0, 0x81);
+    ASSERT_TRUE(engine->runUntilStable());
+    engine->stopTrace();
+
+    std::ifstream in(path);
+    const std::string vcd{std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>()};
+    in.close();
+    std::filesystem::remove(path);
+    EXPECT_NE(vcd.find("$var wire 8 ! data $end"), std::string::npos);
+    EXPECT_NE(vcd.find("$dumpvars\nb1011010 !\n$end\n"), std::string::npos);
+    EXPECT_NE(vcd.find("b10000001 !\n"), std::string::npos);
+}
+
+TEST_F(BusSlotTest, RewindReportsTheRestoredWord) {
+    const auto bus = engine->addComponent(findDefinitionByName("Bus Input 8"));
+    const auto sink = engine->addComponent(findDefinitionByName("Bus Output 8"));
+    ASSERT_TRUE(engine->connectComponent(bus, 0, SlotType::digitalOutput, sink, 0, SlotType::digitalInput));
+    engine->enableHistory();
+    engine->setOutputSlotWord(bus, 0, 0x12);
+    ASSERT_TRUE(engine->runUntilStable());
+    engine->setOutputSlotWord(bus, 0, 0x34);
+    ASSERT_TRUE(engine->runUntilStable());
+    engine->dispatchStateChanges();
+
+    std::vector<uint64_t> seen;
+    const UUID listenerId;
+    engine->addStateChangeListener(listenerId, sink, [&seen](const SlotChange &change) {
+        if (change.type == SlotType::digitalInput)
+            seen.push_back(change.value);
+    });
+    while (engine->getDigitalComponent(sink)->state.inputStates[0].value != 0x12u) {
+        ASSERT_TRUE(engine->stepBack());
+    }
+    engine->dispatchStateChanges();
+    engine->removeStateChangeListener(listenerId, sink);
+    engine->disableHistory();
+
+    ASSERT_FALSE(seen.empty());
+    EXPECT_EQ(seen.back(), 0x12u);
+}
@@ -0,0 +1,114 @@
+#include "component_definition.h"
+#include "digital_component.h"
+#include "gtest/gtest.h"
+#include "netlist/compiled_netlist.h"
+#include "sim_engine_state.h"
+#include "sim_engine_test_fixture.h"
+#include "types.h"
+#include <algorithm>
+#include <memory>
+#include <vector>
+
+namespace {
+    using Bess::UUID;
+    using namespace Bess::SimEngine;
+    using namespace Bess::Tests;
+} // namespace
+
+TEST(CompiledNetlistTest, BuildsDenseIndicesAndDeduplicatedFanOut) {
+    SimEngineState state;
+    auto driver = addComponent(state, 0, 2);
+    auto sinkA = addComponent(state, 2, 1);
+    auto sinkB = addComponent(state, 1, 1);
+
+    connect(*driver, 0, *sinkA, 0);
+    connect(*driver, 1, *sinkA, 1);
+    connect(*driver, 1, *sinkB, 0);
+
+    CompiledNetlist netlist;
+    netlist.compile(state);
+
+    ASSERT_EQ(netlist.size(), 3u);
+    EXPECT_EQ(netlist.getCompiledVersion(), state.getTopologyVersion());
+
+    const auto driverIdx = netlist.indexOf(driver->id);
+    ASSERT_NE(driverIdx, invalidCompIndex);
+    EXPECT_EQ(netlist.uuidOf(driverIdx), driver->id);
+    EXPECT_EQ(netlist.componentAt(driverIdx), driver.get());
+    EXPECT_EQ(netlist.getOutputCount(driverIdx), 2u);
+    EXPECT_EQ(netlist.indexOf(UUID::null), invalidCompIndex);
+
+    const auto dependants = netlist.getDependants(driverIdx);
+    std::vector<UUID> dependantIds;
+    for (const auto dep : dependants) {
+        dependantIds.push_back(netlist.uuidOf(dep));
+    }
+    ASSERT_EQ(dependantIds.size(), 2u);
+    EXPECT_NE(std::ranges::find(dependantIds, sinkA->id), dependantIds.end());
+    EXPECT_NE(std::ranges::find(dependantIds, sinkB->id), dependantIds.end());
+}
+
+TEST(CompiledNetlistTest, GatherInputsResolvesDriversFromPackedOutputs) {
+    SimEngineState state;
+    auto driverA = addComponent(state, 0, 1);
+    auto driverB = addComponent(state, 0, 1);
+    auto sink = addComponent(state, 2, 1);
+
+    // slot 0 has two drivers, slot 1 is left unconnected
+    connect(*driverA, 0, *sink, 0);
+    connect(*driverB, 0, *sink, 0);
+
+    CompiledNetlist netlist;
+    netlist.compile(state);
+    const auto sinkIdx = netlist.indexOf(sink->id);
+
+    std::vector<SlotState> inputs;
+    netlist.gatherInputs(sinkIdx, inputs);
+    ASSERT_EQ(inputs.size(), 2u);
+    EXPECT_EQ(inputs[0].state, LogicState::low);
+    EXPECT_EQ(inputs[1].state, LogicState::low);
+
+    netlist.setOutput(netlist.indexOf(driverA->id), 0, {LogicState::unknown, SimTime(3)});
+    inputs.clear();
+    netlist.gatherInputs(sinkIdx, inputs);
+    EXPECT_EQ(inputs[0].state, LogicState::unknown);
+
+    driverB->state.outputStates[0] = {LogicState::high, SimTime(5)};
+    EXPECT_TRUE(netlist.syncOutputs(netlist.indexOf(driverB->id)));
+    inputs.clear();
+    netlist.gatherInputs(sinkIdx, inputs);
+    EXPECT_EQ(inputs[0].state, LogicState::high);
+    EXPECT_EQ(inputs[0].lastChangeTime, SimTime(5));
+
+    netlist.setOutput(netlist.indexOf(driverB->id), 0, {LogicState::high_z, SimTime(6)});
+    inputs.clear();
+    netlist.gatherInputs(sinkIdx, inputs);
+    EXPECT_EQ(inputs[0].state, LogicState::unknown);
+}
+
+TEST(CompiledNetlistTest, DetectsStaleTopologyAndResizedComponents) {
+    SimEngineState state;
+    auto driver = addComponent(state, 0, 1);
+    auto sink = addComponent(state, 1, 1);
+
+    CompiledNetlist netlist;
+    netlist.compile(state);
+    EXPECT_EQ(netlist.getCompiledVersion(), state.getTopologyVersion());
+
+    connect(*driver, 0, *sink, 0);
+    state.markTopologyChanged();
+    EXPECT_NE(netlist.getCompiledVersion(), state.getTopologyVersion());
+
+    netlist.compile(state);
+    const auto sinkIdx = netlist.indexOf(sink->id);
+    EXPECT_TRUE(netlist.isShapeValid(sinkIdx));
+
+    sink->incrementInputCount(true);
+    EXPECT_FALSE(netlist.isShapeValid(sinkIdx));
+
+    state.removeDigitalComponent(driver->id);
+    netlist.compile(state);
+    EXPECT_EQ(netlist.size(), 1u);
+    EXPECT_EQ(netlist.getInputCount(netlist.indexOf(sink->id)), 2u);
+    EXPECT_TRUE(netlist.getDependants(netlist.indexOf(sink->id)).empty());
+}
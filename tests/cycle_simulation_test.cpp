@@ -0,0 +1,218 @@
+#include "component_definition.h"
+#include "gtest/gtest.h"
+#include "netlist/cycle_schedule.h"
+#include "sim_engine_test_fixture.h"
+#include "simulation_engine.h"
+#include "types.h"
+#include <chrono>
+#include <cstdlib>
+#include <filesystem>
+#include <format>
+#include <memory>
+#include <system_error>
+#include <vector>
+
+namespace {
+    using Bess::UUID;
+    using namespace Bess::SimEngine;
+    using namespace Bess::Tests;
+
+    // rising edge D flip flop, D then CLK
+    std::shared_ptr<ComponentDefinition> makeRegisterDefinition() {
+        auto def = std::make_shared<ComponentDefinition>();
+        def->setName("Cycle Test DFF");
+        def->setGroupName("Tests");
+        def->setInputSlotsInfo({SlotsGroupType::input, false, 2, {"D", "CLK"}, {{1, SlotCatergory::clock}}});
+        def->setOutputSlotsInfo({SlotsGroupType::output, false, 1, {"Q"}, {}});
+        def->setSimDelay(SimDelayNanoSeconds(2));
+        def->setInPlaceSimulationFunction([](std::span<const SlotState> inputs, SimTime ts,
+                                             const ComponentState &prev, std::span<SlotState> outputs) {
+            const bool clock = inputs[1].state == LogicState::high;
+            const bool previous = prev.inputStates.size() > 1 && prev.inputStates[1].state == LogicState::high;
+            if (!clock || previous || outputs[0].state == inputs[0].state)
+                return false;
+            outputs[0] = {inputs[0].state, ts};
+            return true;
+        });
+        def->setParallelSafe(true);
+        def->addTrait<RegisterTrait>(std::make_shared<RegisterTrait>(std::vector<int>{1}, std::vector<int>{}));
+        return def;
+    }
+
+    struct Counter {
+        UUID clock;
+        std::vector<UUID> bits; // registers, bit 0 first
+    };
+
+    // ripple carry incrementer feeding its own registers, optionally clocked through a buffer
+    Counter buildCounter(SimulationEngine &engine, size_t width, bool bufferedClock) {
+        const auto dff = makeRegisterDefinition();
+        const auto xorDef = findDefinitionByName("XOR Gate");
+        const auto andDef = findDefinitionByName("AND Gate");
+        const auto notDef = findDefinitionByName("NOT Gate");
+
+        Counter counter;
+        counter.clock = engine.addComponent(findDefinitionByName("Input"));
+        auto clockNet = counter.clock;
+        if (bufferedClock) {
+            clockNet = engine.addComponent(findDefinitionByName("Buffer Gate"));
+            engine.connectComponent(counter.clock, 0, SlotType::digitalOutput, clockNet, 0, SlotType::digitalInput);
+        }
+
+        for (size_t i = 0; i < width; i++) {
+            counter.bits.push_back(engine.addComponent(dff));
+            engine.connectComponent(clockNet, 0, SlotType::digitalOutput, counter.bits[i], 1, SlotType::digitalInput);
+        }
+
+        const auto flip = engine.addComponent(notDef);
+        engine.connectComponent(counter.bits[0], 0, SlotType::digitalOutput, flip, 0, SlotType::digitalInput);
+        engine.connectComponent(flip, 0, SlotType::digitalOutput, counter.bits[0], 0, SlotType::digitalInput);
+
+        auto carry = counter.bits[0];
+        for (size_t i = 1; i < width; i++) {
+            const auto sum = engine.addComponent(xorDef);
+            engine.connectComponent(counter.bits[i], 0, SlotType::digitalOutput, sum, 0, SlotType::digitalInput);
+            engine.connectComponent(carry, 0, SlotType::digitalOutput, sum, 1, SlotType::digitalInput);
+            engine.connectComponent(sum, 0, SlotType::digitalOutput, counter.bits[i], 0, SlotType::digitalInput);
+
+            const auto nextCarry = engine.addComponent(andDef);
+            engine.connectComponent(counter.bits[i], 0, SlotType::digitalOutput, nextCarry, 0, SlotType::digitalInput);
+            engine.connectComponent(carry, 0, SlotType::digitalOutput, nextCarry, 1, SlotType::digitalInput);
+            carry = nextCarry;
+        }
+        return counter;
+    }
+
+    uint64_t readCounter(SimulationEngine &engine, const Counter &counter) {
+        uint64_t value = 0;
+        for (size_t i = 0; i < counter.bits.size(); i++) {
+            if (engine.getComponentState(counter.bits[i]).outputStates[0].state == LogicState::high)
+                value |= uint64_t{1} << i;
+        }
+        return value;
+    }
+
+    struct CountResult {
+        std::vector<uint64_t> values; // after every clock cycle
+        SimEventStats events;
+        SimCycleStats cycles;
+        bool nativeLoaded = false;
+    };
+
+    CountResult countCycles(SimulationEngine &engine, SimulationMode mode, bool bufferedClock, int cycles) {
+        engine.setSimulationState(SimulationState::paused);
+        engine.clear();
+        engine.setPacing(SimulationPacing::asFastAsPossible);
+        engine.setSimulationMode(mode);
+
+        const auto counter = buildCounter(engine, 4, bufferedClock);
+        SimTime time = engine.getSimulationTime();
+        time += SimTime(100);
+        EXPECT_TRUE(engine.runUntil(time));
+
+        // the model compiles in the background, counting starts once it is loaded
+        CountResult result;
+        if (mode == SimulationMode::native)
+            result.nativeLoaded = engine.waitForNativeModel(std::chrono::minutes(2));
+        for (int cycle = 0; cycle < cycles; cycle++) {
+            engine.setOutputSlotState(counter.clock, 0, LogicState::high);
+            time += SimTime(50);
+            EXPECT_TRUE(engine.runUntil(time));
+            engine.setOutputSlotState(counter.clock, 0, LogicState::low);
+            time += SimTime(50);
+            EXPECT_TRUE(engine.runUntil(time));
+            result.values.push_back(readCounter(engine, counter));
+        }
+        result.events = engine.getEventStats();
+        result.cycles = engine.getCycleStats();
+
+        engine.setSimulationMode(SimulationMode::eventDriven);
+        engine.setPacing(SimulationPacing::realTime);
+        engine.clear();
+        return result;
+    }
+} // namespace
+
+TEST(CycleSimulationTest, CycleBasedCounterMatchesEventDriven) {
+    auto &engine = SimulationEngine::instance();
+    constexpr int cycles = 20;
+
+    const auto events = countCycles(engine, SimulationMode::eventDriven, false, cycles);
+    const auto swept = countCycles(engine, SimulationMode::cycleBased, false, cycles);
+
+    ASSERT_EQ(events.values.size(), static_cast<size_t>(cycles));
+    for (int cycle = 0; cycle < cycles; cycle++) {
+        EXPECT_EQ(events.values[cycle], static_cast<uint64_t>(cycle + 1) % 16) << "cycle " << cycle;
+        EXPECT_EQ(swept.values[cycle], events.values[cycle]) << "cycle " << cycle;
+    }
+
+    EXPECT_TRUE(swept.cycles.active) << swept.cycles.fallbackReason;
+    EXPECT_EQ(swept.cycles.clockDomains, 1u);
+    EXPECT_EQ(swept.cycles.registers, 4u);
+    EXPECT_EQ(swept.cycles.combinational, 7u);
+    EXPECT_EQ(swept.cycles.depth, 3u);
+    EXPECT_EQ(swept.cycles.cycles, static_cast<uint64_t>(cycles));
+    // the logic behind the registers settles in one pass, the event loop only sees the clock
+    EXPECT_LT(swept.events.scheduled, events.events.scheduled);
+    EXPECT_LE(swept.events.evaluated, events.events.evaluated);
+}
+
+TEST(CycleSimulationTest, NativeCounterMatchesEventDriven) {
+#if defined(_WIN32)
+    const bool hasCompiler = std::system("c++ --version > NUL 2>&1") == 0;
+#else
+    const bool hasCompiler = std::system("c++ --version > /dev/null 2>&1") == 0;
+#endif
+    if (!hasCompiler)
+        GTEST_SKIP() << "no c++ compiler on the path";
+
+    auto &engine = SimulationEngine::instance();
+    NativeModelConfig config;
+    config.cacheDirectory = std::filesystem::temp_directory_path() / std::format("bess_native_engine_test_{}", UUID().toString());
+    engine.setNativeModelConfig(config);
+    constexpr int cycles = 20;
+
+    const auto events = countCycles(engine, SimulationMode::eventDriven, false, cycles);
+    const auto native = countCycles(engine, SimulationMode::native, false, cycles);
+    engine.setNativeModelConfig({});
+    std::error_code ec; // loaded libraries cannot be removed everywhere
+    std::filesystem::remove_all(config.cacheDirectory, ec);
+
+    EXPECT_TRUE(native.nativeLoaded) << native.cycles.nativeFallbackReason;
+    EXPECT_TRUE(native.cycles.active) << native.cycles.fallbackReason;
+    EXPECT_TRUE(native.cycles.native) << native.cycles.nativeFallbackReason;
+    EXPECT_EQ(native.cycles.cycles, static_cast<uint64_t>(cycles));
+    ASSERT_EQ(native.values.size(), static_cast<size_t>(cycles));
+    for (int cycle = 0; cycle < cycles; cycle++) {
+        EXPECT_EQ(native.values[cycle], events.values[cycle]) << "cycle " << cycle;
+    }
+}
+
+TEST(CycleSimulationTest, DerivedClockFallsBackToEventDriven) {
+    auto &engine = SimulationEngine::instance();
+    constexpr int cycles = 6;
+
+    const auto result = countCycles(engine, SimulationMode::cycleBased, true, cycles);
+    EXPECT_FALSE(result.cycles.active);
+    EXPECT_NE(result.cycles.fallbackReason.find("Clock"), std::string::npos) << result.cycles.fallbackReason;
+    EXPECT_EQ(result.cycles.sweeps, 0u);
+
+    ASSERT_EQ(result.values.size(), static_cast<size_t>(cycles));
+    for (int cycle = 0; cycle < cycles; cycle++) {
+        EXPECT_EQ(result.values[cycle], static_cast<uint64_t>(cycle + 1)) << "cycle " << cycle;
+    }
+}
+
+TEST(CycleSimulationTest, ScheduleRejectsStateWithoutRegisterTrait) {
+    auto latch = std::make_shared<ComponentDefinition>();
+    latch->setName("Cycle Test Latch");
+    latch->setInputSlotsInfo({SlotsGroupType::input, false, 2, {}, {}});
+    latch->setOutputSlotsInfo({SlotsGroupType::output, false, 1, {}, {}});
+    EXPECT_FALSE(CycleSchedule::isCombinational(*latch));
+
+    latch->addTrait<CombinationalTrait>();
+    EXPECT_TRUE(CycleSchedule::isCombinational(*latch));
+    EXPECT_TRUE(CycleSchedule::isCombinational(*findDefinitionByName("XOR Gate")));
+    EXPECT_TRUE(CycleSchedule::isCombinational(*findDefinitionByName("Output")));
+    EXPECT_FALSE(CycleSchedule::isCombinational(*makeRegisterDefinition()));
+}
@@ -0,0 +1,125 @@
+#include "gtest/gtest.h"
+#include "scheduler/event_scheduler.h"
+#include "scheduler/timing_wheel_scheduler.h"
+#include "types.h"
+#include <cstdint>
+#include <memory>
+#include <random>
+#include <vector>
+
+namespace {
+    using Bess::UUID;
+    using namespace Bess::SimEngine;
+
+    SimulationEvent makeEvent(int64_t t, uint64_t id, uint64_t comp = 1) {
+        return {SimTime(t), UUID(comp), UUID::null, id};
+    }
+
+    std::vector<uint64_t> drainIds(EventScheduler &scheduler) {
+        std::vector<uint64_t> ids;
+        while (!scheduler.empty()) {
+            ids.push_back(scheduler.top().id);
+            scheduler.pop();
+        }
+        return ids;
+    }
+} // namespace
+
+TEST(EventSchedulerTest, OrdersByTimeThenId) {
+    for (const auto type : {EventSchedulerType::orderedSet, EventSchedulerType::timingWheel}) {
+        auto scheduler = EventScheduler::create(type);
+        scheduler->push(makeEvent(10, 4));
+        scheduler->push(makeEvent(5, 3));
+        scheduler->push(makeEvent(10, 1));
+        scheduler->push(makeEvent(5, 7));
+        scheduler->push(makeEvent(100000, 0));
+
+        EXPECT_EQ(scheduler->size(), 5u);
+        EXPECT_EQ(drainIds(*scheduler), (std::vector<uint64_t>{3, 7, 1, 4, 0}));
+        EXPECT_TRUE(scheduler->empty());
+    }
+}
+
+TEST(EventSchedulerTest, TimingWheelHandlesOverflowAndPastEvents) {
+    TimingWheelScheduler wheel(64);
+    wheel.push(makeEvent(1000, 0));
+    wheel.push(makeEvent(10, 1));
+    wheel.push(makeEvent(5000, 2));
+    wheel.push(makeEvent(1010, 3));
+    EXPECT_GT(wheel.getOverflowCount(), 0u);
+
+    EXPECT_EQ(wheel.top().id, 1u);
+    wheel.pop();
+
+    // scheduled behind the current window
+    wheel.push(makeEvent(2, 4));
+    EXPECT_EQ(drainIds(wheel), (std::vector<uint64_t>{4, 0, 3, 2}));
+}
+
+TEST(EventSchedulerTest, EraseIfAndClear) {
+    for (const auto type : {EventSchedulerType::orderedSet, EventSchedulerType::timingWheel}) {
+        auto scheduler = EventScheduler::create(type);
+        for (uint64_t i = 0; i < 20; i++) {
+            scheduler->push(makeEvent(static_cast<int64_t>(i * 997 % 50000), i, i % 3));
+        }
+
+        const size_t removed = scheduler->eraseIf([](const SimulationEvent &ev) {
+            return ev.compId == UUID(1);
+        });
+        EXPECT_EQ(removed, 7u);
+        EXPECT_EQ(scheduler->size(), 13u);
+
+        SimTime last{-1};
+        while (!scheduler->empty()) {
+            EXPECT_NE(scheduler->top().compId, UUID(1));
+            EXPECT_GE(scheduler->top().simTime, last);
+            last = scheduler->top().simTime;
+            scheduler->pop();
+        }
+
+        scheduler->push(makeEvent(3, 100));
+        scheduler->clear();
+        EXPECT_TRUE(scheduler->empty());
+        EXPECT_EQ(scheduler->size(), 0u);
+    }
+}
+
+TEST(EventSchedulerTest, TimingWheelMatchesOrderedSetOnRandomWorkload) {
+    OrderedSetScheduler reference;
+    TimingWheelScheduler wheel(256);
+
+    std::mt19937_64 rng(7);
+    std::uniform_int_distribution<int> op(0, 99);
+    std::uniform_int_distribution<int64_t> shortDelay(0, 300);
+    std::uniform_int_distribution<int64_t> longDelay(0, 20000);
+    uint64_t nextId = 0;
+    int64_t now = 0;
+
+    for (int i = 0; i < 200000; i++) {
+        const int choice = op(rng);
+        if (choice < 55 || reference.empty()) {
+            int64_t t = now + (choice % 5 == 0 ? longDelay(rng) : shortDelay(rng));
+            if (choice == 1) {
+                t = std::max<int64_t>(0, now - 10);
+            }
+            // ids are mostly increasing, but not always
+            const uint64_t id = choice == 2 ? nextId + 1000000 : nextId;
+            nextId++;
+            reference.push(makeEvent(t, id, id % 17));
+            wheel.push(makeEvent(t, id, id % 17));
+        } else if (choice < 98) {
+            ASSERT_EQ(reference.top().id, wheel.top().id);
+            ASSERT_EQ(reference.top().simTime, wheel.top().simTime);
+            now = reference.top().simTime.count();
+            reference.pop();
+            wheel.pop();
+        } else {
+            const UUID target(nextId % 17);
+            const auto pred = [target](const SimulationEvent &ev) { return ev.compId == target; };
+            ASSERT_EQ(reference.eraseIf(pred), wheel.eraseIf(pred));
+        }
+        ASSERT_EQ(reference.size(), wheel.size());
+    }
+
+    EXPECT_EQ(drainIds(reference), drainIds(wheel));
+}
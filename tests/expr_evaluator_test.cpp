@@ -0,0 +1,145 @@
+#include "component_definition.h"
+#include "expression_evalutator/compiled_expression.h"
+#include "expression_evalutator/expr_evaluator.h"
+#include "gtest/gtest.h"
+#include "types.h"
+#include <any>
+#include <bit>
+#include <cstdint>
+#include <format>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace {
+    using namespace Bess::SimEngine;
+    using namespace Bess::SimEngine::ExprEval;
+
+    std::vector<SlotState> toSlots(uint64_t pattern, size_t count) {
+        std::vector<SlotState> slots(count);
+        for (size_t i = 0; i < count; i++) {
+            slots[i].state = ((pattern >> i) & 1) ? LogicState::high : LogicState::low;
+        }
+        return slots;
+    }
+
+    std::vector<bool> toBools(uint64_t pattern, size_t count) {
+        std::vector<bool> values(count);
+        for (size_t i = 0; i < count; i++) {
+            values[i] = (pattern >> i) & 1;
+        }
+        return values;
+    }
+
+    // single digit indices only, so the legacy evaluator can be used as reference
+    const std::vector<std::string> referenceExpressions = {
+        "0",
+        "!0",
+        "$0",
+        "0*1",
+        "0+1*2",
+        "(0+1)*2",
+        "0^1^2",
+        "!(0*1)",
+        "!0*1",
+        "!!0+$1",
+        "0+1^2*3",
+        "!(0^1) * (2 + !3)",
+        "((0*1)+(2*3))^(4+5*!6)",
+        "0*1*2*3*4*5*6*7*8*9",
+    };
+} // namespace
+
+TEST(ExprEvalTest, CompiledMatchesInterpreterOnAllPatterns) {
+    for (const auto &expr : referenceExpressions) {
+        const auto compiled = CompiledExpression::compile(expr);
+        EXPECT_TRUE(compiled.isTruthTable()) << expr;
+
+        const size_t n = compiled.getInputCount();
+        for (uint64_t pattern = 0; pattern < (uint64_t{1} << n); pattern++) {
+            const auto slots = toSlots(pattern, n);
+            ASSERT_EQ(compiled.evaluate(slots), evaluateExpression(expr, toBools(pattern, n)))
+                << expr << " pattern " << pattern;
+        }
+    }
+}
+
+TEST(ExprEvalTest, WideExpressionsUseMultiDigitIndicesAndBytecode) {
+    std::string andAll = "0";
+    std::string xorAll = "0";
+    for (int i = 1; i < 20; i++) {
+        andAll += std::format("*{}", i);
+        xorAll += std::format("^{}", i);
+    }
+
+    const auto andExpr = CompiledExpression::compile(andAll);
+    const auto xorExpr = CompiledExpression::compile(xorAll);
+    EXPECT_EQ(andExpr.getInputCount(), 20u);
+    EXPECT_FALSE(andExpr.isTruthTable());
+
+    std::mt19937_64 rng(7);
+    for (int iter = 0; iter < 1000; iter++) {
+        const uint64_t pattern = iter == 0 ? 0xFFFFF : rng() & 0xFFFFF;
+        const auto slots = toSlots(pattern, 20);
+        EXPECT_EQ(andExpr.evaluate(slots), pattern == 0xFFFFF);
+        EXPECT_EQ(xorExpr.evaluate(slots), std::popcount(pattern) % 2 == 1);
+    }
+
+    // 16 inputs still fit the truth table, index 15 has two digits
+    const auto table = CompiledExpression::compile("!(15 * 0) + 10");
+    EXPECT_TRUE(table.isTruthTable());
+    EXPECT_EQ(table.getInputCount(), 16u);
+    EXPECT_FALSE(table.evaluate(toSlots((1 << 15) | 1, 16)));
+    EXPECT_TRUE(table.evaluate(toSlots((1 << 15) | 1 | (1 << 10), 16)));
+}
+
+TEST(ExprEvalTest, RejectsMalformedExpressions) {
+    for (const std::string expr : {"", "0*", "*0", "(0+1", "0+1)", "0 a 1", "!"}) {
+        EXPECT_THROW(CompiledExpression::compile(expr), std::runtime_error) << expr;
+    }
+
+    const auto compiled = compileExpressions({"0*1", "0+"});
+    EXPECT_TRUE(compiled.compiled.empty());
+    EXPECT_FALSE(compiled.error.empty());
+
+    const auto expr = CompiledExpression::compile("0*3");
+    EXPECT_THROW(expr.evaluate(toSlots(0, 2)), std::out_of_range);
+}
+
+TEST(ExprEvalTest, DefinitionCompilesExpressionsOnChange) {
+    ComponentDefinition def;
+    def.setInputSlotsInfo({SlotsGroupType::input, true, 12, {}, {}});
+    def.setOutputSlotsInfo({SlotsGroupType::output, false, 1, {}, {}});
+    def.setOutputExpressions({"11 * !10"});
+
+    std::any aux = def.getAuxData();
+    ASSERT_EQ(aux.type(), typeid(CompiledExpressions));
+    EXPECT_EQ(std::any_cast<const CompiledExpressions &>(aux).expressions.front(), "11 * !10");
+
+    ComponentState state;
+    state.outputStates = {{LogicState::low, SimTime(0)}};
+    state.auxData = &aux;
+
+    auto inputs = toSlots(1 << 11, 12);
+    auto next = exprEvalSimFunc(inputs, SimTime(4), state);
+    EXPECT_TRUE(next.isChanged);
+    EXPECT_EQ(next.outputStates[0].state, LogicState::high);
+    EXPECT_EQ(next.outputStates[0].lastChangeTime, SimTime(4));
+
+    inputs[10].state = LogicState::high;
+    next = exprEvalSimFunc(inputs, SimTime(5), next);
+    EXPECT_TRUE(next.isChanged);
+    EXPECT_EQ(next.outputStates[0].state, LogicState::low);
+
+    // legacy aux data holding raw expression strings still evaluates
+    std::any raw = std::vector<std::string>{"0 ^ 1"};
+    state.auxData = &raw;
+    next = exprEvalSimFunc(toSlots(0b01, 2), SimTime(1), state);
+    EXPECT_EQ(next.outputStates[0].state, LogicState::high);
+    EXPECT_NE(std::any_cast<CompiledExpressions>(&raw), nullptr) << "compiled once, on the first call";
+
+    ComponentDefinition legacyDef;
+    legacyDef.setAuxData(std::vector<std::string>{"0 * 1"});
+    EXPECT_NE(std::any_cast<CompiledExpressions>(&legacyDef.getAuxData()), nullptr);
+}
@@ -0,0 +1,109 @@
+#include "gtest/gtest.h"
+#include "packed_state/logic_vector.h"
+#include "types.h"
+#include <array>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace {
+    using namespace Bess::SimEngine;
+    using namespace std::chrono_literals;
+
+    constexpr std::array<LogicState, 4> allStates{LogicState::low, LogicState::high, LogicState::unknown,
+                                                  LogicState::high_z};
+
+    ComponentState makeState(size_t inputs, size_t outputs) {
+        ComponentState state;
+        for (size_t i = 0; i < inputs; i++) {
+            state.inputStates.emplace_back(allStates[i % 4], SimTime(i * 10));
+            state.inputConnected.push_back(i % 3 == 0);
+        }
+        for (size_t i = 0; i < outputs; i++) {
+            state.outputStates.emplace_back(allStates[(i + 1) % 4], SimTime(i * 7 + 1));
+            state.outputConnected.push_back(i % 2 == 0);
+        }
+        state.isChanged = true;
+        return state;
+    }
+
+    void expectSameSlots(const std::vector<SlotState> &a, const std::vector<SlotState> &b) {
+        ASSERT_EQ(a.size(), b.size());
+        for (size_t i = 0; i < a.size(); i++) {
+            EXPECT_EQ(a[i].state, b[i].state) << "slot " << i;
+            EXPECT_EQ(a[i].lastChangeTime, b[i].lastChangeTime) << "slot " << i;
+        }
+    }
+} // namespace
+
+TEST(LogicVectorTest, EncodesFourStatesInValueAndStrengthPlanes) {
+    LogicVector vector(4);
+    for (size_t i = 0; i < allStates.size(); i++) {
+        vector.set(i, allStates[i]);
+    }
+    for (size_t i = 0; i < allStates.size(); i++) {
+        EXPECT_EQ(vector.get(i), allStates[i]);
+    }
+    // low 00, high 10, unknown 11, high_z 01
+    ASSERT_EQ(vector.getWords().size(), 2u);
+    EXPECT_EQ(vector.getWords()[0], 0b0110u);
+    EXPECT_EQ(vector.getWords()[1], 0b1100u);
+    EXPECT_FALSE(vector.isKnown());
+
+    vector.set(2, LogicState::high);
+    vector.set(3, LogicState::low);
+    EXPECT_TRUE(vector.isKnown());
+}
+
+TEST(LogicVectorTest, ResizeFillAndCompareAcrossWords) {
+    LogicVector a(130, LogicState::unknown);
+    EXPECT_EQ(a.size(), 130u);
+    EXPECT_EQ(a.getWords().size(), 6u);
+    EXPECT_EQ(a.get(129), LogicState::unknown);
+
+    a.resize(65);
+    LogicVector b(65, LogicState::unknown);
+    EXPECT_EQ(a, b);
+
+    a.fill(LogicState::high);
+    b.resize(0);
+    b.resize(65, LogicState::high);
+    EXPECT_EQ(a, b);
+
+    b.set(64, LogicState::high_z);
+    EXPECT_FALSE(a == b);
+}
+
+TEST(LogicVectorTest, RoundTripsSlotStates) {
+    const auto state = makeState(70, 0);
+    LogicVector vector;
+    vector.assign(state.inputStates);
+    EXPECT_EQ(vector.size(), 70u);
+
+    std::vector<SlotState> slots(70);
+    vector.copyTo(slots);
+    for (size_t i = 0; i < slots.size(); i++) {
+        EXPECT_EQ(slots[i].state, state.inputStates[i].state);
+        EXPECT_EQ(slots[i].lastChangeTime, SimTime{0});
+    }
+}
+
+TEST(ComponentStateTest, ErrorSurvivesTheProjectJson) {
+    auto state = makeState(1, 1);
+    state.simError = std::make_shared<const std::string>("bad input");
+
+    Json::Value j;
+    Bess::JsonConvert::toJsonValue(state, j);
+    EXPECT_TRUE(j["simError"].asBool());
+    EXPECT_EQ(j["errorMessage"].asString(), "bad input");
+
+    ComponentState restored;
+    Bess::JsonConvert::fromJsonValue(j, restored);
+    ASSERT_TRUE(restored.simError);
+    EXPECT_EQ(*restored.simError, "bad input");
+    expectSameSlots(restored.inputStates, state.inputStates);
+
+    j["simError"] = false;
+    Bess::JsonConvert::fromJsonValue(j, restored);
+    EXPECT_FALSE(restored.simError);
+}
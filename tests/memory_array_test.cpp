@@ -0,0 +1,95 @@
+#include "checkpoint/sim_checkpoint.h"
+#include "gtest/gtest.h"
+#include "memory/memory_array.h"
+#include <array>
+#include <cstdint>
+#include <stdexcept>
+#include <string>
+
+namespace {
+    using namespace Bess::SimEngine;
+} // namespace
+
+TEST(MemoryArrayTest, UnwrittenEntriesReadZeroAndStorageGrowsOnlyAsWritten) {
+    MemoryArray memory(8, 1 << 16);
+    EXPECT_EQ(memory.getWordsPerEntry(), 1u);
+    EXPECT_EQ(memory.getAllocatedDepth(), 0u);
+    EXPECT_EQ(memory.readWord(1234), 0u);
+
+    memory.writeWord(3, 0xab);
+    EXPECT_EQ(memory.readWord(3), 0xabu);
+    EXPECT_EQ(memory.readWord(2), 0u);
+    EXPECT_LT(memory.getAllocatedDepth(), 16u);
+
+    // writes past the depth are dropped
+    memory.writeWord(1 << 16, 0xff);
+    EXPECT_EQ(memory.readWord(1 << 16), 0u);
+    EXPECT_LE(memory.getAllocatedDepth(), memory.getDepth());
+}
+
+TEST(MemoryArrayTest, MaskedWritesKeepOtherBitsAndStayInsideTheWidth) {
+    MemoryArray memory(12, 4);
+    memory.writeWord(1, 0xfff);
+    memory.writeWord(1, 0x000, 0x0f0);
+    EXPECT_EQ(memory.readWord(1), 0xf0fu);
+
+    // bits above the width are never stored
+    memory.writeWord(2, ~uint64_t{0});
+    EXPECT_EQ(memory.readWord(2), 0xfffu);
+}
+
+TEST(MemoryArrayTest, WideEntriesSpanSeveralWords) {
+    MemoryArray memory(100, 8);
+    ASSERT_EQ(memory.getWordsPerEntry(), 2u);
+
+    const std::array<uint64_t, 2> data{0x0123456789abcdefULL, 0xfffffffffULL};
+    const std::array<uint64_t, 2> all{~uint64_t{0}, ~uint64_t{0}};
+    memory.write(5, data, all);
+    auto entry = memory.read(5);
+    ASSERT_EQ(entry.size(), 2u);
+    EXPECT_EQ(entry[0], data[0]);
+    EXPECT_EQ(entry[1], data[1]);
+
+    const std::array<uint64_t, 2> zeros{0, 0};
+    const std::array<uint64_t, 2> upperOnly{0, ~uint64_t{0}};
+    memory.write(5, zeros, upperOnly);
+    entry = memory.read(5);
+    EXPECT_EQ(entry[0], data[0]);
+    EXPECT_EQ(entry[1], 0u);
+}
+
+TEST(MemoryArrayTest, LoadsYosysInitWithEntryZeroLast) {
+    MemoryArray memory(4, 4);
+    memory.writeWord(3, 0x9);
+
+    // entries 2, 1, 0, the x bit of entry 1 loads as 0
+    memory.loadInit("1010" "01x1" "0011");
+    EXPECT_EQ(memory.readWord(0), 0x3u);
+    EXPECT_EQ(memory.readWord(1), 0x5u);
+    EXPECT_EQ(memory.readWord(2), 0xau);
+    EXPECT_EQ(memory.readWord(3), 0x9u) << "entries past the INIT string are left alone";
+}
+
+TEST(MemoryArrayTest, CheckpointRoundTripsTheContent) {
+    MemoryArray memory(16, 1024);
+    for (size_t address = 0; address < 300; address += 3) {
+        memory.writeWord(address, address * 7);
+    }
+
+    CheckpointWriter writer;
+    memory.writeCheckpoint(writer);
+
+    MemoryArray restored(16, 1024);
+    restored.writeWord(1000, 1);
+    CheckpointReader reader(writer.getData());
+    restored.readCheckpoint(reader);
+    EXPECT_TRUE(reader.atEnd());
+    for (size_t address = 0; address < 300; address++) {
+        EXPECT_EQ(restored.readWord(address), memory.readWord(address)) << "address " << address;
+    }
+    EXPECT_EQ(restored.readWord(1000), 0u);
+
+    MemoryArray narrower(8, 1024);
+    CheckpointReader again(writer.getData());
+    EXPECT_THROW(narrower.readCheckpoint(again), std::runtime_error);
+}
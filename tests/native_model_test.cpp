@@ -0,0 +1,182 @@
+#include "common/bess_uuid.h"
+#include "component_definition.h"
+#include "digital_component.h"
+#include "gtest/gtest.h"
+#include "native/native_model.h"
+#include "netlist/compiled_netlist.h"
+#include "netlist/cycle_schedule.h"
+#include "sim_engine_state.h"
+#include "sim_engine_test_fixture.h"
+#include "types.h"
+#include <cstdlib>
+#include <filesystem>
+#include <format>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <system_error>
+#include <vector>
+
+namespace {
+    using namespace Bess::SimEngine;
+    using namespace Bess::Tests;
+
+    bool hasCompiler() {
+#if defined(_WIN32)
+        return std::system("c++ --version > NUL 2>&1") == 0;
+#else
+        return std::system("c++ --version > /dev/null 2>&1") == 0;
+#endif
+    }
+
+    // sources a, b, c; expr = {a ^ b, !(a * b)}; nor = NOR(expr.0, expr.1, c) into an output
+    struct Circuit {
+        SimEngineState state;
+        std::shared_ptr<DigitalComponent> a, b, c, expr, nor, out;
+        CompiledNetlist netlist;
+        CycleSchedule schedule;
+
+        Circuit() {
+            const auto source = makeDefinition("Test Source", 0, 1);
+            a = addComponent(state, source);
+            b = addComponent(state, source);
+            c = addComponent(state, source);
+
+            const auto exprDef = makeDefinition("Test Expressions", 2, 2);
+            exprDef->setOutputExpressions({"0^1", "!(0*1)"});
+            expr = addComponent(state, exprDef);
+
+            const auto norDef = makeDefinition("Test NOR", 3, 1);
+            norDef->setOpInfo({'+', true});
+            nor = addComponent(state, norDef);
+
+            const auto outDef = makeDefinition("Test Output", 1, 0);
+            outDef->setBehaviorType(ComponentBehaviorType::output);
+            out = addComponent(state, outDef);
+
+            connect(*a, 0, *expr, 0);
+            connect(*b, 0, *expr, 1);
+            connect(*expr, 0, *nor, 0);
+            connect(*expr, 1, *nor, 1);
+            connect(*c, 0, *nor, 2);
+            connect(*nor, 0, *out, 0);
+        }
+
+        void compile() {
+            netlist.compile(state);
+            ASSERT_TRUE(schedule.build(netlist)) << schedule.getFallbackReason();
+        }
+
+        uint32_t net(const NativeModelSource &source, const DigitalComponent &comp, size_t slot = 0) const {
+            return source.outputNetBegin[netlist.indexOf(comp.id)] + static_cast<uint32_t>(slot);
+        }
+    };
+} // namespace
+
+TEST(NativeModelTest, GeneratesOneBlockPerLevelWithInlinedExpressions) {
+    Circuit circuit;
+    circuit.compile();
+    const auto source = NativeModel::generate(circuit.netlist, circuit.schedule);
+
+    EXPECT_EQ(source.netlistVersion, circuit.netlist.getCompiledVersion());
+    EXPECT_EQ(source.combinational, 2u) << "the output component computes nothing";
+    EXPECT_EQ(source.blocks, 2u);
+    EXPECT_EQ(source.outputNetBegin.back(), 6u);
+
+    const auto a = circuit.net(source, *circuit.a);
+    const auto b = circuit.net(source, *circuit.b);
+    const auto c = circuit.net(source, *circuit.c);
+    EXPECT_NE(source.code.find(std::format("(v[{}] ^ v[{}])", a, b)), std::string::npos) << source.code;
+    EXPECT_NE(source.code.find(std::format("((v[{}] & v[{}]) ^ 1)", a, b)), std::string::npos) << source.code;
+    EXPECT_NE(source.code.find(std::format("((v[{}] | v[{}] | v[{}]) ^ 1)", circuit.net(source, *circuit.expr, 0),
+                                           circuit.net(source, *circuit.expr, 1), c)),
+              std::string::npos)
+        << source.code;
+
+    // equal netlists give equal code, so they share a cached library
+    EXPECT_EQ(NativeModel::generate(circuit.netlist, circuit.schedule).hash, source.hash);
+}
+
+TEST(NativeModelTest, RejectsLogicWithoutNativeForm) {
+    Circuit circuit;
+    const auto custom = makeDefinition("Hand Written Cell", 1, 1);
+    custom->addTrait<CombinationalTrait>();
+    auto cell = addComponent(circuit.state, custom);
+    connect(*circuit.a, 0, *cell, 0);
+    circuit.compile();
+
+    try {
+        NativeModel::generate(circuit.netlist, circuit.schedule);
+        FAIL() << "expected the cell to be rejected";
+    } catch (const std::runtime_error &ex) {
+        EXPECT_NE(std::string(ex.what()).find("Hand Written Cell"), std::string::npos) << ex.what();
+    }
+}
+
+TEST(NativeModelTest, CompiledModelReportsChangedComponentsAndIsCached) {
+    if (!hasCompiler())
+        GTEST_SKIP() << "no c++ compiler on the path";
+
+    Circuit circuit;
+    circuit.compile();
+    NativeModelConfig config;
+    // per run, a directory another account left behind would be refused
+    config.cacheDirectory = std::filesystem::temp_directory_path() / std::format("bess_native_test_{}", Bess::UUID().toString());
+
+    const auto model = NativeModel::load(NativeModel::generate(circuit.netlist, circuit.schedule), config);
+    ASSERT_TRUE(model);
+    EXPECT_FALSE(model->wasCached());
+    EXPECT_TRUE(std::filesystem::exists(NativeModel::getLibraryPath(model->getSource(), config)));
+    for (const auto &entry : std::filesystem::directory_iterator(config.cacheDirectory)) {
+        EXPECT_NE(entry.path().extension(), ".tmp") << "build files are renamed into place";
+    }
+
+    const auto &source = model->getSource();
+    const auto exprIdx = circuit.netlist.indexOf(circuit.expr->id);
+    const auto norIdx = circuit.netlist.indexOf(circuit.nor->id);
+    std::vector<uint8_t> nets(model->getNetCount(), 0);
+    std::vector<uint32_t> changed(source.combinational);
+    const auto evaluate = [&](uint8_t a, uint8_t b, uint8_t c) {
+        nets[circuit.net(source, *circuit.a)] = a;
+        nets[circuit.net(source, *circuit.b)] = b;
+        nets[circuit.net(source, *circuit.c)] = c;
+        return model->evaluate(nets.data(), changed.data());
+    };
+
+    // a ^ b and !(a * b) go high, the nor stays low
+    ASSERT_EQ(evaluate(1, 0, 0), 1u);
+    EXPECT_EQ(changed[0], exprIdx);
+    EXPECT_EQ(nets[circuit.net(source, *circuit.nor)], 0);
+
+    EXPECT_EQ(evaluate(0, 1, 0), 0u) << "same outputs, nothing to write back";
+
+    ASSERT_EQ(evaluate(1, 1, 0), 2u);
+    EXPECT_EQ(changed[0], exprIdx);
+    EXPECT_EQ(changed[1], norIdx);
+    EXPECT_EQ(nets[circuit.net(source, *circuit.nor)], 1);
+
+    ASSERT_EQ(evaluate(1, 1, 1), 1u);
+    EXPECT_EQ(changed[0], norIdx);
+
+    const auto again = NativeModel::load(NativeModel::generate(circuit.netlist, circuit.schedule), config);
+    EXPECT_TRUE(again->wasCached());
+    std::error_code ec; // loaded libraries cannot be removed everywhere
+    std::filesystem::remove_all(config.cacheDirectory, ec);
+}
+
+#if !defined(_WIN32)
+TEST(NativeModelTest, RefusesCacheWritableByOthers) {
+    Circuit circuit;
+    circuit.compile();
+    NativeModelConfig config;
+    config.cacheDirectory = std::filesystem::temp_directory_path() / std::format("bess_native_shared_test_{}", Bess::UUID().toString());
+    std::filesystem::create_directories(config.cacheDirectory);
+    std::filesystem::permissions(config.cacheDirectory, std::filesystem::perms::all,
+                                 std::filesystem::perm_options::replace);
+
+    // anyone could have put a library there, nothing is compiled or loaded
+    EXPECT_THROW(NativeModel::load(NativeModel::generate(circuit.netlist, circuit.schedule), config),
+                 std::runtime_error);
+    std::filesystem::remove_all(config.cacheDirectory);
+}
+#endif
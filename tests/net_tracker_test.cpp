@@ -0,0 +1,207 @@
+#include "component_definition.h"
+#include "gtest/gtest.h"
+#include "net/net_tracker.h"
+#include "sim_engine_test_fixture.h"
+#include "simulation_engine.h"
+#include "types.h"
+#include <algorithm>
+#include <random>
+#include <ranges>
+#include <unordered_map>
+#include <vector>
+
+namespace {
+    using Bess::UUID;
+    using namespace Bess::SimEngine;
+    using namespace Bess::Tests;
+
+    std::vector<UUID> addComponents(NetTracker &tracker, size_t count) {
+        std::vector<UUID> comps;
+        for (size_t i = 0; i < count; i++) {
+            comps.emplace_back(i + 1);
+            tracker.addComponent(comps.back());
+        }
+        return comps;
+    }
+
+    // components reachable from comp over wires, the reference for the tracker
+    std::vector<uint64_t> reachable(const std::vector<std::pair<UUID, UUID>> &wires, UUID comp) {
+        std::vector<uint64_t> found{comp};
+        for (size_t i = 0; i < found.size(); i++) {
+            for (const auto &[a, b] : wires) {
+                const uint64_t wa = a, wb = b;
+                const uint64_t other = wa == found[i] ? wb : (wb == found[i] ? wa : 0);
+                if (other != 0 && std::ranges::find(found, other) == found.end())
+                    found.push_back(other);
+            }
+        }
+        std::ranges::sort(found);
+        return found;
+    }
+
+    std::vector<uint64_t> sortedMembers(const Net &net) {
+        std::vector<uint64_t> members(net.getComponents().begin(), net.getComponents().end());
+        std::ranges::sort(members);
+        return members;
+    }
+} // namespace
+
+TEST(NetTrackerTest, ConnectMergesIntoTheLargerNet) {
+    NetTracker tracker;
+    const auto comps = addComponents(tracker, 4);
+    EXPECT_EQ(tracker.getNets().size(), 4u);
+
+    tracker.connect(comps[0], comps[1]);
+    const auto larger = tracker.getNetOf(comps[0]);
+    EXPECT_TRUE(tracker.connect(comps[2], comps[1]));
+    EXPECT_EQ(tracker.getNetOf(comps[2]), larger);
+    EXPECT_TRUE(tracker.isSameNet(comps[0], comps[2]));
+    EXPECT_FALSE(tracker.isSameNet(comps[0], comps[3]));
+    // a second wire in the same net merges nothing
+    EXPECT_FALSE(tracker.connect(comps[0], comps[2]));
+
+    const auto &nets = tracker.getNets();
+    ASSERT_EQ(nets.size(), 2u);
+    EXPECT_EQ(sortedMembers(nets.at(larger)), (std::vector<uint64_t>{1, 2, 3}));
+}
+
+TEST(NetTrackerTest, DisconnectSplitsLazilyAndKeepsTheIdOnTheLargestPart) {
+    NetTracker tracker;
+    const auto comps = addComponents(tracker, 5);
+    for (size_t i = 0; i + 1 < comps.size(); i++) {
+        tracker.connect(comps[i], comps[i + 1]);
+    }
+    const auto net = tracker.getNetOf(comps[0]);
+    tracker.getNets();
+
+    const auto generation = tracker.getGeneration();
+    tracker.disconnect(comps[1], comps[2]);
+    EXPECT_GT(tracker.getGeneration(), generation);
+
+    EXPECT_EQ(tracker.getNetOf(comps[4]), net);
+    EXPECT_NE(tracker.getNetOf(comps[0]), net);
+    EXPECT_TRUE(tracker.isSameNet(comps[0], comps[1]));
+    EXPECT_FALSE(tracker.isSameNet(comps[1], comps[2]));
+
+    std::vector<UUID> changed;
+    const auto &nets = tracker.getNets(&changed);
+    EXPECT_EQ(nets.size(), 2u);
+    EXPECT_EQ(changed.size(), 2u);
+    EXPECT_EQ(sortedMembers(nets.at(net)), (std::vector<uint64_t>{3, 4, 5}));
+}
+
+TEST(NetTrackerTest, ParallelWiresKeepTheNetTogether) {
+    NetTracker tracker;
+    const auto comps = addComponents(tracker, 2);
+    tracker.connect(comps[0], comps[1]);
+    tracker.connect(comps[1], comps[0]);
+
+    tracker.disconnect(comps[0], comps[1]);
+    EXPECT_TRUE(tracker.isSameNet(comps[0], comps[1]));
+    tracker.disconnect(comps[0], comps[1]);
+    EXPECT_FALSE(tracker.isSameNet(comps[0], comps[1]));
+}
+
+TEST(NetTrackerTest, RemovingAComponentSplitsAndDropsEmptyNets) {
+    NetTracker tracker;
+    const auto comps = addComponents(tracker, 4);
+    // a star around comps[0]
+    for (size_t i = 1; i < comps.size(); i++) {
+        tracker.connect(comps[0], comps[i]);
+    }
+    ASSERT_EQ(tracker.getNets().size(), 1u);
+
+    tracker.removeComponent(comps[0]);
+    EXPECT_FALSE(tracker.contains(comps[0]));
+    EXPECT_EQ(tracker.getNetOf(comps[0]), UUID::null);
+    const auto &nets = tracker.getNets();
+    EXPECT_EQ(nets.size(), 3u);
+    for (const auto &[id, net] : nets) {
+        EXPECT_EQ(net.size(), 1u);
+    }
+
+    tracker.removeComponent(comps[1]);
+    EXPECT_EQ(tracker.getNets().size(), 2u);
+    EXPECT_EQ(tracker.getComponentCount(), 2u);
+
+    // freed nodes are reused by new components
+    tracker.addComponent(UUID(100));
+    tracker.connect(UUID(100), comps[2]);
+    EXPECT_TRUE(tracker.isSameNet(UUID(100), comps[2]));
+    EXPECT_EQ(tracker.getNets().size(), 2u);
+}
+
+TEST(NetTrackerTest, MatchesAReachabilityWalkUnderRandomEdits) {
+    NetTracker tracker;
+    auto comps = addComponents(tracker, 40);
+    std::vector<std::pair<UUID, UUID>> wires;
+    std::mt19937 rng(7);
+
+    for (int step = 0; step < 2000; step++) {
+        const auto action = rng() % 10;
+        if (action < 6 || wires.empty()) {
+            const auto a = comps[rng() % comps.size()];
+            const auto b = comps[rng() % comps.size()];
+            if (a == b)
+                continue;
+            tracker.connect(a, b);
+            wires.emplace_back(a, b);
+        } else if (action < 9) {
+            const auto wire = rng() % wires.size();
+            tracker.disconnect(wires[wire].first, wires[wire].second);
+            wires.erase(wires.begin() + static_cast<std::ptrdiff_t>(wire));
+        } else {
+            const auto index = rng() % comps.size();
+            const auto comp = comps[index];
+            tracker.removeComponent(comp);
+            std::erase_if(wires, [&](const auto &w) { return w.first == comp || w.second == comp; });
+            comps[index] = UUID(1000 + step);
+            tracker.addComponent(comps[index]);
+        }
+
+        // check both query paths, the nets map only every few steps so splits pile up
+        const auto probe = comps[rng() % comps.size()];
+        const auto expected = reachable(wires, probe);
+        for (const auto other : expected) {
+            ASSERT_TRUE(tracker.isSameNet(probe, other)) << "step " << step;
+        }
+        if (step % 7 == 0) {
+            const auto &nets = tracker.getNets();
+            ASSERT_EQ(sortedMembers(nets.at(tracker.getNetOf(probe))), expected) << "step " << step;
+            size_t total = 0;
+            for (const auto &[id, net] : nets) {
+                total += net.size();
+            }
+            ASSERT_EQ(total, comps.size()) << "step " << step;
+        }
+    }
+}
+
+TEST(NetTrackerEngineTest, DeletingAWireSplitsTheEngineNets) {
+    auto &engine = SimulationEngine::instance();
+    engine.setSimulationState(SimulationState::paused);
+    engine.clear();
+
+    const auto input = engine.addComponent(findDefinitionByName("Input"));
+    const auto gate = engine.addComponent(findDefinitionByName("NOT Gate"));
+    const auto output = engine.addComponent(findDefinitionByName("Output"));
+    ASSERT_TRUE(engine.connectComponent(input, 0, SlotType::digitalOutput, gate, 0, SlotType::digitalInput));
+    ASSERT_TRUE(engine.connectComponent(gate, 0, SlotType::digitalOutput, output, 0, SlotType::digitalInput));
+
+    EXPECT_TRUE(engine.isNetUpdated());
+    const auto net = engine.getNetOf(gate);
+    EXPECT_EQ(engine.getNetsMap().size(), 1u);
+    EXPECT_FALSE(engine.isNetUpdated());
+    EXPECT_EQ(engine.getDigitalComponent(input)->netUuid, net);
+
+    engine.deleteConnection(gate, SlotType::digitalOutput, 0, output, SlotType::digitalInput, 0);
+    EXPECT_TRUE(engine.isNetUpdated());
+    EXPECT_EQ(engine.getNetsMap().size(), 2u);
+    EXPECT_EQ(engine.getDigitalComponent(gate)->netUuid, net);
+    EXPECT_NE(engine.getDigitalComponent(output)->netUuid, net);
+
+    engine.deleteComponent(gate);
+    EXPECT_EQ(engine.getNetsMap().size(), 2u);
+    EXPECT_NE(engine.getNetOf(input), engine.getNetOf(output));
+    engine.clear();
+}
@@ -0,0 +1,176 @@
+#include "component_definition.h"
+#include "gtest/gtest.h"
+#include "parallel/work_stealing_pool.h"
+#include "sim_engine_test_fixture.h"
+#include "simulation_engine.h"
+#include "types.h"
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <random>
+#include <thread>
+#include <vector>
+
+using namespace std::chrono_literals;
+
+namespace {
+    using Bess::UUID;
+    using namespace Bess::SimEngine;
+    using namespace Bess::Tests;
+
+    // by-value xor, not parallel safe, so it is simulated in the merge loop
+    std::shared_ptr<ComponentDefinition> makeLegacyXorDefinition() {
+        auto def = std::make_shared<ComponentDefinition>();
+        def->setName("Legacy XOR");
+        def->setGroupName("Tests");
+        def->setInputSlotsInfo({SlotsGroupType::input, false, 2, {}, {}});
+        def->setOutputSlotsInfo({SlotsGroupType::output, false, 1, {}, {}});
+        def->setSimDelay(SimDelayNanoSeconds(3));
+        def->setSimulationFunction([](const std::vector<SlotState> &inputs, SimTime ts,
+                                      const ComponentState &prev) {
+            auto next = prev;
+            next.inputStates = inputs;
+            const auto value = (inputs[0].state == LogicState::high) != (inputs[1].state == LogicState::high)
+                                   ? LogicState::high
+                                   : LogicState::low;
+            next.isChanged = prev.outputStates[0].state != value;
+            if (next.isChanged)
+                next.outputStates[0] = {value, ts};
+            return next;
+        });
+        return def;
+    }
+
+    struct Circuit {
+        std::vector<UUID> inputs;
+        std::vector<UUID> components; // every component, in creation order
+    };
+
+    // width inputs feeding `depth` layers of randomly wired gates
+    Circuit buildRandomCircuit(SimulationEngine &engine, size_t width, size_t depth, uint32_t seed,
+                               bool withLegacy) {
+        const std::vector<std::shared_ptr<ComponentDefinition>> gates = {
+            findDefinitionByName("AND Gate"),
+            findDefinitionByName("OR Gate"),
+            findDefinitionByName("XOR Gate"),
+            findDefinitionByName("NAND Gate"),
+            findDefinitionByName("XNOR Gate"),
+        };
+        const auto legacy = makeLegacyXorDefinition();
+        const auto inputDef = findDefinitionByName("Input");
+
+        std::mt19937 rng(seed);
+        Circuit circuit;
+        for (size_t i = 0; i < width; i++) {
+            circuit.inputs.push_back(engine.addComponent(inputDef));
+        }
+        circuit.components = circuit.inputs;
+
+        std::vector<UUID> previous = circuit.inputs;
+        for (size_t layer = 0; layer < depth; layer++) {
+            std::vector<UUID> current;
+            for (size_t i = 0; i < width; i++) {
+                const auto &def = withLegacy && i % 7 == 3 ? legacy : gates[rng() % gates.size()];
+                const auto gate = engine.addComponent(def);
+                engine.connectComponent(previous[i], 0, SlotType::digitalOutput, gate, 0, SlotType::digitalInput);
+                engine.connectComponent(previous[rng() % width], 0, SlotType::digitalOutput,
+                                        gate, 1, SlotType::digitalInput);
+                current.push_back(gate);
+            }
+            circuit.components.insert(circuit.components.end(), current.begin(), current.end());
+            previous = std::move(current);
+        }
+        return circuit;
+    }
+
+    struct RunResult {
+        std::vector<SlotState> outputs;
+        SimEventStats stats;
+    };
+
+    RunResult runRandomStimulus(SimulationEngine &engine, size_t threads, int rounds) {
+        // built while paused, so the initial events do not depend on thread timing
+        engine.setSimulationState(SimulationState::paused);
+        engine.clear();
+        engine.setWorkerThreadCount(threads);
+
+        const auto circuit = buildRandomCircuit(engine, 256, 8, 42, true);
+        engine.setSimulationState(SimulationState::running);
+        EXPECT_TRUE(engine.waitUntilStable(20s));
+
+        std::mt19937 rng(7);
+        RunResult result;
+        for (int round = 0; round < rounds; round++) {
+            // all inputs change at the same simulation time
+            engine.setSimulationState(SimulationState::paused);
+            for (const auto &input : circuit.inputs) {
+                if (rng() % 3 == 0)
+                    engine.setOutputSlotState(input, 0, rng() % 2 ? LogicState::high : LogicState::low);
+            }
+            engine.setSimulationState(SimulationState::running);
+            EXPECT_TRUE(engine.waitUntilStable(20s)) << "round " << round;
+
+            for (const auto &uuid : circuit.components) {
+                const auto &outputs = engine.getComponentState(uuid).outputStates;
+                result.outputs.insert(result.outputs.end(), outputs.begin(), outputs.end());
+            }
+        }
+        result.stats = engine.getEventStats();
+
+        engine.setSimulationState(SimulationState::paused);
+        engine.setWorkerThreadCount(1);
+        engine.clear();
+        return result;
+    }
+} // namespace
+
+TEST(WorkStealingPoolTest, RunsEveryIndexExactlyOnce) {
+    WorkStealingPool pool(4);
+    EXPECT_EQ(pool.getThreadCount(), 4u);
+
+    std::vector<std::atomic<int>> hits(5000);
+    std::vector<int> expected(hits.size(), 0);
+    std::mt19937 rng(3);
+    for (int job = 0; job < 200; job++) {
+        const size_t count = rng() % hits.size();
+        const size_t grain = 1 + rng() % 64;
+        for (size_t i = 0; i < count; i++) {
+            expected[i]++;
+        }
+
+        // uneven cost, the first indices are much slower so the others have to steal
+        const WorkStealingPool::RangeFunction body = [&](size_t begin, size_t end) {
+            for (size_t i = begin; i < end; i++) {
+                if (i < count / 8)
+                    std::this_thread::yield();
+                hits[i].fetch_add(1, std::memory_order_relaxed);
+            }
+        };
+        pool.parallelFor(count, grain, body);
+    }
+
+    for (size_t i = 0; i < hits.size(); i++) {
+        ASSERT_EQ(hits[i].load(), expected[i]) << "index " << i;
+    }
+}
+
+TEST(ParallelSimulationTest, ParallelEvaluationIsBitIdenticalToSerial) {
+    auto &engine = SimulationEngine::instance();
+    constexpr int rounds = 12;
+
+    const auto serial = runRandomStimulus(engine, 1, rounds);
+    ASSERT_FALSE(serial.outputs.empty());
+
+    for (const size_t threads : {2u, 4u}) {
+        const auto parallel = runRandomStimulus(engine, threads, rounds);
+        ASSERT_EQ(parallel.outputs.size(), serial.outputs.size());
+        for (size_t i = 0; i < serial.outputs.size(); i++) {
+            ASSERT_EQ(parallel.outputs[i].state, serial.outputs[i].state) << threads << " threads, slot " << i;
+            ASSERT_EQ(parallel.outputs[i].lastChangeTime, serial.outputs[i].lastChangeTime)
+                << threads << " threads, slot " << i;
+        }
+        EXPECT_EQ(parallel.stats.scheduled, serial.stats.scheduled);
+        EXPECT_EQ(parallel.stats.coalesced, serial.stats.coalesced);
+        EXPECT_EQ(parallel.stats.evaluated, serial.stats.evaluated);
+    }
+}
@@ -0,0 +1,106 @@
+#include "gtest/gtest.h"
+#include "probe/probe_history.h"
+#include "types.h"
+#include <vector>
+
+namespace {
+    using namespace Bess::SimEngine;
+
+    // a clock toggling every period ns, starting low at 0
+    ProbeHistory makeClock(uint64_t transitions, int64_t period, uint64_t memoryLimit = ProbeHistory::defaultMemoryLimit) {
+        ProbeHistory history(memoryLimit);
+        for (uint64_t i = 0; i < transitions; i++) {
+            history.append(SimTime(static_cast<int64_t>(i) * period), i % 2 ? LogicState::high : LogicState::low);
+        }
+        return history;
+    }
+} // namespace
+
+TEST(ProbeHistoryTest, KeepsOnlyChangesOfState) {
+    ProbeHistory history;
+    EXPECT_TRUE(history.empty());
+    EXPECT_EQ(history.getLastState(), LogicState::unknown);
+
+    history.append(SimTime(10), LogicState::high);
+    history.append(SimTime(20), LogicState::high);
+    history.append(SimTime(30), LogicState::low);
+    history.append(SimTime(40), LogicState::high_z);
+
+    EXPECT_EQ(history.getTransitionCount(), 3u);
+    EXPECT_EQ(history.stateAt(SimTime(5)), LogicState::unknown);
+    EXPECT_EQ(history.stateAt(SimTime(25)), LogicState::high);
+    EXPECT_EQ(history.stateAt(SimTime(30)), LogicState::low);
+    EXPECT_EQ(history.stateAt(SimTime(1000)), LogicState::high_z);
+
+    const auto recent = history.getRecent(2);
+    ASSERT_EQ(recent.size(), 2u);
+    EXPECT_EQ(recent[0].time, SimTime(30));
+    EXPECT_EQ(recent[1].state, LogicState::high_z);
+
+    // a restarted simulation starts a new recording
+    history.append(SimTime(0), LogicState::low);
+    EXPECT_EQ(history.getTransitionCount(), 1u);
+    EXPECT_EQ(history.getBeginTime(), SimTime(0));
+}
+
+TEST(ProbeHistoryTest, BucketsMatchTheRecordedTransitions) {
+    const uint64_t transitions = ProbeHistory::chunkTransitions * 20 + 123;
+    const auto history = makeClock(transitions, 10);
+    ASSERT_EQ(history.getTransitionCount(), transitions);
+
+    // zoomed out, whole chunks per bucket
+    std::vector<ProbeBucket> buckets(7);
+    history.query(SimTime(0), SimTime(static_cast<int64_t>(transitions) * 10), buckets);
+    uint64_t counted = 0;
+    for (const auto &bucket : buckets) {
+        counted += bucket.transitions;
+        EXPECT_EQ(bucket.stateMask & 0b11, 0b11);
+    }
+    EXPECT_EQ(counted, transitions);
+    EXPECT_EQ(buckets.front().first, LogicState::unknown);
+    EXPECT_EQ(buckets.back().last, transitions % 2 ? LogicState::low : LogicState::high);
+
+    // zoomed in, a bucket per transition inside one chunk
+    const int64_t from = 10 * 5000 + 5;
+    buckets.assign(8, {});
+    history.query(SimTime(from), SimTime(from + 80), buckets);
+    for (size_t i = 0; i < buckets.size(); i++) {
+        const auto before = (5000 + i) % 2 ? LogicState::high : LogicState::low;
+        const auto after = (5001 + i) % 2 ? LogicState::high : LogicState::low;
+        EXPECT_EQ(buckets[i].first, before);
+        EXPECT_EQ(buckets[i].transitions, 1u);
+        EXPECT_EQ(buckets[i].last, after);
+    }
+
+    // finer than the transitions, most buckets hold a constant state
+    buckets.assign(10, {});
+    history.query(SimTime(from), SimTime(from + 10), buckets);
+    counted = 0;
+    for (const auto &bucket : buckets) {
+        counted += bucket.transitions;
+    }
+    EXPECT_EQ(counted, 1u);
+    EXPECT_EQ(buckets.front().first, LogicState::low);
+    EXPECT_EQ(buckets.back().last, LogicState::high);
+}
+
+TEST(ProbeHistoryTest, DropsOldestChunksOverTheLimit) {
+    const uint64_t limit = 64 * 1024;
+    const auto history = makeClock(uint64_t{ProbeHistory::chunkTransitions} * 200, 1000, limit);
+
+    // the open chunk is not counted until it closes, two bytes per transition here
+    EXPECT_LE(history.getMemoryUsage(), limit + 2 * ProbeHistory::chunkTransitions);
+    EXPECT_GT(history.getDroppedCount(), 0u);
+    EXPECT_EQ(history.getTransitionCount() + history.getDroppedCount(), uint64_t{ProbeHistory::chunkTransitions} * 200);
+    EXPECT_GT(history.getBeginTime(), SimTime(0));
+    EXPECT_EQ(history.stateAt(history.getBeginTime() - SimTime(1)), LogicState::unknown);
+
+    // the retained part still answers queries
+    std::vector<ProbeBucket> buckets(3);
+    history.query(history.getBeginTime(), history.getEndTime() + SimTime(1), buckets);
+    uint64_t counted = 0;
+    for (const auto &bucket : buckets) {
+        counted += bucket.transitions;
+    }
+    EXPECT_EQ(counted, history.getTransitionCount());
+}
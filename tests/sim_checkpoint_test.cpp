@@ -0,0 +1,152 @@
+#include "checkpoint/sim_checkpoint.h"
+#include "component_definition.h"
+#include "gtest/gtest.h"
+#include "init_components.h"
+#include "sim_engine_state.h"
+#include "sim_engine_test_fixture.h"
+#include "simulation_engine.h"
+#include "types.h"
+#include <cstring>
+#include <memory>
+#include <sstream>
+#include <stdexcept>
+
+namespace {
+    using Bess::UUID;
+    using namespace Bess::SimEngine;
+    using namespace Bess::Tests;
+
+    class SimCheckpointTest : public SimEngineTestBase {};
+} // namespace
+
+TEST(CheckpointReaderTest, ReadsBackWhatWasWrittenAndStopsAtTheEnd) {
+    CheckpointWriter writer;
+    writer.write<uint32_t>(7);
+    writer.writeString("clock");
+    const std::vector<SlotState> slots = {{LogicState::high, SimTime(3)}, {LogicState::high_z, SimTime(9)}};
+    writer.writeSpan(std::span<const SlotState>(slots));
+
+    CheckpointReader reader(writer.getData());
+    EXPECT_EQ(reader.read<uint32_t>(), 7u);
+    EXPECT_EQ(reader.readString(), "clock");
+    std::vector<SlotState> read(2);
+    reader.readSpan(std::span<SlotState>(read));
+    EXPECT_EQ(read[1].state, LogicState::high_z);
+    EXPECT_EQ(read[1].lastChangeTime, SimTime(9));
+    EXPECT_TRUE(reader.atEnd());
+    EXPECT_THROW(reader.read<uint8_t>(), std::runtime_error);
+}
+
+TEST(SimCheckpointFormatTest, KeepsPendingEventsAndTime) {
+    const SimEngineState state;
+    const std::vector<SimulationEvent> events = {
+        {SimTime(40), UUID(11), UUID(12), 5, false},
+        {SimTime(90), UUID(13), UUID::null, 6, true},
+    };
+
+    std::stringstream out;
+    SimCheckpointFormat::write(out, state, events, SimTime(30), 7);
+    const auto checkpoint = SimCheckpointFormat::read(out);
+
+    EXPECT_EQ(checkpoint.simTime, SimTime(30));
+    EXPECT_EQ(checkpoint.nextEventId, 7u);
+    EXPECT_TRUE(checkpoint.components.empty());
+    ASSERT_EQ(checkpoint.events.size(), 2u);
+    EXPECT_EQ(checkpoint.events[0].simTime, SimTime(40));
+    EXPECT_EQ(checkpoint.events[0].compId, UUID(11));
+    EXPECT_EQ(checkpoint.events[0].schedulerId, UUID(12));
+    EXPECT_EQ(checkpoint.events[0].id, 5u);
+    EXPECT_FALSE(checkpoint.events[0].freeRunning);
+    EXPECT_TRUE(checkpoint.events[1].freeRunning);
+}
+
+TEST_F(SimCheckpointTest, RestoresStateEventsAndTimeSoTheRunContinuesIdentically) {
+    const auto clock = engine->addComponent(findDefinitionByName("Clock"));
+    const auto input = engine->addComponent(findDefinitionByName("Input"));
+    const auto gate = engine->addComponent(findDefinitionByName("AND Gate"));
+    const auto inverter = engine->addComponent(findDefinitionByName("NOT Gate"));
+    ASSERT_TRUE(engine->connectComponent(clock, 0, SlotType::digitalOutput, gate, 0, SlotType::digitalInput));
+    ASSERT_TRUE(engine->connectComponent(input, 0, SlotType::digitalOutput, gate, 1, SlotType::digitalInput));
+    ASSERT_TRUE(engine->connectComponent(gate, 0, SlotType::digitalOutput, inverter, 0, SlotType::digitalInput));
+    engine->setOutputSlotState(input, 0, LogicState::high);
+
+    const SimTime checkpointTime = std::chrono::milliseconds(1250);
+    ASSERT_TRUE(engine->runUntil(checkpointTime));
+    const auto clockHigh = engine->getComponentDefinition(clock)->getTrait<ClockTrait>()->high;
+    const auto gateName = engine->getDigitalComponent(gate)->getName();
+
+    std::stringstream checkpoint;
+    engine->saveCheckpoint(checkpoint);
+
+    const SimTime laterTime = std::chrono::milliseconds(3700);
+    ASSERT_TRUE(engine->runUntil(laterTime));
+    const auto expectedGate = outputOf(gate);
+    const auto expectedInverter = outputOf(inverter);
+    const auto expectedChange = engine->getDigitalComponent(inverter)->state.outputStates[0].lastChangeTime;
+
+    engine->restoreCheckpoint(checkpoint);
+    EXPECT_EQ(engine->getSimulationTime(), checkpointTime);
+    EXPECT_EQ(engine->getSimEngineState().getDigitalComponents().size(), 4u);
+    EXPECT_EQ(engine->getDigitalComponent(gate)->getName(), gateName);
+    EXPECT_EQ(engine->getComponentDefinition(clock)->getTrait<ClockTrait>()->high, clockHigh);
+    EXPECT_EQ(outputOf(input), LogicState::high);
+    EXPECT_EQ(engine->getConnections(gate).inputs[1].front().first, input);
+
+    ASSERT_TRUE(engine->runUntil(laterTime));
+    EXPECT_EQ(outputOf(gate), expectedGate);
+    EXPECT_EQ(outputOf(inverter), expectedInverter);
+    EXPECT_EQ(engine->getDigitalComponent(inverter)->state.outputStates[0].lastChangeTime, expectedChange);
+}
+
+TEST_F(SimCheckpointTest, SharesOneDefinitionEntryButKeepsResizedSlots) {
+    const auto narrow = engine->addComponent(findDefinitionByName("AND Gate"));
+    const auto wide = engine->addComponent(findDefinitionByName("AND Gate"));
+    const auto wideInputs = engine->getDigitalComponent(wide)->incrementInputCount();
+    ASSERT_EQ(wideInputs, 3u);
+    ASSERT_TRUE(engine->runUntilStable());
+
+    std::stringstream checkpoint;
+    engine->saveCheckpoint(checkpoint);
+    engine->restoreCheckpoint(checkpoint);
+
+    EXPECT_EQ(engine->getDigitalComponent(narrow)->state.inputStates.size(), 2u);
+    EXPECT_EQ(engine->getDigitalComponent(wide)->state.inputStates.size(), wideInputs);
+    EXPECT_EQ(engine->getComponentDefinition(wide)->getInputSlotsInfo().count, wideInputs);
+    EXPECT_NE(engine->getComponentDefinition(narrow).get(), engine->getComponentDefinition(wide).get());
+}
+
+TEST_F(SimCheckpointTest, RejectsForeignAndTruncatedDataWithoutTouchingTheEngine) {
+    const auto input = engine->addComponent(findDefinitionByName("Input"));
+    std::stringstream checkpoint;
+    engine->saveCheckpoint(checkpoint);
+    const auto bytes = checkpoint.str();
+
+    std::stringstream garbage("definitely not a checkpoint, just some text");
+    EXPECT_THROW(engine->restoreCheckpoint(garbage), std::runtime_error);
+
+    std::stringstream truncated(bytes.substr(0, bytes.size() - 5));
+    EXPECT_THROW(engine->restoreCheckpoint(truncated), std::runtime_error);
+
+    EXPECT_NE(engine->getDigitalComponent(input), nullptr);
+    EXPECT_EQ(engine->getSimEngineState().getDigitalComponents().size(), 1u);
+}
+
+TEST_F(SimCheckpointTest, RejectsSlotCountsTheFileCannotHold) {
+    engine->addComponent(findDefinitionByName("Input"));
+    std::stringstream checkpoint;
+    engine->saveCheckpoint(checkpoint);
+    auto bytes = checkpoint.str();
+
+    // header, then the definitions section, then the components section with its count
+    constexpr size_t headerSize = 40, sectionHeaderSize = 16;
+    uint64_t definitionsSize = 0;
+    std::memcpy(&definitionsSize, bytes.data() + headerSize + 8, sizeof(definitionsSize));
+    const auto record = headerSize + sectionHeaderSize + definitionsSize + sectionHeaderSize + sizeof(uint64_t);
+    // id, net and definition come before the input count
+    const uint32_t inputCount = 0xffffffff;
+    std::memcpy(bytes.data() + record + 20, &inputCount, sizeof(inputCount));
+
+    std::stringstream forged(bytes);
+    EXPECT_THROW(engine->restoreCheckpoint(forged), std::runtime_error);
+    EXPECT_EQ(engine->getSimEngineState().getDigitalComponents().size(), 1u);
+}
@@ -0,0 +1,75 @@
+#pragma once
+
+#include "component_catalog.h"
+#include "component_definition.h"
+#include "digital_component.h"
+#include "sim_engine_state.h"
+#include "simulation_engine.h"
+#include "types.h"
+#include <gtest/gtest.h>
+#include <memory>
+#include <ranges>
+#include <string>
+#include <string_view>
+
+namespace Bess::Tests {
+    using namespace Bess::SimEngine;
+
+    inline std::shared_ptr<ComponentDefinition> findDefinitionByName(std::string_view name) {
+        const auto &components = ComponentCatalog::instance().getComponents();
+        const auto it = std::ranges::find_if(components, [name](const auto &definition) {
+            return definition && definition->getName() == name;
+        });
+        return it == components.end() ? nullptr : *it;
+    }
+
+    // a definition without simulation function, for netlists built by hand
+    inline std::shared_ptr<ComponentDefinition> makeDefinition(std::string_view name, size_t inputs, size_t outputs) {
+        auto def = std::make_shared<ComponentDefinition>();
+        def->setName(std::string(name));
+        def->setGroupName("Tests");
+        def->setInputSlotsInfo({SlotsGroupType::input, false, inputs, {}, {}});
+        def->setOutputSlotsInfo({SlotsGroupType::output, false, outputs, {}, {}});
+        return def;
+    }
+
+    inline std::shared_ptr<DigitalComponent> addComponent(SimEngineState &state, const std::shared_ptr<ComponentDefinition> &def) {
+        auto comp = std::make_shared<DigitalComponent>(def);
+        state.addDigitalComponent(comp);
+        return comp;
+    }
+
+    inline std::shared_ptr<DigitalComponent> addComponent(SimEngineState &state, size_t inputs, size_t outputs) {
+        return addComponent(state, makeDefinition("Test Component", inputs, outputs));
+    }
+
+    // wires src's output slot to dst's input slot the way the engine does, without the engine
+    inline void connect(DigitalComponent &src, int srcSlot, DigitalComponent &dst, int dstSlot) {
+        src.outputConnections[srcSlot].emplace_back(dst.id, dstSlot);
+        dst.inputConnections[dstSlot].emplace_back(src.id, srcSlot);
+        src.addFanOut(dst.id);
+    }
+
+    // Tests on the engine singleton: each starts paused, empty and unpaced.
+    class SimEngineTestBase : public testing::Test {
+      protected:
+        void SetUp() override {
+            engine = &SimulationEngine::instance();
+            engine->setSimulationState(SimulationState::paused);
+            engine->clear();
+            engine->setPacing(SimulationPacing::asFastAsPossible);
+        }
+
+        void TearDown() override {
+            engine->setSimulationState(SimulationState::paused);
+            engine->clear();
+            engine->setPacing(SimulationPacing::realTime);
+        }
+
+        LogicState outputOf(const UUID &id, int slot = 0) const {
+            return engine->getDigitalComponent(id)->state.outputStates[slot].state;
+        }
+
+        SimulationEngine *engine = nullptr;
+    };
+} // namespace Bess::Tests
@@ -0,0 +1,314 @@
+#include "checkpoint/sim_checkpoint.h"
+#include "component_definition.h"
+#include "digital_component.h"
+#include "gtest/gtest.h"
+#include "history/sim_history.h"
+#include "init_components.h"
+#include "netlist/compiled_netlist.h"
+#include "sim_engine_state.h"
+#include "sim_engine_test_fixture.h"
+#include "simulation_engine.h"
+#include "types.h"
+#include <chrono>
+#include <memory>
+#include <vector>
+
+using namespace std::chrono_literals;
+
+namespace {
+    using Bess::UUID;
+    using namespace Bess::SimEngine;
+    using namespace Bess::Tests;
+
+    // keeps a runtime counter, like a clock keeps its phase
+    class CounterDefinition : public ComponentDefinition {
+      public:
+        CounterDefinition() {
+            setName("Test Counter");
+            setGroupName("Tests");
+            setInputSlotsInfo({SlotsGroupType::input, false, 1, {}, {}});
+            setOutputSlotsInfo({SlotsGroupType::output, false, 1, {}, {}});
+        }
+
+        void writeCheckpointState(CheckpointWriter &out) const override {
+            out.write(count);
+        }
+
+        void readCheckpointState(CheckpointReader &in) override {
+            count = in.read<uint32_t>();
+        }
+
+        uint32_t count = 0;
+    };
+
+    struct HistoryCircuit {
+        SimEngineState state;
+        CompiledNetlist netlist;
+        std::shared_ptr<DigitalComponent> driver;
+        std::shared_ptr<DigitalComponent> sink;
+        std::shared_ptr<CounterDefinition> counter;
+        CompIndex driverIdx = invalidCompIndex;
+        CompIndex sinkIdx = invalidCompIndex;
+
+        HistoryCircuit() {
+            driver = std::make_shared<DigitalComponent>(makeDefinition("Test Driver", 0, 1));
+            counter = std::make_shared<CounterDefinition>();
+            sink = std::make_shared<DigitalComponent>(counter, false);
+            state.addDigitalComponent(driver);
+            state.addDigitalComponent(sink);
+
+            netlist.compile(state);
+            driverIdx = netlist.indexOf(driver->id);
+            sinkIdx = netlist.indexOf(sink->id);
+        }
+
+        // writes the driver's output the way a timestep does, recording what it overwrites
+        void setDriver(SimHistory &history, LogicState value, SimTime time) {
+            const SlotState next{value, time};
+            history.recordSlots(driverIdx, SlotType::digitalOutput, driver->state.outputStates,
+                                std::span<const SlotState>(&next, 1));
+            driver->state.outputStates[0] = next;
+            netlist.syncOutputs(driverIdx);
+        }
+
+        void setSink(SimHistory &history, LogicState value, SimTime time) {
+            history.recordSlot(sinkIdx, SlotType::digitalInput, 0, sink->state.inputStates[0]);
+            sink->state.inputStates[0] = {value, time};
+            history.recordDefinitionState(sinkIdx, *sink->definition);
+            counter->count++;
+        }
+    };
+
+    SimulationEvent makeEvent(int64_t time, uint64_t id) {
+        return {SimTime(time), UUID(100 + id), UUID::null, id, false};
+    }
+
+    class SimHistoryEngineTest : public SimEngineTestBase {
+      protected:
+        void TearDown() override {
+            engine->setSimulationState(SimulationState::paused);
+            engine->disableHistory();
+            SimEngineTestBase::TearDown();
+        }
+
+        std::vector<SlotState> outputsOf(const std::vector<UUID> &ids) {
+            std::vector<SlotState> outputs;
+            for (const auto &id : ids) {
+                outputs.push_back(engine->getDigitalComponent(id)->state.outputStates[0]);
+            }
+            return outputs;
+        }
+
+        static void expectSameSlots(const std::vector<SlotState> &actual, const std::vector<SlotState> &expected) {
+            ASSERT_EQ(actual.size(), expected.size());
+            for (size_t i = 0; i < actual.size(); i++) {
+                EXPECT_EQ(actual[i].state, expected[i].state) << "slot " << i;
+                EXPECT_EQ(actual[i].lastChangeTime, expected[i].lastChangeTime) << "slot " << i;
+            }
+        }
+    };
+} // namespace
+
+TEST(SimHistoryTest, RewindRestoresSlotsDefinitionsAndPendingEvents) {
+    HistoryCircuit circuit;
+    SimHistory history;
+    history.reset(circuit.netlist, SimTime(0), 10);
+    const auto origin = history.getFirstPosition();
+
+    // event 3 was pending at the origin, 11 was scheduled by the first timestep
+    const std::vector<SimulationEvent> first = {makeEvent(5, 3)};
+    circuit.setDriver(history, LogicState::high, SimTime(5));
+    history.closeTimestep(circuit.netlist, SimTime(5), 12, first);
+
+    const std::vector<SimulationEvent> second = {makeEvent(8, 4), makeEvent(8, 11)};
+    circuit.setSink(history, LogicState::high, SimTime(8));
+    history.closeTimestep(circuit.netlist, SimTime(8), 15, second);
+    ASSERT_EQ(history.getLastPosition(), origin + 2);
+    EXPECT_EQ(circuit.counter->count, 1u);
+
+    SimHistoryRewind rewind;
+    history.rewind(origin + 1, circuit.netlist, rewind);
+    EXPECT_EQ(rewind.simTime, SimTime(5));
+    EXPECT_EQ(rewind.nextEventId, 12u);
+    ASSERT_EQ(rewind.requeue.size(), 2u);
+    EXPECT_EQ(rewind.requeue[0].id, 4u);
+    EXPECT_EQ(rewind.requeue[1].id, 11u);
+    EXPECT_EQ(circuit.sink->state.inputStates[0].state, LogicState::low);
+    EXPECT_EQ(circuit.counter->count, 0u);
+    EXPECT_EQ(circuit.driver->state.outputStates[0].state, LogicState::high);
+    EXPECT_EQ(history.getLastPosition(), origin + 1);
+
+    history.rewind(origin, circuit.netlist, rewind);
+    EXPECT_EQ(rewind.simTime, SimTime(0));
+    ASSERT_EQ(rewind.requeue.size(), 1u);
+    EXPECT_EQ(rewind.requeue[0].id, 3u);
+    EXPECT_EQ(circuit.driver->state.outputStates[0].state, LogicState::low);
+    EXPECT_EQ(circuit.driver->state.outputStates[0].lastChangeTime, SimTime(0));
+    EXPECT_EQ(circuit.netlist.getOutput(circuit.driverIdx, 0).state, LogicState::low);
+    EXPECT_EQ(rewind.touched, std::vector<CompIndex>{circuit.driverIdx});
+}
+
+TEST(SimHistoryTest, WritesBetweenTimestepsAreUndoneWithTheNextPosition) {
+    HistoryCircuit circuit;
+    SimHistory history;
+    history.reset(circuit.netlist, SimTime(0), 0);
+    circuit.setDriver(history, LogicState::high, SimTime(1));
+    history.closeTimestep(circuit.netlist, SimTime(1), 1, {});
+
+    // an input set while paused, no timestep has closed since
+    circuit.setDriver(history, LogicState::unknown, SimTime(1));
+    SimHistoryRewind rewind;
+    history.rewind(history.getLastPosition(), circuit.netlist, rewind);
+    EXPECT_EQ(circuit.driver->state.outputStates[0].state, LogicState::high);
+}
+
+TEST(SimHistoryTest, KeyframesShortenLongRewindsAndMatchUndoing) {
+    HistoryCircuit circuit;
+    SimHistory history(SimHistory::defaultMemoryBudget, 4);
+    history.reset(circuit.netlist, SimTime(0), 0);
+    for (int t = 1; t <= 10; t++) {
+        circuit.setDriver(history, t % 2 ? LogicState::high : LogicState::low, SimTime(t));
+        circuit.setSink(history, t % 3 ? LogicState::high : LogicState::low, SimTime(t));
+        history.closeTimestep(circuit.netlist, SimTime(t), t, {});
+    }
+    EXPECT_GE(history.getStats().keyframes, 3u);
+
+    uint64_t position = 0;
+    ASSERT_TRUE(history.findPosition(SimTime(3), position));
+    SimHistoryRewind rewind;
+    history.rewind(position, circuit.netlist, rewind);
+    EXPECT_EQ(rewind.simTime, SimTime(3));
+    EXPECT_EQ(circuit.driver->state.outputStates[0].state, LogicState::high);
+    EXPECT_EQ(circuit.driver->state.outputStates[0].lastChangeTime, SimTime(3));
+    EXPECT_EQ(circuit.sink->state.inputStates[0].state, LogicState::low);
+    EXPECT_EQ(circuit.counter->count, 3u);
+    EXPECT_FALSE(history.findPosition(SimTime(-1), position));
+}
+
+TEST(SimHistoryTest, DropsTheOldestPositionsToStayWithinTheBudget) {
+    HistoryCircuit circuit;
+    constexpr uint64_t budget = 16 << 10;
+    SimHistory history(budget);
+    history.reset(circuit.netlist, SimTime(0), 0);
+
+    std::vector<SimulationEvent> events;
+    for (uint64_t i = 0; i < 16; i++) {
+        events.push_back(makeEvent(0, i));
+    }
+    for (int t = 1; t <= 1000; t++) {
+        circuit.setDriver(history, t % 2 ? LogicState::high : LogicState::low, SimTime(t));
+        history.closeTimestep(circuit.netlist, SimTime(t), t, events);
+        EXPECT_LE(history.getMemoryUsage(), budget);
+    }
+
+    const auto stats = history.getStats();
+    EXPECT_GT(stats.dropped, 0u);
+    EXPECT_EQ(stats.positions + stats.dropped, 1001u);
+    EXPECT_EQ(stats.newestTime, SimTime(1000));
+    uint64_t position = 0;
+    EXPECT_FALSE(history.findPosition(SimTime(1), position));
+    EXPECT_TRUE(history.findPosition(stats.oldestTime, position));
+}
+
+TEST(SimHistoryTest, ARecompiledNetlistStartsOver) {
+    HistoryCircuit circuit;
+    SimHistory history;
+    history.reset(circuit.netlist, SimTime(0), 0);
+    circuit.setDriver(history, LogicState::high, SimTime(1));
+    history.closeTimestep(circuit.netlist, SimTime(1), 1, {});
+
+    circuit.state.markTopologyChanged();
+    circuit.netlist.compile(circuit.state);
+    EXPECT_FALSE(history.matches(circuit.netlist));
+    history.closeTimestep(circuit.netlist, SimTime(2), 2, {});
+    EXPECT_TRUE(history.matches(circuit.netlist));
+    EXPECT_EQ(history.getStats().positions, 1u);
+    EXPECT_EQ(history.getStats().oldestTime, SimTime(2));
+}
+
+TEST_F(SimHistoryEngineTest, RewindsAndRepeatsTheSameFuture) {
+    const auto clock = engine->addComponent(findDefinitionByName("Clock"));
+    const auto input = engine->addComponent(findDefinitionByName("Input"));
+    const auto gate = engine->addComponent(findDefinitionByName("AND Gate"));
+    const auto inverter = engine->addComponent(findDefinitionByName("NOT Gate"));
+    ASSERT_TRUE(engine->connectComponent(clock, 0, SlotType::digitalOutput, gate, 0, SlotType::digitalInput));
+    ASSERT_TRUE(engine->connectComponent(input, 0, SlotType::digitalOutput, gate, 1, SlotType::digitalInput));
+    ASSERT_TRUE(engine->connectComponent(gate, 0, SlotType::digitalOutput, inverter, 0, SlotType::digitalInput));
+    engine->enableHistory();
+    engine->setOutputSlotState(input, 0, LogicState::high);
+
+    const std::vector<UUID> observed = {clock, input, gate, inverter};
+    const SimTime rewindTime = std::chrono::milliseconds(1250);
+    ASSERT_TRUE(engine->runUntil(rewindTime));
+    const auto atRewind = outputsOf(observed);
+    const auto clockHigh = engine->getComponentDefinition(clock)->getTrait<ClockTrait>()->high;
+
+    // the input goes low after the rewind point, rewinding takes that back too
+    ASSERT_TRUE(engine->runUntil(std::chrono::milliseconds(2100)));
+    engine->setOutputSlotState(input, 0, LogicState::low);
+    const SimTime laterTime = std::chrono::milliseconds(3700);
+    ASSERT_TRUE(engine->runUntil(laterTime));
+    EXPECT_EQ(outputOf(gate), LogicState::low);
+
+    ASSERT_TRUE(engine->scrubTo(rewindTime));
+    EXPECT_EQ(engine->getSimulationTime(), rewindTime);
+    expectSameSlots(outputsOf(observed), atRewind);
+    EXPECT_EQ(engine->getComponentDefinition(clock)->getTrait<ClockTrait>()->high, clockHigh);
+    EXPECT_LE(engine->getHistoryStats().newestTime, rewindTime);
+
+    // without the input change the resumed run matches a run that never had it
+    ASSERT_TRUE(engine->scrubTo(laterTime));
+    const auto resumed = outputsOf(observed);
+    EXPECT_EQ(outputOf(input), LogicState::high);
+
+    engine->disableHistory();
+    engine->clear();
+    const auto clock2 = engine->addComponent(findDefinitionByName("Clock"));
+    const auto input2 = engine->addComponent(findDefinitionByName("Input"));
+    const auto gate2 = engine->addComponent(findDefinitionByName("AND Gate"));
+    const auto inverter2 = engine->addComponent(findDefinitionByName("NOT Gate"));
+    ASSERT_TRUE(engine->connectComponent(clock2, 0, SlotType::digitalOutput, gate2, 0, SlotType::digitalInput));
+    ASSERT_TRUE(engine->connectComponent(input2, 0, SlotType::digitalOutput, gate2, 1, SlotType::digitalInput));
+    ASSERT_TRUE(engine->connectComponent(gate2, 0, SlotType::digitalOutput, inverter2, 0, SlotType::digitalInput));
+    engine->setOutputSlotState(input2, 0, LogicState::high);
+    ASSERT_TRUE(engine->runUntil(laterTime));
+    expectSameSlots(outputsOf({clock2, input2, gate2, inverter2}), resumed);
+}
+
+TEST_F(SimHistoryEngineTest, StepsBackOneTimestepAtATime) {
+    const auto input = engine->addComponent(findDefinitionByName("Input"));
+    const auto first = engine->addComponent(findDefinitionByName("NOT Gate"));
+    const auto second = engine->addComponent(findDefinitionByName("NOT Gate"));
+    ASSERT_TRUE(engine->connectComponent(input, 0, SlotType::digitalOutput, first, 0, SlotType::digitalInput));
+    ASSERT_TRUE(engine->connectComponent(first, 0, SlotType::digitalOutput, second, 0, SlotType::digitalInput));
+    ASSERT_TRUE(engine->runUntilStable());
+    EXPECT_FALSE(engine->stepBack());
+
+    engine->enableHistory();
+    EXPECT_TRUE(engine->isHistoryEnabled());
+    const auto settledFirst = outputOf(first);
+    const auto settledSecond = outputOf(second);
+    engine->setOutputSlotState(input, 0, LogicState::high);
+    ASSERT_TRUE(engine->runUntilStable());
+    ASSERT_GE(engine->getHistoryStats().positions, 3u);
+    EXPECT_NE(outputOf(second), settledSecond);
+
+    // the last timestep only changed the second gate
+    ASSERT_TRUE(engine->stepBack());
+    EXPECT_EQ(outputOf(second), settledSecond);
+    EXPECT_NE(outputOf(first), settledFirst);
+
+    // resuming simulates the discarded timestep again
+    ASSERT_TRUE(engine->runUntilStable());
+    EXPECT_NE(outputOf(second), settledSecond);
+
+    // the input was set after the first position, so going back there undoes it as well
+    ASSERT_TRUE(engine->stepBack());
+    ASSERT_TRUE(engine->stepBack());
+    EXPECT_EQ(outputOf(input), LogicState::low);
+    EXPECT_EQ(outputOf(first), settledFirst);
+    EXPECT_EQ(outputOf(second), settledSecond);
+    EXPECT_FALSE(engine->stepBack());
+    ASSERT_TRUE(engine->runUntilStable());
+    EXPECT_EQ(outputOf(first), settledFirst);
+}
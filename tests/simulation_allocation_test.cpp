@@ -0,0 +1,136 @@
+#include "component_definition.h"
+#include "gtest/gtest.h"
+#include "sim_engine_test_fixture.h"
+#include "simulation_engine.h"
+#include "types.h"
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <memory>
+#include <new>
+#include <span>
+#include <thread>
+#include <vector>
+
+using namespace std::chrono_literals;
+
+// Replaces the global allocation functions, so it is built as its own executable (BessAllocationTests).
+namespace {
+    // allocations are only counted on this thread, the sim thread once it is known
+    std::atomic<std::thread::id> countedThread{};
+    std::atomic<size_t> countedAllocations{0};
+    std::atomic<std::thread::id> simThread{};
+
+    void *countedAlloc(std::size_t size) {
+        if (countedThread.load(std::memory_order_relaxed) == std::this_thread::get_id())
+            countedAllocations.fetch_add(1, std::memory_order_relaxed);
+        if (void *ptr = std::malloc(size ? size : 1))
+            return ptr;
+        throw std::bad_alloc();
+    }
+} // namespace
+
+void *operator new(std::size_t size) { return countedAlloc(size); }
+void *operator new[](std::size_t size) { return countedAlloc(size); }
+void operator delete(void *ptr) noexcept { std::free(ptr); }
+void operator delete[](void *ptr) noexcept { std::free(ptr); }
+void operator delete(void *ptr, std::size_t) noexcept { std::free(ptr); }
+void operator delete[](void *ptr, std::size_t) noexcept { std::free(ptr); }
+
+namespace {
+    using Bess::UUID;
+    using namespace Bess::SimEngine;
+    using namespace Bess::Tests;
+
+    // passes its input through and remembers which thread evaluated it
+    std::shared_ptr<ComponentDefinition> makeProbeDefinition() {
+        auto def = std::make_shared<ComponentDefinition>();
+        def->setName("Allocation Probe");
+        def->setGroupName("Tests");
+        def->setInputSlotsInfo({SlotsGroupType::input, false, 1, {}, {}});
+        def->setOutputSlotsInfo({SlotsGroupType::output, false, 1, {}, {}});
+        def->setSimDelay(SimDelayNanoSeconds(1));
+        def->setInPlaceSimulationFunction([](std::span<const SlotState> inputs, SimTime ts,
+                                             const ComponentState &, std::span<SlotState> outputs) {
+            simThread.store(std::this_thread::get_id());
+            if (outputs[0].state == inputs[0].state)
+                return false;
+            outputs[0] = {inputs[0].state, ts};
+            return true;
+        });
+        return def;
+    }
+
+    bool waitForOutput(SimulationEngine &engine, const UUID &uuid, LogicState expected,
+                       std::chrono::milliseconds timeout = 5000ms) {
+        const auto deadline = std::chrono::steady_clock::now() + timeout;
+        while (std::chrono::steady_clock::now() < deadline) {
+            if (engine.getDigitalSlotState(uuid, SlotType::digitalOutput, 0).state == expected)
+                return true;
+            std::this_thread::sleep_for(1ms);
+        }
+        return false;
+    }
+} // namespace
+
+TEST(SimulationAllocationTest, SteadyStateEventLoopDoesNotAllocate) {
+#if defined(_WIN32)
+    // every dll has its own operator new, the engine's allocations would not be counted here
+    GTEST_SKIP() << "allocations inside BessSimEngine.dll cannot be counted";
+#endif
+    constexpr int chains = 100;
+    constexpr int depth = 100; // even, so every chain ends with the input value
+    constexpr int warmupToggles = 300;
+    constexpr int measuredToggles = 20;
+
+    auto &engine = SimulationEngine::instance();
+    engine.setSimulationState(SimulationState::running);
+    engine.clear();
+
+    const auto inputDef = findDefinitionByName("Input");
+    const auto notDef = findDefinitionByName("NOT Gate");
+    ASSERT_NE(inputDef, nullptr);
+    ASSERT_NE(notDef, nullptr);
+
+    // 10k NOT gates in parallel chains, every timestep simulates a batch of `chains` gates
+    const auto input = engine.addComponent(inputDef);
+    std::vector<UUID> tails;
+    for (int c = 0; c < chains; c++) {
+        UUID prev = input;
+        for (int d = 0; d < depth; d++) {
+            const auto gate = engine.addComponent(notDef);
+            ASSERT_TRUE(engine.connectComponent(prev, 0, SlotType::digitalOutput,
+                                                gate, 0, SlotType::digitalInput));
+            prev = gate;
+        }
+        tails.push_back(prev);
+    }
+    const auto probe = engine.addComponent(makeProbeDefinition());
+    ASSERT_TRUE(engine.connectComponent(tails.front(), 0, SlotType::digitalOutput,
+                                        probe, 0, SlotType::digitalInput));
+
+    bool value = false;
+    const auto toggle = [&] {
+        value = !value;
+        engine.setOutputSlotState(input, 0, value ? LogicState::high : LogicState::low);
+        return waitForOutput(engine, probe, value ? LogicState::high : LogicState::low);
+    };
+
+    // lets every reusable buffer, including all timing wheel slots, reach its working size
+    for (int i = 0; i < warmupToggles; i++) {
+        ASSERT_TRUE(toggle()) << "warm up toggle " << i;
+    }
+    ASSERT_NE(simThread.load(), std::thread::id{});
+
+    countedAllocations.store(0);
+    countedThread.store(simThread.load());
+    for (int i = 0; i < measuredToggles; i++) {
+        ASSERT_TRUE(toggle()) << "measured toggle " << i;
+    }
+    countedThread.store(std::thread::id{});
+
+    EXPECT_EQ(countedAllocations.load(), 0u);
+
+    engine.setSimulationState(SimulationState::paused);
+    engine.clear();
+}
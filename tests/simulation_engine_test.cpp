@@ -1,12 +1,16 @@
 #include "component_catalog.h"
 #include "component_definition.h"
 #include "gtest/gtest.h"
+#include "init_components.h"
 #include "plugin_manager.h"
 #include "simulation_engine.h"
 #include "types.h"
+#include <array>
+#include <bit>
 #include <chrono>
 #include <memory>
 #include <ranges>
+#include <span>
 #include <string_view>
 #include <thread>
 
@@ -380,3 +384,253 @@ TEST_F(SimulationEngineTest, RepeatedSignalChangesRemainConsistentAcrossSingleCh
         expectOutputEventually(sink, SlotType::digitalInput, 0, boolToState(!value));
     }
 }
+
+TEST_F(SimulationEngineTest, NativeGateLibraryMatchesPluginDefinitionHashes) {
+    // same fields the bess-plugin uses for its gate schematics
+    auto pluginAnd = std::make_shared<ComponentDefinition>();
+    pluginAnd->setName("AND Gate");
+    pluginAnd->setGroupName("Digital Gates");
+    pluginAnd->setInputSlotsInfo({SlotsGroupType::input, true, 2, {}, {}});
+    pluginAnd->setOutputSlotsInfo({SlotsGroupType::output, false, 1, {}, {}});
+    pluginAnd->setOpInfo({'*', false});
+    pluginAnd->setSimDelay(SimDelayNanoSeconds(2));
+    pluginAnd->computeHash();
+
+    ASSERT_TRUE(ComponentCatalog::instance().isRegistered(pluginAnd->getHash()));
+    const auto native = ComponentCatalog::instance().getComponentDefinition(pluginAnd->getHash());
+    EXPECT_EQ(native->getOwnership(), CompDefinitionOwnership::NativeCpp);
+
+    for (const auto *name : {"Buffer Gate", "AND Gate", "OR Gate", "NOT Gate",
+                             "NAND Gate", "NOR Gate", "XOR Gate", "XNOR Gate"}) {
+        const auto def = findDefinitionByName(name);
+        ASSERT_NE(def, nullptr) << name;
+        EXPECT_EQ(def->getOwnership(), CompDefinitionOwnership::NativeCpp) << name;
+    }
+}
+
+TEST_F(SimulationEngineTest, NativeGatesEvaluateAnyInputCount) {
+    const auto nandDef = findDefinitionByName("NAND Gate");
+    const auto xorGateDef = findDefinitionByName("XOR Gate");
+    ASSERT_NE(nandDef, nullptr);
+    ASSERT_NE(xorGateDef, nullptr);
+
+    const auto nand = addComponent(nandDef);
+    const auto parity = addComponent(xorGateDef);
+    for (const auto &gate : {nand, parity}) {
+        auto comp = engine->getDigitalComponent(gate);
+        comp->incrementInputCount();
+        comp->incrementInputCount();
+        ASSERT_EQ(comp->inputConnections.size(), 4u);
+    }
+
+    std::array<UUID, 4> inputs{};
+    for (int i = 0; i < 4; i++) {
+        inputs[i] = addComponent(inputDef);
+        ASSERT_TRUE(engine->connectComponent(inputs[i], 0, SlotType::digitalOutput,
+                                             nand, i, SlotType::digitalInput));
+        ASSERT_TRUE(engine->connectComponent(inputs[i], 0, SlotType::digitalOutput,
+                                             parity, i, SlotType::digitalInput));
+    }
+
+    for (int pattern = 0; pattern < 16; pattern++) {
+        for (int i = 0; i < 4; i++) {
+            driveInput(inputs[i], (pattern >> i) & 1);
+        }
+        const int highCount = std::popcount(static_cast<unsigned>(pattern));
+        expectOutputEventually(nand, SlotType::digitalOutput, 0, boolToState(pattern != 0xF));
+        expectOutputEventually(parity, SlotType::digitalOutput, 0, boolToState(highCount % 2 == 1));
+    }
+}
+
+TEST_F(SimulationEngineTest, InPlaceAndLegacySimulationFunctionsAreInterchangeable) {
+    const auto makeInverterDef = [](const std::string &name) {
+        auto def = std::make_shared<ComponentDefinition>();
+        def->setName(name);
+        def->setGroupName("Tests");
+        def->setInputSlotsInfo({SlotsGroupType::input, false, 1, {}, {}});
+        def->setOutputSlotsInfo({SlotsGroupType::output, false, 1, {}, {}});
+        def->setSimDelay(SimDelayNanoSeconds(1));
+        return def;
+    };
+
+    auto legacyDef = makeInverterDef("Legacy Inverter");
+    legacyDef->setSimulationFunction([](const std::vector<SlotState> &inputs, SimTime ts,
+                                        const ComponentState &prevState) {
+        auto newState = prevState;
+        newState.inputStates = inputs;
+        const auto next = inputs[0].state == LogicState::high ? LogicState::low : LogicState::high;
+        newState.isChanged = prevState.outputStates[0].state != next;
+        newState.outputStates[0] = {next, ts};
+        return newState;
+    });
+    EXPECT_FALSE(legacyDef->getInPlaceSimulationFunction());
+
+    auto inPlaceDef = makeInverterDef("In Place Inverter");
+    inPlaceDef->setInPlaceSimulationFunction([](std::span<const SlotState> inputs, SimTime ts,
+                                                const ComponentState &, std::span<SlotState> outputs) {
+        const auto next = inputs[0].state == LogicState::high ? LogicState::low : LogicState::high;
+        if (outputs[0].state == next)
+            return false;
+        outputs[0] = {next, ts};
+        return true;
+    });
+
+    // the by-value signature is derived from the in place one
+    ComponentState prev;
+    prev.outputStates = {{LogicState::low, SimTime(0)}};
+    const std::vector<SlotState> lowInput = {{LogicState::low, SimTime(0)}};
+    const auto adapted = inPlaceDef->getSimulationFunction()(lowInput, SimTime(3), prev);
+    EXPECT_TRUE(adapted.isChanged);
+    EXPECT_EQ(adapted.outputStates[0].state, LogicState::high);
+    EXPECT_EQ(adapted.inputStates.size(), 1u);
+
+    const auto input = addComponent(inputDef);
+    const auto legacyGate = addComponent(legacyDef);
+    const auto inPlaceGate = addComponent(inPlaceDef);
+    ASSERT_TRUE(engine->connectComponent(input, 0, SlotType::digitalOutput,
+                                         legacyGate, 0, SlotType::digitalInput));
+    ASSERT_TRUE(engine->connectComponent(legacyGate, 0, SlotType::digitalOutput,
+                                         inPlaceGate, 0, SlotType::digitalInput));
+
+    for (const bool value : {true, false, true}) {
+        driveInput(input, value);
+        expectOutputEventually(legacyGate, SlotType::digitalOutput, 0, boolToState(!value));
+        expectOutputEventually(inPlaceGate, SlotType::digitalOutput, 0, boolToState(value));
+    }
+
+    // setting a by-value function later drops the in place one
+    inPlaceDef->setSimulationFunction(legacyDef->getSimulationFunction());
+    EXPECT_FALSE(inPlaceDef->getInPlaceSimulationFunction());
+}
+
+TEST_F(SimulationEngineTest, FanOutIsMaintainedIncrementallyAndDuplicateEventsCoalesce) {
+    const auto inputA = addComponent(inputDef);
+    const auto inputB = addComponent(inputDef);
+    const auto andGate = addComponent(andDef);
+    const auto orGate = addComponent(orDef);
+
+    const auto fanOutOf = [&](const UUID &uuid) {
+        return engine->getDigitalComponent(uuid)->fanOut;
+    };
+    using FanOut = std::vector<std::pair<UUID, uint32_t>>;
+
+    // both AND inputs driven by A, one fan-out entry with two connections
+    ASSERT_TRUE(engine->connectComponent(inputA, 0, SlotType::digitalOutput,
+                                         andGate, 0, SlotType::digitalInput));
+    ASSERT_TRUE(engine->connectComponent(andGate, 1, SlotType::digitalInput,
+                                         inputA, 0, SlotType::digitalOutput));
+    EXPECT_EQ(fanOutOf(inputA), (FanOut{{andGate, 2}}));
+
+    ASSERT_TRUE(engine->connectComponent(inputA, 0, SlotType::digitalOutput,
+                                         orGate, 0, SlotType::digitalInput));
+    ASSERT_TRUE(engine->connectComponent(inputB, 0, SlotType::digitalOutput,
+                                         orGate, 1, SlotType::digitalInput));
+    EXPECT_EQ(fanOutOf(inputA), (FanOut{{andGate, 2}, {orGate, 1}}));
+
+    engine->deleteConnection(inputA, SlotType::digitalOutput, 0,
+                             andGate, SlotType::digitalInput, 1);
+    EXPECT_EQ(fanOutOf(inputA), (FanOut{{andGate, 1}, {orGate, 1}}));
+
+    driveInput(inputA, true);
+    expectOutputEventually(orGate, SlotType::digitalOutput, 0, LogicState::high);
+    driveInput(inputA, false);
+    expectOutputEventually(orGate, SlotType::digitalOutput, 0, LogicState::low);
+
+    // A and B change at the same time, the OR gate is scheduled once for both
+    engine->setSimulationState(SimulationState::paused);
+    const auto before = engine->getEventStats();
+    driveInput(inputA, true);
+    driveInput(inputB, true);
+    const auto queued = engine->getEventStats();
+    EXPECT_EQ(queued.scheduled - before.scheduled, 2u); // AND and OR
+    EXPECT_EQ(queued.coalesced - before.coalesced, 1u);
+
+    engine->setSimulationState(SimulationState::running);
+    expectOutputEventually(orGate, SlotType::digitalOutput, 0, LogicState::high);
+    ASSERT_TRUE(waitUntil([&] { return engine->getEventStats().processed == before.processed + 2; }));
+    EXPECT_EQ(engine->getEventStats().evaluated - before.evaluated, 2u);
+
+    engine->deleteComponent(orGate);
+    EXPECT_EQ(fanOutOf(inputA), (FanOut{{andGate, 1}}));
+    EXPECT_TRUE(fanOutOf(inputB).empty());
+}
+
+TEST_F(SimulationEngineTest, PacingModesMapSimulatedTimeToWallClock) {
+    const auto clock = addComponent(findDefinitionByName("Clock"));
+    const auto clockTrait = engine->getComponentDefinition(clock)->getTrait<ClockTrait>();
+    ASSERT_NE(clockTrait, nullptr);
+    clockTrait->frequency = 1.f;
+    clockTrait->frequencyUnit = FrequencyUnit::kHz;
+
+    const auto runFor = [&](SimTime duration) {
+        const auto target = engine->getSimulationTime() + duration;
+        const auto start = std::chrono::steady_clock::now();
+        EXPECT_TRUE(engine->runUntil(target));
+        EXPECT_EQ(engine->getSimulationTime(), target);
+        EXPECT_EQ(engine->getSimulationState(), SimulationState::paused);
+        return std::chrono::steady_clock::now() - start;
+    };
+
+    // two simulated seconds of a 1 kHz clock, 4000 edges, are not tied to the wall clock
+    engine->setPacing(SimulationPacing::asFastAsPossible);
+    const auto before = engine->getEventStats();
+    runFor(2s);
+    EXPECT_GE(engine->getEventStats().evaluated - before.evaluated, 4000u);
+
+    // only the order is checked here, the wall clock times are in the pacing benchmark
+    const auto fast = runFor(100ms);
+
+    engine->setPacing(SimulationPacing::realTime);
+    const auto real = runFor(100ms);
+
+    engine->setPacing(SimulationPacing::scaled);
+    engine->setTimeScale(4.0);
+    const auto scaled = runFor(100ms);
+    EXPECT_LT(fast, scaled);
+    EXPECT_LT(scaled, real);
+    EXPECT_THROW(engine->setTimeScale(0.0), std::runtime_error);
+    EXPECT_DOUBLE_EQ(engine->getTimeScale(), 4.0);
+
+    // without events the time still advances to the target
+    engine->deleteComponent(clock);
+    runFor(5ms);
+
+    engine->setTimeScale(1.0);
+    engine->setPacing(SimulationPacing::realTime);
+}
+
+TEST_F(SimulationEngineTest, QuiescenceIgnoresClockEdgesAndSettlesWhilePaused) {
+    const auto clock = addComponent(findDefinitionByName("Clock"));
+    engine->getComponentDefinition(clock)->getTrait<ClockTrait>()->frequencyUnit = FrequencyUnit::kHz;
+
+    const auto inputA = addComponent(inputDef);
+    const auto inputB = addComponent(inputDef);
+    const auto gate = addComponent(andDef);
+    const auto output = addComponent(outputDef);
+    ASSERT_TRUE(engine->connectComponent(inputA, 0, SlotType::digitalOutput, gate, 0, SlotType::digitalInput));
+    ASSERT_TRUE(engine->connectComponent(inputB, 0, SlotType::digitalOutput, gate, 1, SlotType::digitalInput));
+    ASSERT_TRUE(engine->connectComponent(gate, 0, SlotType::digitalOutput, output, 0, SlotType::digitalInput));
+
+    // the clock keeps the queue busy, its edges do not count as pending work
+    EXPECT_TRUE(engine->waitUntilStable(1s));
+
+    engine->setSimulationState(SimulationState::paused);
+    driveInput(inputA, true);
+    driveInput(inputB, true);
+    EXPECT_FALSE(engine->isSimStable());
+    EXPECT_FALSE(engine->waitUntilStable(5ms));
+
+    const auto generation = engine->getStableGeneration();
+    ASSERT_TRUE(engine->runUntilStable());
+    EXPECT_TRUE(engine->isSimStable());
+    EXPECT_GT(engine->getStableGeneration(), generation);
+    EXPECT_EQ(engine->getSimulationState(), SimulationState::paused);
+    EXPECT_EQ(engine->getDigitalSlotState(output, SlotType::digitalInput, 0).state, LogicState::high);
+
+    // every combination settles without the engine running
+    const auto table = engine->getTruthTableOfNet(engine->getNetOf(gate));
+    ASSERT_EQ(table.getRowCount(), 4u);
+    for (uint64_t comb = 0; comb < table.getRowCount(); comb++) {
+        EXPECT_EQ(table.getOutput(comb, 0), comb == 3 ? LogicState::high : LogicState::low) << "row " << comb;
+    }
+}
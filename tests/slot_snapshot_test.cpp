@@ -0,0 +1,150 @@
+#include "component_definition.h"
+#include "gtest/gtest.h"
+#include "sim_engine_test_fixture.h"
+#include "simulation_engine.h"
+#include "snapshot/slot_state_snapshot.h"
+#include "types.h"
+#include <chrono>
+#include <memory>
+#include <thread>
+
+using namespace std::chrono_literals;
+
+namespace {
+    using Bess::UUID;
+    using namespace Bess::SimEngine;
+    using namespace Bess::Tests;
+
+    std::shared_ptr<const SlotSnapshotLayout> makeLayout(uint64_t id, uint32_t inputs, uint32_t outputs) {
+        return std::make_shared<const SlotSnapshotLayout>(id, std::vector<UUID>{UUID()},
+                                                          std::vector<std::pair<uint32_t, uint32_t>>{{inputs, outputs}});
+    }
+
+    class SlotSnapshotTest : public SimEngineTestBase {
+      protected:
+        // acquires until a snapshot matching the engine's own state is published
+        const SlotStateSnapshot &acquireMatching(const UUID &uuid, SlotType type, int idx) {
+            const auto deadline = std::chrono::steady_clock::now() + 1s;
+            while (true) {
+                const auto &snapshot = engine->acquireSlotSnapshot();
+                const auto slot = snapshot.getLayout()
+                                      ? snapshot.getLayout()->slotIndexOf(uuid, type, idx)
+                                      : invalidSnapshotSlot;
+                if ((slot != invalidSnapshotSlot &&
+                     snapshot.getState(slot) == engine->getDigitalSlotState(uuid, type, idx).state) ||
+                    std::chrono::steady_clock::now() > deadline) {
+                    return snapshot;
+                }
+                std::this_thread::sleep_for(1ms);
+            }
+        }
+    };
+} // namespace
+
+TEST(SlotSnapshotBufferTest, ReaderGetsNewestAndKeepsItsOwnBuffer) {
+    SlotSnapshotBuffer buffer;
+    const auto layout = makeLayout(1, 40, 1);
+
+    EXPECT_EQ(buffer.acquire().getEpoch(), 0u);
+
+    for (uint64_t epoch = 1; epoch <= 2; epoch++) {
+        auto &back = buffer.back();
+        back.reset(layout, epoch, SimTime(epoch));
+        back.setSlot(33, epoch == 1 ? LogicState::high : LogicState::high_z, true);
+        buffer.publish();
+    }
+
+    // the first publish was replaced before the reader came back
+    const auto &snapshot = buffer.acquire();
+    EXPECT_EQ(snapshot.getEpoch(), 2u);
+    EXPECT_EQ(snapshot.getState(33), LogicState::high_z);
+    EXPECT_TRUE(snapshot.isConnected(33));
+    EXPECT_EQ(snapshot.getState(32), LogicState::low);
+    EXPECT_FALSE(snapshot.isConnected(32));
+
+    // later publishes never write into the buffer the reader holds
+    for (uint64_t epoch = 3; epoch <= 6; epoch++) {
+        buffer.back().reset(layout, epoch, SimTime(epoch));
+        buffer.publish();
+    }
+    EXPECT_EQ(snapshot.getEpoch(), 2u);
+    EXPECT_EQ(snapshot.getState(33), LogicState::high_z);
+    EXPECT_EQ(&buffer.front(), &snapshot);
+
+    EXPECT_EQ(buffer.acquire().getEpoch(), 6u);
+    EXPECT_EQ(buffer.front().getState(invalidSnapshotSlot), LogicState::unknown);
+}
+
+TEST(SlotSnapshotLayoutTest, InputsComeBeforeOutputs) {
+    const UUID a, b;
+    const SlotSnapshotLayout layout(7, {a, b}, {{2, 1}, {3, 2}});
+
+    EXPECT_EQ(layout.getId(), 7u);
+    EXPECT_EQ(layout.getSlotCount(), 8u);
+    EXPECT_EQ(layout.slotIndexOf(a, SlotType::digitalInput, 1), 1u);
+    EXPECT_EQ(layout.slotIndexOf(b, SlotType::digitalInput, 0), 2u);
+    EXPECT_EQ(layout.slotIndexOf(a, SlotType::digitalOutput, 0), 5u);
+    EXPECT_EQ(layout.slotIndexOf(b, SlotType::digitalOutput, 1), 7u);
+    EXPECT_EQ(layout.slotIndexOf(b, SlotType::digitalOutput, 2), invalidSnapshotSlot);
+    EXPECT_EQ(layout.slotIndexOf(UUID(), SlotType::digitalInput, 0), invalidSnapshotSlot);
+}
+
+TEST_F(SlotSnapshotTest, PublishesWhilePausedAndFollowsTopologyChanges) {
+    const auto input = engine->addComponent(findDefinitionByName("Input"));
+    const auto gate = engine->addComponent(findDefinitionByName("NOT Gate"));
+    ASSERT_TRUE(engine->connectComponent(input, 0, SlotType::digitalOutput, gate, 0, SlotType::digitalInput));
+
+    engine->setOutputSlotState(input, 0, LogicState::high);
+    ASSERT_TRUE(engine->runUntilStable());
+
+    const auto &snapshot = acquireMatching(gate, SlotType::digitalOutput, 0);
+    const auto layoutId = snapshot.getLayoutId();
+    const auto &layout = *snapshot.getLayout();
+    EXPECT_EQ(snapshot.getState(layout.slotIndexOf(input, SlotType::digitalOutput, 0)), LogicState::high);
+    EXPECT_EQ(snapshot.getState(layout.slotIndexOf(gate, SlotType::digitalInput, 0)), LogicState::high);
+    EXPECT_EQ(snapshot.getState(layout.slotIndexOf(gate, SlotType::digitalOutput, 0)), LogicState::low);
+    EXPECT_TRUE(snapshot.isConnected(layout.slotIndexOf(gate, SlotType::digitalInput, 0)));
+    EXPECT_FALSE(snapshot.isConnected(layout.slotIndexOf(gate, SlotType::digitalOutput, 0)));
+
+    // a new component changes the numbering, the old slot indices are looked up again
+    const auto sink = engine->addComponent(findDefinitionByName("Output"));
+    ASSERT_TRUE(engine->connectComponent(gate, 0, SlotType::digitalOutput, sink, 0, SlotType::digitalInput));
+    ASSERT_TRUE(engine->runUntilStable());
+
+    const auto &updated = acquireMatching(sink, SlotType::digitalInput, 0);
+    EXPECT_NE(updated.getLayoutId(), layoutId);
+    const auto sinkSlot = updated.getLayout()->slotIndexOf(sink, SlotType::digitalInput, 0);
+    ASSERT_NE(sinkSlot, invalidSnapshotSlot);
+    EXPECT_EQ(updated.getState(sinkSlot), LogicState::low);
+    EXPECT_TRUE(updated.isConnected(updated.getLayout()->slotIndexOf(gate, SlotType::digitalOutput, 0)));
+}
+
+TEST_F(SlotSnapshotTest, ReaderSeesProgressWhileRunning) {
+    const auto clock = engine->addComponent(findDefinitionByName("Clock"));
+    const auto gate = engine->addComponent(findDefinitionByName("NOT Gate"));
+    ASSERT_TRUE(engine->connectComponent(clock, 0, SlotType::digitalOutput, gate, 0, SlotType::digitalInput));
+
+    engine->setPacing(SimulationPacing::asFastAsPossible);
+    engine->setSimulationState(SimulationState::running);
+
+    // the UI thread's side, one acquire per frame
+    uint64_t lastEpoch = 0;
+    SimTime lastTime{0};
+    size_t frames = 0;
+    const auto deadline = std::chrono::steady_clock::now() + 50ms;
+    while (std::chrono::steady_clock::now() < deadline) {
+        const auto &snapshot = engine->acquireSlotSnapshot();
+        EXPECT_GE(snapshot.getEpoch(), lastEpoch);
+        EXPECT_GE(snapshot.getSimTime(), lastTime);
+        if (snapshot.getEpoch() != lastEpoch)
+            frames++;
+        lastEpoch = snapshot.getEpoch();
+        lastTime = snapshot.getSimTime();
+        std::this_thread::sleep_for(2ms);
+    }
+
+    engine->setSimulationState(SimulationState::paused);
+    engine->setPacing(SimulationPacing::realTime);
+    EXPECT_GT(frames, 1u);
+    EXPECT_GT(lastTime, SimTime(0));
+}
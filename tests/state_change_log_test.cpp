@@ -0,0 +1,132 @@
+#include "component_definition.h"
+#include "gtest/gtest.h"
+#include "sim_engine_test_fixture.h"
+#include "simulation_engine.h"
+#include "state_change/state_change_log.h"
+#include "types.h"
+#include <memory>
+#include <thread>
+#include <vector>
+
+namespace {
+    using Bess::UUID;
+    using namespace Bess::SimEngine;
+    using namespace Bess::Tests;
+
+    SlotChange makeChange(uint32_t slot, LogicState state) {
+        SlotChange change;
+        change.slot = slot;
+        change.state = state;
+        return change;
+    }
+
+    class StateChangeDispatchTest : public SimEngineTestBase {
+      protected:
+        void SetUp() override {
+            SimEngineTestBase::SetUp();
+            engine->dispatchStateChanges();
+        }
+
+        void TearDown() override {
+            SimEngineTestBase::TearDown();
+            engine->dispatchStateChanges();
+        }
+    };
+} // namespace
+
+TEST(StateChangeLogTest, DrainsInOrderAndDropsWhenFull) {
+    StateChangeLog log(3);
+    EXPECT_EQ(log.getCapacity(), 4u);
+
+    for (uint32_t i = 0; i < 4; i++) {
+        EXPECT_TRUE(log.push(makeChange(i, LogicState::high)));
+    }
+    EXPECT_FALSE(log.push(makeChange(4, LogicState::high)));
+    EXPECT_EQ(log.getDroppedCount(), 1u);
+
+    std::vector<SlotChange> drained;
+    EXPECT_EQ(log.drain(drained), 4u);
+    for (uint32_t i = 0; i < 4; i++) {
+        EXPECT_EQ(drained[i].slot, i);
+    }
+
+    // the cells are reusable after a drain
+    EXPECT_TRUE(log.push(makeChange(5, LogicState::low)));
+    drained.clear();
+    EXPECT_EQ(log.drain(drained), 1u);
+    EXPECT_EQ(drained[0].slot, 5u);
+    EXPECT_EQ(log.drain(drained), 0u);
+}
+
+TEST(StateChangeLogTest, ConcurrentProducersKeepTheirOwnOrder) {
+    constexpr uint32_t producers = 4;
+    constexpr uint32_t perProducer = 20000;
+    StateChangeLog log(1024);
+
+    std::vector<std::thread> threads;
+    for (uint32_t p = 0; p < producers; p++) {
+        threads.emplace_back([&log, p] {
+            for (uint32_t i = 0; i < perProducer; i++) {
+                // slot carries the producer, state alternates so order can be checked
+                while (!log.push(makeChange(p, i % 2 ? LogicState::high : LogicState::low))) {
+                    std::this_thread::yield();
+                }
+            }
+        });
+    }
+
+    std::vector<SlotChange> drained;
+    while (drained.size() < producers * perProducer) {
+        log.drain(drained);
+    }
+    for (auto &thread : threads) {
+        thread.join();
+    }
+
+    std::vector<uint32_t> seen(producers, 0);
+    for (const auto &change : drained) {
+        ASSERT_LT(change.slot, producers);
+        EXPECT_EQ(change.state, seen[change.slot] % 2 ? LogicState::high : LogicState::low);
+        seen[change.slot]++;
+    }
+    for (const auto count : seen) {
+        EXPECT_EQ(count, perProducer);
+    }
+}
+
+TEST_F(StateChangeDispatchTest, CoalescesUnlessEveryTransitionIsRequested) {
+    const auto input = engine->addComponent(findDefinitionByName("Input"));
+    const auto gate = engine->addComponent(findDefinitionByName("NOT Gate"));
+    ASSERT_TRUE(engine->connectComponent(input, 0, SlotType::digitalOutput, gate, 0, SlotType::digitalInput));
+    ASSERT_TRUE(engine->runUntilStable());
+
+    std::vector<LogicState> latest, every;
+    const UUID latestId, everyId;
+    const auto onOutput = [](std::vector<LogicState> &out) {
+        return [&out](const SlotChange &change) {
+            if (change.type == SlotType::digitalOutput)
+                out.push_back(change.state);
+        };
+    };
+    engine->addStateChangeListener(latestId, gate, onOutput(latest));
+    engine->addStateChangeListener(everyId, gate, onOutput(every), true);
+
+    // three output transitions between two dispatches
+    for (const auto state : {LogicState::high, LogicState::low, LogicState::high}) {
+        engine->setOutputSlotState(input, 0, state);
+        ASSERT_TRUE(engine->runUntilStable());
+    }
+
+    EXPECT_GT(engine->dispatchStateChanges(), 0u);
+    EXPECT_EQ(every, (std::vector<LogicState>{LogicState::low, LogicState::high, LogicState::low}));
+    EXPECT_EQ(latest, std::vector<LogicState>{LogicState::low});
+    EXPECT_EQ(engine->getDroppedStateChanges(), 0u);
+
+    // nothing is logged for a component without listeners
+    engine->removeStateChangeListener(latestId, gate);
+    engine->removeStateChangeListener(everyId, gate);
+    engine->setOutputSlotState(input, 0, LogicState::low);
+    ASSERT_TRUE(engine->runUntilStable());
+    EXPECT_EQ(engine->dispatchStateChanges(), 0u);
+    EXPECT_EQ(every.size(), 3u);
+}
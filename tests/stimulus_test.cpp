@@ -0,0 +1,97 @@
+#include "component_definition.h"
+#include "gtest/gtest.h"
+#include "sim_engine_test_fixture.h"
+#include "simulation_engine.h"
+#include "stimulus/stimulus.h"
+#include "types.h"
+#include <memory>
+#include <sstream>
+#include <stdexcept>
+
+namespace {
+    using Bess::UUID;
+    using namespace Bess::SimEngine;
+    using namespace Bess::Tests;
+
+    Stimulus parse(const std::string &text) {
+        std::istringstream in(text);
+        return Stimulus::parseCsv(in);
+    }
+
+    class StimulusApplyTest : public SimEngineTestBase {};
+} // namespace
+
+TEST(SimTimeParseTest, AcceptsUnitsAndDefaultsToNanoseconds) {
+    SimTime time;
+    ASSERT_TRUE(parseSimTime("15", time));
+    EXPECT_EQ(time, SimTime(15));
+    ASSERT_TRUE(parseSimTime("3us", time));
+    EXPECT_EQ(time, SimTime(3000));
+    ASSERT_TRUE(parseSimTime("2000ps", time));
+    EXPECT_EQ(time, SimTime(2));
+    ASSERT_TRUE(parseSimTime("1ms", time));
+    EXPECT_EQ(time, SimTime(1000000));
+
+    EXPECT_FALSE(parseSimTime("", time));
+    EXPECT_FALSE(parseSimTime("10 days", time));
+    EXPECT_FALSE(parseSimTime("-5ns", time));
+}
+
+TEST(StimulusParseTest, ReadsStepsAndSkipsCommentsAndEmptyCells) {
+    const auto stimulus = parse("# reset then count\n"
+                                "time, a, bus\n"
+                                "0, 0, 0x3\n"
+                                "\n"
+                                "10ns, 1,\n"
+                                "20, , 1z0x\n");
+
+    ASSERT_EQ(stimulus.getSignals(), (std::vector<std::string>{"a", "bus"}));
+    const auto &steps = stimulus.getSteps();
+    ASSERT_EQ(steps.size(), 3u);
+    EXPECT_EQ(stimulus.getEndTime(), SimTime(20));
+
+    ASSERT_EQ(steps[0].values.size(), 2u);
+    EXPECT_EQ(steps[0].values[1].signal, 1u);
+    ASSERT_EQ(steps[0].values[1].bits.size(), 4u);
+    EXPECT_EQ(steps[0].values[1].bits[0], LogicState::high);
+    EXPECT_EQ(steps[0].values[1].bits[1], LogicState::high);
+    EXPECT_EQ(steps[0].values[1].bits[2], LogicState::low);
+
+    ASSERT_EQ(steps[1].values.size(), 1u);
+    EXPECT_EQ(steps[1].values[0].signal, 0u);
+    EXPECT_EQ(steps[1].values[0].bits, std::vector<LogicState>{LogicState::high});
+
+    ASSERT_EQ(steps[2].values.size(), 1u);
+    EXPECT_EQ(steps[2].values[0].bits, (std::vector<LogicState>{LogicState::unknown, LogicState::low,
+                                                                 LogicState::high_z, LogicState::high}));
+}
+
+TEST(StimulusParseTest, RejectsMalformedInput) {
+    EXPECT_THROW(parse("time\n0\n"), std::runtime_error);
+    EXPECT_THROW(parse("time,a\nsoon,1\n"), std::runtime_error);
+    EXPECT_THROW(parse("time,a\n0,2\n"), std::runtime_error);
+    EXPECT_THROW(parse("time,a\n0,0xg\n"), std::runtime_error);
+    EXPECT_THROW(parse("time,a\n0,1,1\n"), std::runtime_error);
+    EXPECT_THROW(parse("time,a\n10,1\n5,0\n"), std::runtime_error);
+}
+
+TEST_F(StimulusApplyTest, DrivesInputsAtTheirTimes) {
+    const auto input = engine->addComponent(findDefinitionByName("Input"));
+    const auto gate = engine->addComponent(findDefinitionByName("NOT Gate"));
+    ASSERT_TRUE(engine->connectComponent(input, 0, SlotType::digitalOutput, gate, 0, SlotType::digitalInput));
+    ASSERT_TRUE(engine->runUntilStable());
+
+    const auto stimulus = parse("time,in\n10,1\n30,0\n");
+    const auto start = engine->getSimulationTime();
+    ASSERT_TRUE(stimulus.apply(*engine, {{"in", input}}, start + SimTime(20)));
+
+    // only the first step falls inside the run
+    EXPECT_GE(engine->getSimulationTime(), start + SimTime(20));
+    EXPECT_EQ(engine->getDigitalComponent(input)->state.outputStates[0].state, LogicState::high);
+    EXPECT_EQ(engine->getDigitalComponent(gate)->state.outputStates[0].state, LogicState::low);
+}
+
+TEST_F(StimulusApplyTest, RejectsSignalsThatAreNotInputs) {
+    const auto stimulus = parse("time,missing\n0,1\n");
+    EXPECT_THROW(stimulus.apply(*engine, {}, SimTime(10)), std::runtime_error);
+}
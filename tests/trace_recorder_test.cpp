@@ -0,0 +1,181 @@
+#include "component_definition.h"
+#include "gtest/gtest.h"
+#include "sim_engine_test_fixture.h"
+#include "simulation_engine.h"
+#include "trace/trace_recorder.h"
+#include "trace/trace_writer.h"
+#include "types.h"
+#include <atomic>
+#include <chrono>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <memory>
+#include <sstream>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+namespace {
+    using Bess::UUID;
+    using namespace Bess::SimEngine;
+    using namespace Bess::Tests;
+
+    std::string readFile(const std::filesystem::path &path) {
+        std::ifstream in(path, std::ios::binary);
+        return {std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>()};
+    }
+
+    // clearing the engine also stops a trace a failed test left running
+    class TraceRecorderTest : public SimEngineTestBase {};
+} // namespace
+
+TEST(VcdTraceWriterTest, NestsScopesAndWritesChangesPerTimestamp) {
+    auto stream = std::make_unique<std::ostringstream>();
+    const auto *text = stream.get();
+    VcdTraceWriter writer(std::move(stream));
+
+    const std::vector<TraceSignal> signals = {
+        {"top/u0", "q", UUID(), SlotType::digitalOutput, 0},
+        {"top", "clk", UUID(), SlotType::digitalOutput, 0},
+        {"top/u0", "d in", UUID(), SlotType::digitalInput, 0},
+    };
+    writer.begin(signals, SimTime(0),
+                 {SlotState(LogicState::low, SimTime(0)), SlotState(LogicState::high, SimTime(0)),
+                  SlotState(LogicState::high_z, SimTime(0))});
+    writer.change(SimTime(5), 1, LogicState::low, 0);
+    writer.change(SimTime(5), 0, LogicState::unknown, 0);
+    writer.change(SimTime(7), 0, LogicState::high, 0);
+    writer.end(SimTime(10));
+
+    const std::string expected =
+        "$version BESS $end\n"
+        "$timescale 1ns $end\n"
+        "$scope module top $end\n"
+        "$var wire 1 \" clk $end\n"
+        "$scope module u0 $end\n"
+        "$var wire 1 ! q $end\n"
+        "$var wire 1 # d_in $end\n"
+        "$upscope $end\n"
+        "$upscope $end\n"
+        "$enddefinitions $end\n"
+        "#0\n$dumpvars\n0!\n1\"\nz#\n$end\n"
+        "#5\n0\"\nx!\n"
+        "#7\n1!\n"
+        "#10\n";
+    EXPECT_EQ(text->str(), expected);
+    EXPECT_EQ(VcdTraceWriter::identifierOf(94), "!\"");
+}
+
+TEST(VcdTraceWriterTest, WritesBusesAsVectors) {
+    auto stream = std::make_unique<std::ostringstream>();
+    const auto *text = stream.get();
+    VcdTraceWriter writer(std::move(stream));
+
+    std::vector<TraceSignal> signals = {{"top", "data", UUID(), SlotType::digitalOutput, 0}};
+    signals[0].width = 8;
+    SlotState initial(LogicState::high, SimTime(0));
+    initial.value = 0xa5;
+    writer.begin(signals, SimTime(0), {initial});
+    writer.change(SimTime(3), 0, LogicState::low, 0);
+    writer.change(SimTime(4), 0, LogicState::unknown, 0);
+    writer.end(SimTime(4));
+
+    const auto vcd = text->str();
+    EXPECT_NE(vcd.find("$var wire 8 ! data $end"), std::string::npos);
+    EXPECT_NE(vcd.find("$dumpvars\nb10100101 !\n$end\n"), std::string::npos);
+    EXPECT_NE(vcd.find("#3\nb0 !\n#4\nbx !\n"), std::string::npos);
+}
+
+TEST(TraceRecorderLogTest, FullLogMakesProducersWaitInsteadOfDropping) {
+    // counts the changes, with a delay so the tiny log keeps filling up
+    class CountingWriter : public TraceWriter {
+      public:
+        explicit CountingWriter(std::atomic<uint64_t> &changes) : m_changes(changes) {}
+        void begin(const std::vector<TraceSignal> &, SimTime, const std::vector<SlotState> &) override {}
+        void change(SimTime, uint32_t, LogicState, uint64_t) override {
+            if (m_changes.fetch_add(1) % 1024 == 0)
+                std::this_thread::sleep_for(std::chrono::microseconds(200));
+        }
+        void end(SimTime) override {}
+
+      private:
+        std::atomic<uint64_t> &m_changes;
+    };
+
+    const UUID component;
+    std::atomic<uint64_t> changes{0};
+    TraceRecorder recorder(std::make_unique<CountingWriter>(changes),
+                           {{"top", "a", component, SlotType::digitalOutput, 0}}, 16);
+    recorder.start(SimTime(0), {SlotState(LogicState::low, SimTime(0))});
+
+    constexpr int producers = 4;
+    constexpr int perProducer = 20000;
+    std::vector<std::thread> threads;
+    for (int p = 0; p < producers; p++) {
+        threads.emplace_back([&recorder, &component] {
+            for (int i = 0; i < perProducer; i++) {
+                recorder.record({component, SlotType::digitalOutput, 0,
+                                 i % 2 ? LogicState::high : LogicState::low, SimTime(i)});
+            }
+        });
+    }
+    for (auto &thread : threads) {
+        thread.join();
+    }
+    recorder.stop(SimTime(perProducer));
+
+    EXPECT_EQ(changes.load(), static_cast<uint64_t>(producers * perProducer));
+    EXPECT_EQ(recorder.getWrittenCount(), static_cast<uint64_t>(producers * perProducer));
+    EXPECT_GT(recorder.getStallCount(), 0u);
+}
+
+TEST_F(TraceRecorderTest, StreamsSelectedSlotsToVcdAndBinary) {
+    const auto input = engine->addComponent(findDefinitionByName("Input"));
+    const auto gate = engine->addComponent(findDefinitionByName("NOT Gate"));
+    ASSERT_TRUE(engine->connectComponent(input, 0, SlotType::digitalOutput, gate, 0, SlotType::digitalInput));
+    ASSERT_TRUE(engine->runUntilStable());
+
+    const std::vector<TraceSignal> signals = {
+        {"top", "a", input, SlotType::digitalOutput, 0},
+        {"top", "y", gate, SlotType::digitalOutput, 0},
+    };
+    const auto dir = std::filesystem::temp_directory_path();
+    const auto vcdPath = dir / "bess_trace_recorder_test.vcd";
+    const auto binPath = dir / "bess_trace_recorder_test.btrc";
+
+    for (const auto &[path, format] : {std::pair{vcdPath, TraceFormat::vcd}, std::pair{binPath, TraceFormat::binary}}) {
+        ASSERT_TRUE(engine->startTrace(path, signals, format));
+        EXPECT_TRUE(engine->isTracing());
+        for (const auto state : {LogicState::high, LogicState::low, LogicState::high}) {
+            engine->setOutputSlotState(input, 0, state);
+            ASSERT_TRUE(engine->runUntilStable());
+        }
+        engine->stopTrace();
+        EXPECT_FALSE(engine->isTracing());
+    }
+
+    const auto vcd = readFile(vcdPath);
+    EXPECT_NE(vcd.find("$var wire 1 ! a $end"), std::string::npos);
+    EXPECT_NE(vcd.find("$var wire 1 \" y $end"), std::string::npos);
+    EXPECT_NE(vcd.find("$dumpvars\n0!\n1\"\n$end\n"), std::string::npos);
+    // three edges on the input, each followed by the inverted output
+    size_t risingInput = 0, fallingOutput = 0;
+    for (size_t pos = 0; (pos = vcd.find('\n', pos)) != std::string::npos; pos++) {
+        const auto line = std::string_view(vcd).substr(pos + 1, vcd.find('\n', pos + 1) - pos - 1);
+        risingInput += line == "1!";
+        fallingOutput += line == "0\"";
+    }
+    EXPECT_EQ(risingInput, 2u);
+    EXPECT_EQ(fallingOutput, 2u);
+
+    const auto bin = readFile(binPath);
+    ASSERT_GE(bin.size(), sizeof(BinaryTraceWriter::magic));
+    uint64_t magic = 0;
+    std::memcpy(&magic, bin.data(), sizeof(magic));
+    EXPECT_EQ(magic, BinaryTraceWriter::magic);
+    EXPECT_LT(bin.size(), vcd.size());
+
+    std::filesystem::remove(vcdPath);
+    std::filesystem::remove(binPath);
+}
@@ -0,0 +1,197 @@
+#include "component_definition.h"
+#include "expression_evalutator/expr_evaluator.h"
+#include "gtest/gtest.h"
+#include "sim_engine_test_fixture.h"
+#include "simulation_engine.h"
+#include "truth_table/truth_table.h"
+#include "types.h"
+#include <filesystem>
+#include <memory>
+#include <random>
+#include <vector>
+
+namespace {
+    using Bess::UUID;
+    using namespace Bess::SimEngine;
+    using namespace Bess::Tests;
+
+    // 3 input, 2 output part with an expression based definition
+    std::shared_ptr<ComponentDefinition> makeExpressionDefinition() {
+        auto def = std::make_shared<ComponentDefinition>();
+        def->setName("Test Majority");
+        def->setGroupName("Tests");
+        def->setInputSlotsInfo({SlotsGroupType::input, false, 3, {}, {}});
+        def->setOutputSlotsInfo({SlotsGroupType::output, false, 2, {}, {}});
+        def->setOutputExpressions({"(0*1)+(1*2)+(0*2)", "!(0^1^2)"});
+        def->setInPlaceSimulationFunction(ExprEval::exprEvalInPlaceSimFunc);
+        def->setParallelSafe(true);
+        def->setSimDelay(SimDelayNanoSeconds(2));
+        return def;
+    }
+
+    // simulation function only, so the table has to come from the event loop
+    std::shared_ptr<ComponentDefinition> makeOpaqueXorDefinition() {
+        auto def = std::make_shared<ComponentDefinition>();
+        def->setName("Opaque XOR");
+        def->setGroupName("Tests");
+        def->setInputSlotsInfo({SlotsGroupType::input, false, 2, {}, {}});
+        def->setOutputSlotsInfo({SlotsGroupType::output, false, 1, {}, {}});
+        def->setSimDelay(SimDelayNanoSeconds(3));
+        def->setSimulationFunction([](const std::vector<SlotState> &inputs, SimTime ts,
+                                      const ComponentState &prev) {
+            auto next = prev;
+            next.inputStates = inputs;
+            const auto value = (inputs[0].state == LogicState::high) != (inputs[1].state == LogicState::high)
+                                   ? LogicState::high
+                                   : LogicState::low;
+            next.isChanged = prev.outputStates[0].state != value;
+            if (next.isChanged)
+                next.outputStates[0] = {value, ts};
+            return next;
+        });
+        return def;
+    }
+
+    // stands in for a definition held by the python bindings, which clone it themselves
+    class PythonOwnedDefinition : public ComponentDefinition {
+      public:
+        explicit PythonOwnedDefinition(const ComponentDefinition &base) : ComponentDefinition(base) {}
+
+        std::shared_ptr<ComponentDefinition> clone() const override {
+            return std::make_shared<PythonOwnedDefinition>(*this);
+        }
+    };
+
+    // `width` inputs through `depth` layers of random gates, every last layer gate drives an output
+    UUID buildRandomCone(SimulationEngine &engine, size_t width, size_t depth, uint32_t seed,
+                         const std::shared_ptr<ComponentDefinition> &extra = nullptr) {
+        const std::vector<std::shared_ptr<ComponentDefinition>> gates = {
+            findDefinitionByName("AND Gate"),
+            findDefinitionByName("OR Gate"),
+            findDefinitionByName("XOR Gate"),
+            findDefinitionByName("NAND Gate"),
+            findDefinitionByName("XNOR Gate"),
+            findDefinitionByName("NOT Gate"),
+        };
+        const auto expression = makeExpressionDefinition();
+
+        std::mt19937 rng(seed);
+        std::vector<UUID> previous;
+        for (size_t i = 0; i < width; i++) {
+            previous.push_back(engine.addComponent(findDefinitionByName("Input")));
+        }
+
+        for (size_t layer = 0; layer < depth; layer++) {
+            std::vector<UUID> current;
+            for (size_t i = 0; i < width; i++) {
+                auto def = gates[rng() % gates.size()];
+                if (i % 5 == 2)
+                    def = expression;
+                else if (extra && i % 7 == 3)
+                    def = extra;
+
+                const auto gate = engine.addComponent(def);
+                const auto inputCount = def->getInputSlotsInfo().count;
+                for (size_t slot = 0; slot < inputCount; slot++) {
+                    const auto &src = slot == 0 ? previous[i] : previous[rng() % width];
+                    engine.connectComponent(src, 0, SlotType::digitalOutput, gate, (int)slot, SlotType::digitalInput);
+                }
+                current.push_back(gate);
+            }
+            previous = std::move(current);
+        }
+
+        for (const auto &gate : previous) {
+            const auto output = engine.addComponent(findDefinitionByName("Output"));
+            engine.connectComponent(gate, 0, SlotType::digitalOutput, output, 0, SlotType::digitalInput);
+        }
+        return engine.getNetOf(previous.front());
+    }
+
+    // drives every row through the simulation and compares the settled outputs
+    void expectMatchesSimulation(SimulationEngine &engine, const TruthTable &table) {
+        for (uint64_t row = 0; row < table.getRowCount(); row++) {
+            for (size_t column = 0; column < table.getInputCount(); column++) {
+                engine.setOutputSlotState(table.inputUuids[column], 0, table.getInput(row, column));
+            }
+            ASSERT_TRUE(engine.runUntilStable());
+            for (size_t column = 0; column < table.getOutputCount(); column++) {
+                const auto state = engine.getDigitalSlotState(table.outputUuids[column], SlotType::digitalInput, 0).state;
+                ASSERT_EQ(table.getOutput(row, column), state) << "row " << row << ", output " << column;
+            }
+        }
+    }
+
+    class TruthTableTest : public SimEngineTestBase {};
+} // namespace
+
+TEST_F(TruthTableTest, BitParallelMatchesEventSimulation) {
+    const auto net = buildRandomCone(*engine, 7, 4, 5);
+
+    const auto table = engine->getTruthTableOfNet(net);
+    ASSERT_TRUE(table.isBitParallel());
+    ASSERT_FALSE(table.isSpilled());
+    ASSERT_EQ(table.getInputCount(), 7u);
+    ASSERT_EQ(table.getOutputCount(), 7u);
+    ASSERT_EQ(table.getRowCount(), 128u);
+
+    expectMatchesSimulation(*engine, table);
+}
+
+TEST_F(TruthTableTest, NetsWithoutBitwiseFormUseEventLoop) {
+    const auto net = buildRandomCone(*engine, 5, 3, 9, makeOpaqueXorDefinition());
+
+    const auto table = engine->getTruthTableOfNet(net);
+    ASSERT_FALSE(table.empty());
+    EXPECT_FALSE(table.isBitParallel());
+    ASSERT_EQ(table.getRowCount(), 32u);
+
+    expectMatchesSimulation(*engine, table);
+}
+
+TEST_F(TruthTableTest, PythonDefinitionsUseEventLoop) {
+    // the expression is only a hint, python sims may do more than it says
+    const auto def = std::make_shared<PythonOwnedDefinition>(*makeOpaqueXorDefinition());
+    def->setOutputExpressions({"0^1"});
+    def->setOwnership(CompDefinitionOwnership::Python);
+    const auto net = buildRandomCone(*engine, 5, 3, 9, def);
+
+    const auto table = engine->getTruthTableOfNet(net);
+    ASSERT_FALSE(table.empty());
+    EXPECT_FALSE(table.isBitParallel());
+
+    expectMatchesSimulation(*engine, table);
+}
+
+TEST_F(TruthTableTest, LargeTablesSpillToDisk) {
+    const auto net = buildRandomCone(*engine, 9, 3, 17);
+
+    const auto inMemory = engine->getTruthTableOfNet(net);
+    ASSERT_FALSE(inMemory.isSpilled());
+
+    TruthTableOptions options;
+    options.memoryLimitBytes = 0;
+    options.threadCount = 2;
+    const auto spilled = engine->getTruthTableOfNet(net, options);
+    ASSERT_TRUE(spilled.isSpilled());
+    ASSERT_TRUE(std::filesystem::exists(spilled.getSpillPath()));
+    EXPECT_EQ(std::filesystem::file_size(spilled.getSpillPath()),
+              4 * sizeof(uint64_t) + spilled.getOutputCount() * 2 * spilled.getWordCount() * sizeof(uint64_t));
+
+    ASSERT_EQ(spilled.getRowCount(), inMemory.getRowCount());
+    for (uint64_t row = 0; row < inMemory.getRowCount(); row++) {
+        for (size_t column = 0; column < inMemory.getOutputCount(); column++) {
+            ASSERT_EQ(spilled.getOutput(row, column), inMemory.getOutput(row, column))
+                << "row " << row << ", output " << column;
+        }
+    }
+    std::filesystem::remove(spilled.getSpillPath());
+}
+
+TEST_F(TruthTableTest, TwentyInputConeIsBitParallel) {
+    const auto net = buildRandomCone(*engine, 20, 6, 23);
+
+    const auto table = engine->getTruthTableOfNet(net);
+    ASSERT_TRUE(table.isBitParallel());
+    ASSERT_EQ(table.getRowCount(), uint64_t{1} << 20);
+}
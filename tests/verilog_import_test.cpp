@@ -10,6 +10,7 @@
 #include "simulation_engine.h"
 #include "types.h"
 #include "gtest/gtest.h"
+#include <algorithm>
 #include <atomic>
 #include <array>
 #include <filesystem>
@@ -17,6 +18,7 @@
 #include <json/value.h>
 #include <limits>
 #include <memory>
+#include <sstream>
 #include <thread>
 #include <unordered_map>
 
@@ -190,6 +192,27 @@ TEST_F(VerilogImportTest, ImportsNestedModulesIntoSimulationEngineAndPropagatesS
     })) << "Expected output to resolve low for 1 & !1";
 }
 
+TEST_F(VerilogImportTest, CollectsTraceSignalsScopedByInstancePath) {
+    const auto design = parseDesignFromYosysJson(buildNestedModuleJson());
+    const auto result = importDesignIntoSimulationEngine(design, *engine);
+
+    const auto topSignals = collectTraceSignals(result, *engine);
+    ASSERT_EQ(topSignals.size(), 3u);
+    for (const auto &signal : topSignals) {
+        EXPECT_EQ(signal.scope, "top");
+    }
+    const auto out0 = std::ranges::find(topSignals, std::string("out0"), &TraceSignal::name);
+    ASSERT_NE(out0, topSignals.end());
+    EXPECT_EQ(out0->component, result.topOutputComponents.at("out0"));
+    EXPECT_EQ(out0->type, SlotType::digitalInput);
+
+    const auto allSignals = collectTraceSignals(result, *engine, true);
+    EXPECT_GT(allSignals.size(), topSignals.size());
+    EXPECT_TRUE(std::ranges::any_of(allSignals, [](const TraceSignal &signal) {
+        return signal.scope == "top/u_child";
+    }));
+}
+
 TEST_F(VerilogImportTest, PreservesHierarchicalHalfAdderInstanceInterfacesForSceneImport) {
     const auto verilogPath = writeTempVerilogFile(
         "bess_hierarchical_full_adder_test.v",
@@ -1902,6 +1925,351 @@ TEST_F(VerilogImportTest, ImportsMemoryReadWriteCellsFromYosysJson) {
     ASSERT_TRUE(waitUntil([&] { return readBus(dout, 4) == 0xA; }));
 }
 
+TEST_F(VerilogImportTest, ImportsMemV2CellAsDenseMemoryWithInitAndCheckpoints) {
+    Json::Value root(Json::objectValue);
+    root["modules"] = Json::Value(Json::objectValue);
+
+    auto &top = root["modules"]["top"];
+    top["attributes"]["top"] = "1";
+
+    top["ports"]["clk"]["direction"] = "input";
+    top["ports"]["clk"]["bits"].append(1);
+    top["ports"]["we"]["direction"] = "input";
+    top["ports"]["we"]["bits"].append(2);
+    top["ports"]["addr"]["direction"] = "input";
+    top["ports"]["addr"]["bits"].append(3);
+    top["ports"]["addr"]["bits"].append(4);
+    top["ports"]["din"]["direction"] = "input";
+    top["ports"]["dout"]["direction"] = "output";
+    for (int bit = 0; bit < 4; ++bit) {
+        top["ports"]["din"]["bits"].append(5 + bit);
+        top["ports"]["dout"]["bits"].append(9 + bit);
+    }
+
+    auto &mem = top["cells"]["u_mem"];
+    mem["type"] = "$mem_v2";
+    mem["parameters"]["MEMID"] = "\\dense_mem";
+    mem["parameters"]["ABITS"] = "00000000000000000000000000000010";
+    mem["parameters"]["WIDTH"] = "00000000000000000000000000000100";
+    mem["parameters"]["SIZE"] = "00000000000000000000000000000100";
+    mem["parameters"]["OFFSET"] = "00000000000000000000000000000000";
+    // entries 3, 2, 1, 0
+    mem["parameters"]["INIT"] = "0111001010010101";
+    mem["parameters"]["RD_PORTS"] = "00000000000000000000000000000001";
+    mem["parameters"]["RD_CLK_ENABLE"] = "0";
+    mem["parameters"]["RD_CLK_POLARITY"] = "0";
+    mem["parameters"]["RD_TRANSPARENCY_MASK"] = "0";
+    mem["parameters"]["WR_PORTS"] = "00000000000000000000000000000001";
+    mem["parameters"]["WR_CLK_ENABLE"] = "1";
+    mem["parameters"]["WR_CLK_POLARITY"] = "1";
+    mem["connections"]["RD_CLK"].append("x");
+    mem["connections"]["RD_EN"].append("1");
+    mem["connections"]["RD_ADDR"].append(3);
+    mem["connections"]["RD_ADDR"].append(4);
+    mem["connections"]["WR_CLK"].append(1);
+    mem["connections"]["WR_ADDR"].append(3);
+    mem["connections"]["WR_ADDR"].append(4);
+    for (int bit = 0; bit < 4; ++bit) {
+        mem["connections"]["RD_DATA"].append(9 + bit);
+        mem["connections"]["WR_DATA"].append(5 + bit);
+        mem["connections"]["WR_EN"].append(2);
+    }
+
+    const auto design = parseDesignFromYosysJson(root);
+    const auto result = importDesignIntoSimulationEngine(design, *engine);
+
+    const auto clk = result.topInputComponents.at("clk");
+    const auto we = result.topInputComponents.at("we");
+    const auto addr = result.topInputComponents.at("addr");
+    const auto din = result.topInputComponents.at("din");
+    const auto dout = result.topOutputComponents.at("dout");
+
+    auto writeBus = [&](const UUID &componentId, uint32_t value, size_t width) {
+        for (size_t i = 0; i < width; ++i) {
+            engine->setOutputSlotState(componentId,
+                                       static_cast<int>(i),
+                                       ((value >> i) & 1U) ? LogicState::high : LogicState::low);
+        }
+    };
+
+    auto readBus = [&](const UUID &componentId, size_t width) {
+        uint32_t value = 0;
+        for (size_t i = 0; i < width; ++i) {
+            if (engine->getDigitalSlotState(componentId, SlotType::digitalInput, static_cast<int>(i)).state ==
+                LogicState::high) {
+                value |= (1U << i);
+            }
+        }
+        return value;
+    };
+
+    auto writeEntry = [&](uint32_t address, uint32_t value) {
+        writeBus(addr, address, 2);
+        writeBus(din, value, 4);
+        engine->setOutputSlotState(we, 0, LogicState::high);
+        engine->setOutputSlotState(clk, 0, LogicState::high);
+        std::this_thread::sleep_for(std::chrono::milliseconds(5));
+        engine->setOutputSlotState(clk, 0, LogicState::low);
+        engine->setOutputSlotState(we, 0, LogicState::low);
+        std::this_thread::sleep_for(std::chrono::milliseconds(5));
+    };
+
+    auto readEntry = [&](uint32_t address, uint32_t expected) {
+        writeBus(addr, address, 2);
+        return waitUntil([&] { return readBus(dout, 4) == expected; });
+    };
+
+    engine->setOutputSlotState(clk, 0, LogicState::low);
+    engine->setOutputSlotState(we, 0, LogicState::low);
+
+    ASSERT_TRUE(readEntry(0, 0x5)) << "INIT entry 0";
+    ASSERT_TRUE(readEntry(1, 0x9));
+    ASSERT_TRUE(readEntry(3, 0x7));
+
+    writeEntry(2, 0xC);
+    ASSERT_TRUE(readEntry(2, 0xC));
+    ASSERT_TRUE(readEntry(1, 0x9));
+
+    engine->setSimulationState(SimulationState::paused);
+    std::stringstream checkpoint;
+    engine->saveCheckpoint(checkpoint);
+    engine->setSimulationState(SimulationState::running);
+
+    writeEntry(2, 0x1);
+    ASSERT_TRUE(readEntry(2, 0x1));
+
+    engine->setSimulationState(SimulationState::paused);
+    engine->restoreCheckpoint(checkpoint);
+    engine->setSimulationState(SimulationState::running);
+
+    ASSERT_TRUE(readEntry(1, 0x9));
+    ASSERT_TRUE(readEntry(2, 0xC)) << "Restoring the checkpoint should bring back the memory content";
+}
+
+TEST_F(VerilogImportTest, ImportsWordLevelRegisterAddAndMuxCellsFromYosysJson) {
+    Json::Value root(Json::objectValue);
+    root["modules"] = Json::Value(Json::objectValue);
+
+    auto &top = root["modules"]["top"];
+    top["attributes"]["top"] = "1";
+
+    top["ports"]["clk"]["direction"] = "input";
+    top["ports"]["clk"]["bits"].append(1);
+    top["ports"]["rst"]["direction"] = "input";
+    top["ports"]["rst"]["bits"].append(2);
+    top["ports"]["en"]["direction"] = "input";
+    top["ports"]["en"]["bits"].append(3);
+    top["ports"]["q"]["direction"] = "output";
+    for (int bit = 4; bit < 8; ++bit) {
+        top["ports"]["q"]["bits"].append(bit);
+    }
+
+    // q <= rst ? 4'b0101 : (en ? q + 1 : q)
+    auto &add = top["cells"]["u_add"];
+    add["type"] = "$add";
+    add["parameters"]["A_SIGNED"] = "0";
+    add["parameters"]["B_SIGNED"] = "0";
+    for (int bit = 0; bit < 4; ++bit) {
+        add["connections"]["A"].append(4 + bit);
+        add["connections"]["B"].append(bit == 0 ? "1" : "0");
+        add["connections"]["Y"].append(8 + bit);
+    }
+
+    auto &mux = top["cells"]["u_mux"];
+    mux["type"] = "$mux";
+    mux["connections"]["S"].append(3);
+    for (int bit = 0; bit < 4; ++bit) {
+        mux["connections"]["A"].append(4 + bit);
+        mux["connections"]["B"].append(8 + bit);
+        mux["connections"]["Y"].append(12 + bit);
+    }
+
+    auto &reg = top["cells"]["u_reg"];
+    reg["type"] = "$adff";
+    reg["parameters"]["CLK_POLARITY"] = "1";
+    reg["parameters"]["ARST_POLARITY"] = "1";
+    reg["parameters"]["ARST_VALUE"] = "0101";
+    reg["connections"]["CLK"].append(1);
+    reg["connections"]["ARST"].append(2);
+    for (int bit = 0; bit < 4; ++bit) {
+        reg["connections"]["D"].append(12 + bit);
+        reg["connections"]["Q"].append(4 + bit);
+    }
+
+    const auto design = parseDesignFromYosysJson(root);
+    const auto result = importDesignIntoSimulationEngine(design, *engine);
+
+    size_t wordComponents = 0;
+    for (const auto &componentId : result.createdComponentIds) {
+        const auto component = engine->getDigitalComponent(componentId);
+        ASSERT_NE(component, nullptr);
+        const auto &name = component->definition->getName();
+        if (name.starts_with("Verilog $add") || name.starts_with("Verilog $mux") ||
+            name.find(" W4") != std::string::npos) {
+            ++wordComponents;
+        }
+    }
+    EXPECT_EQ(wordComponents, 3u) << "Each coarse cell should stay a single component";
+
+    const auto clk = result.topInputComponents.at("clk");
+    const auto rst = result.topInputComponents.at("rst");
+    const auto en = result.topInputComponents.at("en");
+    const auto q = result.topOutputComponents.at("q");
+
+    auto readBus = [&](const UUID &componentId, size_t width) {
+        uint32_t value = 0;
+        for (size_t i = 0; i < width; ++i) {
+            if (engine->getDigitalSlotState(componentId, SlotType::digitalInput, static_cast<int>(i)).state ==
+                LogicState::high) {
+                value |= (1U << i);
+            }
+        }
+        return value;
+    };
+
+    auto clockTick = [&]() {
+        engine->setOutputSlotState(clk, 0, LogicState::high);
+        std::this_thread::sleep_for(std::chrono::milliseconds(20));
+        engine->setOutputSlotState(clk, 0, LogicState::low);
+        std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    };
+
+    engine->setOutputSlotState(clk, 0, LogicState::low);
+    engine->setOutputSlotState(en, 0, LogicState::high);
+    engine->setOutputSlotState(rst, 0, LogicState::high);
+    ASSERT_TRUE(waitUntil([&] { return readBus(q, 4) == 5; })) << "Async reset did not load ARST_VALUE";
+    engine->setOutputSlotState(rst, 0, LogicState::low);
+
+    clockTick();
+    ASSERT_TRUE(waitUntil([&] { return readBus(q, 4) == 6; }));
+    clockTick();
+    ASSERT_TRUE(waitUntil([&] { return readBus(q, 4) == 7; }));
+
+    engine->setOutputSlotState(en, 0, LogicState::low);
+    clockTick();
+    EXPECT_EQ(readBus(q, 4), 7u) << "Mux should hold the register when en is low";
+}
+
+TEST_F(VerilogImportTest, WordLevelImportOfSmallCpuCreatesFewerComponentsThanGateLevel) {
+    const auto verilogPath = writeTempVerilogFile(
+        buildUniqueTempVerilogFileName("bess_word_cpu"),
+        R"verilog(
+module acc_cpu(
+    input clk,
+    input rst,
+    input [11:0] instr,
+    output reg [7:0] acc,
+    output reg [7:0] pc
+);
+    wire [3:0] op = instr[11:8];
+    wire [7:0] imm = instr[7:0];
+    reg [7:0] next;
+
+    always @(*) begin
+        case (op)
+            4'h0: next = acc;
+            4'h1: next = imm;
+            4'h2: next = acc + imm;
+            4'h3: next = acc - imm;
+            4'h4: next = acc << imm[2:0];
+            4'h5: next = acc >> imm[2:0];
+            4'h6: next = (acc == imm) ? 8'd1 : 8'd0;
+            4'h7: next = (acc < imm) ? 8'd1 : 8'd0;
+            default: next = acc * imm;
+        endcase
+    end
+
+    always @(posedge clk or posedge rst) begin
+        if (rst) begin
+            acc <= 8'd0;
+            pc <= 8'd0;
+        end else begin
+            acc <= next;
+            pc <= pc + 8'd1;
+        end
+    end
+endmodule
+)verilog");
+
+    struct RunResult {
+        size_t components = 0;
+        uint64_t evaluations = 0;
+        uint32_t acc = 0;
+        uint32_t pc = 0;
+    };
+
+    const std::array<uint16_t, 6> program = {0x105, 0x203, 0x401, 0x302, 0x703, 0x20a};
+
+    auto runProgram = [&](YosysMappingLevel level) {
+        engine->clear();
+        const auto result = importVerilogFileIntoSimulationEngine(
+            verilogPath,
+            *engine,
+            YosysRunnerConfig{
+                .executablePath = "yosys",
+                .topModuleName = std::string("acc_cpu"),
+                .mappingLevel = level,
+            });
+
+        const auto clk = result.topInputComponents.at("clk");
+        const auto rst = result.topInputComponents.at("rst");
+        const auto instr = result.topInputComponents.at("instr");
+        const auto acc = result.topOutputComponents.at("acc");
+        const auto pc = result.topOutputComponents.at("pc");
+
+        auto readBus = [&](const UUID &componentId, size_t width) {
+            uint32_t value = 0;
+            for (size_t i = 0; i < width; ++i) {
+                if (engine->getDigitalSlotState(componentId, SlotType::digitalInput, static_cast<int>(i)).state ==
+                    LogicState::high) {
+                    value |= (1U << i);
+                }
+            }
+            return value;
+        };
+
+        const auto statsBefore = engine->getEventStats();
+        engine->setOutputSlotState(clk, 0, LogicState::low);
+        engine->setOutputSlotState(rst, 0, LogicState::high);
+        EXPECT_TRUE(engine->waitUntilStable(std::chrono::seconds(5)));
+        engine->setOutputSlotState(rst, 0, LogicState::low);
+
+        for (const auto word : program) {
+            for (size_t i = 0; i < 12; ++i) {
+                engine->setOutputSlotState(instr, static_cast<int>(i),
+                                           ((word >> i) & 1U) ? LogicState::high : LogicState::low);
+            }
+            EXPECT_TRUE(engine->waitUntilStable(std::chrono::seconds(5)));
+            engine->setOutputSlotState(clk, 0, LogicState::high);
+            EXPECT_TRUE(engine->waitUntilStable(std::chrono::seconds(5)));
+            engine->setOutputSlotState(clk, 0, LogicState::low);
+            EXPECT_TRUE(engine->waitUntilStable(std::chrono::seconds(5)));
+        }
+
+        return RunResult{
+            .components = result.createdComponentIds.size(),
+            .evaluations = engine->getEventStats().evaluated - statsBefore.evaluated,
+            .acc = readBus(acc, 8),
+            .pc = readBus(pc, 8),
+        };
+    };
+
+    const auto gate = runProgram(YosysMappingLevel::gate);
+    const auto word = runProgram(YosysMappingLevel::word);
+
+    // 5, 8, 16, 14, 0 (14 < 3 is false), 10
+    EXPECT_EQ(gate.acc, 10u);
+    EXPECT_EQ(gate.pc, program.size());
+    EXPECT_EQ(word.acc, gate.acc);
+    EXPECT_EQ(word.pc, gate.pc);
+
+    EXPECT_LT(word.components * 5, gate.components)
+        << "word level " << word.components << " components, gate level " << gate.components;
+    EXPECT_LT(word.evaluations, gate.evaluations);
+
+    std::filesystem::remove(verilogPath);
+}
+
 TEST_F(VerilogImportTest, DISABLED_TemporaryHarvardCpuSmokeExecutesBasicInstructions) {
     const std::filesystem::path cpuDir =
         "Verilog-Harvard-CPU/01. Single-cycle CPU";